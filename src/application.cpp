@@ -19,6 +19,7 @@
 #include "datastore/sqlitedatastore.h"
 #include "datastore/stashrepo.h"
 #include "datastore/userstore.h"
+#include "datastore/writebehindstore.h"
 #include "imagecache.h"
 #include "itemsmanager.h"
 #include "itemsmanagerworker.h"
@@ -128,31 +129,48 @@ void Application::InitUserSession()
     connect(item_mgr, &ItemsManager::RefreshFinished, &shop(), &Shop::OnRefreshFinished);
     connect(&shop(), &Shop::PoeSessionRejected, this, &Application::ClearSessionId);
 
-    auto characters = &userstore().characters();
-    auto stashes = &userstore().stashes();
+    // Replies are persisted write-behind: these connections are direct, so
+    // the writer queues them in emission order and a reconcile always lands
+    // after the saves emitted before it.
+    auto writer = session().store_writer.get();
 
     connect(worker,
             &ItemsManagerWorker::characterListReceived,
-            characters,
-            &CharacterRepo::saveCharacterList);
+            writer,
+            &WriteBehindStore::saveCharacterList);
     connect(worker,
             &ItemsManagerWorker::characterReceived,
-            characters,
-            &CharacterRepo::saveCharacter);
-    connect(worker, &ItemsManagerWorker::stashListReceived, stashes, &StashRepo::saveStashList);
-    connect(worker, &ItemsManagerWorker::stashReceived, stashes, &StashRepo::saveStash);
+            writer,
+            &WriteBehindStore::saveCharacter);
+    connect(worker,
+            &ItemsManagerWorker::stashListReceived,
+            writer,
+            &WriteBehindStore::saveStashList);
+    connect(worker, &ItemsManagerWorker::stashReceived, writer, &WriteBehindStore::saveStash);
+    connect(worker, &ItemsManagerWorker::stashUnchanged, writer, &WriteBehindStore::touchStash);
 
     // Authoritative-list reconciliation: rows the server no longer lists
     // are deleted so they cannot resurrect from the cache (F53).
     connect(worker,
             &ItemsManagerWorker::characterListReplaced,
-            characters,
-            &CharacterRepo::reconcileCharacterList);
-    connect(worker, &ItemsManagerWorker::stashListReplaced, stashes, &StashRepo::reconcileStashList);
+            writer,
+            &WriteBehindStore::reconcileCharacterList);
+    connect(worker,
+            &ItemsManagerWorker::stashListReplaced,
+            writer,
+            &WriteBehindStore::reconcileStashList);
     connect(worker,
             &ItemsManagerWorker::stashChildrenReplaced,
-            stashes,
-            &StashRepo::reconcileStashChildren);
+            writer,
+            &WriteBehindStore::reconcileStashChildren);
+
+    // A finished refresh is committed at once rather than after the delay.
+    connect(worker, &ItemsManagerWorker::RefreshFinished, writer, &WriteBehindStore::commitNow);
+    // A backlogged writer holds the worker's replies rather than its caller.
+    connect(writer,
+            &WriteBehindStore::backlogChanged,
+            worker,
+            &ItemsManagerWorker::OnStoreBacklog);
 
     auto buyout_mgr = &buyout_manager();
     auto buyouts = &userstore().buyouts();
@@ -173,7 +191,14 @@ void Application::InitUserSession()
     disconnect(updater, &UpdateChecker::UpdateAvailable, nullptr, nullptr);
 
     // Connect UI signals.
-    ConnectMainWindow(*this, main_window(), *item_mgr, *worker, shop(), *updater, *cache);
+    ConnectMainWindow(*this,
+                      main_window(),
+                      *item_mgr,
+                      *worker,
+                      shop(),
+                      *updater,
+                      *cache,
+                      *writer);
 }
 
 Application::CoreServices &Application::core() const
@@ -255,6 +280,7 @@ Application::UserSession::UserSession(const Application::CoreServices &core)
 
     spdlog::trace("Application::InitLogin() creating user datastore");
     userstore = std::make_unique<UserStore>(data_dir, account);
+    store_writer = std::make_unique<WriteBehindStore>(data_dir, account);
 
     spdlog::trace("Application::InitLogin() creating rate limiter");
     rate_limiter = std::make_unique<RateLimiter>(network_manager);
@@ -267,6 +293,7 @@ Application::UserSession::UserSession(const Application::CoreServices &core)
                                              "yyyyMMdd'T'hhmmss'Z'"));
         rate_limiter->EnableCapture(dir.filePath(capture_name));
     }
+    rate_limiter->EnablePersistence(*data);
 
     spdlog::trace("Application::InitLogin() creating the api client");
     api = std::make_unique<PoeApiClient>(*rate_limiter);
@@ -30,6 +30,7 @@ class RePoE;
 class Shop;
 class UserStore;
 class UpdateChecker;
+class WriteBehindStore;
 
 struct MainWindowDeleter
 {
@@ -77,6 +78,9 @@ private:
 
         std::unique_ptr<DataStore> data;
         std::unique_ptr<UserStore> userstore;
+        // The worker's replies are persisted through this, on its own
+        // thread and connection; it dies after the worker, flushing.
+        std::unique_ptr<WriteBehindStore> store_writer;
         std::unique_ptr<RateLimiter> rate_limiter;
         // Declared immediately after the limiter it references, so it dies
         // before the limiter and after every consumer that holds it (R6-2).
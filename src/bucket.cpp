@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <thread>
 
 #include "locationinventory.h"
 #include "modelprobes.h"
@@ -49,6 +50,96 @@ namespace {
         return bytes;
     }
 
+    // Rows per cancellation check and the floor below which another
+    // PlanSort worker costs more to start than it saves.
+    constexpr size_t kCancelStride = 4096;
+    constexpr size_t kMinRowsPerWorker = 16384;
+
+    // Runs fn(task) for every task in [0, tasks), one thread each, the
+    // calling thread taking task 0; returns when all have finished.
+    template<typename Fn>
+    void RunTasks(int tasks, const Fn &fn)
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(static_cast<size_t>(std::max(0, tasks - 1)));
+        for (int task = 1; task < tasks; ++task) {
+            workers.emplace_back([&fn, task]() { fn(task); });
+        }
+        fn(0);
+    }
+
+    // Row where chunk `chunk` of `chunks` even chunks over `rows` starts.
+    size_t ChunkStart(size_t rows, int chunks, int chunk)
+    {
+        return rows * static_cast<size_t>(chunk) / static_cast<size_t>(chunks);
+    }
+
+    // The keyed sort's comparison over permutation entries: the dense
+    // prefix array decides almost every pair, and only a prefix tie
+    // touches the (strided, QString-bearing) keys themselves.
+    class KeyedLess
+    {
+    public:
+        KeyedLess(const std::vector<ItemSortKey::Prefix> &prefixes,
+                  const std::vector<ItemSortKey> &keys,
+                  Qt::SortOrder order)
+            : m_prefixes(prefixes)
+            , m_keys(keys)
+            , m_ascending(order == Qt::AscendingOrder)
+        {}
+
+        bool operator()(std::uint32_t lhs, std::uint32_t rhs) const
+        {
+            if (!m_ascending) {
+                std::swap(lhs, rhs);
+            }
+            const ItemSortKey::Prefix &a = m_prefixes[lhs];
+            const ItemSortKey::Prefix &b = m_prefixes[rhs];
+            if (a != b) {
+                return a < b;
+            }
+            return m_keys[lhs] < m_keys[rhs];
+        }
+
+    private:
+        const std::vector<ItemSortKey::Prefix> &m_prefixes;
+        const std::vector<ItemSortKey> &m_keys;
+        bool m_ascending;
+    };
+
+    // Reorders items and keys so that row n takes old row perm[n], walking
+    // each cycle once and marking spent entries as self-loops (S3 review
+    // round 1): materializing sorted copies would transiently duplicate the
+    // key vector — ~144 B per item, ~144 MB extra at a one-million-item
+    // By-Item sort, right where the resident-key budget is tightest — and
+    // the gauge does not (and should not) count temporaries. The
+    // permutation itself is the only transient (4 B per item).
+    void ApplyPermutation(std::vector<std::uint32_t> &perm,
+                          Items &items,
+                          std::vector<ItemSortKey> &keys)
+    {
+        for (std::uint32_t start = 0; start < static_cast<std::uint32_t>(perm.size()); ++start) {
+            if (perm[start] == start) {
+                continue;
+            }
+            std::shared_ptr<Item> lifted_item = std::move(items[start]);
+            ItemSortKey lifted_key = std::move(keys[start]);
+            std::uint32_t n = start;
+            while (true) {
+                const std::uint32_t from = perm[n];
+                perm[n] = n;
+                if (from == start) {
+                    items[n] = std::move(lifted_item);
+                    keys[n] = std::move(lifted_key);
+                    break;
+                }
+                items[n] = std::move(items[from]);
+                keys[n] = std::move(keys[from]);
+                n = from;
+            }
+        }
+    }
+
 } // namespace
 
 void ResidentKeyStore::Release()
@@ -236,48 +327,182 @@ void Bucket::Sort(const Column &column, Qt::SortOrder order)
     // item order.
     HydrateKeys(column);
     const auto &keys = m_keys.keys;
+    std::vector<ItemSortKey::Prefix> prefixes;
+    prefixes.reserve(keys.size());
+    for (const auto &key : keys) {
+        prefixes.push_back(key.prefix);
+    }
+    const KeyedLess less(prefixes, keys, order);
     std::vector<std::uint32_t> perm(m_items.size());
     std::iota(perm.begin(), perm.end(), 0);
     std::sort(perm.begin(),
               perm.end(),
-              [&probes, &keys, order](const std::uint32_t lhs, const std::uint32_t rhs) {
+              [&probes, &less](const std::uint32_t lhs, const std::uint32_t rhs) {
                   if (probes.enabled) {
                       ++probes.keyed_compares;
                   }
-                  if (order == Qt::AscendingOrder) {
-                      return keys[lhs] < keys[rhs];
-                  } else {
-                      return keys[rhs] < keys[lhs];
-                  }
+                  return less(lhs, rhs);
               });
 
-    // Apply the permutation in place, walking each cycle once and marking
-    // spent entries as self-loops (S3 review round 1): materializing
-    // sorted copies would transiently duplicate the key vector — ~144 B
-    // per item, ~144 MB extra at a one-million-item By-Item sort, right
-    // where the resident-key budget is tightest — and the gauge does not
-    // (and should not) count temporaries. The permutation itself is the
-    // only transient (4 B per item).
-    for (std::uint32_t start = 0; start < static_cast<std::uint32_t>(perm.size()); ++start) {
-        if (perm[start] == start) {
-            continue;
+    ApplyPermutation(perm, m_items, m_keys.keys);
+    m_sorted = true;
+}
+
+Bucket::SortPlan Bucket::MakeSortPlan(const Column &column, Qt::SortOrder order) const
+{
+    SortPlan plan;
+    plan.column = &column;
+    plan.order = order;
+    plan.serial = m_serial;
+    plan.items = m_items;
+    if (column.buyoutDependent()) {
+        // Price/Date keys read BuyoutManager, which the UI thread mutates;
+        // their key build is a lookup per item, so it stays here and only
+        // the ordering moves to the workers.
+        plan.keys.reserve(plan.items.size());
+        for (const auto &item : plan.items) {
+            plan.keys.push_back(column.key(*item));
         }
-        std::shared_ptr<Item> lifted_item = std::move(m_items[start]);
-        ItemSortKey lifted_key = std::move(m_keys.keys[start]);
-        std::uint32_t n = start;
-        while (true) {
-            const std::uint32_t from = perm[n];
-            perm[n] = n;
-            if (from == start) {
-                m_items[n] = std::move(lifted_item);
-                m_keys.keys[n] = std::move(lifted_key);
-                break;
+    }
+    return plan;
+}
+
+bool Bucket::PlanSort(SortPlan &plan, int threads, const std::atomic_bool &cancelled)
+{
+    const size_t rows = plan.items.size();
+    const int workers = std::clamp(static_cast<int>(rows / kMinRowsPerWorker),
+                                   1,
+                                   std::max(1, threads));
+    const Column &column = *plan.column;
+    const bool build_keys = (plan.keys.size() != rows);
+    if (build_keys) {
+        plan.keys.resize(rows);
+    }
+
+    // 1. Keys (unless prebuilt), their dense prefixes, and their gauge
+    //    bytes, one contiguous chunk per worker.
+    std::vector<ItemSortKey::Prefix> prefixes(rows);
+    std::vector<std::int64_t> chunk_bytes(static_cast<size_t>(workers), 0);
+    RunTasks(workers, [&](int worker) {
+        const size_t end = ChunkStart(rows, workers, worker + 1);
+        std::int64_t bytes = 0;
+        for (size_t row = ChunkStart(rows, workers, worker); row < end; ++row) {
+            if (((row % kCancelStride) == 0) && cancelled.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (build_keys) {
+                plan.keys[row] = column.key(*plan.items[row]);
             }
-            m_items[n] = std::move(m_items[from]);
-            m_keys.keys[n] = std::move(m_keys.keys[from]);
-            n = from;
+            prefixes[row] = plan.keys[row].prefix;
+            bytes += keyBytes(plan.keys[row]);
+        }
+        chunk_bytes[static_cast<size_t>(worker)] = bytes;
+    });
+    if (cancelled.load()) {
+        return false;
+    }
+    plan.key_bytes = std::accumulate(chunk_bytes.begin(), chunk_bytes.end(), std::int64_t{0});
+
+    // 2. Each worker sorts its own run of the permutation, counting its
+    //    comparisons locally (the probes are not thread-safe).
+    const KeyedLess less(prefixes, plan.keys, plan.order);
+    std::vector<std::uint32_t> &perm = plan.perm;
+    perm.resize(rows);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::vector<size_t> bounds;
+    for (int worker = 0; worker <= workers; ++worker) {
+        bounds.push_back(ChunkStart(rows, workers, worker));
+    }
+    std::vector<std::int64_t> compares(static_cast<size_t>(workers), 0);
+    RunTasks(workers, [&](int worker) {
+        std::int64_t count = 0;
+        const auto w = static_cast<size_t>(worker);
+        std::sort(perm.begin() + static_cast<std::ptrdiff_t>(bounds[w]),
+                  perm.begin() + static_cast<std::ptrdiff_t>(bounds[w + 1]),
+                  [&](const std::uint32_t lhs, const std::uint32_t rhs) {
+                      ++count;
+                      return less(lhs, rhs);
+                  });
+        compares[static_cast<size_t>(worker)] = count;
+    });
+
+    // 3. Pairwise merge rounds, one task per pair, halving the run count
+    //    until one run remains; an unpaired last run is carried over.
+    std::vector<std::uint32_t> merged(rows);
+    while (bounds.size() > 2) {
+        if (cancelled.load()) {
+            return false;
+        }
+        const int runs = static_cast<int>(bounds.size()) - 1;
+        const int tasks = (runs + 1) / 2;
+        std::vector<std::int64_t> round_compares(static_cast<size_t>(tasks), 0);
+        RunTasks(tasks, [&](int task) {
+            const size_t first = bounds[static_cast<size_t>(2 * task)];
+            const size_t middle = bounds[static_cast<size_t>(std::min(2 * task + 1, runs))];
+            const size_t last = bounds[static_cast<size_t>(std::min(2 * task + 2, runs))];
+            std::int64_t count = 0;
+            std::merge(perm.begin() + static_cast<std::ptrdiff_t>(first),
+                       perm.begin() + static_cast<std::ptrdiff_t>(middle),
+                       perm.begin() + static_cast<std::ptrdiff_t>(middle),
+                       perm.begin() + static_cast<std::ptrdiff_t>(last),
+                       merged.begin() + static_cast<std::ptrdiff_t>(first),
+                       [&](const std::uint32_t lhs, const std::uint32_t rhs) {
+                           ++count;
+                           return less(lhs, rhs);
+                       });
+            round_compares[static_cast<size_t>(task)] = count;
+        });
+        perm.swap(merged);
+        compares.insert(compares.end(), round_compares.begin(), round_compares.end());
+        std::vector<size_t> next;
+        for (size_t n = 0; n < bounds.size(); n += 2) {
+            next.push_back(bounds[n]);
+        }
+        if (next.back() != rows) {
+            next.push_back(rows);
+        }
+        bounds.swap(next);
+    }
+    plan.keyed_compares = std::accumulate(compares.begin(), compares.end(), std::int64_t{0});
+
+    // 4. Reorder the snapshot and its keys; perm survives for adoption's
+    //    snapshot check, so the cycle walk consumes a copy.
+    std::vector<std::uint32_t> walk = perm;
+    ApplyPermutation(walk, plan.items, plan.keys);
+    return !cancelled.load();
+}
+
+bool Bucket::CanAdoptSortPlan(const SortPlan &plan) const
+{
+    if (m_replace_window || (plan.serial != m_serial) || (plan.items.size() != m_items.size())
+        || (plan.perm.size() != m_items.size())) {
+        return false;
+    }
+    for (size_t row = 0; row < plan.items.size(); ++row) {
+        if (m_items[plan.perm[row]] != plan.items[row]) {
+            return false;
         }
     }
+    return true;
+}
+
+void Bucket::AdoptSortPlan(SortPlan &&plan)
+{
+    auto &probes = ModelProbes::instance();
+    if (probes.enabled) {
+        const LocationInventory::Key key = LocationInventory::KeyFor(m_location);
+        ++probes.bucket_sorts;
+        ++probes.bucket_sorts_by_location[key];
+        ++probes.key_builds;
+        ++probes.key_builds_by_location[key];
+        probes.keyed_compares += plan.keyed_compares;
+    }
+    m_keys.Release();
+    m_items = std::move(plan.items);
+    m_keys.keys = std::move(plan.keys);
+    m_keys.column = plan.column;
+    m_keys.bytes = plan.key_bytes;
+    probes.live_key_bytes += plan.key_bytes;
     m_sorted = true;
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <set>
@@ -143,6 +144,40 @@ public:
     // (column, order).
     void Sort(const Column &column, Qt::SortOrder order);
 
+    // The off-thread form of Sort, for the By-Item flat bucket's column
+    // switch (ItemsModel's background sort). MakeSortPlan snapshots the
+    // items on the UI thread — and builds the keys there too for
+    // buyout-dependent columns, whose keys read BuyoutManager; PlanSort
+    // fills the rest on any thread; AdoptSortPlan installs the result.
+    struct SortPlan
+    {
+        const Column *column{nullptr};
+        Qt::SortOrder order{Qt::AscendingOrder};
+        std::uint64_t serial{0};
+        // The snapshot, then (after PlanSort) the sorted order, with its
+        // keys aligned and perm[i] the snapshot row of sorted row i.
+        Items items;
+        std::vector<ItemSortKey> keys;
+        std::vector<std::uint32_t> perm;
+        std::int64_t key_bytes{0};
+        // Counted on the workers, credited to the probes on adoption.
+        std::int64_t keyed_compares{0};
+    };
+    SortPlan MakeSortPlan(const Column &column, Qt::SortOrder order) const;
+
+    // Parallel key materialization over `threads` workers, a per-worker
+    // sort of contiguous runs, then pairwise merge rounds. Touches no
+    // bucket and no probe. Returns false, leaving the plan unusable, when
+    // `cancelled` is raised before it finishes.
+    static bool PlanSort(SortPlan &plan, int threads, const std::atomic_bool &cancelled);
+
+    // True iff the bucket still holds exactly the plan's snapshot, in the
+    // snapshot's order — any delta, merge, or sort since invalidates it.
+    bool CanAdoptSortPlan(const SortPlan &plan) const;
+    // Installs a finished, adoptable plan: the sorted order, its keys as
+    // the resident vector, and the sorted flag.
+    void AdoptSortPlan(SortPlan &&plan);
+
     // D2's per-bucket sorted-validity flag. Sorted-order validity and key
     // residency are independent axes (R3-1): sorted-but-keyless is a
     // legitimate state, entered by expanding with a valid flag or by
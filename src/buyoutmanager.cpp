@@ -47,6 +47,9 @@ BuyoutManager::~BuyoutManager()
 
 void BuyoutManager::BeginBatch()
 {
+    // The repo nests the same way, so only the outermost batch opens (and
+    // later commits) its transaction.
+    m_repo.beginBatch();
     ++m_batch_depth;
 }
 
@@ -57,6 +60,7 @@ void BuyoutManager::EndBatch()
         m_batch_depth = 0;
         return;
     }
+    m_repo.endBatch();
     // Only the outermost boundary emits (R3-3): an inner pass or command
     // boundary leaves its accumulated scope for the enclosing batch.
     if (--m_batch_depth == 0) {
@@ -75,6 +79,7 @@ void BuyoutManager::RecordChange(ChangeScope scope, const QString &id)
         break;
     case ChangeScope::Everything:
         m_pending_changes.everything = true;
+        m_reprice.everything = true;
         break;
     }
     // A mutation with no batch open is its own outer boundary: immediacy
@@ -115,6 +120,7 @@ void BuyoutManager::Set(const Item &item, const Buyout &buyout)
         // instead of leaving the row to resurrect at the next Load().
         if (m_buyouts.contains(item.id()) && m_repo.removeItemBuyout(item)) {
             m_buyouts.erase(item.id());
+            m_reprice.location_ids.insert(item.location().id());
             RecordChange(ChangeScope::Item, item.id());
         }
         return;
@@ -125,11 +131,13 @@ void BuyoutManager::Set(const Item &item, const Buyout &buyout)
         // The item hash is not present.
         m_buyouts[item.id()] = buyout;
         emit SetItemBuyout(buyout, item);
+        m_reprice.location_ids.insert(item.location().id());
         RecordChange(ChangeScope::Item, item.id());
     } else if (buyout != it->second) {
         // The item hash is present and the buyout has changed.
         it->second = buyout;
         emit SetItemBuyout(buyout, item);
+        m_reprice.location_ids.insert(item.location().id());
         RecordChange(ChangeScope::Item, item.id());
     }
 }
@@ -179,6 +187,7 @@ void BuyoutManager::SetTab(const ItemLocation &location, const Buyout &buyout)
         // Same no-op-delete guard and erase-after-success ordering as Set() (F52).
         if (m_tab_buyouts.contains(location.id()) && m_repo.removeLocationBuyout(location)) {
             m_tab_buyouts.erase(location.id());
+            m_reprice.location_ids.insert(location.id());
             RecordChange(ChangeScope::Tab, location.id());
         }
         return;
@@ -188,10 +197,12 @@ void BuyoutManager::SetTab(const ItemLocation &location, const Buyout &buyout)
     if (it == m_tab_buyouts.end()) {
         m_tab_buyouts[location.id()] = buyout;
         emit SetLocationBuyout(buyout, location);
+        m_reprice.location_ids.insert(location.id());
         RecordChange(ChangeScope::Tab, location.id());
     } else if (buyout != it->second) {
         it->second = buyout;
         emit SetLocationBuyout(buyout, location);
+        m_reprice.location_ids.insert(location.id());
         RecordChange(ChangeScope::Tab, location.id());
     }
 }
@@ -215,6 +226,7 @@ void BuyoutManager::CompressTabBuyouts()
             m_save_needed = true;
             const QString id = it->first;
             it = m_tab_buyouts.erase(it);
+            m_reprice.location_ids.insert(id);
             RecordChange(ChangeScope::Tab, id);
         } else {
             ++it;
@@ -274,6 +286,11 @@ void BuyoutManager::ClearRefreshLocks()
     m_refresh_locked.clear();
 }
 
+void BuyoutManager::ClearRefreshLock(const QString &location_id)
+{
+    m_refresh_locked.erase(location_id);
+}
+
 void BuyoutManager::Clear()
 {
     m_save_needed = true;
@@ -465,5 +482,7 @@ void BuyoutManager::MigrateItem(const QString &old_hash, const QString &new_hash
         const BuyoutBatch batch(*this);
         RecordChange(ChangeScope::Item, old_hash);
         RecordChange(ChangeScope::Item, new_hash);
+        // Only hashes are known here, not the items' locations.
+        m_reprice.everything = true;
     }
 }
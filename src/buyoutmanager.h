@@ -11,6 +11,7 @@
 
 #include <set>
 #include <unordered_map>
+#include <utility>
 
 #include "buyout.h"
 
@@ -34,6 +35,22 @@ struct BuyoutChangeSet
     bool IsEmpty() const { return !everything && item_ids.empty() && tab_ids.empty(); }
 };
 
+// The locations ItemsManager's pricing passes must revisit: stable location
+// ids whose tab buyout, or an item buyout inside them, changed since the
+// scope was last taken. `everything` stands for a wholesale change (reload,
+// clear, migration) that no list of locations describes.
+struct RepriceScope
+{
+    std::set<QString> location_ids;
+    bool everything{false};
+
+    void Merge(const RepriceScope &other)
+    {
+        location_ids.insert(other.location_ids.begin(), other.location_ids.end());
+        everything = everything || other.everything;
+    }
+};
+
 class BuyoutManager : public QObject
 {
     Q_OBJECT
@@ -45,6 +62,8 @@ public:
     // outermost EndBatch emits BuyoutsChanged — a pass or command boundary
     // reached inside an enclosing batch emits nothing of its own (R3-3).
     // A mutation outside any batch emits immediately as its own batch.
+    // The repo's writes follow the same boundaries: one transaction per
+    // outermost batch, committed before BuyoutsChanged is emitted.
     // Prefer the scoped BuyoutBatch guard to calling these directly.
     void BeginBatch();
     void EndBatch();
@@ -64,6 +83,11 @@ public:
     bool GetRefreshLocked(const ItemLocation &tab) const;
     void SetRefreshLocked(const ItemLocation &tab);
     void ClearRefreshLocks();
+    void ClearRefreshLock(const QString &location_id);
+
+    // Every mutation of the lookup state also widens the reprice scope (see
+    // RepriceScope); ItemsManager takes it when a pricing pass starts.
+    RepriceScope TakeRepriceScope() { return std::exchange(m_reprice, {}); }
 
     void SetStashTabLocations(const std::vector<ItemLocation> &tabs);
     const std::vector<ItemLocation> &GetStashTabLocations() const;
@@ -121,6 +145,7 @@ private:
 
     int m_batch_depth{0};
     BuyoutChangeSet m_pending_changes;
+    RepriceScope m_reprice;
 
     static const std::unordered_map<QString, BuyoutType> m_string_to_buyout_type;
 };
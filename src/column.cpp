@@ -3,11 +3,12 @@
 
 #include "column.h"
 
+#include <algorithm>
 #include <cmath>
 #include <QApplication>
 #include <QIcon>
 #include <QPalette>
-#include <QRegularExpression>
+#include <QStringView>
 #include <QVector>
 
 #include "buyoutmanager.h"
@@ -17,40 +18,87 @@
 #include "util/util.h"
 
 const double EPS = 1e-6;
-const char *SORT_DOUBLE_MATCH = "^\\+?([\\d.]+)%?$";
-const char *SORT_TWO_VALUES = "^(\\d+)([-/])(\\d+)$";
+
+namespace {
+
+    bool isAsciiDigit(QChar c)
+    {
+        return (c >= u'0') && (c <= u'9');
+    }
+
+    bool allAsciiDigits(QStringView s)
+    {
+        return !s.isEmpty() && std::all_of(s.begin(), s.end(), isAsciiDigit);
+    }
+
+} // namespace
+
+SortValue SortValue::Parse(const QString &str)
+{
+    // This used to be two regular expressions, ^\+?([\d.]+)%?$ and
+    // ^(\d+)([-/])(\d+)$, and matches exactly what they did: ASCII digits
+    // only, and one trailing newline allowed where $ allowed it.
+    QStringView s(str);
+    if (s.endsWith(u'\n')) {
+        s.chop(1);
+    }
+
+    QStringView number = s;
+    if (number.startsWith(u'+')) {
+        number = number.sliced(1);
+    }
+    if (number.endsWith(u'%')) {
+        number.chop(1);
+    }
+    if (!number.isEmpty() && std::all_of(number.begin(), number.end(), [](QChar c) {
+            return isAsciiDigit(c) || (c == u'.');
+        })) {
+        return Number(number.toDouble());
+    }
+
+    qsizetype split = 0;
+    while ((split < s.size()) && isAsciiDigit(s[split])) {
+        ++split;
+    }
+    if ((split > 0) && (split < s.size()) && ((s[split] == u'-') || (s[split] == u'/'))
+        && allAsciiDigits(s.sliced(split + 1))) {
+        const double first = s.first(split).toDouble();
+        if (s[split] == u'/') {
+            return Pair(first);
+        }
+        return Number(0.5 * (first + s.sliced(split + 1).toDouble()));
+    }
+
+    return Text(str);
+}
 
 QColor Column::color(const Item & /* item */) const
 {
     return QApplication::palette().color(QPalette::WindowText);
 }
 
-Column::MultivalueParts Column::parts(const Item *item, const QString &pretty) const
+SortValue Column::sortValue(const Item &item) const
 {
-    // Transform values into something optimal for sorting
-    // Possibilities: 12, 12.12, 10%, 10.13%, +16%, 12-14, 10/20
-    static const QRegularExpression sort_double_match(SORT_DOUBLE_MATCH);
-    static const QRegularExpression sort_two_values(SORT_TWO_VALUES);
+    return SortValue::Parse(value(item).toString());
+}
 
+Column::MultivalueParts Column::parts(const Item *item, const QString &pretty) const
+{
     MultivalueParts result;
-
-    QString str = value(*item).toString();
-    QRegularExpressionMatch match;
-
-    if (str.contains(sort_double_match, &match)) {
-        result.d1 = match.captured(1).toDouble();
-    } else if (str.contains(sort_two_values, &match)) {
-        if (match.captured(2).startsWith("-")) {
-            result.d1 = 0.5 * (match.captured(1).toDouble() + match.captured(3).toDouble());
-        } else {
-            result.s1 = pretty;
-            result.d2 = match.captured(1).toDouble();
-        }
-    } else {
-        result.s1 = str;
+    SortValue v = sortValue(*item);
+    switch (v.kind) {
+    case SortValue::Kind::Number:
+        result.d1 = v.number;
+        break;
+    case SortValue::Kind::Pair:
+        result.s1 = pretty;
+        result.d2 = v.number;
+        break;
+    case SortValue::Kind::Text:
+        result.s1 = std::move(v.text);
         result.s2 = pretty;
+        break;
     }
-
     return result;
 }
 
@@ -305,6 +353,16 @@ QVariant PropertyColumn::value(const Item &item) const
     return QVariant();
 }
 
+SortValue PropertyColumn::sortValue(const Item &item) const
+{
+    const auto &properties = item.properties();
+    const auto result = properties.find(m_property);
+    if (result != properties.end()) {
+        return SortValue::Parse(result->second);
+    }
+    return SortValue::Text({});
+}
+
 QString DPSColumn::name() const
 {
     return "DPS";
@@ -319,6 +377,15 @@ QVariant DPSColumn::value(const Item &item) const
     return dps;
 }
 
+SortValue DPSColumn::sortValue(const Item &item) const
+{
+    const double dps = item.DPS();
+    if (fabs(dps) < EPS) {
+        return SortValue::Text({});
+    }
+    return SortValue::Number(dps);
+}
+
 QString pDPSColumn::name() const
 {
     return "pDPS";
@@ -333,6 +400,15 @@ QVariant pDPSColumn::value(const Item &item) const
     return pdps;
 }
 
+SortValue pDPSColumn::sortValue(const Item &item) const
+{
+    const double pdps = item.pDPS();
+    if (fabs(pdps) < EPS) {
+        return SortValue::Text({});
+    }
+    return SortValue::Number(pdps);
+}
+
 QString eDPSColumn::name() const
 {
     return "eDPS";
@@ -347,6 +423,15 @@ QVariant eDPSColumn::value(const Item &item) const
     return edps;
 }
 
+SortValue eDPSColumn::sortValue(const Item &item) const
+{
+    const double edps = item.eDPS();
+    if (fabs(edps) < EPS) {
+        return SortValue::Text({});
+    }
+    return SortValue::Number(edps);
+}
+
 ElementalDamageColumn::ElementalDamageColumn(int index)
     : m_index(index)
 {}
@@ -368,6 +453,14 @@ QVariant ElementalDamageColumn::value(const Item &item) const
     return QVariant();
 }
 
+SortValue ElementalDamageColumn::sortValue(const Item &item) const
+{
+    if (item.elemental_damage().size() > m_index) {
+        return SortValue::Parse(item.elemental_damage().at(m_index).first);
+    }
+    return SortValue::Text({});
+}
+
 QColor ElementalDamageColumn::color(const Item &item) const
 {
     if (item.elemental_damage().size() > m_index) {
@@ -399,6 +492,16 @@ QVariant ChaosDamageColumn::value(const Item &item) const
     return QVariant();
 }
 
+SortValue ChaosDamageColumn::sortValue(const Item &item) const
+{
+    const auto &properties = item.properties();
+    const auto result = properties.find(QStringLiteral("Chaos Damage"));
+    if (result != properties.end()) {
+        return SortValue::Parse(result->second);
+    }
+    return SortValue::Text({});
+}
+
 QColor ChaosDamageColumn::color(const Item &item) const
 {
     Q_UNUSED(item);
@@ -419,6 +522,15 @@ QVariant cDPSColumn::value(const Item &item) const
     return cdps;
 }
 
+SortValue cDPSColumn::sortValue(const Item &item) const
+{
+    const double cdps = item.cDPS();
+    if (fabs(cdps) < EPS) {
+        return SortValue::Text({});
+    }
+    return SortValue::Number(cdps);
+}
+
 PriceColumn::PriceColumn(const BuyoutManager &bo_manager)
     : m_bo_manager(bo_manager)
 {}
@@ -515,3 +627,11 @@ QVariant ItemlevelColumn::value(const Item &item) const
     }
     return QVariant();
 }
+
+SortValue ItemlevelColumn::sortValue(const Item &item) const
+{
+    if (item.ilvl() > 0) {
+        return SortValue::Number(item.ilvl());
+    }
+    return SortValue::Text({});
+}
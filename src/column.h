@@ -12,6 +12,26 @@
 
 class BuyoutManager;
 
+// A column value as the base-family sort key reads it: a number (a range
+// such as 12-14 reads as its midpoint), a pair written a/b, which sorts by
+// item name and then a, or free text.
+struct SortValue
+{
+    enum class Kind { Number, Pair, Text };
+
+    Kind kind = Kind::Text;
+    double number = 0.0;
+    QString text;
+
+    static SortValue Number(double value) { return {Kind::Number, value, {}}; }
+    static SortValue Pair(double first) { return {Kind::Pair, first, {}}; }
+    static SortValue Text(QString value) { return {Kind::Text, 0.0, std::move(value)}; }
+
+    // Recovers the number a formatted value started with: 12, 12.12, 10%,
+    // +16%, 12-14, 10/20. Anything else is text.
+    static SortValue Parse(const QString &str);
+};
+
 class Column
 {
 public:
@@ -47,6 +67,11 @@ protected:
     // of the Item's own members.
     static ItemSortKey::Suffix suffix(const Item &item, const QString &pretty);
 
+    // What parts() builds the base-family key from. The default parses the
+    // string of value(); columns whose value is a number, or a string the
+    // item already holds, override it to skip the QVariant round trip.
+    virtual SortValue sortValue(const Item &item) const;
+
 private:
     typedef std::tuple<double, QString, double, QString, const Item &> sort_tuple;
     struct MultivalueParts
@@ -131,6 +156,9 @@ public:
         return QVariant::fromValue(NULL);
     }
 
+protected:
+    SortValue sortValue(const Item &item) const;
+
 private:
     QString m_name;
     QString m_property;
@@ -146,6 +174,9 @@ public:
         Q_UNUSED(item);
         return QVariant::fromValue(NULL);
     }
+
+protected:
+    SortValue sortValue(const Item &item) const;
 };
 
 class pDPSColumn : public Column
@@ -158,6 +189,9 @@ public:
         Q_UNUSED(item);
         return QVariant::fromValue(NULL);
     }
+
+protected:
+    SortValue sortValue(const Item &item) const;
 };
 
 class eDPSColumn : public Column
@@ -170,6 +204,9 @@ public:
         Q_UNUSED(item);
         return QVariant::fromValue(NULL);
     }
+
+protected:
+    SortValue sortValue(const Item &item) const;
 };
 
 class ElementalDamageColumn : public Column
@@ -185,6 +222,9 @@ public:
         return QVariant::fromValue(NULL);
     }
 
+protected:
+    SortValue sortValue(const Item &item) const;
+
 private:
     size_t m_index;
 };
@@ -200,6 +240,9 @@ public:
         Q_UNUSED(item);
         return QVariant::fromValue(NULL);
     }
+
+protected:
+    SortValue sortValue(const Item &item) const;
 };
 
 class cDPSColumn : public Column
@@ -212,6 +255,9 @@ public:
         Q_UNUSED(item);
         return QVariant::fromValue(NULL);
     }
+
+protected:
+    SortValue sortValue(const Item &item) const;
 };
 
 class PriceColumn : public Column
@@ -270,4 +316,7 @@ public:
         Q_UNUSED(item);
         return QVariant::fromValue(NULL);
     }
+
+protected:
+    SortValue sortValue(const Item &item) const;
 };
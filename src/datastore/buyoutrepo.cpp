@@ -7,6 +7,8 @@
 #include <QSqlError>
 #include <QSqlQuery>
 
+#include <algorithm>
+
 #include "currency.h"
 #include "datastore/datastore_utils.h"
 #include "item.h"
@@ -72,6 +74,25 @@ ON CONFLICT(location_id) DO UPDATE SET
     value           = excluded.value
 )"};
 
+// UPSERT_ITEM_BUYOUT for many rows at once: the VALUES tuples go between
+// the two halves, nine positional parameters each.
+constexpr const char *UPSERT_ITEM_BUYOUT_ROWS_HEAD{R"(
+INSERT INTO item_buyouts (
+    item_id, location_id, location_type, currency, inherited, last_update, source, type, value
+) VALUES )"};
+
+constexpr const char *UPSERT_ITEM_BUYOUT_ROWS_TAIL{R"(
+ON CONFLICT(item_id) DO UPDATE SET
+    location_id     = excluded.location_id,
+    location_type   = excluded.location_type,
+    currency        = excluded.currency,
+    inherited       = excluded.inherited,
+    last_update     = excluded.last_update,
+    source          = excluded.source,
+    type            = excluded.type,
+    value           = excluded.value
+)"};
+
 constexpr const char *IMPORT_ITEM_BUYOUT{R"(
 INSERT INTO item_buyouts (
     item_id, location_id, location_type, currency, inherited, last_update, source, type, value
@@ -161,11 +182,139 @@ namespace {
         query.bindValue(":value", buyout.value);
     }
 
+    // Rows per multi-row upsert. At nine parameters a row this stays under
+    // SQLITE_MAX_VARIABLE_NUMBER even on builds older than 3.32 (999).
+    constexpr size_t kUpsertRows = 100;
+
+    QString upsertItemRowsSql(qsizetype rows)
+    {
+        QString sql(UPSERT_ITEM_BUYOUT_ROWS_HEAD);
+        for (qsizetype n = 0; n < rows; ++n) {
+            sql += (n == 0) ? "(?,?,?,?,?,?,?,?,?)" : ",(?,?,?,?,?,?,?,?,?)";
+        }
+        sql += UPSERT_ITEM_BUYOUT_ROWS_TAIL;
+        return sql;
+    }
+
+    void bindItemRow(QSqlQuery &query, int first, const ItemBuyoutWrite &row)
+    {
+        query.bindValue(first + 0, row.item_id);
+        query.bindValue(first + 1, row.location_id);
+        query.bindValue(first + 2, locationTypeTag(row.location_type));
+        query.bindValue(first + 3, row.buyout.CurrencyAsTag());
+        query.bindValue(first + 4, row.buyout.inherited);
+        query.bindValue(first + 5, row.buyout.last_update);
+        query.bindValue(first + 6, row.buyout.BuyoutSourceAsTag());
+        query.bindValue(first + 7, row.buyout.BuyoutTypeAsTag());
+        query.bindValue(first + 8, row.buyout.value);
+    }
+
 } // namespace
 
 BuyoutRepo::BuyoutRepo(QSqlDatabase &db)
     : m_db(db) {};
 
+void BuyoutRepo::beginBatch()
+{
+    if (m_batch_depth++ > 0) {
+        return;
+    }
+    // Without a transaction the batch still queues and upserts many rows per
+    // statement; it just commits each statement on its own.
+    m_in_transaction = m_db.transaction();
+    if (!m_in_transaction) {
+        spdlog::warn("BuyoutRepo: could not begin a batch transaction: {}",
+                     m_db.lastError().text());
+    }
+}
+
+bool BuyoutRepo::endBatch()
+{
+    if (m_batch_depth <= 0) {
+        spdlog::error("BuyoutRepo: endBatch() without a matching beginBatch()");
+        m_batch_depth = 0;
+        return false;
+    }
+    if (--m_batch_depth > 0) {
+        return true;
+    }
+
+    bool ok = flushPendingItems();
+    if (m_in_transaction) {
+        m_in_transaction = false;
+        if (!m_db.commit()) {
+            spdlog::error("BuyoutRepo: could not commit a batch: {}", m_db.lastError().text());
+            if (!m_db.rollback()) {
+                spdlog::error("BuyoutRepo: rollback also failed: {}", m_db.lastError().text());
+            }
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+QSqlQuery *BuyoutRepo::prepared(std::optional<QSqlQuery> &query, const QString &sql)
+{
+    if (!query) {
+        query.emplace(m_db);
+        if (!query->prepare(sql)) {
+            spdlog::error("BuyoutRepo: prepare() failed: {}", query->lastError().text());
+            query.reset();
+            return nullptr;
+        }
+    }
+    return &*query;
+}
+
+bool BuyoutRepo::flushPendingItems()
+{
+    if (m_pending_items.empty()) {
+        return true;
+    }
+    std::vector<ItemBuyoutWrite> rows;
+    rows.reserve(m_pending_items.size());
+    for (auto &[item_id, write] : m_pending_items) {
+        rows.push_back(std::move(write));
+    }
+    m_pending_items.clear();
+
+    bool ok = true;
+    for (size_t first = 0; first < rows.size(); first += kUpsertRows) {
+        const size_t count = std::min(kUpsertRows, rows.size() - first);
+        ok = upsertItemRows(&rows[first], qsizetype(count)) && ok;
+    }
+    return ok;
+}
+
+bool BuyoutRepo::upsertItemRows(const ItemBuyoutWrite *rows, qsizetype count)
+{
+    // Full statements reuse one cached query; only the remainder that ends
+    // a batch is prepared on the spot.
+    std::optional<QSqlQuery> remainder;
+    QSqlQuery *q = prepared((count == qsizetype(kUpsertRows)) ? m_upsert_item_rows : remainder,
+                            upsertItemRowsSql(count));
+    if (q) {
+        for (qsizetype n = 0; n < count; ++n) {
+            bindItemRow(*q, int(n * 9), rows[n]);
+        }
+        if (q->exec()) {
+            return true;
+        }
+        ds::logQueryError("BuyoutRepo::upsertItemRows()", *q);
+    }
+
+    // One bad row fails its whole statement; retry the rows one at a time
+    // so it costs only itself.
+    bool ok = true;
+    for (qsizetype n = 0; n < count; ++n) {
+        const ItemBuyoutWrite &row = rows[n];
+        ok = (saveItemBuyout(row.buyout, row.item_id, row.location_id, row.location_type, true)
+              != BuyoutSaveResult::Error)
+             && ok;
+    }
+    return ok;
+}
+
 bool BuyoutRepo::resetRepo()
 {
     // Deliberately does NOT drop its tables, unlike StashRepo and
@@ -202,6 +351,7 @@ bool BuyoutRepo::ensureSchema()
 std::unordered_map<QString, Buyout> BuyoutRepo::getItemBuyouts()
 {
     spdlog::debug("BuyoutRepo: getting item buyouts");
+    flushPendingItems();
 
     QSqlQuery q(m_db);
     if (!q.prepare("SELECT"
@@ -269,14 +419,36 @@ std::unordered_map<QString, Buyout> BuyoutRepo::getLocationBuyouts()
 
 bool BuyoutRepo::saveItemBuyout(const Buyout &buyout, const Item &item)
 {
-    spdlog::debug("BuyoutRepo: saving item buyout: PrettyName='{}' ({}), buyout='{}'",
-                  item.PrettyName(),
-                  item.id(),
-                  buyout.AsText());
+    // A pricing pass comes through here once per item; only format the
+    // message when it will be written.
+    if (spdlog::should_log(spdlog::level::trace)) {
+        spdlog::trace("BuyoutRepo: saving item buyout: PrettyName='{}' ({}), buyout='{}'",
+                      item.PrettyName(),
+                      item.id(),
+                      buyout.AsText());
+    }
 
     const ItemLocation &location = item.location();
-    return saveItemBuyout(buyout, item.id(), location.id(), location.type(), true)
-           == BuyoutSaveResult::Saved;
+    if (m_batch_depth == 0) {
+        return saveItemBuyout(buyout, item.id(), location.id(), location.type(), true)
+               == BuyoutSaveResult::Saved;
+    }
+
+    if (locationTypeTag(location.type()).isEmpty()) {
+        spdlog::error("BuyoutRepo::saveItemBuyout: invalid item location type: {}",
+                      location.type());
+        return false;
+    }
+    m_pending_items.insert_or_assign(item.id(),
+                                     ItemBuyoutWrite{buyout,
+                                                     item.id(),
+                                                     location.id(),
+                                                     location.type(),
+                                                     true});
+    if (m_pending_items.size() >= kUpsertRows) {
+        return flushPendingItems();
+    }
+    return true;
 }
 
 BuyoutSaveResult BuyoutRepo::saveItemBuyout(const Buyout &buyout,
@@ -291,27 +463,25 @@ BuyoutSaveResult BuyoutRepo::saveItemBuyout(const Buyout &buyout,
         return BuyoutSaveResult::Error;
     }
 
-    QSqlQuery q(m_db);
-    if (!q.prepare(overwrite_existing ? UPSERT_ITEM_BUYOUT : INSERT_ITEM_BUYOUT)) {
-        spdlog::error("BuyoutRepo: prepare() failed: {}", q.lastError().text());
+    // An insert-if-absent must see a row still queued in this batch.
+    flushPendingItems();
+
+    QSqlQuery *q = overwrite_existing ? prepared(m_upsert_item, UPSERT_ITEM_BUYOUT)
+                                      : prepared(m_insert_item, INSERT_ITEM_BUYOUT);
+    if (!q) {
         return BuyoutSaveResult::Error;
     }
 
-    q.bindValue(":item_id", item_id);
-    q.bindValue(":location_id", location_id);
-    q.bindValue(":location_type", location_type_tag);
-    q.bindValue(":currency", buyout.CurrencyAsTag());
-    q.bindValue(":inherited", buyout.inherited);
-    q.bindValue(":last_update", buyout.last_update);
-    q.bindValue(":source", buyout.BuyoutSourceAsTag());
-    q.bindValue(":type", buyout.BuyoutTypeAsTag());
-    q.bindValue(":value", buyout.value);
+    q->bindValue(":item_id", item_id);
+    q->bindValue(":location_id", location_id);
+    q->bindValue(":location_type", location_type_tag);
+    bindBuyout(*q, buyout);
 
-    if (!q.exec()) {
-        ds::logQueryError("BuyoutRepo::saveItemBuyout()", q);
+    if (!q->exec()) {
+        ds::logQueryError("BuyoutRepo::saveItemBuyout()", *q);
         return BuyoutSaveResult::Error;
     }
-    return q.numRowsAffected() == 0 ? BuyoutSaveResult::Existing : BuyoutSaveResult::Saved;
+    return q->numRowsAffected() == 0 ? BuyoutSaveResult::Existing : BuyoutSaveResult::Saved;
 }
 
 bool BuyoutRepo::saveLocationBuyout(const Buyout &buyout, const ItemLocation &location)
@@ -337,32 +507,32 @@ BuyoutSaveResult BuyoutRepo::saveLocationBuyout(const Buyout &buyout,
         return BuyoutSaveResult::Error;
     }
 
-    QSqlQuery q(m_db);
-    if (!q.prepare(overwrite_existing ? UPSERT_LOCATION_BUYOUT : INSERT_LOCATION_BUYOUT)) {
-        spdlog::error("BuyoutRepo: prepare() failed: {}", q.lastError().text());
+    QSqlQuery *q = overwrite_existing ? prepared(m_upsert_location, UPSERT_LOCATION_BUYOUT)
+                                      : prepared(m_insert_location, INSERT_LOCATION_BUYOUT);
+    if (!q) {
         return BuyoutSaveResult::Error;
     }
 
-    q.bindValue(":location_id", location_id);
-    q.bindValue(":location_type", location_type_tag);
-    q.bindValue(":currency", buyout.CurrencyAsTag());
-    q.bindValue(":inherited", buyout.inherited);
-    q.bindValue(":last_update", buyout.last_update);
-    q.bindValue(":source", buyout.BuyoutSourceAsTag());
-    q.bindValue(":type", buyout.BuyoutTypeAsTag());
-    q.bindValue(":value", buyout.value);
+    q->bindValue(":location_id", location_id);
+    q->bindValue(":location_type", location_type_tag);
+    bindBuyout(*q, buyout);
 
-    if (!q.exec()) {
-        ds::logQueryError("BuyoutRepo::saveLocationBuyout()", q);
+    if (!q->exec()) {
+        ds::logQueryError("BuyoutRepo::saveLocationBuyout()", *q);
         return BuyoutSaveResult::Error;
     }
-    return q.numRowsAffected() == 0 ? BuyoutSaveResult::Existing : BuyoutSaveResult::Saved;
+    return q->numRowsAffected() == 0 ? BuyoutSaveResult::Existing : BuyoutSaveResult::Saved;
 }
 
 BuyoutBatchSaveResult BuyoutRepo::saveImportBatch(const std::vector<ItemBuyoutWrite> &items,
                                                   const std::vector<LocationBuyoutWrite> &locations)
 {
     BuyoutBatchSaveResult result;
+    // An import is its own transaction, and SQLite does not nest them.
+    if (m_batch_depth > 0) {
+        result.error = "Cannot import buyouts inside an open buyout batch";
+        return result;
+    }
     if (!m_db.transaction()) {
         result.error = QString("Could not start buyout import transaction: %1")
                            .arg(m_db.lastError().text());
@@ -493,22 +663,26 @@ BuyoutBatchSaveResult BuyoutRepo::saveImportBatch(const std::vector<ItemBuyoutWr
 
 bool BuyoutRepo::removeItemBuyout(const Item &item)
 {
-    spdlog::debug("BuyoutRepo: removing item buyout: PrettyName='{}' ({})",
-                  item.PrettyName(),
-                  item.id());
+    if (spdlog::should_log(spdlog::level::trace)) {
+        spdlog::trace("BuyoutRepo: removing item buyout: PrettyName='{}' ({})",
+                      item.PrettyName(),
+                      item.id());
+    }
 
-    QSqlQuery q(m_db);
-    if (!q.prepare("DELETE FROM item_buyouts WHERE item_id = :item_id")) {
-        spdlog::error("BuyoutRepo: prepare() failed: {}", q.lastError().text());
+    QSqlQuery *q = prepared(m_remove_item, "DELETE FROM item_buyouts WHERE item_id = :item_id");
+    if (!q) {
         return false;
     }
 
-    q.bindValue(":item_id", item.id());
+    q->bindValue(":item_id", item.id());
 
-    if (!q.exec()) {
-        ds::logQueryError("BuyoutRepo::removeItemBuyout()", q);
+    if (!q->exec()) {
+        ds::logQueryError("BuyoutRepo::removeItemBuyout()", *q);
         return false;
     }
+    // Only now: a failed delete leaves the queued write too, matching the
+    // entry BuyoutManager keeps for the retry.
+    m_pending_items.erase(item.id());
     return true;
 }
 
@@ -518,16 +692,16 @@ bool BuyoutRepo::removeLocationBuyout(const ItemLocation &location)
                   location.GetHeader(),
                   location.id());
 
-    QSqlQuery q(m_db);
-    if (!q.prepare("DELETE FROM location_buyouts WHERE location_id = :location_id")) {
-        spdlog::error("BuyoutRepo: prepare() failed: {}", q.lastError().text());
+    QSqlQuery *q = prepared(m_remove_location,
+                            "DELETE FROM location_buyouts WHERE location_id = :location_id");
+    if (!q) {
         return false;
     }
 
-    q.bindValue(":location_id", location.id());
+    q->bindValue(":location_id", location.id());
 
-    if (!q.exec()) {
-        ds::logQueryError("BuyoutRepo::removeLocationBuyout()", q);
+    if (!q->exec()) {
+        ds::logQueryError("BuyoutRepo::removeLocationBuyout()", *q);
         return false;
     }
     return true;
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <QObject>
+#include <QSqlQuery>
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -52,6 +54,15 @@ class BuyoutRepo : public QObject
 public:
     explicit BuyoutRepo(QSqlDatabase &db);
 
+    // Storage side of BuyoutBatch. Batches nest; the outermost one runs in a
+    // single transaction, and while it is open the saveItemBuyout slot only
+    // queues the row: queued rows go out as multi-row upserts, a full
+    // statement at a time, and the rest at the outermost endBatch(), which
+    // then commits. Reads, removals, and the explicit save and import calls
+    // see every row queued before them.
+    void beginBatch();
+    bool endBatch();
+
     std::unordered_map<QString, Buyout> getItemBuyouts();
     std::unordered_map<QString, Buyout> getLocationBuyouts();
 
@@ -78,5 +89,24 @@ public slots:
     bool saveLocationBuyout(const Buyout &buyout, const ItemLocation &location);
 
 private:
+    QSqlQuery *prepared(std::optional<QSqlQuery> &query, const QString &sql);
+    bool flushPendingItems();
+    bool upsertItemRows(const ItemBuyoutWrite *rows, qsizetype count);
+
     QSqlDatabase &m_db;
+
+    int m_batch_depth{0};
+    bool m_in_transaction{false};
+    // Keyed by item id, so a later write in the same batch replaces an
+    // earlier one and a removal can drop it.
+    std::unordered_map<QString, ItemBuyoutWrite> m_pending_items;
+
+    // Prepared on first use: the repo is built before its connection opens.
+    std::optional<QSqlQuery> m_upsert_item;
+    std::optional<QSqlQuery> m_insert_item;
+    std::optional<QSqlQuery> m_upsert_item_rows;
+    std::optional<QSqlQuery> m_upsert_location;
+    std::optional<QSqlQuery> m_insert_location;
+    std::optional<QSqlQuery> m_remove_item;
+    std::optional<QSqlQuery> m_remove_location;
 };
@@ -23,7 +23,9 @@ CREATE TABLE IF NOT EXISTS characters (
     listed_at       TEXT NOT NULL,
     json_fetched_at TEXT,
     json_data       TEXT,
-    json_version    INTEGER
+    json_version    INTEGER,
+    json_digest     TEXT,
+    json_changed_at TEXT
 )
 )"};
 
@@ -48,7 +50,12 @@ SET
     league          = :league,
     json_fetched_at = :json_fetched_at,
     json_data       = :json_data,
-    json_version    = :json_version
+    json_version    = :json_version,
+    json_changed_at = CASE
+        WHEN json_digest IS :json_digest THEN json_changed_at
+        ELSE :json_changed_at
+    END,
+    json_digest     = :json_digest
 WHERE id = :id
 )"};
 
@@ -77,7 +84,9 @@ bool CharacterRepo::ensureSchema()
     return true;
 }
 
-bool CharacterRepo::saveCharacter(const poe::Character &character, const QByteArray &bytes)
+bool CharacterRepo::saveCharacter(const poe::Character &character,
+                                  const QByteArray &bytes,
+                                  const QByteArray &digest)
 {
     spdlog::debug("CharacterRepo: saving character: name='{}', id='{}', realm='{}', league='{}'",
                   character.name,
@@ -100,6 +109,9 @@ bool CharacterRepo::saveCharacter(const poe::Character &character, const QByteAr
     q.bindValue(":json_fetched_at", json_fetched_at);
     q.bindValue(":json_data", bytes);
     q.bindValue(":json_version", json::PAYLOAD_VERSION);
+    // As for stashes, json_changed_at moves only when the digest does.
+    q.bindValue(":json_digest", digest);
+    q.bindValue(":json_changed_at", json_fetched_at);
 
     if (!q.exec()) {
         ds::logQueryError("CharacterRepo::saveCharacter()", q);
@@ -191,6 +203,15 @@ bool CharacterRepo::reconcileCharacterList(const std::vector<poe::Character> &ch
 }
 
 std::optional<poe::Character> CharacterRepo::getCharacter(const QString &name, const QString &realm)
+{
+    const auto json = getCharacterJson(name, realm);
+    if (!json) {
+        return std::nullopt;
+    }
+    return json::readCharacter(*json);
+}
+
+std::optional<QByteArray> CharacterRepo::getCharacterJson(const QString &name, const QString &realm)
 {
     spdlog::debug("CharacterRepo: getting character: name='{}', realm='{}'", name, realm);
 
@@ -198,7 +219,7 @@ std::optional<poe::Character> CharacterRepo::getCharacter(const QString &name, c
 
     if (!q.prepare("SELECT json_data, json_version"
                    " FROM characters WHERE name = :name AND realm = :realm")) {
-        ds::logQueryError("CharacterRepo::getCharacter()", q);
+        ds::logQueryError("CharacterRepo::getCharacterJson()", q);
         return std::nullopt;
     }
 
@@ -206,7 +227,7 @@ std::optional<poe::Character> CharacterRepo::getCharacter(const QString &name, c
     q.bindValue(":realm", realm);
 
     if (!q.exec()) {
-        ds::logQueryError("CharacterRepo::getCharacter()", q);
+        ds::logQueryError("CharacterRepo::getCharacterJson()", q);
         return std::nullopt;
     }
 
@@ -243,8 +264,7 @@ std::optional<poe::Character> CharacterRepo::getCharacter(const QString &name, c
         return std::nullopt;
     }
 
-    const auto json = q.value(0).toByteArray();
-    return json::readCharacter(json);
+    return q.value(0).toByteArray();
 }
 
 std::vector<poe::Character> CharacterRepo::getCharacterList(const QString &realm,
@@ -296,3 +316,37 @@ std::vector<poe::Character> CharacterRepo::getCharacterList(const QString &realm
     spdlog::debug("CharacterRepo: returning {} characters", characters.size());
     return characters;
 }
+
+std::vector<CharacterRepo::FetchHistory> CharacterRepo::getFetchHistory(const QString &realm,
+                                                                        const QString &league)
+{
+    spdlog::debug("CharacterRepo: getting fetch history: realm='{}', league='{}'", realm, league);
+
+    QSqlQuery q(m_db);
+
+    if (!q.prepare("SELECT id, json_digest, json_changed_at, json_fetched_at"
+                   " FROM characters"
+                   " WHERE realm = :realm AND league = :league AND json_digest IS NOT NULL")) {
+        ds::logQueryError("CharacterRepo::getFetchHistory()", q);
+        return {};
+    }
+
+    q.bindValue(":realm", realm);
+    q.bindValue(":league", league);
+
+    if (!q.exec()) {
+        ds::logQueryError("CharacterRepo::getFetchHistory()", q);
+        return {};
+    }
+
+    std::vector<FetchHistory> history;
+    while (q.next()) {
+        history.push_back(FetchHistory{q.value("id").toString(),
+                                       q.value("json_digest").toByteArray(),
+                                       q.value("json_changed_at").toDateTime(),
+                                       q.value("json_fetched_at").toDateTime()});
+    }
+
+    spdlog::debug("CharacterRepo: returning fetch history for {} characters", history.size());
+    return history;
+}
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <QByteArray>
+#include <QDateTime>
 #include <QObject>
+#include <QString>
 
 #include <optional>
 #include <vector>
@@ -12,7 +14,6 @@
 #include "poe/types/character.h"
 
 class QSqlDatabase;
-class QString;
 
 class CharacterRepo : public QObject
 {
@@ -21,17 +22,32 @@ public:
     explicit CharacterRepo(QSqlDatabase &db);
 
     std::optional<poe::Character> getCharacter(const QString &name, const QString &realm);
+    // The version-checked json_data blob getCharacter() parses, unparsed
+    // (see StashRepo::getStashJson).
+    std::optional<QByteArray> getCharacterJson(const QString &name, const QString &realm);
     std::vector<poe::Character> getCharacterList(const QString &realm,
                                                  const std::optional<QString> league = {});
 
+    // Per fetched character, keyed by id (see StashRepo::FetchHistory).
+    struct FetchHistory
+    {
+        QString id;
+        QByteArray digest;
+        QDateTime changed_at;
+        QDateTime fetched_at;
+    };
+    std::vector<FetchHistory> getFetchHistory(const QString &realm, const QString &league);
+
     bool resetRepo();
     bool ensureSchema();
 
 public slots:
     // `bytes` is the exact wire JSON of the reply's character sub-object
     // (F62): stored as-is in json_data, never a re-serialization of
-    // `character` — see StashRepo::saveStash.
-    bool saveCharacter(const poe::Character &character, const QByteArray &bytes);
+    // `character` — see StashRepo::saveStash, `digest` included.
+    bool saveCharacter(const poe::Character &character,
+                       const QByteArray &bytes,
+                       const QByteArray &digest);
     bool saveCharacterList(const std::vector<poe::Character> &characters);
     bool reconcileCharacterList(const std::vector<poe::Character> &characters, const QString &realm);
 
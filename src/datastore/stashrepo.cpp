@@ -10,6 +10,7 @@
 
 #include "datastore/datastore_utils.h"
 #include "poe/types/stashtab.h"
+#include "util/binary_items.h"
 #include "util/json_readers.h"
 #include "util/json_writers.h"
 #include "util/spdlog_qt.h" // IWYU pragma: keep
@@ -30,7 +31,11 @@ CREATE TABLE IF NOT EXISTS stashes (
     listed_at       TEXT,
     json_fetched_at TEXT,
     json_data       TEXT,
-    json_version    INTEGER
+    json_version    INTEGER,
+    items_data      BLOB,
+    items_version   INTEGER,
+    json_digest     TEXT,
+    json_changed_at TEXT
 )
 )"};
 
@@ -44,6 +49,10 @@ CREATE INDEX IF NOT EXISTS idx_stashes_realm_league_folder
 ON stashes(realm, league, folder)
 )"};
 
+// What readStashColumns() reads back.
+constexpr const char *STASH_COLUMNS{
+    "id, parent, folder, name, type, stash_index, meta_public, meta_folder, meta_colour"};
+
 constexpr const char *UPSERT_STASH_ENTRY{R"(
 INSERT INTO stashes (
     id, realm, league, parent, folder, name, type, stash_index,
@@ -73,12 +82,14 @@ constexpr const char *UPSERT_STASH{R"(
 INSERT INTO stashes (
     id, realm, league, parent, folder, name, type, stash_index,
     meta_public, meta_folder, meta_colour,
-    json_fetched_at, json_data, json_version
+    json_fetched_at, json_data, json_version, items_data, items_version,
+    json_digest, json_changed_at
 )
 VALUES (
     :id, :realm, :league, :parent, :folder, :name, :type, :stash_index,
     :meta_public, :meta_folder, :meta_colour,
-    :json_fetched_at, :json_data, :json_version
+    :json_fetched_at, :json_data, :json_version, :items_data, :items_version,
+    :json_digest, :json_changed_at
 )
 ON CONFLICT(id) DO UPDATE SET
     realm           = excluded.realm,
@@ -93,7 +104,14 @@ ON CONFLICT(id) DO UPDATE SET
     meta_colour     = excluded.meta_colour,
     json_fetched_at = excluded.json_fetched_at,
     json_data       = excluded.json_data,
-    json_version    = excluded.json_version
+    json_version    = excluded.json_version,
+    items_data      = excluded.items_data,
+    items_version   = excluded.items_version,
+    json_changed_at = CASE
+        WHEN stashes.json_digest IS excluded.json_digest THEN stashes.json_changed_at
+        ELSE excluded.json_changed_at
+    END,
+    json_digest     = excluded.json_digest
 )"};
 
 StashRepo::StashRepo(QSqlDatabase &db)
@@ -133,6 +151,7 @@ bool StashRepo::ensureSchema()
 
 bool StashRepo::saveStash(const poe::StashTab &stash,
                           const QByteArray &bytes,
+                          const QByteArray &digest,
                           const QString &realm,
                           const QString &league)
 {
@@ -164,6 +183,26 @@ bool StashRepo::saveStash(const poe::StashTab &stash,
     q.bindValue(":json_fetched_at", json_fetched_at);
     q.bindValue(":json_data", bytes);
     q.bindValue(":json_version", json::PAYLOAD_VERSION);
+    // A new row changed when it was fetched; an existing one keeps its
+    // json_changed_at unless the digest moved (see UPSERT_STASH).
+    q.bindValue(":json_digest", digest);
+    q.bindValue(":json_changed_at", json_fetched_at);
+
+    // The binary records are derived from the same typed parse as the wire
+    // bytes, so they agree with what readStash would give back. A stash
+    // without an items array, or one that fails to encode, stores NULL and
+    // reloads through the JSON.
+    QByteArray items_data;
+    if (stash.items) {
+        items_data = binary::writeItems(*stash.items);
+    }
+    if (items_data.isEmpty()) {
+        q.bindValue(":items_data", QVariant{QMetaType::fromType<QByteArray>()});
+        q.bindValue(":items_version", QVariant{QMetaType::fromType<int>()});
+    } else {
+        q.bindValue(":items_data", items_data);
+        q.bindValue(":items_version", binary::ITEMS_VERSION);
+    }
 
     if (!q.exec()) {
         ds::logQueryError("StashRepo::saveStash()", q);
@@ -172,6 +211,29 @@ bool StashRepo::saveStash(const poe::StashTab &stash,
     return true;
 }
 
+bool StashRepo::touchStash(const QString &id, const QString &realm, const QString &league)
+{
+    spdlog::debug("StashRepo: touching stash: realm='{}', league='{}', id='{}'", realm, league, id);
+
+    QSqlQuery q(m_db);
+    if (!q.prepare("UPDATE stashes SET json_fetched_at = :json_fetched_at"
+                   " WHERE id = :id AND realm = :realm AND league = :league")) {
+        ds::logQueryError("StashRepo::touchStash()", q);
+        return false;
+    }
+
+    q.bindValue(":json_fetched_at", ds::timestamp());
+    q.bindValue(":id", id);
+    q.bindValue(":realm", realm);
+    q.bindValue(":league", league);
+
+    if (!q.exec()) {
+        ds::logQueryError("StashRepo::touchStash()", q);
+        return false;
+    }
+    return true;
+}
+
 bool StashRepo::saveStashList(const std::vector<poe::StashTab> &stashes,
                               const QString &realm,
                               const QString &league)
@@ -358,9 +420,48 @@ bool StashRepo::reconcileStashChildren(const QString &parent_id,
     return true;
 }
 
+namespace {
+
+    // The tab's own fields from a row selected with STASH_COLUMNS.
+    poe::StashTab readStashColumns(const QSqlQuery &q)
+    {
+        poe::StashTab stash;
+        stash.id = q.value("id").toString();
+        if (!q.isNull("parent")) {
+            stash.parent = q.value("parent").toString();
+        }
+        if (!q.isNull("folder")) {
+            stash.folder = q.value("folder").toString();
+        }
+        stash.name = q.value("name").toString();
+        stash.type = q.value("type").toString();
+        if (!q.isNull("stash_index")) {
+            stash.index = q.value("stash_index").toUInt();
+        }
+        stash.metadata.public_ = q.value("meta_public").toBool();
+        stash.metadata.folder = q.value("meta_folder").toBool();
+        if (!q.isNull("meta_colour")) {
+            stash.metadata.colour = q.value("meta_colour").toString();
+        }
+        return stash;
+    }
+
+} // namespace
+
 std::optional<poe::StashTab> StashRepo::getStash(const QString &id,
                                                  const QString &realm,
                                                  const QString &league)
+{
+    const auto json = getStashJson(id, realm, league);
+    if (!json) {
+        return std::nullopt;
+    }
+    return json::readStash(*json);
+}
+
+std::optional<QByteArray> StashRepo::getStashJson(const QString &id,
+                                                  const QString &realm,
+                                                  const QString &league)
 {
     spdlog::debug("StashRepo: getting stash: id='{}', realm='{}', league='{}'", id, realm, league);
 
@@ -369,7 +470,7 @@ std::optional<poe::StashTab> StashRepo::getStash(const QString &id,
     if (!q.prepare("SELECT json_data, json_version"
                    " FROM stashes"
                    " WHERE realm = :realm AND league = :league AND id = :id")) {
-        ds::logQueryError("StashRepo::getStash()", q);
+        ds::logQueryError("StashRepo::getStashJson()", q);
         return std::nullopt;
     }
 
@@ -378,7 +479,7 @@ std::optional<poe::StashTab> StashRepo::getStash(const QString &id,
     q.bindValue(":league", league);
 
     if (!q.exec()) {
-        ds::logQueryError("StashRepo::getStash()", q);
+        ds::logQueryError("StashRepo::getStashJson()", q);
         return std::nullopt;
     }
 
@@ -413,8 +514,48 @@ std::optional<poe::StashTab> StashRepo::getStash(const QString &id,
         return std::nullopt;
     }
 
-    const auto json = q.value(0).toByteArray();
-    return json::readStash(json);
+    return q.value(0).toByteArray();
+}
+
+std::optional<StashRepo::CachedStash> StashRepo::getCachedStash(const QString &id,
+                                                               const QString &realm,
+                                                               const QString &league)
+{
+    QSqlQuery q(m_db);
+
+    if (!q.prepare(QString("SELECT json_data, json_version, items_data, items_version, ")
+                   + STASH_COLUMNS + " FROM stashes"
+                   " WHERE realm = :realm AND league = :league AND id = :id")) {
+        ds::logQueryError("StashRepo::getCachedStash()", q);
+        return std::nullopt;
+    }
+
+    q.bindValue(":id", id);
+    q.bindValue(":realm", realm);
+    q.bindValue(":league", league);
+
+    if (!q.exec()) {
+        ds::logQueryError("StashRepo::getCachedStash()", q);
+        return std::nullopt;
+    }
+
+    if (!q.next() || q.isNull(0)) {
+        return std::nullopt;
+    }
+
+    // The binary records are only as good as the payload they were derived
+    // from, so the JSON version gates both forms (see getStashJson).
+    if (q.isNull(1) || (q.value(1).toInt() != json::PAYLOAD_VERSION)) {
+        return std::nullopt;
+    }
+
+    if (!q.isNull(2) && !q.isNull(3) && (q.value(3).toInt() == binary::ITEMS_VERSION)) {
+        // The tab's fields come from this row, not from an earlier
+        // getStashList(): they are whatever the row's last write left, the
+        // save that wrote these records or a later stash list.
+        return CachedStash{q.value(2).toByteArray(), true, readStashColumns(q)};
+    }
+    return CachedStash{q.value(0).toByteArray(), false};
 }
 
 std::vector<poe::StashTab> StashRepo::getStashList(const QString &realm,
@@ -430,9 +571,7 @@ std::vector<poe::StashTab> StashRepo::getStashList(const QString &realm,
         spdlog::debug("StashRepo: getting stash list: realm='{}', league='{}'", realm, league);
     }
 
-    QString sql{"SELECT realm, league, id, parent, folder, name, type, stash_index, meta_public, "
-                "meta_folder, meta_colour"
-                " FROM stashes"
+    QString sql{QString("SELECT realm, league, ") + STASH_COLUMNS + " FROM stashes"
                 " WHERE realm = :realm AND league = :league"};
 
     if (type) {
@@ -460,31 +599,47 @@ std::vector<poe::StashTab> StashRepo::getStashList(const QString &realm,
     std::vector<poe::StashTab> stashes;
 
     while (q.next()) {
-        poe::StashTab stash;
-        stash.id = q.value("id").toString();
-        if (!q.isNull("parent")) {
-            stash.parent = q.value("parent").toString();
-        }
-        if (!q.isNull("folder")) {
-            stash.folder = q.value("folder").toString();
-        }
-        stash.name = q.value("name").toString();
-        stash.type = q.value("type").toString();
-        if (!q.isNull("stash_index")) {
-            stash.index = q.value("stash_index").toUInt();
-        }
-        stash.metadata.public_ = q.value("meta_public").toBool();
-        stash.metadata.folder = q.value("meta_folder").toBool();
-        if (!q.isNull("meta_colour")) {
-            stash.metadata.colour = q.value("meta_colour").toString();
-        }
-        stashes.push_back(stash);
+        stashes.push_back(readStashColumns(q));
     }
 
     spdlog::debug("StashRepo: returning {} stashes", stashes.size());
     return stashes;
 }
 
+std::vector<StashRepo::FetchHistory> StashRepo::getFetchHistory(const QString &realm,
+                                                                const QString &league)
+{
+    spdlog::debug("StashRepo: getting fetch history: realm='{}', league='{}'", realm, league);
+
+    QSqlQuery q(m_db);
+
+    if (!q.prepare("SELECT id, json_digest, json_changed_at, json_fetched_at"
+                   " FROM stashes"
+                   " WHERE realm = :realm AND league = :league AND json_digest IS NOT NULL")) {
+        ds::logQueryError("StashRepo::getFetchHistory()", q);
+        return {};
+    }
+
+    q.bindValue(":realm", realm);
+    q.bindValue(":league", league);
+
+    if (!q.exec()) {
+        ds::logQueryError("StashRepo::getFetchHistory()", q);
+        return {};
+    }
+
+    std::vector<FetchHistory> history;
+    while (q.next()) {
+        history.push_back(FetchHistory{q.value("id").toString(),
+                                       q.value("json_digest").toByteArray(),
+                                       q.value("json_changed_at").toDateTime(),
+                                       q.value("json_fetched_at").toDateTime()});
+    }
+
+    spdlog::debug("StashRepo: returning fetch history for {} stashes", history.size());
+    return history;
+}
+
 std::vector<poe::StashTab> StashRepo::getStashChildren(const QString &id,
                                                        const QString &realm,
                                                        const QString &league)
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <QByteArray>
+#include <QDateTime>
 #include <QObject>
+#include <QString>
 #include <QStringList>
 
 #include <optional>
@@ -13,7 +15,6 @@
 #include "poe/types/stashtab.h"
 
 class QSqlDatabase;
-class QString;
 
 class StashRepo : public QObject
 {
@@ -24,10 +25,44 @@ public:
     std::optional<poe::StashTab> getStash(const QString &id,
                                           const QString &realm,
                                           const QString &league);
+    // The version-checked json_data blob getStash() parses, unparsed. The
+    // cold-start reader streams these off the connection's own thread and
+    // leaves the parse to the worker pool.
+    std::optional<QByteArray> getStashJson(const QString &id,
+                                           const QString &realm,
+                                           const QString &league);
+
+    // What the cold-start reader loads for one stash: its binary item
+    // records (util/binary_items.h) when the row holds a current encoding,
+    // otherwise the json_data blob. Binary records carry only the items, so
+    // `tab` holds the tab's own fields, read from the same row by the same
+    // statement; it is empty for the JSON form, which carries its own.
+    struct CachedStash
+    {
+        QByteArray data;
+        bool binary{false};
+        std::optional<poe::StashTab> tab;
+    };
+    std::optional<CachedStash> getCachedStash(const QString &id,
+                                              const QString &realm,
+                                              const QString &league);
+
     std::vector<poe::StashTab> getStashList(const QString &realm,
                                             const QString &league,
                                             const std::optional<QString> type = {});
 
+    // What the fetch scheduler learns from the cache: per fetched stash, the
+    // digest of its last reply's bytes, when those bytes last changed, and
+    // when they were last fetched. Rows never fetched are left out.
+    struct FetchHistory
+    {
+        QString id;
+        QByteArray digest;
+        QDateTime changed_at;
+        QDateTime fetched_at;
+    };
+    std::vector<FetchHistory> getFetchHistory(const QString &realm, const QString &league);
+
     std::vector<poe::StashTab> getStashChildren(const QString &id,
                                                 const QString &realm,
                                                 const QString &league);
@@ -39,11 +74,17 @@ public slots:
     // `bytes` is the exact wire JSON of the reply's stash sub-object (F62):
     // it is stored as-is in json_data, never a re-serialization of `stash`,
     // so the cache keeps every field the poe:: types do not model. The typed
-    // `stash` fills the queryable columns.
+    // `stash` fills the queryable columns. `digest` is Util::ContentDigest of
+    // `bytes`, which the worker already took to rank the reply; it moves
+    // json_changed_at only when it differs from the last save's.
     bool saveStash(const poe::StashTab &stash,
                    const QByteArray &bytes,
+                   const QByteArray &digest,
                    const QString &realm,
                    const QString &league);
+    // Records a fetch whose bytes matched the stored ones: only
+    // json_fetched_at moves, the row is not rewritten.
+    bool touchStash(const QString &id, const QString &realm, const QString &league);
     bool saveStashList(const std::vector<poe::StashTab> &stashes,
                        const QString &realm,
                        const QString &league);
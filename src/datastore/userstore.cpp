@@ -19,7 +19,7 @@
 // json stored inside them: a payload change needs no schema bump, and this
 // one is compared with '<' (migrations replay forward) where the payload
 // version is compared with '!=' (a downgrade must not misparse newer blobs).
-static constexpr int SCHEMA_VERSION = 3;
+static constexpr int SCHEMA_VERSION = 6;
 
 constexpr unsigned int QSQLITE_BUSY_TIMEOUT{5000};
 
@@ -31,6 +31,19 @@ constexpr std::array CONNECTION_PRAGMAS{
     "PRAGMA foreign_keys=OFF",
 };
 
+namespace {
+
+    // QSQLITE reports SQLite's extended result code as the native code; its
+    // low byte is the primary code.
+    bool isBusyError(const QSqlError &error)
+    {
+        bool ok = false;
+        const int code = error.nativeErrorCode().toInt(&ok) & 0xff;
+        return ok && ((code == 5 /* SQLITE_BUSY */) || (code == 6 /* SQLITE_LOCKED */));
+    }
+
+} // namespace
+
 UserStore::UserStore(const QDir &dir, const QString &username)
 {
     const QString uuid = QUuid::createUuid().toString(QUuid::WithoutBraces);
@@ -105,6 +118,48 @@ UserStore::~UserStore()
     }
 }
 
+bool UserStore::transaction()
+{
+    // IMMEDIATE takes the write lock up front: a database another
+    // connection is writing fails here, after busy_timeout, rather than
+    // part-way through the group. QSqlDatabase::commit() and rollback()
+    // end it like one begun with transaction().
+    QSqlQuery query(m_db);
+    if (!query.exec("BEGIN IMMEDIATE")) {
+        spdlog::error("UserStore: could not begin a transaction: {}", query.lastError().text());
+        m_last_failure_busy = isBusyError(query.lastError());
+        return false;
+    }
+    return true;
+}
+
+bool UserStore::commit()
+{
+    if (!m_db.commit()) {
+        spdlog::error("UserStore: could not commit: {}", m_db.lastError().text());
+        m_last_failure_busy = isBusyError(m_db.lastError());
+        return false;
+    }
+    return true;
+}
+
+bool UserStore::rollback()
+{
+    if (!m_db.rollback()) {
+        spdlog::error("UserStore: could not roll back: {}", m_db.lastError().text());
+        return false;
+    }
+    return true;
+}
+
+void UserStore::setBusyTimeout(std::chrono::milliseconds timeout)
+{
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("PRAGMA busy_timeout=%1").arg(timeout.count()))) {
+        spdlog::error("UserStore: could not set busy_timeout: {}", query.lastError().text());
+    }
+}
+
 namespace {
 
     // True when the table exists and its primary key is exactly (id), which
@@ -131,6 +186,23 @@ namespace {
         return (pk_columns.size() == 1) && (pk_columns.front() == "id");
     }
 
+    bool hasColumn(QSqlDatabase &db, const QString &table, const QString &column)
+    {
+        QSqlQuery q(db);
+        if (!q.exec("PRAGMA table_info(" + table + ")")) {
+            spdlog::error("UserStore: error reading table_info for {}: {}",
+                          table,
+                          q.lastError().text());
+            return false;
+        }
+        while (q.next()) {
+            if (q.value("name").toString() == column) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 } // namespace
 
 int UserStore::userVersion()
@@ -244,6 +316,70 @@ void UserStore::migrate()
                 return;
             }
         }
+
+        // 3 -> 4: add the binary item records beside json_data. Existing
+        // rows get NULL and keep loading through their JSON until the next
+        // fetch rewrites them. Conditional, unlike the 1 -> 2 step, because
+        // the 2 -> 3 repair may have just rebuilt stashes at the current
+        // DDL, columns included.
+        if (version < 4) {
+            constexpr std::array columns{
+                std::pair{"items_data", "BLOB"},
+                std::pair{"items_version", "INTEGER"},
+            };
+            for (const auto &[column, type] : columns) {
+                if (hasColumn(m_db, "stashes", column)) {
+                    continue;
+                }
+                if (!q.exec(QString("ALTER TABLE stashes ADD COLUMN %1 %2").arg(column, type))) {
+                    ds::logQueryError("UserStore::migrate", q);
+                    m_db.rollback();
+                    return;
+                }
+            }
+        }
+
+        // 4 -> 5: add the reply digest and last-changed time the fetch
+        // scheduler ranks tabs by. Existing rows get NULL, which reads as
+        // "never fetched" until their next save fills both in. Conditional
+        // for the same reason as the 3 -> 4 step.
+        if (version < 5) {
+            constexpr std::array columns{
+                std::pair{"json_digest", "TEXT"},
+                std::pair{"json_changed_at", "TEXT"},
+            };
+            for (const auto &[column, type] : columns) {
+                if (hasColumn(m_db, "stashes", column)) {
+                    continue;
+                }
+                if (!q.exec(QString("ALTER TABLE stashes ADD COLUMN %1 %2").arg(column, type))) {
+                    ds::logQueryError("UserStore::migrate", q);
+                    m_db.rollback();
+                    return;
+                }
+            }
+        }
+
+        // 5 -> 6: the same two columns for characters, so they are ranked
+        // from their own history after a restart rather than as never
+        // fetched. Conditional for the same reason as the 3 -> 4 step.
+        if (version < 6) {
+            constexpr std::array columns{
+                std::pair{"json_digest", "TEXT"},
+                std::pair{"json_changed_at", "TEXT"},
+            };
+            for (const auto &[column, type] : columns) {
+                if (hasColumn(m_db, "characters", column)) {
+                    continue;
+                }
+                if (!q.exec(
+                        QString("ALTER TABLE characters ADD COLUMN %1 %2").arg(column, type))) {
+                    ds::logQueryError("UserStore::migrate", q);
+                    m_db.rollback();
+                    return;
+                }
+            }
+        }
     }
 
     // Update the user_version.
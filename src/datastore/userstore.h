@@ -8,6 +8,8 @@
 #include <QSqlDatabase>
 #include <QString>
 
+#include <chrono>
+
 class BuyoutRepo;
 class CharacterRepo;
 class StashRepo;
@@ -23,6 +25,20 @@ public:
     CharacterRepo &characters() { return *m_characters; }
     BuyoutRepo &buyouts() { return *m_buyouts; }
 
+    // Groups the repos' writes on this connection into one transaction
+    // (WriteBehindStore commits its batches this way). The write lock is
+    // taken at the start, so a busy database fails transaction() itself.
+    bool transaction();
+    bool commit();
+    bool rollback();
+    // Whether the last transaction() or commit() that failed did so because
+    // another connection held the lock (SQLITE_BUSY or SQLITE_LOCKED), the
+    // one failure that waiting can clear.
+    bool lastFailureWasBusy() const { return m_last_failure_busy; }
+
+    // Overrides the connection's busy_timeout pragma.
+    void setBusyTimeout(std::chrono::milliseconds timeout);
+
 private:
     int userVersion();
     void migrate();
@@ -31,4 +47,5 @@ private:
     std::unique_ptr<StashRepo> m_stashes;
     std::unique_ptr<CharacterRepo> m_characters;
     std::unique_ptr<BuyoutRepo> m_buyouts;
+    bool m_last_failure_busy{false};
 };
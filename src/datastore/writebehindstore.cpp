@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "datastore/writebehindstore.h"
+
+#include <algorithm>
+
+#include "datastore/characterrepo.h"
+#include "datastore/stashrepo.h"
+#include "datastore/userstore.h"
+#include "util/spdlog_qt.h" // IWYU pragma: keep
+
+// The longest wait between retries of a group the database is too busy for.
+constexpr std::chrono::milliseconds MAX_RETRY_BACKOFF{5000};
+
+WriteBehindStore::WriteBehindStore(const QDir &dir, const QString &username)
+    : WriteBehindStore(dir, username, Config{})
+{}
+
+WriteBehindStore::WriteBehindStore(const QDir &dir, const QString &username, Config config)
+    : m_dir(dir)
+    , m_username(username)
+    , m_config(config)
+    , m_thread([this](std::stop_token stop) { Run(stop); })
+{}
+
+WriteBehindStore::~WriteBehindStore()
+{
+    // A stop drains the whole queue without waiting out the delay, so
+    // nothing the worker emitted before shutdown is lost.
+    m_thread.request_stop();
+    {
+        const std::lock_guard lock(m_mutex);
+        m_wake.notify_all();
+    }
+    m_thread.join();
+}
+
+void WriteBehindStore::flush()
+{
+    std::unique_lock lock(m_mutex);
+    const std::uint64_t target = m_next_seq - 1;
+    m_commit_through = std::max(m_commit_through, target);
+    m_wake.notify_all();
+    m_committed.wait(lock, [&]() { return m_committed_seq >= target; });
+}
+
+void WriteBehindStore::commitNow()
+{
+    const std::lock_guard lock(m_mutex);
+    m_commit_through = m_next_seq - 1;
+    m_wake.notify_all();
+}
+
+std::uint64_t WriteBehindStore::committedBatches() const
+{
+    const std::lock_guard lock(m_mutex);
+    return m_committed_batches;
+}
+
+std::uint64_t WriteBehindStore::droppedBatches() const
+{
+    const std::lock_guard lock(m_mutex);
+    return m_dropped_batches;
+}
+
+void WriteBehindStore::saveStash(const poe::StashTab &stash,
+                                 const QByteArray &bytes,
+                                 const QByteArray &digest,
+                                 const QString &realm,
+                                 const QString &league)
+{
+    Enqueue("saveStash", bytes.size(), [=](UserStore &store) {
+        return store.stashes().saveStash(stash, bytes, digest, realm, league);
+    });
+}
+
+void WriteBehindStore::touchStash(const QString &id, const QString &realm, const QString &league)
+{
+    Enqueue("touchStash", 0, [=](UserStore &store) {
+        return store.stashes().touchStash(id, realm, league);
+    });
+}
+
+void WriteBehindStore::saveStashList(const std::vector<poe::StashTab> &stashes,
+                                     const QString &realm,
+                                     const QString &league)
+{
+    Enqueue("saveStashList", 0, [=](UserStore &store) {
+        return store.stashes().saveStashList(stashes, realm, league);
+    });
+}
+
+void WriteBehindStore::reconcileStashList(const std::vector<poe::StashTab> &stashes,
+                                          const QString &realm,
+                                          const QString &league)
+{
+    Enqueue("reconcileStashList", 0, [=](UserStore &store) {
+        return store.stashes().reconcileStashList(stashes, realm, league);
+    });
+}
+
+void WriteBehindStore::reconcileStashChildren(const QString &parent_id,
+                                              const QStringList &child_ids,
+                                              const QString &realm,
+                                              const QString &league)
+{
+    Enqueue("reconcileStashChildren", 0, [=](UserStore &store) {
+        return store.stashes().reconcileStashChildren(parent_id, child_ids, realm, league);
+    });
+}
+
+void WriteBehindStore::saveCharacter(const poe::Character &character,
+                                     const QByteArray &bytes,
+                                     const QByteArray &digest)
+{
+    Enqueue("saveCharacter", bytes.size(), [=](UserStore &store) {
+        return store.characters().saveCharacter(character, bytes, digest);
+    });
+}
+
+void WriteBehindStore::saveCharacterList(const std::vector<poe::Character> &characters)
+{
+    Enqueue("saveCharacterList", 0, [=](UserStore &store) {
+        return store.characters().saveCharacterList(characters);
+    });
+}
+
+void WriteBehindStore::reconcileCharacterList(const std::vector<poe::Character> &characters,
+                                              const QString &realm)
+{
+    Enqueue("reconcileCharacterList", 0, [=](UserStore &store) {
+        return store.characters().reconcileCharacterList(characters, realm);
+    });
+}
+
+void WriteBehindStore::Enqueue(const char *what,
+                               qsizetype bytes,
+                               std::function<bool(UserStore &)> run)
+{
+    const std::lock_guard lock(m_mutex);
+    m_queue.push_back(Write{m_next_seq++, Clock::now(), bytes, what, std::move(run)});
+    m_queued_bytes += bytes;
+    // Back-pressure. The typed copy riding along with each reply scales with
+    // its wire bytes, so those are what is bounded. The write is always
+    // queued: the caller is the UI thread and must not wait on SQLite. The
+    // queue commits at once and the producer is asked to hold its replies
+    // instead.
+    if (!m_backlogged && (m_queued_bytes > m_config.max_queued_bytes)) {
+        spdlog::debug("WriteBehindStore: {} bytes queued; asking for a pause", m_queued_bytes);
+        m_commit_through = m_next_seq - 1;
+        SetBacklogged(true);
+    }
+    m_wake.notify_all();
+}
+
+void WriteBehindStore::SetBacklogged(bool backlogged)
+{
+    // Called under m_mutex by both threads. The change is announced from
+    // this object's thread in the order it happened, and never from inside
+    // Enqueue, whose caller may be handling a reply.
+    m_backlogged = backlogged;
+    QMetaObject::invokeMethod(
+        this,
+        [this, backlogged]() { emit backlogChanged(backlogged); },
+        Qt::QueuedConnection);
+}
+
+void WriteBehindStore::Run(std::stop_token stop)
+{
+    // The connection belongs to this thread: it is opened, used, and
+    // closed here.
+    UserStore store(m_dir, m_username);
+    store.setBusyTimeout(m_config.busy_timeout);
+
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [&]() { return stop.stop_requested() || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            break;
+        }
+
+        // Let the group fill until the oldest write has waited max_delay,
+        // unless it is already full or a commit has been asked for.
+        const auto deadline = m_queue.front().queued_at + m_config.max_delay;
+        m_wake.wait_until(lock, deadline, [&]() {
+            return stop.stop_requested() || (m_queue.size() >= m_config.max_batch)
+                   || (m_queue.front().seq <= m_commit_through);
+        });
+
+        std::vector<Write> batch;
+        const size_t count = std::min(m_queue.size(), m_config.max_batch);
+        batch.reserve(count);
+        for (size_t n = 0; n < count; ++n) {
+            batch.push_back(std::move(m_queue.front()));
+            m_queue.pop_front();
+        }
+
+        lock.unlock();
+        auto backoff = m_config.retry_backoff;
+        bool committed = false;
+        for (int attempt = 1;; ++attempt) {
+            bool busy = false;
+            committed = Commit(store, batch, busy);
+            if (committed) {
+                break;
+            }
+            if (!busy) {
+                spdlog::error("WriteBehindStore: dropping {} writes the database refused",
+                              batch.size());
+                break;
+            }
+            if (attempt >= m_config.max_attempts) {
+                spdlog::error("WriteBehindStore: database still busy after {} attempts;"
+                              " dropping {} writes",
+                              attempt,
+                              batch.size());
+                break;
+            }
+            if (stop.stop_requested()) {
+                spdlog::error("WriteBehindStore: shutting down; {} writes were not saved",
+                              batch.size());
+                break;
+            }
+            spdlog::warn("WriteBehindStore: database busy; retrying {} writes in {} ms",
+                         batch.size(),
+                         backoff.count());
+            std::unique_lock wait_lock(m_mutex);
+            m_wake.wait_for(wait_lock, backoff, [&]() { return stop.stop_requested(); });
+            backoff = std::min(backoff * 2, MAX_RETRY_BACKOFF);
+        }
+        lock.lock();
+
+        // Bytes stay counted until their group is done with, committed or
+        // dropped, so the bound covers the batch in flight too.
+        for (const auto &write : batch) {
+            m_queued_bytes -= write.bytes;
+        }
+        m_committed_seq = batch.back().seq;
+        if (committed) {
+            ++m_committed_batches;
+        } else {
+            ++m_dropped_batches;
+        }
+        m_committed.notify_all();
+        if (m_backlogged && (m_queued_bytes <= m_config.max_queued_bytes / 2)) {
+            SetBacklogged(false);
+        }
+    }
+}
+
+bool WriteBehindStore::Commit(UserStore &store, std::vector<Write> &batch, bool &busy)
+{
+    // Each write logs its own failure; a failed statement only undoes
+    // itself, so the rest of the group still commits. A group that cannot
+    // begin or commit as a whole is rolled back, and the caller retries all
+    // of it if the lock was the reason: writing one by one would hit the
+    // same lock and lose the writes.
+    if (!store.transaction()) {
+        busy = store.lastFailureWasBusy();
+        return false;
+    }
+    size_t failed = 0;
+    for (auto &write : batch) {
+        if (!write.run(store)) {
+            spdlog::warn("WriteBehindStore: {} failed", write.what);
+            ++failed;
+        }
+    }
+    if (!store.commit()) {
+        busy = store.lastFailureWasBusy();
+        store.rollback();
+        return false;
+    }
+    spdlog::debug("WriteBehindStore: committed {} writes ({} failed)", batch.size(), failed);
+    return true;
+}
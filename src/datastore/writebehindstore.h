@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <QByteArray>
+#include <QDir>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "poe/types/character.h"
+#include "poe/types/stashtab.h"
+
+class UserStore;
+
+// Write-behind persistence for the worker's replies. The slots mirror the
+// StashRepo/CharacterRepo write slots and take the same signals, but only
+// queue the write: a dedicated thread with its own UserStore connection
+// runs the queue, grouping up to `max_batch` writes — or whatever arrived
+// within `max_delay` of the oldest — into one transaction, so a burst of
+// replies costs one WAL commit per group instead of one per reply, and none
+// of it on the UI thread.
+//
+// Every write, reconciles included, goes through one FIFO queue, so a
+// reconcile always runs after the saves emitted before it. The slots never
+// block their caller, which is the UI thread: past `max_queued_bytes` of
+// wire bytes the queue is committed at once and backlogChanged(true) asks
+// the producer to hold its replies, until the queue has drained to half
+// the bound. commitNow() (connected to RefreshFinished) commits what is
+// queued without waiting out the delay; flush() and the destructor also
+// wait for it.
+//
+// A group is one IMMEDIATE transaction. While another connection holds the
+// write lock (a BuyoutRepo batch spans a whole pricing pass) the group
+// cannot begin; it is retried whole, with backoff, up to `max_attempts`
+// times. Any other failure (a full disk, a read-only or corrupt file) does
+// not clear by waiting: the group is dropped at once with an error, as is
+// a busy group out of attempts, so the queue and the backlog always drain
+// and the producer is never held for good. A dropped write is lost: its
+// row keeps what it held before until that tab's next save.
+//
+// Other connections see a write only once its group commits. A reader of
+// the stash or character rows that must not miss a queued reply calls
+// flush() first (MainWindow does before the legacy buyout importer plans).
+class WriteBehindStore : public QObject
+{
+    Q_OBJECT
+public:
+    struct Config
+    {
+        size_t max_batch{64};
+        std::chrono::milliseconds max_delay{250};
+        qsizetype max_queued_bytes{64 * 1024 * 1024};
+        // The writer connection's SQLite busy_timeout, and the first wait
+        // before a busy group is retried (doubling up to a few seconds).
+        std::chrono::milliseconds busy_timeout{5000};
+        std::chrono::milliseconds retry_backoff{100};
+        // Attempts per group while the database is busy, the first included.
+        int max_attempts{20};
+    };
+
+    WriteBehindStore(const QDir &dir, const QString &username);
+    WriteBehindStore(const QDir &dir, const QString &username, Config config);
+    ~WriteBehindStore();
+
+    // Blocks until every write queued before the call is committed or
+    // dropped.
+    void flush();
+
+    // Transactions committed so far (for the tests and the debug log).
+    std::uint64_t committedBatches() const;
+    // Groups given up on, and their writes lost.
+    std::uint64_t droppedBatches() const;
+
+public slots:
+    void saveStash(const poe::StashTab &stash,
+                   const QByteArray &bytes,
+                   const QByteArray &digest,
+                   const QString &realm,
+                   const QString &league);
+    void touchStash(const QString &id, const QString &realm, const QString &league);
+    void saveStashList(const std::vector<poe::StashTab> &stashes,
+                       const QString &realm,
+                       const QString &league);
+    void reconcileStashList(const std::vector<poe::StashTab> &stashes,
+                            const QString &realm,
+                            const QString &league);
+    void reconcileStashChildren(const QString &parent_id,
+                                const QStringList &child_ids,
+                                const QString &realm,
+                                const QString &league);
+
+    void saveCharacter(const poe::Character &character,
+                       const QByteArray &bytes,
+                       const QByteArray &digest);
+    void saveCharacterList(const std::vector<poe::Character> &characters);
+    void reconcileCharacterList(const std::vector<poe::Character> &characters,
+                                const QString &realm);
+
+    void commitNow();
+
+signals:
+    // True once the queued bytes pass max_queued_bytes, false once they
+    // are back under half of it. Always emitted from this object's thread,
+    // through its event loop.
+    void backlogChanged(bool backlogged);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Write
+    {
+        std::uint64_t seq{0};
+        Clock::time_point queued_at;
+        qsizetype bytes{0};
+        const char *what{""};
+        std::function<bool(UserStore &)> run;
+    };
+
+    void Enqueue(const char *what, qsizetype bytes, std::function<bool(UserStore &)> run);
+    void SetBacklogged(bool backlogged);
+    void Run(std::stop_token stop);
+    // False when the group was rolled back; `busy` then says whether it
+    // failed for the lock, which is worth retrying.
+    bool Commit(UserStore &store, std::vector<Write> &batch, bool &busy);
+
+    const QDir m_dir;
+    const QString m_username;
+    const Config m_config;
+
+    mutable std::mutex m_mutex;
+    // Wakes the thread: a write arrived, a commit was requested, or stop.
+    std::condition_variable m_wake;
+    // Wakes flush(): a batch committed.
+    std::condition_variable m_committed;
+    std::deque<Write> m_queue;
+    qsizetype m_queued_bytes{0};
+    bool m_backlogged{false};
+    std::uint64_t m_next_seq{1};
+    // Writes up to this sequence number commit without waiting out the delay.
+    std::uint64_t m_commit_through{0};
+    std::uint64_t m_committed_seq{0};
+    std::uint64_t m_committed_batches{0};
+    std::uint64_t m_dropped_batches{0};
+
+    // Last, so the thread starts after everything it reads is initialized.
+    std::jthread m_thread;
+};
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "fetchscheduler.h"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+constexpr double RECENCY_HALF_LIFE_HOURS = 24.0;
+constexpr double ACTIVE_TYPE_BONUS = 0.5;
+
+namespace {
+
+    bool isActiveTabType(const QString &type)
+    {
+        static const QStringList types{"CurrencyStash", "FragmentStash", "EssenceStash"};
+        return types.contains(type);
+    }
+
+} // namespace
+
+void FetchScheduler::Reset(std::map<FetchSourceKey, History> history)
+{
+    m_history = std::move(history);
+}
+
+bool FetchScheduler::Observe(const FetchSourceKey &key,
+                             const QByteArray &digest,
+                             const QDateTime &now)
+{
+    History &history = m_history[key];
+    const bool changed = (history.digest != digest);
+    ++history.fetches;
+    history.fetched_at = now;
+    if (changed) {
+        ++history.changes;
+        history.changed_at = now;
+        history.digest = digest;
+    }
+    return changed;
+}
+
+const FetchScheduler::History *FetchScheduler::Find(const FetchSourceKey &key) const
+{
+    const auto it = m_history.find(key);
+    return (it == m_history.end()) ? nullptr : &it->second;
+}
+
+void FetchScheduler::Forget(const FetchSourceKey &key)
+{
+    m_history.erase(key);
+}
+
+double FetchScheduler::Score(const ItemLocation &location, const QDateTime &now) const
+{
+    const History *history = Find(FetchSourceKey::ForLocation(location));
+    if (!history) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double score = (history->changes + 1.0) / (history->fetches + 2.0);
+    if (history->changed_at.isValid()) {
+        const double hours = std::max<qint64>(0, history->changed_at.msecsTo(now)) / 3.6e6;
+        score += std::exp2(-hours / RECENCY_HALF_LIFE_HOURS);
+    }
+    if (isActiveTabType(location.tab_type())) {
+        score += ACTIVE_TYPE_BONUS;
+    }
+    return score;
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+
+#include <map>
+
+#include "fetchsourcekey.h"
+#include "itemlocation.h"
+
+// Ranks fetch sources by how likely their next reply is to differ from the
+// last one, so a content batch can go out likeliest-changed first. Under
+// the rate limit a full refresh of a large account takes hours, and in
+// source traversal order a changed currency tab can sit behind every
+// untouched one; ranked, the changes reach the UI first. Ordering never
+// changes what a batch covers: that is the caller's choice (see
+// TabSelection::Quick in ItemsManagerWorker).
+//
+// The history is keyed like the item store (FetchSourceKey), seeded from
+// the stash and character rows' digest and last-changed time at startup,
+// and updated from every accepted reply. A source scores by
+//
+// - the Laplace-smoothed share of its fetches that found new bytes;
+// - how recently it last changed (halving every RECENCY_HALF_LIFE_HOURS),
+//   which is what brings an in-use dump tab forward;
+// - a fixed bonus for tab types that change with play (currency,
+//   fragments, essences).
+//
+// A source with no history at all ranks ahead of everything: nothing is
+// known about it, and it may hold items the cache has never seen.
+class FetchScheduler
+{
+public:
+    struct History
+    {
+        QByteArray digest;
+        QDateTime changed_at;
+        QDateTime fetched_at;
+        unsigned fetches{0};
+        unsigned changes{0};
+    };
+
+    // Replaces the whole history (the cold-start seed).
+    void Reset(std::map<FetchSourceKey, History> history);
+
+    // Records a reply's digest (Util::ContentDigest of its wire bytes).
+    // Returns true when it differs from the last one seen for the source,
+    // which a source's first reply always does.
+    bool Observe(const FetchSourceKey &key, const QByteArray &digest, const QDateTime &now);
+
+    // Null when the source has never been fetched.
+    const History *Find(const FetchSourceKey &key) const;
+
+    // Drops a source's history, so it ranks as never fetched and its next
+    // reply counts as changed whatever its bytes.
+    void Forget(const FetchSourceKey &key);
+
+    double Score(const ItemLocation &location, const QDateTime &now) const;
+
+private:
+    std::map<FetchSourceKey, History> m_history;
+};
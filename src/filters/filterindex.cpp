@@ -0,0 +1,488 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "filters/filterindex.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "filters/filtermatchers.h"
+
+namespace {
+
+    constexpr size_t kWordBits = 64;
+
+    size_t WordCount(size_t rows)
+    {
+        return (rows + kWordBits - 1) / kWordBits;
+    }
+
+    void AssignBit(std::vector<std::uint64_t> &bits, size_t row, bool value)
+    {
+        const std::uint64_t bit = std::uint64_t{1} << (row % kWordBits);
+        if (value) {
+            bits[row / kWordBits] |= bit;
+        } else {
+            bits[row / kWordBits] &= ~bit;
+        }
+    }
+
+    // A code column's pass: the slots whose code is accepted.
+    void AndAcceptedCodes(std::vector<std::uint64_t> &slots,
+                          const std::vector<std::uint32_t> &codes,
+                          const std::vector<char> &accepted)
+    {
+        const size_t capacity = codes.size();
+        for (size_t word = 0; word < slots.size(); ++word) {
+            if (slots[word] == 0) {
+                continue;
+            }
+            const size_t base = word * kWordBits;
+            const size_t end = std::min(base + kWordBits, capacity);
+            std::uint64_t pass = 0;
+            for (size_t slot = base; slot < end; ++slot) {
+                pass |= std::uint64_t{accepted[codes[slot]] != 0} << (slot - base);
+            }
+            slots[word] &= pass;
+        }
+    }
+
+    constexpr qsizetype kTrigram = 3;
+
+    // The distinct trigrams of a folded string, sorted.
+    std::vector<std::uint64_t> Trigrams(QStringView text)
+    {
+        std::vector<std::uint64_t> trigrams;
+        if (text.size() < kTrigram) {
+            return trigrams;
+        }
+        trigrams.reserve(static_cast<size_t>(text.size() - kTrigram + 1));
+        for (qsizetype i = 0; i + kTrigram <= text.size(); ++i) {
+            trigrams.push_back((std::uint64_t{text[i].unicode()} << 32)
+                               | (std::uint64_t{text[i + 1].unicode()} << 16)
+                               | std::uint64_t{text[i + 2].unicode()});
+        }
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+        return trigrams;
+    }
+
+    // The one attribute each combo matcher reads; items sharing a key
+    // share the matcher's answer for every state.
+    QString ComboKey(const Item &item, ComboMatchKind kind)
+    {
+        switch (kind) {
+        case ComboMatchKind::CategoryContains:
+            return item.category();
+        case ComboMatchKind::Rarity:
+            return QString::number(item.frameType());
+        }
+        Q_ASSERT(false);
+        return {};
+    }
+
+} // namespace
+
+FilterIndex::FilterIndex(const FilterCatalog &catalog)
+{
+    m_refs.reserve(static_cast<size_t>(catalog.size()));
+    for (const auto &spec : catalog) {
+        ColumnRef ref;
+        std::visit(
+            [this, &ref](const auto &payload) {
+                using Payload = std::decay_t<decltype(payload)>;
+                if constexpr (std::is_same_v<Payload, MinMaxPayload>) {
+                    ref = {ColumnKind::MinMax, m_minmax.size()};
+                    m_minmax.push_back({&payload, {}, {}});
+                } else if constexpr (std::is_same_v<Payload, BoolPayload>) {
+                    if (payload.indexable) {
+                        ref = {ColumnKind::Bool, m_bool.size()};
+                        m_bool.push_back({&payload, {}});
+                    }
+                } else if constexpr (std::is_same_v<Payload, ComboPayload>) {
+                    ref = {ColumnKind::Combo, m_combo.size()};
+                    m_combo.push_back({&payload, {}, {}, {}});
+                } else if constexpr (std::is_same_v<Payload, TextPayload>) {
+                    if (payload.indexable) {
+                        ref = {ColumnKind::Text, m_text.size()};
+                        m_text.push_back({&payload, {}, {}, {}, {}, {}});
+                    }
+                }
+            },
+            spec.payload);
+        m_refs.push_back(ref);
+    }
+}
+
+void FilterIndex::ResetTo(const Items &items)
+{
+    m_items.clear();
+    m_free_slots.clear();
+    m_slot_of.clear();
+    m_source_slots.clear();
+    for (auto &column : m_minmax) {
+        column.values.clear();
+        column.present.clear();
+    }
+    for (auto &column : m_bool) {
+        column.bits.clear();
+    }
+    for (auto &column : m_combo) {
+        column.codes.clear();
+        column.dictionary.clear();
+        column.representatives.clear();
+    }
+    for (auto &column : m_text) {
+        column.codes.clear();
+        column.dictionary.clear();
+        column.strings.clear();
+        column.postings.clear();
+    }
+
+    // Materialized columns stay materialized across the snapshot: they are
+    // the filters this session actually uses.
+    m_items.reserve(items.size());
+    m_slot_of.reserve(items.size());
+    for (const auto &item : items) {
+        const std::uint32_t slot = AcquireSlot();
+        WriteSlot(slot, item);
+        m_source_slots[FetchSourceKey::ForLocation(item->location())].push_back(slot);
+    }
+    m_order_dirty = true;
+}
+
+void FilterIndex::ReplaceSource(const FetchSourceKey &key, const Items &items)
+{
+    const auto it = m_source_slots.find(key);
+    if (it != m_source_slots.end()) {
+        ReleaseSlots(it->second);
+        m_source_slots.erase(it);
+    }
+    if (!items.empty()) {
+        AppendSource(key, items);
+    }
+}
+
+bool FilterIndex::Indexes(qsizetype spec_index) const
+{
+    return m_refs.at(static_cast<size_t>(spec_index)).kind != ColumnKind::None;
+}
+
+std::uint32_t FilterIndex::AcquireSlot()
+{
+    if (!m_free_slots.empty()) {
+        const std::uint32_t slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        return slot;
+    }
+    const auto slot = static_cast<std::uint32_t>(m_items.size());
+    m_items.emplace_back();
+    const size_t capacity = m_items.size();
+    const size_t words = WordCount(capacity);
+    for (auto &column : m_minmax) {
+        column.values.resize(capacity);
+        column.present.resize(words);
+    }
+    for (auto &column : m_bool) {
+        column.bits.resize(words);
+    }
+    for (auto &column : m_combo) {
+        column.codes.resize(capacity);
+    }
+    for (auto &column : m_text) {
+        column.codes.resize(capacity);
+    }
+    return slot;
+}
+
+void FilterIndex::ReleaseSlots(const std::vector<std::uint32_t> &slots)
+{
+    for (const std::uint32_t slot : slots) {
+        m_slot_of.erase(m_items[slot].get());
+        m_items[slot].reset();
+        m_free_slots.push_back(slot);
+    }
+    m_order_dirty = true;
+}
+
+void FilterIndex::WriteSlot(std::uint32_t slot, const std::shared_ptr<Item> &item)
+{
+    m_items[slot] = item;
+    m_slot_of[item.get()] = slot;
+    for (auto &column : m_minmax) {
+        if (column.materialized) {
+            WriteCell(column, slot);
+        }
+    }
+    for (auto &column : m_bool) {
+        if (column.materialized) {
+            WriteCell(column, slot);
+        }
+    }
+    for (auto &column : m_combo) {
+        if (column.materialized) {
+            WriteCell(column, slot);
+        }
+    }
+    for (auto &column : m_text) {
+        if (column.materialized) {
+            WriteCell(column, slot);
+        }
+    }
+}
+
+void FilterIndex::WriteCell(MinMaxColumn &column, std::uint32_t slot) const
+{
+    // A payload's value is only defined for items it is present on, so the
+    // accessor only runs for present rows.
+    const Item &item = *m_items[slot];
+    const bool present = column.payload->present(item);
+    column.values[slot] = present ? static_cast<float>(column.payload->value(item)) : 0.0f;
+    AssignBit(column.present, slot, present);
+}
+
+void FilterIndex::WriteCell(BoolColumn &column, std::uint32_t slot) const
+{
+    AssignBit(column.bits, slot, column.payload->predicate(*m_items[slot]));
+}
+
+void FilterIndex::WriteCell(ComboColumn &column, std::uint32_t slot) const
+{
+    const auto &item = m_items[slot];
+    const QString key = ComboKey(*item, column.payload->matchKind);
+    auto found = column.dictionary.constFind(key);
+    if (found == column.dictionary.cend()) {
+        const auto code = static_cast<std::uint32_t>(column.representatives.size());
+        found = column.dictionary.insert(key, code);
+        column.representatives.push_back(item);
+    }
+    column.codes[slot] = *found;
+}
+
+void FilterIndex::WriteCell(TextColumn &column, std::uint32_t slot) const
+{
+    const QString folded = column.payload->value(*m_items[slot]).toLower();
+    auto found = column.dictionary.constFind(folded);
+    if (found == column.dictionary.cend()) {
+        const auto code = static_cast<std::uint32_t>(column.strings.size());
+        found = column.dictionary.insert(folded, code);
+        column.strings.push_back(folded);
+        for (const std::uint64_t trigram : Trigrams(folded)) {
+            column.postings[trigram].push_back(code);
+        }
+    }
+    column.codes[slot] = *found;
+}
+
+std::vector<char> FilterIndex::AcceptedCodes(const TextColumn &column, const QString &query)
+{
+    std::vector<char> accepted(column.strings.size(), 0);
+    const std::vector<std::uint64_t> trigrams = Trigrams(query);
+    if (trigrams.empty()) {
+        // Too short to narrow: test every distinct string.
+        for (size_t code = 0; code < accepted.size(); ++code) {
+            accepted[code] = column.strings[code].contains(query);
+        }
+        return accepted;
+    }
+
+    // Intersect from the rarest trigram. Holding every trigram does not
+    // make a substring ("abcab" against "abc cab"), so each survivor is
+    // confirmed with the matcher's own test.
+    std::vector<const std::vector<std::uint32_t> *> lists;
+    lists.reserve(trigrams.size());
+    for (const std::uint64_t trigram : trigrams) {
+        const auto found = column.postings.find(trigram);
+        if (found == column.postings.end()) {
+            return accepted;
+        }
+        lists.push_back(&found->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const auto *a, const auto *b) {
+        return a->size() < b->size();
+    });
+    std::vector<std::uint32_t> candidates = *lists.front();
+    std::vector<std::uint32_t> narrowed;
+    for (size_t i = 1; (i < lists.size()) && !candidates.empty(); ++i) {
+        narrowed.clear();
+        std::set_intersection(candidates.begin(),
+                              candidates.end(),
+                              lists[i]->begin(),
+                              lists[i]->end(),
+                              std::back_inserter(narrowed));
+        candidates.swap(narrowed);
+    }
+    for (const std::uint32_t code : candidates) {
+        accepted[code] = column.strings[code].contains(query);
+    }
+    return accepted;
+}
+
+template<typename Column>
+void FilterIndex::Materialize(Column &column) const
+{
+    if (column.materialized) {
+        return;
+    }
+    for (size_t slot = 0; slot < m_items.size(); ++slot) {
+        if (m_items[slot]) {
+            WriteCell(column, static_cast<std::uint32_t>(slot));
+        }
+    }
+    column.materialized = true;
+}
+
+void FilterIndex::AppendSource(const FetchSourceKey &key, const Items &items)
+{
+    auto &slots = m_source_slots[key];
+    slots.reserve(items.size());
+    for (const auto &item : items) {
+        const std::uint32_t slot = AcquireSlot();
+        WriteSlot(slot, item);
+        slots.push_back(slot);
+    }
+    m_order_dirty = true;
+}
+
+bool FilterIndex::Bind(const Items &items) const
+{
+    if (!m_order_dirty && (m_order.size() == items.size())) {
+        bool same = true;
+        for (size_t row = 0; row < items.size(); ++row) {
+            if (m_items[m_order[row]].get() != items[row].get()) {
+                same = false;
+                break;
+            }
+        }
+        if (same) {
+            return true;
+        }
+    }
+
+    m_order_dirty = true;
+    if (items.size() != m_slot_of.size()) {
+        return false;
+    }
+    m_order.resize(items.size());
+    for (size_t row = 0; row < items.size(); ++row) {
+        const auto found = m_slot_of.find(items[row].get());
+        if (found == m_slot_of.end()) {
+            return false;
+        }
+        m_order[row] = found->second;
+    }
+    m_order_dirty = false;
+    return true;
+}
+
+std::optional<FilterIndex::RowMask> FilterIndex::Scan(
+    const Items &items,
+    const std::vector<FilterState> &states,
+    const std::vector<qsizetype> &active_filters) const
+{
+    if (!Bind(items)) {
+        return std::nullopt;
+    }
+
+    // Slot-space mask first: every column is dense by slot, so each filter
+    // is one sequential pass over its column. Released slots start cleared.
+    const size_t capacity = m_items.size();
+    RowMask slots(WordCount(capacity), 0);
+    for (size_t slot = 0; slot < capacity; ++slot) {
+        if (m_items[slot]) {
+            AssignBit(slots, slot, true);
+        }
+    }
+
+    for (const qsizetype index : active_filters) {
+        const ColumnRef &ref = m_refs.at(static_cast<size_t>(index));
+        const FilterState &state = states.at(static_cast<size_t>(index));
+        switch (ref.kind) {
+        case ColumnKind::None:
+            break;
+        case ColumnKind::MinMax: {
+            MinMaxColumn &column = m_minmax[ref.column];
+            Materialize(column);
+            const auto &minmax = std::get<MinMaxState>(state);
+            const bool has_min = minmax.min.has_value();
+            const bool has_max = minmax.max.has_value();
+            const float min = has_min ? static_cast<float>(*minmax.min) : 0.0f;
+            const float max = has_max ? static_cast<float>(*minmax.max) : 0.0f;
+            for (size_t word = 0; word < slots.size(); ++word) {
+                if (slots[word] == 0) {
+                    continue;
+                }
+                const size_t base = word * kWordBits;
+                const size_t end = std::min(base + kWordBits, capacity);
+                std::uint64_t pass = 0;
+                std::uint64_t tie = 0;
+                for (size_t slot = base; slot < end; ++slot) {
+                    const float value = column.values[slot];
+                    // A tie is equality after rounding, or NaN on either side.
+                    const bool min_pass = !has_min || (value > min);
+                    const bool min_tie = !min_pass && !(value < min);
+                    const bool max_pass = !has_max || (value < max);
+                    const bool max_tie = !max_pass && !(value > max);
+                    const auto shift = slot - base;
+                    pass |= std::uint64_t{min_pass && max_pass} << shift;
+                    tie |= std::uint64_t{(min_pass || min_tie) && (max_pass || max_tie)
+                                         && !(min_pass && max_pass)}
+                           << shift;
+                }
+                const std::uint64_t present = column.present[word];
+                slots[word] &= present & (pass | tie);
+                std::uint64_t recheck = slots[word] & tie;
+                while (recheck != 0) {
+                    const int bit = std::countr_zero(recheck);
+                    recheck &= recheck - 1;
+                    const Item &item = *m_items[base + static_cast<size_t>(bit)];
+                    if (!matches(item, minmax, *column.payload)) {
+                        slots[word] &= ~(std::uint64_t{1} << bit);
+                    }
+                }
+            }
+            break;
+        }
+        case ColumnKind::Bool: {
+            // An active BoolState is a checked one: the predicate must hold.
+            BoolColumn &column = m_bool[ref.column];
+            Materialize(column);
+            for (size_t word = 0; word < slots.size(); ++word) {
+                slots[word] &= column.bits[word];
+            }
+            break;
+        }
+        case ColumnKind::Combo: {
+            ComboColumn &column = m_combo[ref.column];
+            Materialize(column);
+            const auto &combo = std::get<ComboState>(state);
+            std::vector<char> accepted(column.representatives.size());
+            for (size_t code = 0; code < accepted.size(); ++code) {
+                accepted[code] = matches(*column.representatives[code], combo, *column.payload);
+            }
+            AndAcceptedCodes(slots, column.codes, accepted);
+            break;
+        }
+        case ColumnKind::Text: {
+            TextColumn &column = m_text[ref.column];
+            Materialize(column);
+            const QString query = std::get<TextState>(state).query.toLower();
+            AndAcceptedCodes(slots, column.codes, AcceptedCodes(column, query));
+            break;
+        }
+        }
+    }
+
+    // Gather into the caller's row order.
+    RowMask rows(WordCount(items.size()), 0);
+    for (size_t row = 0; row < items.size(); ++row) {
+        if (Test(slots, m_order[row])) {
+            AssignBit(rows, row, true);
+        }
+    }
+    return rows;
+}
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "fetchsourcekey.h"
+#include "filters/filterspec.h"
+#include "filters/filterstate.h"
+#include "item.h"
+
+// A columnar side index over the published collection for the refilter's
+// hot loop. The per-item path pays a std::visit and a std::function call
+// per item per active filter, plus a pointer chase into each Item; at a
+// million items a broad filter spends nearly all of its time there. The
+// index evaluates every item-derived payload once per item and stores the
+// results densely: a float column plus a presence bitset per MinMaxPayload,
+// a bitset per indexable BoolPayload, an interned code per ComboPayload,
+// and an interned case-folded string per indexable TextPayload, with a
+// trigram posting list over the distinct strings. A refilter then ANDs one
+// row mask per active indexed filter; socket-color and mod filters, the tab
+// filter, and the buyout-backed Priced flag, which no item snapshot can
+// answer, stay per-item for the caller.
+//
+// Columns materialize on the first scan that needs them — that scan pays
+// the one per-item pass the old loop paid for the filter anyway — and are
+// maintained from then on. Eagerly evaluating every payload at each
+// snapshot would put a whole-catalog pass over a million items on the UI
+// thread for filters most users never touch.
+//
+// Maintenance mirrors SourceKeyedItems: ResetTo at the snapshot boundary,
+// ReplaceSource per delta, EraseSourcesIf per child reconciliation. Rows
+// live in slots that a delta recycles, so a patch is O(replaced + delta).
+// The published flat vector's order is not the slot order (the snapshot is
+// sorted by name, the delta rebuild by source key), so Scan binds the
+// caller's vector to slots and answers in the caller's order; a vector the
+// index does not hold exactly gets nullopt and the caller falls back to the
+// per-item path — a divergence can cost speed, never correctness.
+class FilterIndex
+{
+public:
+    // Bit i answers row i of the vector given to Scan.
+    using RowMask = std::vector<std::uint64_t>;
+
+    explicit FilterIndex(const FilterCatalog &catalog);
+
+    void ResetTo(const Items &items);
+    void ReplaceSource(const FetchSourceKey &key, const Items &items);
+
+    // Drops whole sources matching pred(key, representative location), with
+    // SourceKeyedItems::EraseSourcesIf's signature and homogeneity invariant.
+    template<typename Pred>
+    void EraseSourcesIf(Pred pred)
+    {
+        for (auto it = m_source_slots.begin(); it != m_source_slots.end();) {
+            if (pred(it->first, m_items[it->second.front()]->location())) {
+                ReleaseSlots(it->second);
+                it = m_source_slots.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // True when the filter at this catalog index is answered by Scan.
+    bool Indexes(qsizetype spec_index) const;
+
+    // The row mask of `items` passing every active filter this index
+    // answers (the others are the caller's), or nullopt when `items` is not
+    // exactly the indexed collection. MinMax columns are float, but the
+    // result is exact: rounding to float is monotonic, so a float comparison
+    // that is strict decides the double one, and the rare tie (or NaN) is
+    // re-tested through the payload itself.
+    std::optional<RowMask> Scan(const Items &items,
+                                const std::vector<FilterState> &states,
+                                const std::vector<qsizetype> &active_filters) const;
+
+    static bool Test(const RowMask &mask, size_t row)
+    {
+        return (mask[row / 64] >> (row % 64)) & 1U;
+    }
+
+    size_t size() const { return m_slot_of.size(); }
+
+private:
+    enum class ColumnKind { None, MinMax, Bool, Combo, Text };
+    struct ColumnRef
+    {
+        ColumnKind kind{ColumnKind::None};
+        size_t column{0};
+    };
+
+    struct MinMaxColumn
+    {
+        const MinMaxPayload *payload;
+        bool materialized{false};
+        std::vector<float> values;
+        std::vector<std::uint64_t> present;
+    };
+    struct BoolColumn
+    {
+        const BoolPayload *payload;
+        bool materialized{false};
+        std::vector<std::uint64_t> bits;
+    };
+    // Codes intern the one attribute the combo matcher reads (category or
+    // frame type); a representative item per code lets Scan run the real
+    // matcher once per distinct code instead of re-deriving its rules.
+    struct ComboColumn
+    {
+        const ComboPayload *payload;
+        bool materialized{false};
+        std::vector<std::uint32_t> codes;
+        QHash<QString, std::uint32_t> dictionary;
+        Items representatives;
+    };
+    // Codes intern the case-folded value, folded exactly as the text
+    // matcher folds it; a query tests each distinct string once. Postings
+    // map each trigram (three UTF-16 units) to the ascending codes whose
+    // string contains it, so a query of three or more units only tests the
+    // strings holding all of its trigrams. Strings are kept until the next
+    // snapshot, like combo codes, so a posting list only ever appends.
+    struct TextColumn
+    {
+        const TextPayload *payload;
+        bool materialized{false};
+        std::vector<std::uint32_t> codes;
+        QHash<QString, std::uint32_t> dictionary;
+        std::vector<QString> strings;
+        std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> postings;
+    };
+
+    std::uint32_t AcquireSlot();
+    void ReleaseSlots(const std::vector<std::uint32_t> &slots);
+    void WriteSlot(std::uint32_t slot, const std::shared_ptr<Item> &item);
+    void AppendSource(const FetchSourceKey &key, const Items &items);
+    bool Bind(const Items &items) const;
+
+    void WriteCell(MinMaxColumn &column, std::uint32_t slot) const;
+    void WriteCell(BoolColumn &column, std::uint32_t slot) const;
+    void WriteCell(ComboColumn &column, std::uint32_t slot) const;
+    void WriteCell(TextColumn &column, std::uint32_t slot) const;
+    static std::vector<char> AcceptedCodes(const TextColumn &column, const QString &query);
+    template<typename Column>
+    void Materialize(Column &column) const;
+
+    // Columns point at their payloads in the catalog, which MainWindow owns
+    // and which outlives the index. Mutable so a const Scan can materialize
+    // them, like SourceKeyedItems' lazily rebuilt flat view.
+    std::vector<ColumnRef> m_refs;
+    mutable std::vector<MinMaxColumn> m_minmax;
+    mutable std::vector<BoolColumn> m_bool;
+    mutable std::vector<ComboColumn> m_combo;
+    mutable std::vector<TextColumn> m_text;
+
+    // Slot storage. A released slot holds a null item until reused.
+    Items m_items;
+    std::vector<std::uint32_t> m_free_slots;
+    std::unordered_map<const Item *, std::uint32_t> m_slot_of;
+    std::map<FetchSourceKey, std::vector<std::uint32_t>> m_source_slots;
+
+    // The caller's row order bound to slots by the last Scan, re-derived
+    // only after a mutation or when the caller's vector changed; otherwise
+    // rebinding is one sequential pointer comparison per row.
+    mutable std::vector<std::uint32_t> m_order;
+    mutable bool m_order_dirty{true};
+};
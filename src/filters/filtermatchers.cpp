@@ -12,6 +12,7 @@
 
 #include "item.h"
 #include "itemconstants.h"
+#include "modlist.h"
 
 bool MatchesAltart(const Item &item)
 {
@@ -257,12 +258,13 @@ bool matches(const Item &item, const ModsState &state, const ModsPayload &)
             continue;
         }
 
-        const ModTable &modTable = item.mod_table();
-        if (!modTable.count(row.mod)) {
+        const ModifierId id = row.id ? *row.id : modifier_id(row.mod);
+        const auto found = item.mod_table().value(id);
+        if (!found) {
             return false;
         }
 
-        const double value = modTable.at(row.mod);
+        const double value = *found;
         if (row.min.has_value() && value < *row.min) {
             return false;
         }
@@ -34,10 +34,12 @@ FilterCatalog BuildFilterCatalog(const BuyoutManager &buyoutManager)
         [](const char *caption, FilterGroup group, std::function<bool(const Item &)> predicate) {
             return FilterSpec{caption, group, Immediate, BoolPayload{std::move(predicate)}};
         };
-    const auto text =
-        [](const char *caption, FilterGroup group, std::function<QString(const Item &)> value) {
-            return FilterSpec{caption, group, Debounced, TextPayload{std::move(value)}};
-        };
+    const auto text = [](const char *caption,
+                         FilterGroup group,
+                         std::function<QString(const Item &)> value,
+                         bool indexable = true) {
+        return FilterSpec{caption, group, Debounced, TextPayload{std::move(value), indexable}};
+    };
     const auto combo = [](const char *caption,
                           FilterGroup group,
                           ComboMatchKind matchKind,
@@ -59,42 +61,36 @@ FilterCatalog BuildFilterCatalog(const BuyoutManager &buyoutManager)
                           Debounced,
                           MinMaxPayload{std::move(value), std::move(present)}};
     };
+    // The numeric payloads read Item::numbers(), parsed once per item,
+    // rather than the property and requirement strings.
     const auto simpleProperty =
-        [&minMax](const char *property, const char *caption, FilterGroup group) {
-            const QString propertyName = QString::fromUtf8(property);
+        [&minMax](ItemNumbers::Property property, const char *caption, FilterGroup group) {
             return minMax(
                 caption,
                 group,
-                [propertyName](const Item &item) {
-                    return item.properties().at(propertyName).toDouble();
-                },
-                [propertyName](const Item &item) { return item.properties().count(propertyName); });
+                [property](const Item &item) { return item.numbers().value(property); },
+                [property](const Item &item) { return item.numbers().has(property); });
         };
-    const auto defaultProperty = [&minMax](const char *property,
+    const auto defaultProperty = [&minMax](ItemNumbers::Property property,
                                            const char *caption,
                                            FilterGroup group,
                                            double defaultValue) {
-        const QString propertyName = QString::fromUtf8(property);
         return minMax(
             caption,
             group,
-            [propertyName, defaultValue](const Item &item) {
-                const auto &properties = item.properties();
-                const auto found = properties.find(propertyName);
-                return found == properties.end() ? defaultValue : found->second.toDouble();
+            [property, defaultValue](const Item &item) {
+                const ItemNumbers &numbers = item.numbers();
+                return numbers.has(property) ? numbers.value(property) : defaultValue;
             },
             [](const Item &) { return true; });
     };
     const auto requiredStat =
-        [&minMax](const char *property, const char *caption, FilterGroup group) {
-            const QString propertyName = QString::fromUtf8(property);
+        [&minMax](ItemNumbers::Requirement requirement, const char *caption, FilterGroup group) {
             return minMax(
                 caption,
                 group,
-                [propertyName](const Item &item) {
-                    const auto &requirements = item.requirements();
-                    const auto found = requirements.find(propertyName);
-                    return found == requirements.end() ? 0.0 : static_cast<double>(found->second);
+                [requirement](const Item &item) {
+                    return static_cast<double>(item.numbers().requirement(requirement));
                 },
                 [](const Item &) { return true; });
         };
@@ -106,9 +102,11 @@ FilterCatalog BuildFilterCatalog(const BuyoutManager &buyoutManager)
 
     std::vector<FilterSpec> specs;
     specs.reserve(38);
-    specs.push_back(text("Tab", FilterGroup::TopForm, [](const Item &item) {
-        return item.location().GetHeader();
-    }));
+    specs.push_back(text(
+        "Tab",
+        FilterGroup::TopForm,
+        [](const Item &item) { return item.location().GetHeader(); },
+        false));
     specs.push_back(
         text("Name", FilterGroup::TopForm, [](const Item &item) { return item.PrettyName(); }));
     specs.push_back(combo("Category", FilterGroup::TopForm, ComboMatchKind::CategoryContains, [] {
@@ -121,7 +119,8 @@ FilterCatalog BuildFilterCatalog(const BuyoutManager &buyoutManager)
     specs.push_back(combo("Rarity", FilterGroup::TopForm, ComboMatchKind::Rarity, [] {
         return RarityChoices();
     }));
-    specs.push_back(simpleProperty("Critical Strike Chance", "Crit.", FilterGroup::Offense));
+    specs.push_back(
+        simpleProperty(ItemNumbers::CriticalStrikeChance, "Crit.", FilterGroup::Offense));
     specs.push_back(
         itemMethod("DPS", FilterGroup::Offense, [](const Item &item) { return item.DPS(); }));
     specs.push_back(
@@ -130,11 +129,11 @@ FilterCatalog BuildFilterCatalog(const BuyoutManager &buyoutManager)
         itemMethod("eDPS", FilterGroup::Offense, [](const Item &item) { return item.eDPS(); }));
     specs.push_back(
         itemMethod("cDPS", FilterGroup::Offense, [](const Item &item) { return item.cDPS(); }));
-    specs.push_back(simpleProperty("Attacks per Second", "APS", FilterGroup::Offense));
-    specs.push_back(simpleProperty("Armour", "Armour", FilterGroup::Defense));
-    specs.push_back(simpleProperty("Evasion Rating", "Evasion", FilterGroup::Defense));
-    specs.push_back(simpleProperty("Energy Shield", "Shield", FilterGroup::Defense));
-    specs.push_back(simpleProperty("Chance to Block", "Block", FilterGroup::Defense));
+    specs.push_back(simpleProperty(ItemNumbers::AttacksPerSecond, "APS", FilterGroup::Offense));
+    specs.push_back(simpleProperty(ItemNumbers::Armour, "Armour", FilterGroup::Defense));
+    specs.push_back(simpleProperty(ItemNumbers::EvasionRating, "Evasion", FilterGroup::Defense));
+    specs.push_back(simpleProperty(ItemNumbers::EnergyShield, "Shield", FilterGroup::Defense));
+    specs.push_back(simpleProperty(ItemNumbers::ChanceToBlock, "Block", FilterGroup::Defense));
     specs.push_back(itemMethod("Sockets", FilterGroup::Sockets, [](const Item &item) {
         return item.sockets_cnt();
     }));
@@ -143,19 +142,24 @@ FilterCatalog BuildFilterCatalog(const BuyoutManager &buyoutManager)
     }));
     specs.push_back(colors("Colors", ColorsMatchKind::Sockets));
     specs.push_back(colors("Linked", ColorsMatchKind::Links));
-    specs.push_back(requiredStat("Level", "R. Level", FilterGroup::Requirements));
-    specs.push_back(requiredStat("Str", "R. Str", FilterGroup::Requirements));
-    specs.push_back(requiredStat("Dex", "R. Dex", FilterGroup::Requirements));
-    specs.push_back(requiredStat("Int", "R. Int", FilterGroup::Requirements));
-    specs.push_back(defaultProperty("Quality", "Quality", FilterGroup::Misc, 0.0));
-    specs.push_back(simpleProperty("Level", "Level", FilterGroup::Misc));
-    specs.push_back(simpleProperty("Map Tier", "Map Tier", FilterGroup::Misc));
+    specs.push_back(
+        requiredStat(ItemNumbers::RequiredLevel, "R. Level", FilterGroup::Requirements));
+    specs.push_back(requiredStat(ItemNumbers::RequiredStr, "R. Str", FilterGroup::Requirements));
+    specs.push_back(requiredStat(ItemNumbers::RequiredDex, "R. Dex", FilterGroup::Requirements));
+    specs.push_back(requiredStat(ItemNumbers::RequiredInt, "R. Int", FilterGroup::Requirements));
+    specs.push_back(defaultProperty(ItemNumbers::Quality, "Quality", FilterGroup::Misc, 0.0));
+    specs.push_back(simpleProperty(ItemNumbers::Level, "Level", FilterGroup::Misc));
+    specs.push_back(simpleProperty(ItemNumbers::MapTier, "Map Tier", FilterGroup::Misc));
     specs.push_back(
         itemMethod("ilvl", FilterGroup::Misc, [](const Item &item) { return item.ilvl(); }));
     specs.push_back(boolean("Alt. art", FilterGroup::MiscFlags, MatchesAltart));
-    specs.push_back(boolean("Priced", FilterGroup::MiscFlags, [&buyoutManager](const Item &item) {
-        return buyoutManager.Get(item).IsActive();
-    }));
+    specs.push_back(FilterSpec{"Priced",
+                               FilterGroup::MiscFlags,
+                               Immediate,
+                               BoolPayload{[&buyoutManager](const Item &item) {
+                                               return buyoutManager.Get(item).IsActive();
+                                           },
+                                           false}});
     specs.push_back(boolean("Unidentified", FilterGroup::MiscFlags2, [](const Item &item) {
         return !item.identified();
     }));
@@ -31,6 +31,9 @@ inline const QString kAnyFilterChoice = QStringLiteral("<any>");
 struct TextPayload
 {
     std::function<QString(const Item &)> value;
+    // False when the value reads state a tab-list reconciliation rebases in
+    // place (the tab header), which FilterIndex must not snapshot.
+    bool indexable = true;
 };
 
 enum class ComboMatchKind { CategoryContains, Rarity };
@@ -50,6 +53,9 @@ struct MinMaxPayload
 struct BoolPayload
 {
     std::function<bool(const Item &)> predicate;
+    // False when the predicate reads state the item does not own (buyouts),
+    // which FilterIndex must not snapshot.
+    bool indexable = true;
 };
 
 enum class ColorsMatchKind { Sockets, Links };
@@ -5,6 +5,7 @@
 
 #include "filters/filterspec.h"
 
+#include <algorithm>
 #include <type_traits>
 
 bool IsActive(const FilterState &state)
@@ -33,3 +34,90 @@ FilterState MakeDefaultState(const FilterSpec &spec)
         },
         spec.payload);
 }
+
+namespace {
+
+    // Both bounds of `inner` lie within `outer`'s; a missing bound is
+    // unbounded. NaN bounds compare false and stay unproven.
+    bool Within(const std::optional<double> &inner_min,
+                const std::optional<double> &inner_max,
+                const std::optional<double> &outer_min,
+                const std::optional<double> &outer_max)
+    {
+        const bool min_ok = !outer_min || (inner_min && (*inner_min >= *outer_min));
+        const bool max_ok = !outer_max || (inner_max && (*inner_max <= *outer_max));
+        return min_ok && max_ok;
+    }
+
+    // The matchers are monotonic in each of these: a longer query, a
+    // tighter range, more required sockets, or an extra mod row can only
+    // reject more. Each answers whether `after` accepts a subset of what
+    // `before` accepted. An inactive state accepts everything, so it is
+    // the top of every order.
+    bool Narrows(const TextState &before, const TextState &after)
+    {
+        return after.query.toLower().contains(before.query.toLower());
+    }
+
+    bool Narrows(const ComboState &before, const ComboState &after)
+    {
+        return !before.isActive() || (before == after);
+    }
+
+    bool Narrows(const MinMaxState &before, const MinMaxState &after)
+    {
+        return Within(after.min, after.max, before.min, before.max);
+    }
+
+    bool Narrows(const ColorsState &before, const ColorsState &after)
+    {
+        if (!before.isActive()) {
+            return true;
+        }
+        if (!after.isActive()) {
+            return false;
+        }
+        return (after.r.value_or(0) >= before.r.value_or(0))
+               && (after.g.value_or(0) >= before.g.value_or(0))
+               && (after.b.value_or(0) >= before.b.value_or(0));
+    }
+
+    bool Narrows(const BoolState &before, const BoolState &after)
+    {
+        return !before.checked || after.checked;
+    }
+
+    // Mod rows AND together and blank rows are skipped, so every row of
+    // `before` reappearing in `after` means `after` only adds constraints.
+    bool Narrows(const ModsState &before, const ModsState &after)
+    {
+        for (const auto &row : before.rows) {
+            if (!row.mod.isEmpty()
+                && (std::find(after.rows.begin(), after.rows.end(), row) == after.rows.end())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+FilterEdit ClassifyFilterEdit(const FilterState &before, const FilterState &after)
+{
+    if (before.index() != after.index()) {
+        return FilterEdit::Unknown;
+    }
+    return std::visit(
+        [&after](const auto &from) {
+            using State = std::decay_t<decltype(from)>;
+            const auto &to = std::get<State>(after);
+            if (Narrows(from, to)) {
+                return FilterEdit::Narrowing;
+            }
+            if (Narrows(to, from)) {
+                return FilterEdit::Widening;
+            }
+            return FilterEdit::Unknown;
+        },
+        before);
+}
@@ -6,9 +6,12 @@
 #include <QString>
 
 #include <optional>
+#include <tuple>
 #include <variant>
 #include <vector>
 
+#include "modtable.h"
+
 struct FilterSpec;
 
 // Every state is comparable: Search uses equality to tell whether a save
@@ -58,7 +61,15 @@ struct ModRow
     QString mod;
     std::optional<double> min;
     std::optional<double> max;
-    bool operator==(const ModRow &) const = default;
+    // The dictionary id of `mod`, derived from it when Search stores the
+    // state, so the matcher does no string lookup per item. Unset on rows
+    // nobody resolved (the matcher then looks the id up itself); never part
+    // of equality.
+    std::optional<ModifierId> id;
+    bool operator==(const ModRow &other) const
+    {
+        return std::tie(mod, min, max) == std::tie(other.mod, other.min, other.max);
+    }
 };
 
 struct ModsState
@@ -73,3 +84,11 @@ using FilterState
 
 bool IsActive(const FilterState &state);
 FilterState MakeDefaultState(const FilterSpec &spec);
+
+// How an edit moves a filter's accepted set, decided from the two states
+// alone: Narrowing when everything the new state accepts the old one
+// accepted too, Widening for the converse, Unknown when neither follows
+// from the states (a combo switching values, a mod row's bounds moving).
+// Search refilters a one-directional edit as row operations.
+enum class FilterEdit { Narrowing, Widening, Unknown };
+FilterEdit ClassifyFilterEdit(const FilterState &before, const FilterState &after);
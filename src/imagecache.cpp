@@ -5,72 +5,207 @@
 
 #include <QCryptographicHash>
 #include <QDir>
-#include <QFile>
-#include <QImageReader>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QSaveFile>
 #include <QString>
 
+#include <algorithm>
+
 #include "util/networkmanager.h"
 #include "util/spdlog_qt.h"
 #include "util/util.h"
 
-ImageCache::ImageCache(NetworkManager &network_manager, const QString &directory)
+// Icon decodes are small; a second thread keeps one slow read from holding
+// up the rest of a prefetch.
+constexpr int DECODE_THREADS = 2;
+
+namespace {
+
+    int costOf(const QImage &image)
+    {
+        return std::max<int>(1, static_cast<int>(image.sizeInBytes() / 1024));
+    }
+
+} // namespace
+
+ImageCache::ImageCache(NetworkManager &network_manager,
+                       const QString &directory,
+                       qint64 memory_budget)
     : m_network_manager(network_manager)
     , m_directory(directory)
 {
     if (!QDir(m_directory).exists()) {
         QDir().mkpath(m_directory);
     }
+    m_memory.setMaxCost(static_cast<qsizetype>(std::max<qint64>(1, memory_budget / 1024)));
+    m_decode_pool.setMaxThreadCount(DECODE_THREADS);
+
+    const QStringList files = QDir(m_directory).entryList({"*.png"}, QDir::Files);
+    m_on_disk.reserve(files.size());
+    for (const QString &file : files) {
+        m_on_disk.insert(file.chopped(4));
+    }
+    spdlog::debug("ImageCache: {} images on disk in {}", m_on_disk.size(), m_directory);
+}
+
+ImageCache::~ImageCache()
+{
+    m_decode_pool.clear();
 }
 
 bool ImageCache::contains(const QString &url) const
 {
-    const QString filename = getImagePath(url);
-    const QFile file(filename);
-    return file.exists();
+    const QString key = Util::Md5(url);
+    return m_memory.contains(key) || m_on_disk.contains(key);
 }
 
 void ImageCache::fetch(const QString &url)
 {
-    if (contains(url)) {
+    const QString key = Util::Md5(url);
+    if (m_memory.contains(key)) {
         spdlog::debug("ImageCache: already contains {}", url);
         emit imageReady(url);
+    } else if (m_pending.contains(key)) {
+        // Already on its way. A queued download moves to the front: this
+        // is now the image on screen.
+        spdlog::debug("ImageCache: already fetching {}", url);
+        for (auto *queue : {&m_fetch_queue, &m_prefetch_queue}) {
+            const auto it = std::find(queue->begin(), queue->end(), url);
+            if (it != queue->end()) {
+                queue->erase(it);
+                m_fetch_queue.push_front(url);
+                break;
+            }
+        }
+    } else if (m_on_disk.contains(key)) {
+        decode(url, key);
     } else {
+        m_pending.insert(key);
+        m_fetch_queue.push_front(url);
+        startDownloads();
+    }
+}
+
+void ImageCache::prefetch(const QStringList &urls)
+{
+    // The rows a previous prefetch was for are behind the user now: its
+    // downloads that have not started give way to these.
+    for (const QString &url : m_prefetch_queue) {
+        m_pending.remove(Util::Md5(url));
+    }
+    m_prefetch_queue.clear();
+
+    for (const QString &url : urls) {
+        const QString key = Util::Md5(url);
+        if (m_memory.contains(key) || m_pending.contains(key)) {
+            continue;
+        }
+        if (m_on_disk.contains(key)) {
+            decode(url, key);
+        } else {
+            m_pending.insert(key);
+            m_prefetch_queue.push_back(url);
+        }
+    }
+    startDownloads();
+}
+
+void ImageCache::startDownloads()
+{
+    while (m_downloads < MAX_DOWNLOADS) {
+        auto &queue = m_fetch_queue.empty() ? m_prefetch_queue : m_fetch_queue;
+        if (queue.empty()) {
+            return;
+        }
+        const QString url = queue.front();
+        queue.pop_front();
+
         spdlog::debug("ImageCache: fetching {}", url);
-        QNetworkRequest request = QNetworkRequest(QUrl(url));
-        QNetworkReply *reply = m_network_manager.get(request);
-        connect(reply, &QNetworkReply::finished, this, &ImageCache::onFetched);
+        ++m_downloads;
+        QNetworkReply *reply = m_network_manager.get(QNetworkRequest(QUrl(url)));
+        connect(reply, &QNetworkReply::finished, this, [this, reply, url]() {
+            onFetched(reply, url, Util::Md5(url));
+        });
     }
 }
 
-void ImageCache::onFetched()
+void ImageCache::onFetched(QNetworkReply *reply, const QString &url, const QString &key)
 {
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    const QString url = reply->url().toString();
+    reply->deleteLater();
+    --m_downloads;
     if (reply->error() != QNetworkReply::NoError) {
         spdlog::error("ImageCache: failed to fetch image: {}: {}", reply->errorString(), url);
-        return;
+        m_pending.remove(key);
+    } else {
+        spdlog::debug("ImageCache: fetched {}", url);
+        // The reply is decoded and saved on the pool, like a disk read.
+        m_decode_pool.start([this, url, key, path = getImagePath(key), bytes = reply->readAll()]() {
+            QImage image;
+            image.loadFromData(bytes);
+            bool saved = false;
+            if (!image.isNull()) {
+                QSaveFile file(path);
+                saved = file.open(QIODevice::WriteOnly) && image.save(&file, "PNG")
+                        && file.commit();
+            }
+            QMetaObject::invokeMethod(
+                this,
+                [this, url, key, image, saved]() { onDecoded(url, key, image, saved); },
+                Qt::QueuedConnection);
+        });
     }
-    spdlog::debug("ImageCatch: fetched {}", url);
-    QImageReader image_reader(reply);
-    const QImage image = image_reader.read();
-    image.save(getImagePath(url));
-    emit imageReady(url);
+    startDownloads();
 }
 
-QImage ImageCache::load(const QString &url) const
+QImage ImageCache::load(const QString &url)
 {
-    const QString filename = getImagePath(url);
-    const QFile file(filename);
-    if (file.exists()) {
-        return QImage(getImagePath(url));
-    } else {
+    const QString key = Util::Md5(url);
+    if (const QImage *image = m_memory.object(key)) {
+        return *image;
+    }
+    if (!m_on_disk.contains(key)) {
         return QImage();
     }
+    const QImage image(getImagePath(key));
+    if (!image.isNull()) {
+        m_memory.insert(key, new QImage(image), costOf(image));
+    }
+    return image;
+}
+
+void ImageCache::decode(const QString &url, const QString &key)
+{
+    m_pending.insert(key);
+    m_decode_pool.start([this, url, key, path = getImagePath(key)]() {
+        const QImage image(path);
+        QMetaObject::invokeMethod(
+            this,
+            [this, url, key, image]() { onDecoded(url, key, image, true); },
+            Qt::QueuedConnection);
+    });
+}
+
+void ImageCache::onDecoded(const QString &url, const QString &key, const QImage &image, bool saved)
+{
+    m_pending.remove(key);
+    if (image.isNull()) {
+        // Unreadable on disk, or not an image on the wire: forget the file
+        // so the next fetch downloads it again.
+        spdlog::warn("ImageCache: could not decode {}", url);
+        m_on_disk.remove(key);
+        return;
+    }
+    if (saved) {
+        m_on_disk.insert(key);
+    } else {
+        spdlog::warn("ImageCache: could not save {}", getImagePath(key));
+    }
+    m_memory.insert(key, new QImage(image), costOf(image));
+    emit imageReady(url);
 }
 
-QString ImageCache::getImagePath(const QString &url) const
+QString ImageCache::getImagePath(const QString &key) const
 {
-    return m_directory + QDir::separator() + Util::Md5(url) + ".png";
+    return m_directory + QDir::separator() + key + ".png";
 }
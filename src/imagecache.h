@@ -3,29 +3,87 @@
 
 #pragma once
 
+#include <QCache>
 #include <QImage>
 #include <QObject>
+#include <QSet>
 #include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <deque>
 
 class QNetworkReply;
 
 class NetworkManager;
 
+// Item icons, kept on disk as <md5 of url>.png and, decoded, in a bounded
+// in-memory LRU keyed the same way. Reading, decoding, and saving run on a
+// private pool, so the UI thread only ever touches decoded QImages. The
+// directory is listed once at construction and the index is kept current
+// by the cache's own writes, so a lookup never stats the disk.
+//
+// Downloads are coalesced per URL (one request however many fetches ask
+// for it; every asker is answered by the one imageReady) and at most
+// MAX_DOWNLOADS run at once. The rest wait in two queues: fetched images,
+// newest first, since the newest is the item on screen, and then
+// prefetched ones in the order asked. Files are written to a temporary and
+// renamed into place, so a reader never sees a partial image.
 class ImageCache : public QObject
 {
     Q_OBJECT
 public:
-    explicit ImageCache(NetworkManager &network_manager, const QString &directory);
+    // About a thousand inventory-sized icons.
+    static constexpr qint64 DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+    static constexpr int MAX_DOWNLOADS = 4;
+
+    explicit ImageCache(NetworkManager &network_manager,
+                        const QString &directory,
+                        qint64 memory_budget = DEFAULT_MEMORY_BUDGET);
+    ~ImageCache();
+
+    // True when the image is in memory or on disk.
     bool contains(const QString &url) const;
-    QImage load(const QString &url) const;
+
+    // The decoded image: from memory, or read from disk on the calling
+    // thread when it has been evicted since imageReady. Null when the image
+    // has not been fetched.
+    QImage load(const QString &url);
+
 public slots:
+    // Emits imageReady once the image is in memory: at once when it
+    // already is, after a background decode when it is on disk, and after
+    // the download otherwise.
     void fetch(const QString &url);
-    void onFetched();
+
+    // Starts background decodes of the on-disk images among `urls`, and
+    // queues downloads of the rest behind every fetch, so a later fetch of
+    // a nearby row finds them in memory. Each one emits imageReady when it
+    // lands.
+    void prefetch(const QStringList &urls);
+
 signals:
     void imageReady(const QString &url);
 
 private:
-    QString getImagePath(const QString &url) const;
+    QString getImagePath(const QString &key) const;
+    void decode(const QString &url, const QString &key);
+    void startDownloads();
+    void onFetched(QNetworkReply *reply, const QString &url, const QString &key);
+    void onDecoded(const QString &url, const QString &key, const QImage &image, bool saved);
+
     NetworkManager &m_network_manager;
     QString m_directory;
+
+    QSet<QString> m_on_disk;          // keys with a file in m_directory
+    QSet<QString> m_pending;          // keys queued, downloading, or decoding
+    QCache<QString, QImage> m_memory; // costs in KiB
+
+    std::deque<QString> m_fetch_queue;    // urls, newest first
+    std::deque<QString> m_prefetch_queue; // urls, oldest first
+    int m_downloads{0};
+
+    // Destroyed first: its destructor waits out any running decode, whose
+    // completion is queued to this object and dropped with it.
+    QThreadPool m_decode_pool;
 };
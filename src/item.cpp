@@ -17,6 +17,7 @@
 #include "modlist.h"
 #include "poe/types/displaymode.h"
 #include "poe/types/item.h"
+#include "util/stringpool.h"
 #include "util/util.h"
 
 const std::array<Item::CategoryReplaceMap, Item::k_CategoryLevels> Item::m_replace_map = {
@@ -117,8 +118,10 @@ Item::Item(const poe::Item &item, const ItemLocation &base_location)
     } else {
         m_typeLine = item.typeLine;
     }
-    m_typeLine = fixup_name(m_typeLine);
-    m_baseType = fixup_name(item.baseType);
+    // The item vocabulary repeats across the collection, so each of these
+    // shares the pooled buffer (see StringPool).
+    m_typeLine = StringPool::Intern(fixup_name(m_typeLine));
+    m_baseType = StringPool::Intern(fixup_name(item.baseType));
     m_identified = item.identified;
 
     if (item.corrupted) {
@@ -144,7 +147,7 @@ Item::Item(const poe::Item &item, const ItemLocation &base_location)
     if (item.frameType) {
         m_frameType = static_cast<int>(*item.frameType);
     }
-    m_frameTypeId = item.frameTypeId;
+    m_frameTypeId = StringPool::Intern(item.frameTypeId);
     m_icon = item.icon;
 
     LoadModifiers(item);
@@ -155,8 +158,10 @@ Item::Item(const poe::Item &item, const ItemLocation &base_location)
 
     // quad stashes, currency stashes, etc
     m_icon.replace("scaleIndex=", "scaleIndex=0&");
+    m_icon = StringPool::Intern(m_icon);
 
     CalculateCategories();
+    m_category = StringPool::Intern(m_category);
 
     if (item.id) {
         m_uid = *item.id;
@@ -177,6 +182,8 @@ Item::Item(const poe::Item &item, const ItemLocation &base_location)
         LoadSockets(*item.sockets);
     }
 
+    CalculateNumbers();
+
     CalculateHash(item);
 
     m_ilvl = item.ilvl;
@@ -421,18 +428,19 @@ void Item::LoadModifiers(const poe::Item &item)
     m_enchanted = (item.enchantMods && !item.enchantMods->empty());
     m_crafted = !craftedMods.empty();
 
-    m_text_mods["enchantMods"] = enchantMods;
-    m_text_mods["implicitMods"] = implicitMods;
-    m_text_mods["fracturedMods"] = fracturedMods;
-    m_text_mods["explicitMods"] = explicitMods;
-    m_text_mods["craftedMods"] = craftedMods;
-    m_text_mods["mutatedMods"] = mutatedMods;
+    m_text_mods[QStringLiteral("enchantMods")] = enchantMods;
+    m_text_mods[QStringLiteral("implicitMods")] = implicitMods;
+    m_text_mods[QStringLiteral("fracturedMods")] = fracturedMods;
+    m_text_mods[QStringLiteral("explicitMods")] = explicitMods;
+    m_text_mods[QStringLiteral("craftedMods")] = craftedMods;
+    m_text_mods[QStringLiteral("mutatedMods")] = mutatedMods;
 
     for (const auto &[name, mods] : m_text_mods) {
         for (const auto &mod : mods) {
             AddModToTable(mod, m_mod_table);
         }
     }
+    m_mod_table.shrink_to_fit();
 }
 
 void Item::LoadProperties(const std::vector<poe::ItemProperty> &properties)
@@ -470,18 +478,21 @@ void Item::LoadProperties(const std::vector<poe::ItemProperty> &properties)
                 const auto n = strval.indexOf("/");
                 m_count = strval.first(n).toInt();
             }
-            m_properties[name] = strval;
+            m_properties[StringPool::Intern(name)] = strval;
         }
 
         ItemProperty property;
-        property.name = name;
+        property.name = StringPool::Intern(name);
         property.display_mode = static_cast<int>(
             prop.displayMode.value_or(poe::DisplayMode::InsertedValues));
+        property.values.reserve(values.size());
         for (const auto &[str, type] : values) {
             property.values.emplace_back(str, type);
         }
-        m_text_properties.push_back(property);
+        m_text_properties.push_back(std::move(property));
     }
+    m_properties.shrink_to_fit();
+    m_text_properties.shrink_to_fit();
 }
 
 void Item::LoadRequirements(const std::vector<poe::ItemProperty> &requirements)
@@ -491,11 +502,13 @@ void Item::LoadRequirements(const std::vector<poe::ItemProperty> &requirements)
         if (values.size() < 1) {
             continue;
         }
-        const auto &name = req.name;
+        const QString name = StringPool::Intern(req.name);
         const auto &[str, type] = values[0];
         m_requirements[name] = str.toInt();
         m_text_requirements.push_back({name, ItemPropertyValue{str, type}});
     }
+    m_requirements.shrink_to_fit();
+    m_text_requirements.shrink_to_fit();
 }
 
 void Item::LoadSockets(const std::vector<poe::ItemSocket> &sockets)
@@ -568,58 +581,61 @@ void Item::CalculateCategories()
     }
 }
 
-double Item::DPS() const
-{
-    return pDPS() + eDPS() + cDPS();
-}
-
-double Item::pDPS() const
+void Item::CalculateNumbers()
 {
-    const auto phys = m_properties.find(QStringLiteral("Physical Damage"));
-    if (phys == m_properties.end()) {
-        return 0;
+    // Indexed by ItemNumbers::Property and ItemNumbers::Requirement.
+    static const std::array<QString, ItemNumbers::PropertyCount> property_names{
+        QStringLiteral("Critical Strike Chance"),
+        QStringLiteral("Attacks per Second"),
+        QStringLiteral("Armour"),
+        QStringLiteral("Evasion Rating"),
+        QStringLiteral("Energy Shield"),
+        QStringLiteral("Chance to Block"),
+        QStringLiteral("Quality"),
+        QStringLiteral("Level"),
+        QStringLiteral("Map Tier")};
+    static const std::array<QString, ItemNumbers::RequirementCount> requirement_names{
+        QStringLiteral("Level"),
+        QStringLiteral("Str"),
+        QStringLiteral("Dex"),
+        QStringLiteral("Int")};
+
+    for (size_t i = 0; i < property_names.size(); ++i) {
+        const auto found = m_properties.find(property_names[i]);
+        if (found != m_properties.end()) {
+            m_numbers.properties[i] = found->second.toDouble();
+            m_numbers.present |= static_cast<std::uint16_t>(1U << i);
+        }
     }
-    const auto aps = m_properties.find(QStringLiteral("Attacks per Second"));
-    if (aps == m_properties.end()) {
-        return 0;
+    for (size_t i = 0; i < requirement_names.size(); ++i) {
+        const auto found = m_requirements.find(requirement_names[i]);
+        if (found != m_requirements.end()) {
+            m_numbers.requirements[i] = found->second;
+        }
     }
-    const double attacks = aps->second.toDouble();
-    const QString hit = phys->second;
-    return attacks * Util::AverageDamage(hit);
-}
 
-double Item::eDPS() const
-{
-    if (m_elemental_damage.empty()) {
-        return 0;
-    }
+    // The DPS family needs an attack rate; without one every term is 0.
     const auto aps = m_properties.find(QStringLiteral("Attacks per Second"));
     if (aps == m_properties.end()) {
-        return 0;
-    }
-    double damage = 0;
-    for (auto &x : m_elemental_damage) {
-        damage += Util::AverageDamage(x.first);
+        return;
     }
     const double attacks = aps->second.toDouble();
-    return attacks * damage;
-}
-
-double Item::cDPS() const
-{
-    const auto chaos = m_properties.find(QStringLiteral("Chaos Damage"));
-    if (chaos == m_properties.end()) {
-        return 0;
+    const auto phys = m_properties.find(QStringLiteral("Physical Damage"));
+    if (phys != m_properties.end()) {
+        m_numbers.pdps = attacks * Util::AverageDamage(phys->second);
     }
-
-    const auto aps = m_properties.find(QStringLiteral("Attacks per Second"));
-    if (aps == m_properties.end()) {
-        return 0;
+    if (!m_elemental_damage.empty()) {
+        double damage = 0;
+        for (auto &x : m_elemental_damage) {
+            damage += Util::AverageDamage(x.first);
+        }
+        m_numbers.edps = attacks * damage;
     }
-    const double attacks = aps->second.toDouble();
-    const QString hit = chaos->second;
-
-    return attacks * Util::AverageDamage(hit);
+    const auto chaos = m_properties.find(QStringLiteral("Chaos Damage"));
+    if (chaos != m_properties.end()) {
+        m_numbers.cdps = attacks * Util::AverageDamage(chaos->second);
+    }
+    m_numbers.dps = m_numbers.pdps + m_numbers.edps + m_numbers.cdps;
 }
 
 void Item::CalculateHash(const poe::Item &json)
@@ -7,15 +7,18 @@
 #include <QString>
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include "itemlocation.h"
+#include "modtable.h"
 #include "poe/types/item.h"
 #include "poe/types/itemproperty.h"
 #include "poe/types/itemsocket.h"
+#include "util/flatmap.h"
 
 namespace poe {
 
@@ -54,7 +57,42 @@ struct ItemSocket
 };
 
 typedef std::vector<QString> ItemMods;
-typedef std::unordered_map<QString, double> ModTable;
+
+// The numbers behind the numeric filters and the DPS columns, derived once
+// at construction from the property and requirement strings. Parsing is the
+// same the per-call accessors did (QString::toDouble, Util::AverageDamage),
+// so every value is identical to what they returned, including the 0 a
+// string like "7.50%" parses to.
+struct ItemNumbers
+{
+    enum Property {
+        CriticalStrikeChance,
+        AttacksPerSecond,
+        Armour,
+        EvasionRating,
+        EnergyShield,
+        ChanceToBlock,
+        Quality,
+        Level,
+        MapTier,
+        PropertyCount
+    };
+    enum Requirement { RequiredLevel, RequiredStr, RequiredDex, RequiredInt, RequirementCount };
+
+    // A property the item does not carry reads 0 and has() is false; a
+    // missing requirement reads 0.
+    bool has(Property property) const { return (present >> property) & 1U; }
+    double value(Property property) const { return properties[property]; }
+    int requirement(Requirement requirement) const { return requirements[requirement]; }
+
+    std::array<double, PropertyCount> properties{};
+    std::array<int, RequirementCount> requirements{};
+    std::uint16_t present{0};
+    double pdps{0};
+    double edps{0};
+    double cdps{0};
+    double dps{0};
+};
 
 class Item
 {
@@ -109,10 +147,10 @@ public:
     int h() const { return m_h; }
     int frameType() const { return m_frameType; }
     const QString &icon() const { return m_icon; }
-    const std::map<QString, QString> &properties() const { return m_properties; }
+    const FlatMap<QString, QString> &properties() const { return m_properties; }
     const std::vector<ItemProperty> &text_properties() const { return m_text_properties; }
     const std::vector<ItemRequirement> &text_requirements() const { return m_text_requirements; }
-    const std::map<QString, ItemMods> &text_mods() const { return m_text_mods; }
+    const FlatMap<QString, ItemMods> &text_mods() const { return m_text_mods; }
     const std::vector<ItemSocket> &text_sockets() const { return m_text_sockets; }
     const QString &hash_v4() const { return m_hash; }
     const QString &old_hash() const { return m_old_hash; }
@@ -120,11 +158,12 @@ public:
     {
         return m_elemental_damage;
     }
-    const std::map<QString, int> &requirements() const { return m_requirements; }
-    double DPS() const;
-    double pDPS() const;
-    double eDPS() const;
-    double cDPS() const;
+    const FlatMap<QString, int> &requirements() const { return m_requirements; }
+    const ItemNumbers &numbers() const { return m_numbers; }
+    double DPS() const { return m_numbers.dps; }
+    double pDPS() const { return m_numbers.pdps; }
+    double eDPS() const { return m_numbers.edps; }
+    double cDPS() const { return m_numbers.cdps; }
     int sockets_cnt() const { return m_sockets_cnt; }
     int links_cnt() const { return m_links_cnt; }
     const ItemSocketGroup &sockets() const { return m_sockets; }
@@ -153,6 +192,7 @@ private:
     void LoadRequirements(const std::vector<poe::ItemProperty> &requirements);
     void LoadSockets(const std::vector<poe::ItemSocket> &sockets);
     void CalculateCategories();
+    void CalculateNumbers();
     void CalculateHash(const poe::Item &json);
 
     QString m_name;
@@ -174,7 +214,7 @@ private:
     int m_frameType{-1};
     QString m_frameTypeId;
     QString m_icon;
-    std::map<QString, QString> m_properties;
+    FlatMap<QString, QString> m_properties;
     QString m_old_hash;
     QString m_hash;
     // vector of pairs [damage, type]
@@ -183,12 +223,13 @@ private:
     int m_links_cnt{0};
     ItemSocketGroup m_sockets{0, 0, 0, 0};
     std::vector<ItemSocketGroup> m_socket_groups;
-    std::map<QString, int> m_requirements;
+    FlatMap<QString, int> m_requirements;
+    ItemNumbers m_numbers;
     int m_count{1};
     int m_ilvl{0};
     std::vector<ItemProperty> m_text_properties;
     std::vector<ItemRequirement> m_text_requirements;
-    std::map<QString, ItemMods> m_text_mods;
+    FlatMap<QString, ItemMods> m_text_mods;
     std::vector<ItemSocket> m_text_sockets;
     QString m_note;
     ModTable m_mod_table;
@@ -41,6 +41,8 @@ public:
 
     ItemLocationType type() const { return m_type; }
     QString tab_label() const { return m_tab_label; }
+    // GGG's stash "type" (e.g. "CurrencyStash"); empty for characters.
+    QString tab_type() const { return m_tab_type; }
     QString character() const { return m_character; }
     bool socketed() const { return m_socketed; }
     bool removeonly() const { return m_removeonly; }
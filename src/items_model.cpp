@@ -3,6 +3,9 @@
 
 #include "items_model.h"
 
+#include <QPointer>
+#include <QThread>
+
 #include "bucket.h"
 #include "buyoutmanager.h"
 #include "itemlocation.h"
@@ -12,20 +15,46 @@
 #include "util/util.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <set>
 #include <vector>
 
+// One background sort: the plan its worker fills, the flag a newer click
+// raises, and the worker thread, which deletes itself when it finishes.
+struct ItemsModel::BackgroundSort
+{
+    Bucket::SortPlan plan;
+    std::atomic_bool cancelled{false};
+    bool completed{false};
+    QPointer<QThread> thread;
+};
+
 ItemsModel::ItemsModel(BuyoutManager &bo_manager, Search &search)
     : m_bo_manager(bo_manager)
     , m_search(search)
     , m_sort_order(Qt::DescendingOrder)
     , m_sort_column(0)
     , m_sorted(false)
+    , m_background_sort_rows(kBackgroundSortRows)
 {}
 
+ItemsModel::~ItemsModel()
+{
+    // Workers read the search's columns, which the Search destructor
+    // releases right after this model; superseded workers included, none
+    // may outlive it.
+    CancelBackgroundSort();
+    for (const auto &job : m_sort_jobs) {
+        job->cancelled = true;
+        if (job->thread) {
+            job->thread->wait();
+        }
+    }
+}
+
 /*
     Tree structure:
 
@@ -227,8 +256,10 @@ void ItemsModel::sort(int column, Qt::SortOrder order)
         return;
     }
 
-    // Ignore sort requests if we're already sorted
-    if (m_sorted && (m_sort_column == column) && (m_sort_order == order)) {
+    // Ignore sort requests if we're already sorted, or sorting this way
+    // in the background
+    const bool changed = (column != m_sort_column) || (order != m_sort_order);
+    if (!changed && (m_sorted || m_background_sort)) {
         return;
     }
 
@@ -243,11 +274,18 @@ void ItemsModel::sort(int column, Qt::SortOrder order)
     if (column != m_sort_column) {
         m_search.EvictResidentKeys();
     }
-    if ((column != m_sort_column) || (order != m_sort_order)) {
+    if (changed) {
         m_search.InvalidateAllOrder();
     }
     m_sort_order = order;
     m_sort_column = column;
+    CancelBackgroundSort();
+    if (changed && (m_background_sort_rows > 0)
+        && (m_search.GetViewMode() == Search::ViewMode::ByItem) && m_search.has_bucket(0)
+        && (m_search.bucket(0).size() >= m_background_sort_rows)) {
+        StartBackgroundSort();
+        return;
+    }
     ApplySort(column, order);
 }
 
@@ -273,6 +311,9 @@ void ItemsModel::OnBucketExpanded(int row)
         return;
     }
     m_search.MarkBucketExpanded(row);
+    if (m_background_sort) {
+        return; // the flat bucket's order is already on its way
+    }
     // D2 rule 2: an invalid flag sorts the bucket first (building its
     // keys, which stay resident — D1); a valid flag does no sort work and
     // builds no keys — the bucket stays sorted-but-keyless until a
@@ -294,6 +335,29 @@ void ItemsModel::OnBucketCollapsed(int row)
 }
 
 void ItemsModel::ApplySort(int column, Qt::SortOrder order, int only_bucket)
+{
+    if (m_background_sort) {
+        // A delta or buyout batch reshaped the flat bucket under a running
+        // sort, whose snapshot can no longer be adopted: re-snapshot rather
+        // than block the UI thread on the sort the click moved off it.
+        StartBackgroundSort();
+        return;
+    }
+    ApplyLayoutChange(only_bucket, [&]() {
+        if (only_bucket >= 0) {
+            m_search.SortBucket(only_bucket, column, order);
+        } else {
+            m_search.Sort(column, order);
+        }
+    });
+    if (only_bucket < 0) {
+        // A scoped expand-sort says nothing about the materialized set as
+        // a whole; only the view-wide pass marks the model sorted.
+        SetSorted(true);
+    }
+}
+
+void ItemsModel::ApplyLayoutChange(int only_bucket, const std::function<void()> &reorder)
 {
     struct ItemIndexSnapshot
     {
@@ -340,11 +404,7 @@ void ItemsModel::ApplySort(int column, Qt::SortOrder order, int only_bucket)
             {persistent_index, bucket_row, persistent_index.column(), bucket.item(item_row)});
     }
 
-    if (only_bucket >= 0) {
-        m_search.SortBucket(only_bucket, column, order);
-    } else {
-        m_search.Sort(column, order);
-    }
+    reorder();
 
     QModelIndexList from;
     QModelIndexList to;
@@ -369,11 +429,63 @@ void ItemsModel::ApplySort(int column, Qt::SortOrder order, int only_bucket)
     }
     changePersistentIndexList(from, to);
     emit layoutChanged(parents, QAbstractItemModel::VerticalSortHint);
-    if (only_bucket < 0) {
-        // A scoped expand-sort says nothing about the materialized set as
-        // a whole; only the view-wide pass marks the model sorted.
-        SetSorted(true);
+}
+
+void ItemsModel::StartBackgroundSort()
+{
+    CancelBackgroundSort();
+    auto plan = m_search.MakeFlatSortPlan(m_sort_column, m_sort_order);
+    if (!plan) {
+        ApplySort(m_sort_column, m_sort_order);
+        return;
+    }
+    auto job = std::make_shared<BackgroundSort>();
+    job->plan = std::move(*plan);
+    const int threads = std::max(1, QThread::idealThreadCount());
+    job->thread = QThread::create([job, threads]() {
+        job->completed = Bucket::PlanSort(job->plan, threads, job->cancelled);
+    });
+    connect(job->thread, &QThread::finished, this, [this, job]() {
+        OnBackgroundSortFinished(job);
+    });
+    connect(job->thread, &QThread::finished, job->thread, &QObject::deleteLater);
+    m_background_sort = job;
+    m_sort_jobs.push_back(job);
+    SetSorted(false);
+    job->thread->start();
+}
+
+void ItemsModel::CancelBackgroundSort()
+{
+    if (m_background_sort) {
+        m_background_sort->cancelled = true;
+        m_background_sort.reset();
+    }
+}
+
+void ItemsModel::OnBackgroundSortFinished(const std::shared_ptr<BackgroundSort> &job)
+{
+    std::erase(m_sort_jobs, job);
+    if (job != m_background_sort) {
+        return; // superseded and cancelled
+    }
+    m_background_sort.reset();
+    if (!job->completed) {
+        return;
+    }
+    Bucket::SortPlan &plan = job->plan;
+    if ((plan.column != m_search.columns()[static_cast<size_t>(m_sort_column)].get())
+        || (plan.order != m_sort_order)) {
+        return;
+    }
+    if (!m_search.CanAdoptFlatSortPlan(plan)) {
+        // The bucket changed under the snapshot and is still unsorted.
+        StartBackgroundSort();
+        return;
     }
+    // The flat bucket is row 0; the swap is one scoped layout change.
+    ApplyLayoutChange(0, [&]() { m_search.AdoptFlatSortPlan(std::move(plan)); });
+    SetSorted(true);
 }
 
 void ItemsModel::RepaintBuyoutCells(const BuyoutChangeSet &changes)
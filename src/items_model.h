@@ -5,6 +5,10 @@
 
 #include <QAbstractItemModel>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "modelprobes.h"
 
 class BuyoutManager;
@@ -16,6 +20,7 @@ class ItemsModel : public QAbstractItemModel
     Q_OBJECT
 public:
     explicit ItemsModel(BuyoutManager &bo_manager, Search &search);
+    ~ItemsModel();
     int rowCount(const QModelIndex &parent = QModelIndex()) const;
     int columnCount(const QModelIndex &parent = QModelIndex()) const;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
@@ -30,7 +35,17 @@ public:
     // (column, order) change clears every bucket's sorted flag — then the
     // materialized buckets re-establish order (Search::Sort) and collapsed
     // ones defer to expansion.
+    //
+    // In By-Item, a (column, order) change on a flat bucket of at least
+    // backgroundSortRows() rows sorts off the UI thread: sort() returns at
+    // once, the view keeps the old order, and the result lands later as
+    // one scoped layout change. A newer click cancels the running sort.
     void sort(int column, Qt::SortOrder order);
+    static constexpr int kBackgroundSortRows = 50000;
+    int backgroundSortRows() const { return m_background_sort_rows; }
+    // 0 keeps every sort on the UI thread; tests and benchmarks move it.
+    void SetBackgroundSortRows(int rows) { m_background_sort_rows = rows; }
+    bool backgroundSortPending() const { return m_background_sort != nullptr; }
     // Re-sorts on the current sort indicator unconditionally (M3 S2): a
     // buyout batch changes Price/Date order without touching the
     // indicator, so sort()'s already-sorted skip must not apply. The
@@ -80,6 +95,8 @@ public:
     void SetSorted(bool val) { m_sorted = val; }
     void beginUpdate()
     {
+        // A reset rebuilds the buckets a running sort snapshotted.
+        CancelBackgroundSort();
         if (auto &probes = ModelProbes::instance(); probes.enabled) {
             ++probes.model_resets;
             ++probes.model_resets_by_model[this];
@@ -96,10 +113,23 @@ private:
     // one bucket (sort-on-expand); -1 sorts the materialized set and
     // marks the model sorted.
     void ApplySort(int column, Qt::SortOrder order, int only_bucket = -1);
+    // The layout-change protocol itself, with `reorder` as the mutation.
+    void ApplyLayoutChange(int only_bucket, const std::function<void()> &reorder);
+
+    // The background By-Item sort: one job at a time, superseded by
+    // cancellation. Finished jobs report back on the UI thread.
+    struct BackgroundSort;
+    void StartBackgroundSort();
+    void CancelBackgroundSort();
+    void OnBackgroundSortFinished(const std::shared_ptr<BackgroundSort> &job);
 
     BuyoutManager &m_bo_manager;
     Search &m_search;
     Qt::SortOrder m_sort_order;
     int m_sort_column;
     bool m_sorted;
+    int m_background_sort_rows;
+    std::shared_ptr<BackgroundSort> m_background_sort;
+    // Every job whose worker may still be running, superseded ones too.
+    std::vector<std::shared_ptr<BackgroundSort>> m_sort_jobs;
 };
@@ -7,6 +7,8 @@
 #include <QSettings>
 
 #include <set>
+#include <unordered_map>
+#include <utility>
 
 #include "buyoutmanager.h"
 #include "datastore/datastore.h"
@@ -38,6 +40,20 @@ ItemsManager::ItemsManager(QSettings &settings, BuyoutManager &buyout_manager, D
 
 ItemsManager::~ItemsManager() {}
 
+template<typename Fn>
+void ItemsManager::ForEachItemIn(const RepriceScope &scope, Fn fn) const
+{
+    if (scope.everything) {
+        for (const auto &item : m_items.Flat()) {
+            fn(item);
+        }
+        return;
+    }
+    for (const auto &location_id : scope.location_ids) {
+        m_items.ForEachItemAt(location_id, fn);
+    }
+}
+
 void ItemsManager::OnStatusUpdate(ProgramState state, const QString &status)
 {
     emit StatusUpdate(state, status);
@@ -74,8 +90,11 @@ void ItemsManager::ApplyAutoItemBuyouts()
     // Pricing passes batch (M3 R1-6): one model update at pass end when
     // this pass is outermost, never one per Set.
     const BuyoutBatch batch(m_buyout_manager);
-    // Loop over all items, check for note field with pricing and apply
-    for (auto const &item : m_items.Flat()) {
+    // A note only changes when its item is refetched, so only locations
+    // whose items changed since the last note pass are checked for pricing.
+    TakeRepriceScope();
+    const RepriceScope scope = std::exchange(m_note_scope, {});
+    ForEachItemIn(scope, [&](const std::shared_ptr<Item> &item) {
         auto const &note = item->note();
         if (!note.isEmpty()) {
             Buyout buyout = m_buyout_manager.StringToBuyout(note);
@@ -87,7 +106,7 @@ void ItemsManager::ApplyAutoItemBuyouts()
                 m_buyout_manager.Set(*item, buyout);
             }
         }
-    }
+    });
 
     // Commenting this out for robustness (iss381) to make it as unlikely as possible that users
     // pricing data will be removed.  Side effect is that stale pricing data will pile up and
@@ -102,8 +121,19 @@ void ItemsManager::PropagateTabBuyouts()
     // pass, the command's own batch encloses it and this boundary emits
     // nothing (R3-3).
     const BuyoutBatch batch(m_buyout_manager);
-    m_buyout_manager.ClearRefreshLocks();
-    for (auto &item_ptr : m_items.Flat()) {
+    // Only locations whose items or buyouts changed since the last
+    // propagation are revisited, refresh locks included: a location's lock
+    // is cleared and re-derived from its own items.
+    TakeRepriceScope();
+    const RepriceScope scope = std::exchange(m_propagation_scope, {});
+    if (scope.everything) {
+        m_buyout_manager.ClearRefreshLocks();
+    } else {
+        for (const auto &location_id : scope.location_ids) {
+            m_buyout_manager.ClearRefreshLock(location_id);
+        }
+    }
+    ForEachItemIn(scope, [&](const std::shared_ptr<Item> &item_ptr) {
         Item &item = *item_ptr;
         auto item_bo = m_buyout_manager.Get(item);
         auto tab_bo = m_buyout_manager.GetTab(item.location());
@@ -127,15 +157,60 @@ void ItemsManager::PropagateTabBuyouts()
                 m_buyout_manager.SetRefreshLocked(item.location());
             }
         }
+    });
+    // This pass's own Sets are its output, not input for the next one.
+    m_buyout_manager.TakeRepriceScope();
+}
+
+void ItemsManager::MarkForPricing(const QString &location_id)
+{
+    m_note_scope.location_ids.insert(location_id);
+    m_propagation_scope.location_ids.insert(location_id);
+}
+
+void ItemsManager::MarkChangedSources(const SourceKeyedItems &previous)
+{
+    // Unchanged buckets hold the very same Item pointers (the worker keeps
+    // the items it published), so an element-wise pointer comparison finds
+    // every source that gained, lost, or replaced items.
+    const auto &before = previous.buckets();
+    const auto &after = m_items.buckets();
+    auto b = before.begin();
+    auto a = after.begin();
+    while ((b != before.end()) || (a != after.end())) {
+        if ((a == after.end()) || ((b != before.end()) && (b->first < a->first))) {
+            MarkForPricing(b->second.front()->location().id());
+            ++b;
+        } else if ((b == before.end()) || (a->first < b->first)) {
+            MarkForPricing(a->second.front()->location().id());
+            ++a;
+        } else {
+            if (a->second != b->second) {
+                MarkForPricing(a->second.front()->location().id());
+            }
+            ++a;
+            ++b;
+        }
     }
 }
 
+void ItemsManager::TakeRepriceScope()
+{
+    const RepriceScope changed = m_buyout_manager.TakeRepriceScope();
+    m_propagation_scope.Merge(changed);
+    // The note rule reads an item's game-set state, which only a wholesale
+    // buyout change can alter behind the note pass's back.
+    m_note_scope.everything = m_note_scope.everything || changed.everything;
+}
+
 void ItemsManager::OnItemsRefreshed(const Items &items,
                                     const std::vector<ItemLocation> &tabs,
                                     bool initial_refresh)
 {
     spdlog::trace("ItemsManager::OnItemsRefreshed() entered");
+    SourceKeyedItems previous = std::exchange(m_items, {});
     m_items.ResetTo(items);
+    MarkChangedSources(previous);
 
     spdlog::debug("There are {} items and {} tabs after the refresh.", m_items.size(), tabs.size());
     // Debug-only diagnostic, gated so release users never pay a
@@ -158,6 +233,18 @@ void ItemsManager::OnItemsRefreshed(const Items &items,
     // canonical inventory — deletions and ordering take effect here (D6).
     m_location_inventory.ResetTo(tabs);
 
+    // A tab's remove-only flag gates its refresh lock, and rebasing flips it
+    // on items the bucket comparison sees as unchanged.
+    std::unordered_map<QString, bool> removeonly;
+    for (const auto &tab : m_buyout_manager.GetStashTabLocations()) {
+        removeonly.emplace(tab.id(), tab.removeonly());
+    }
+    for (const auto &tab : tabs) {
+        const auto it = removeonly.find(tab.id());
+        if ((it != removeonly.end()) && (it->second != tab.removeonly())) {
+            MarkForPricing(tab.id());
+        }
+    }
     m_buyout_manager.SetStashTabLocations(tabs);
     {
         // The snapshot's pricing sequence is one batch (M3 R3-4): nothing
@@ -184,6 +271,7 @@ void ItemsManager::OnTabRefreshed(const ItemLocation &location, const Items &ite
     // empty delta empties the fetch source and nothing else; tab deletion
     // stays snapshot-boundary.
     m_items.ReplaceSource(FetchSourceKey::ForLocation(location), items);
+    MarkForPricing(location.id());
 
     // Every delta's location anchor feeds the canonical inventory, empty
     // deltas included (D6/R6-1).
@@ -205,10 +293,14 @@ void ItemsManager::OnChildrenReconciled(const ItemLocation &parent,
     // are erased too. A walk of the bucket index with set lookup — the
     // erased items are the only ones touched (D3, post-M2-M2).
     const std::set<FetchSourceKey> expected_keys(expected.begin(), expected.end());
-    m_items.EraseSourcesIf([&](const FetchSourceKey &key, const ItemLocation &loc) {
-        return (key.type == ItemLocationType::STASH) && (loc.id() == parent.id())
-               && (expected_keys.count(key) == 0);
-    });
+    const size_t erased = m_items.EraseSourcesIf(
+        [&](const FetchSourceKey &key, const ItemLocation &loc) {
+            return (key.type == ItemLocationType::STASH) && (loc.id() == parent.id())
+                   && (expected_keys.count(key) == 0);
+        });
+    if (erased > 0) {
+        MarkForPricing(parent.id());
+    }
 
     m_location_inventory.Ingest(parent);
 
@@ -8,6 +8,7 @@
 
 #include <vector>
 
+#include "buyoutmanager.h"
 #include "fetchsourcekey.h"
 #include "item.h"
 #include "itemlocation.h"
@@ -19,7 +20,6 @@
 
 class QSettings;
 
-class BuyoutManager;
 class DataStore;
 class Shop;
 
@@ -49,6 +49,15 @@ public:
     // every delta's location anchor and reset by every snapshot. Search
     // buckets render through it.
     const LocationInventory &locationInventory() const { return m_location_inventory; }
+    // The pricing passes. The item passes are incremental: the note pass
+    // revisits only locations whose items changed since it last ran, and
+    // propagation also those whose tab or item buyouts changed since it
+    // last ran — so a tab price edit touches that tab's items alone. A
+    // wholesale buyout change (reload, clear, migration) walks everything.
+    // A note is therefore re-read only when its item is refetched: a manual
+    // price set over a note-priced item holds across snapshots and buyout
+    // edits, and the note's price comes back with the next fetch of the
+    // item's tab, not at the next snapshot.
     void ApplyAutoTabBuyouts();
     void ApplyAutoItemBuyouts();
     void PropagateTabBuyouts();
@@ -87,6 +96,15 @@ private:
     // ItemsRefreshed stays authoritative.
     void ApplyScopedPricing(const Items &delta_items);
 
+    // Incremental pricing bookkeeping: a location whose items changed is
+    // marked for both passes; buyout changes come from BuyoutManager's
+    // reprice scope, folded in when a pass starts.
+    void MarkForPricing(const QString &location_id);
+    void MarkChangedSources(const SourceKeyedItems &previous);
+    void TakeRepriceScope();
+    template<typename Fn>
+    void ForEachItemIn(const RepriceScope &scope, Fn fn) const;
+
     QSettings &m_settings;
     BuyoutManager &m_buyout_manager;
     DataStore &m_datastore;
@@ -97,4 +115,8 @@ private:
     // reconciliation are bucket operations, never O(all-items) passes.
     SourceKeyedItems m_items;
     LocationInventory m_location_inventory;
+
+    // Both start as everything: the first passes have no baseline.
+    RepriceScope m_note_scope{{}, true};
+    RepriceScope m_propagation_scope{{}, true};
 };
@@ -5,11 +5,13 @@
 
 #include <QCoroFuture>
 
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 #include <QNetworkCookie>
 #include <QNetworkCookieJar>
 #include <QNetworkReply>
+#include <QPromise>
 #include <QSettings>
 #include <QSignalMapper>
 #include <QThread>
@@ -17,6 +19,12 @@
 #include <QUrlQuery>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 
@@ -32,6 +40,8 @@
 #include "poe/types/item.h"
 #include "poe/types/stashtab.h"
 #include "repoe/repoe.h"
+#include "util/binary_items.h"
+#include "util/heap.h"
 #include "util/json_readers.h"
 #include "util/spdlog_qt.h" // IWYU pragma: keep
 #include "util/util.h"
@@ -67,6 +77,68 @@ namespace {
         }
     }
 
+    // One cached fetch source as the cold-start reader stage hands it to the
+    // parse pool: the cached blob and the slot its Items merge into. The
+    // blob is json_data, or a stash's binary item records when `binary` is
+    // set. A non-negative character_tab marks a character blob and carries
+    // the tab index its ItemLocation takes.
+    struct CachedSource
+    {
+        size_t slot{0};
+        QByteArray data;
+        int character_tab{-1};
+        bool binary{false};
+        // The binary form's tab fields (StashRepo::CachedStash::tab).
+        std::optional<poe::StashTab> tab;
+    };
+
+    // The reader-to-pool hand-off. Bounded, so a reader running ahead of the
+    // parsers holds a few blobs rather than the whole cache; close() lets the
+    // workers drain what is queued and then stop.
+    class CachedSourceQueue
+    {
+    public:
+        explicit CachedSourceQueue(size_t capacity)
+            : m_capacity(std::max<size_t>(1, capacity))
+        {}
+
+        void push(CachedSource source)
+        {
+            std::unique_lock lock(m_mutex);
+            m_not_full.wait(lock, [this] { return m_queue.size() < m_capacity; });
+            m_queue.push_back(std::move(source));
+            m_not_empty.notify_one();
+        }
+
+        std::optional<CachedSource> pop()
+        {
+            std::unique_lock lock(m_mutex);
+            m_not_empty.wait(lock, [this] { return m_closed || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return std::nullopt;
+            }
+            CachedSource source = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_not_full.notify_one();
+            return source;
+        }
+
+        void close()
+        {
+            std::lock_guard lock(m_mutex);
+            m_closed = true;
+            m_not_empty.notify_all();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_not_full;
+        std::condition_variable m_not_empty;
+        std::deque<CachedSource> m_queue;
+        const size_t m_capacity;
+        bool m_closed{false};
+    };
+
 } // namespace
 
 ItemsManagerWorker::ItemsManagerWorker(QSettings &settings,
@@ -87,6 +159,9 @@ ItemsManagerWorker::ItemsManagerWorker(QSettings &settings,
 {
     spdlog::trace("ItemsManagerWorker::ItemsManagerWorker() entered");
 
+    // Leave a core for the UI thread, as the cold-start pool does.
+    m_parse_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+
     m_realm = m_settings.value("realm").toString();
     m_league = m_settings.value("league").toString();
     m_account = m_settings.value("account").toString();
@@ -155,6 +230,14 @@ ParseResult ItemsManagerWorker::ParseCachedItems(const QString &dataDir) const
         spdlog::warn("ACQ_PARSE_DELAY_MS is set: delaying {}ms per cached tab", parse_delay_ms);
     }
 
+    // Measurement aid: pin the parse pool's size (1 reproduces the old
+    // serial load). Unset or zero in normal use, which leaves one core for
+    // the reader stage and the UI.
+    int parse_threads = qEnvironmentVariableIntValue("ACQ_PARSE_THREADS");
+    if (parse_threads <= 0) {
+        parse_threads = std::max(1, QThread::idealThreadCount() - 1);
+    }
+
     // Create a datastore to get a connection to the database.
     // NOTE: we only need read access, but this isn't enforced or checked.
     QDir data_dir{dataDir};
@@ -164,6 +247,23 @@ ParseResult ItemsManagerWorker::ParseCachedItems(const QString &dataDir) const
     const auto stashes = userstore.stashes().getStashList(m_realm, m_league);
     const auto characters = userstore.characters().getCharacterList(m_realm, m_league);
 
+    // Seed the fetch scheduler. Each row records the source's last fetch,
+    // and that fetch found new bytes exactly when it also moved
+    // json_changed_at.
+    auto seed = [&](ItemLocationType type, auto &&entries) {
+        for (auto &entry : entries) {
+            FetchScheduler::History history;
+            history.digest = std::move(entry.digest);
+            history.changed_at = entry.changed_at;
+            history.fetched_at = entry.fetched_at;
+            history.fetches = 1;
+            history.changes = (entry.changed_at == entry.fetched_at) ? 1 : 0;
+            result.fetch_history.emplace(FetchSourceKey{type, entry.id}, std::move(history));
+        }
+    };
+    seed(ItemLocationType::STASH, userstore.stashes().getFetchHistory(m_realm, m_league));
+    seed(ItemLocationType::CHARACTER, userstore.characters().getFetchHistory(m_realm, m_league));
+
     // Do not process children from unique and map stashers.
     auto special = [](const poe::StashTab &stash) {
         return stash.parent && ((stash.type == "UniqueStash") || (stash.type == "MapStash"));
@@ -189,27 +289,48 @@ ParseResult ItemsManagerWorker::ParseCachedItems(const QString &dataDir) const
     // Get cached items
     spdlog::trace("ItemsManagerWorker::ParseItemMods() getting cached items");
 
-    // Get stash items.
-    for (size_t i = 0; i < stashes.size(); ++i) {
-        if (m_shutdown.load()) {
-            return result;
+    // The cold-start pipeline: this thread is the reader stage — it owns the
+    // SQLite connection and streams cached blobs off it in source order —
+    // and a pool of parse workers turns each blob into that source's Items.
+    // Every source has its own slot, so the workers never share output and
+    // the merge below restores the serial load's order however the parses
+    // interleave. result.tabs is complete and read-only from here on, which
+    // is what lets the workers resolve special children's parents from it.
+    std::vector<Items> slots(stashes.size() + characters.size());
+    // Set by a slot's worker once its blob loaded, so the fetch history can
+    // be cut back to the sources whose items are actually held.
+    std::vector<char> loaded(slots.size(), 0);
+
+    auto parseSource = [&](CachedSource &source) {
+        Items &out = slots[source.slot];
+        if (source.character_tab >= 0) {
+            const auto character = json::readCharacter(source.data);
+            if (!character) {
+                spdlog::error("ItemsManagerWorker: could not parse cached character");
+                return;
+            }
+            LoadItems(*character, ItemLocation{*character, source.character_tab}, out);
+            loaded[source.slot] = 1;
+            return;
         }
-        if (parse_delay_ms > 0) {
-            QThread::msleep(parse_delay_ms);
+        // Binary records hold only the items; the rest of the tab was read
+        // from the same row as the records, not from the list read above.
+        std::optional<poe::StashTab> stash;
+        if (source.binary) {
+            auto items = binary::readItems(source.data);
+            if (!items || !source.tab) {
+                spdlog::error("ItemsManagerWorker: could not decode cached stash items");
+                return;
+            }
+            stash = std::move(source.tab);
+            stash->items = std::move(*items);
+        } else {
+            stash = json::readStash(source.data);
         }
-        const auto id = stashes[i].id;
-        const auto stash = userstore.stashes().getStash(id, m_realm, m_league);
         if (!stash) {
-            // The row was listed but its contents were never fetched, so
-            // there is nothing cached to load for it here.
-            continue;
+            spdlog::error("ItemsManagerWorker: could not parse cached stash");
+            return;
         }
-        sendStatusUpdate(ProgramState::Initializing,
-                         QString("Parsing items from stash %1/%2: %3 '%4'")
-                             .arg(QString::number(i),
-                                  QString::number(stashes.size()),
-                                  stash->id,
-                                  stash->name));
         ItemLocation location;
         if (!special(*stash)) {
             location = ItemLocation{*stash};
@@ -223,26 +344,72 @@ ParseResult ItemsManagerWorker::ParseCachedItems(const QString &dataDir) const
             }
             if (!location.IsValid()) {
                 spdlog::error("ItemsManagerWorker: could not find stash parent");
-                continue;
+                return;
             }
             // The items display under the parent, but they were fetched from
             // (and are keyed for replacement by) this child stash.
             location.setFetchId(stash->id);
         }
-        LoadItems(*stash, location, result);
+        LoadItems(*stash, location, out);
+        loaded[source.slot] = 1;
+    };
+
+    // Twice the pool keeps every worker fed without letting the reader
+    // buffer the whole cache ahead of the parsers.
+    CachedSourceQueue queue(2 * static_cast<size_t>(parse_threads));
+    std::vector<std::jthread> workers;
+    workers.reserve(static_cast<size_t>(parse_threads));
+    for (int n = 0; n < parse_threads; ++n) {
+        workers.emplace_back([&]() {
+            while (auto source = queue.pop()) {
+                // A shutdown drains the queue without parsing what is left.
+                if (!m_shutdown.load()) {
+                    parseSource(*source);
+                }
+            }
+        });
+    }
+    spdlog::debug("ItemsManagerWorker: parsing cached items with {} worker threads",
+                  parse_threads);
+
+    // Get stash items.
+    for (size_t i = 0; i < stashes.size(); ++i) {
+        if (m_shutdown.load()) {
+            break;
+        }
+        if (parse_delay_ms > 0) {
+            QThread::msleep(parse_delay_ms);
+        }
+        const auto &id = stashes[i].id;
+        auto cached = userstore.stashes().getCachedStash(id, m_realm, m_league);
+        if (!cached) {
+            // The row was listed but its contents were never fetched, so
+            // there is nothing cached to load for it here.
+            continue;
+        }
+        // Progress follows the reader, which the bounded queue keeps at
+        // most a few blobs ahead of the parsers.
+        sendStatusUpdate(ProgramState::Initializing,
+                         QString("Parsing items from stash %1/%2: %3 '%4'")
+                             .arg(QString::number(i),
+                                  QString::number(stashes.size()),
+                                  id,
+                                  stashes[i].name));
+        queue.push(
+            CachedSource{i, std::move(cached->data), -1, cached->binary, std::move(cached->tab)});
     }
 
     // Get character items.
     for (size_t i = 0; i < characters.size(); ++i) {
         if (m_shutdown.load()) {
-            return result;
+            break;
         }
         if (parse_delay_ms > 0) {
             QThread::msleep(parse_delay_ms);
         }
-        const auto name = characters[i].name;
-        const auto character = userstore.characters().getCharacter(name, m_realm);
-        if (!character) {
+        const auto &name = characters[i].name;
+        auto json = userstore.characters().getCharacterJson(name, m_realm);
+        if (!json) {
             // Listed but never fetched: nothing cached to load here.
             continue;
         }
@@ -251,9 +418,46 @@ ParseResult ItemsManagerWorker::ParseCachedItems(const QString &dataDir) const
                              .arg(i)
                              .arg(characters.size())
                              .arg(name));
-        ItemLocation tab{*character, int(stashes.size() + i)};
-        LoadItems(*character, tab, result);
+        queue.push(CachedSource{stashes.size() + i, std::move(*json), int(stashes.size() + i)});
+    }
+
+    // Let the pool drain and join it before touching the slots.
+    queue.close();
+    workers.clear();
+    if (m_shutdown.load()) {
+        return result;
+    }
+
+    // A tab whose cache did not load (never fetched, an older payload
+    // version, a blob that would not parse) must not keep its digest: an
+    // identical reply would then be skipped without its items ever having
+    // been built.
+    std::set<FetchSourceKey> loaded_keys;
+    for (size_t i = 0; i < stashes.size(); ++i) {
+        if (loaded[i]) {
+            loaded_keys.insert({ItemLocationType::STASH, stashes[i].id});
+        }
     }
+    for (size_t i = 0; i < characters.size(); ++i) {
+        if (loaded[stashes.size() + i]) {
+            loaded_keys.insert({ItemLocationType::CHARACTER, characters[i].id});
+        }
+    }
+    std::erase_if(result.fetch_history, [&](const auto &entry) {
+        return loaded_keys.count(entry.first) == 0;
+    });
+
+    // The ordered merge.
+    size_t total = 0;
+    for (const auto &items : slots) {
+        total += items.size();
+    }
+    result.items.reserve(total);
+    for (auto &items : slots) {
+        std::move(items.begin(), items.end(), std::back_inserter(result.items));
+    }
+    // Every cached tab's poe:: graph is gone by now; only the Items remain.
+    heap::releaseFreedMemory();
 
     sendStatusUpdate(ProgramState::Ready,
                      QString("Parsed %1 items from %2 tabs")
@@ -268,6 +472,7 @@ void ItemsManagerWorker::OnParseCompleted(ParseResult result)
     m_tabs = std::move(result.tabs);
     m_items.ResetTo(std::move(result.items));
     m_tab_id_index = std::move(result.tab_id_index);
+    m_fetch_scheduler.Reset(std::move(result.fetch_history));
     m_state = WorkerState::Idle;
     // let ItemManager know that the retrieval of cached items/tabs has been completed (calls ItemsManager::OnItemsRefreshed method)
     spdlog::trace("ItemsManagerWorker::ParseItemMods() emitting ItemsRefreshed signal");
@@ -282,26 +487,26 @@ void ItemsManagerWorker::OnParseCompleted(ParseResult result)
 
 void ItemsManagerWorker::LoadItems(const poe::StashTab &stash,
                                    ItemLocation location,
-                                   ParseResult &result) const
+                                   Items &out) const
 {
     const auto items = stash.items;
     if (!items) {
         return;
     }
-    result.items.reserve(result.items.size() + items->size());
+    out.reserve(out.size() + items->size());
     spdlog::debug("ItemManagerWorker: loading {} items from stash # {}: {} ({})",
                   items->size(),
                   stash.index.value_or(-1),
                   stash.id,
                   stash.name);
     for (const auto &item : *items) {
-        result.items.push_back(std::make_shared<Item>(item, location));
+        out.push_back(std::make_shared<Item>(item, location));
     }
 }
 
 void ItemsManagerWorker::LoadItems(const poe::Character &character,
                                    ItemLocation location,
-                                   ParseResult &result) const
+                                   Items &out) const
 {
     const std::array collections{
         std::make_pair("equipment", character.equipment),
@@ -314,14 +519,14 @@ void ItemsManagerWorker::LoadItems(const poe::Character &character,
         if (!items) {
             continue;
         }
-        result.items.reserve(result.items.size() + items->size());
+        out.reserve(out.size() + items->size());
         spdlog::debug("ItemManagerWorker: loading {} items from character {} {} ({})",
                       items->size(),
                       name,
                       character.id,
                       character.name);
         for (const auto &item : *items) {
-            result.items.push_back(std::make_shared<Item>(item, location));
+            out.push_back(std::make_shared<Item>(item, location));
         }
     }
 }
@@ -394,12 +599,19 @@ void ItemsManagerWorker::Update(TabSelection type, const std::vector<ItemLocatio
     // reconciled against the fresh lists as they arrive, and each tab's
     // items are replaced atomically when its reply arrives, so a failed
     // update never leaves anything missing (F28).
-    m_update_all = (type == TabSelection::All) || (type == TabSelection::TabsOnly);
+    m_update_all = (type == TabSelection::All) || (type == TabSelection::TabsOnly)
+                   || (type == TabSelection::Quick);
     m_tabs_to_update.clear();
+    m_quick_refresh_limit = 0;
     switch (type) {
     case TabSelection::All:
         spdlog::debug("ItemsManagerWorker: updating all tabs and items.");
         break;
+    case TabSelection::Quick:
+        m_quick_refresh_limit = std::max(1, m_settings.value("quick_refresh_tabs", 20).toInt());
+        spdlog::debug("ItemsManagerWorker: updating the {} likeliest changed tabs.",
+                      m_quick_refresh_limit);
+        break;
     case TabSelection::TabsOnly:
         spdlog::debug("ItemsManagerWorker: updating stash and character lists.");
         break;
@@ -557,6 +769,7 @@ void ItemsManagerWorker::AbortUpdate()
                           .arg(QString::number(m_request_failures)));
     m_state = WorkerState::Idle;
     spdlog::debug("Update failed.");
+    ReleaseParseMemory();
 
     // The typed terminal event (D4): after the Idle transition, exactly
     // once — the already-terminal guard above keeps later stragglers and
@@ -684,14 +897,41 @@ QCoro::Task<> ItemsManagerWorker::FetchStash(ItemLocation location,
                                              std::stop_token token)
 {
     try {
-        Result<poe::StashPayload> result;
+        auto result = std::make_shared<Result<poe::StashPayload>>();
         try {
-            auto future = m_api.getStash(m_realm, m_league, stash_id, substash_id, token);
-            result = co_await qCoro(future).takeResult();
+            // The digest of the bytes this source's held items were built
+            // from: a reply that still matches it comes back unchanged,
+            // without its items ever being parsed (see OnStashReceived).
+            QByteArray known_digest;
+            if (const auto *history = m_fetch_scheduler.Find(
+                    FetchSourceKey::ForLocation(location))) {
+                known_digest = history->digest;
+            }
+            auto future = m_api.getStash(m_realm,
+                                         m_league,
+                                         stash_id,
+                                         substash_id,
+                                         known_digest,
+                                         token);
+            *result = co_await qCoro(future).takeResult();
         } catch (...) {
-            result = std::unexpected(MakeInternalError("the stash fetch threw"));
+            *result = std::unexpected(MakeInternalError("the stash fetch threw"));
+        }
+        // The ticket is taken before the parse can reorder anything.
+        const std::uint64_t ticket = EnqueueReply(token);
+        std::optional<Items> delta;
+        if (!token.stop_requested() && *result && !(*result)->unchanged && (*result)->stash.items
+            && ((*result)->stash.items->size() >= m_pool_parse_min_items)) {
+            auto build = BuildOnParsePool([result, location]() {
+                Items out;
+                ParseItems(*(*result)->stash.items, location, out);
+                return out;
+            });
+            delta = co_await qCoro(build).takeResult();
         }
-        ProcessIfLive(token, [&] { OnStashReceived(result, location); });
+        CompleteReply(ticket, [this, result, location, token, delta = std::move(delta)]() mutable {
+            ProcessIfLive(token, [&] { OnStashReceived(*result, location, std::move(delta)); });
+        });
     } catch (...) {
         spdlog::error("ItemsManagerWorker: a stash continuation threw; aborting the update");
         RecordFirstError(MakeInternalError("a stash continuation threw"));
@@ -705,14 +945,27 @@ QCoro::Task<> ItemsManagerWorker::FetchCharacter(ItemLocation location,
                                                  std::stop_token token)
 {
     try {
-        Result<poe::CharacterPayload> result;
+        auto result = std::make_shared<Result<poe::CharacterPayload>>();
         try {
             auto future = m_api.getCharacter(m_realm, name, token);
-            result = co_await qCoro(future).takeResult();
+            *result = co_await qCoro(future).takeResult();
         } catch (...) {
-            result = std::unexpected(MakeInternalError("the character fetch threw"));
+            *result = std::unexpected(MakeInternalError("the character fetch threw"));
         }
-        ProcessIfLive(token, [&] { OnCharacterReceived(result, location); });
+        const std::uint64_t ticket = EnqueueReply(token);
+        std::optional<Items> delta;
+        if (!token.stop_requested() && *result
+            && (CountCharacterItems((*result)->character) >= m_pool_parse_min_items)) {
+            auto build = BuildOnParsePool([result, location]() {
+                Items out;
+                ParseCharacterItems((*result)->character, location, out);
+                return out;
+            });
+            delta = co_await qCoro(build).takeResult();
+        }
+        CompleteReply(ticket, [this, result, location, token, delta = std::move(delta)]() mutable {
+            ProcessIfLive(token, [&] { OnCharacterReceived(*result, location, std::move(delta)); });
+        });
     } catch (...) {
         spdlog::error("ItemsManagerWorker: a character continuation threw; aborting the update");
         RecordFirstError(MakeInternalError("a character continuation threw"));
@@ -820,7 +1073,7 @@ void ItemsManagerWorker::OnStashListReceived(const Result<poe::StashListWrapper>
     // bucket's stable id is its display parent's), so a deleted parent
     // takes its children's buckets with it — the same predicate the old
     // per-item pass applied.
-    const size_t dropped = m_items.EraseSourcesIf(
+    const size_t dropped = EraseSourcesIf(
         [this](const FetchSourceKey &key, const ItemLocation &location) {
             return (key.type == ItemLocationType::STASH)
                    && (m_tab_id_index.count(location.id()) == 0);
@@ -834,9 +1087,9 @@ void ItemsManagerWorker::OnStashListReceived(const Result<poe::StashListWrapper>
     // Launch this list's complete stash content batch now (D6): it is never
     // held behind the character list, which RunUpdate already requested and
     // whose own content launches from its handler. ProcessTab accumulated the
-    // batch above in source traversal order; LaunchContent launches it all at
-    // once.
-    LaunchContent(std::move(batch));
+    // batch above in source traversal order; LaunchContent ranks it and
+    // launches it all at once (a quick refresh only its head).
+    LaunchContent(std::move(batch), m_quick_refresh_limit);
     CheckUpdateFinished();
 }
 
@@ -914,7 +1167,7 @@ void ItemsManagerWorker::OnCharacterListReceived(const Result<poe::CharacterList
     spdlog::debug("There are {} characters to update in '{}'", batch.size(), m_league);
 
     // Drop items belonging to characters the server no longer lists.
-    const size_t dropped = m_items.EraseSourcesIf(
+    const size_t dropped = EraseSourcesIf(
         [this](const FetchSourceKey &key, const ItemLocation &location) {
             return (key.type == ItemLocationType::CHARACTER)
                    && (m_tab_id_index.count(location.id()) == 0);
@@ -927,12 +1180,25 @@ void ItemsManagerWorker::OnCharacterListReceived(const Result<poe::CharacterList
 
     // Launch this list's complete character content batch now (D6): it is
     // independent of the stash lane, so it is never held behind the stash list.
-    LaunchContent(std::move(batch));
+    LaunchContent(std::move(batch), m_quick_refresh_limit);
     CheckUpdateFinished();
 }
 
+size_t ItemsManagerWorker::EraseSourcesIf(
+    const std::function<bool(const FetchSourceKey &, const ItemLocation &)> &pred)
+{
+    return m_items.EraseSourcesIf([&](const FetchSourceKey &key, const ItemLocation &location) {
+        if (!pred(key, location)) {
+            return false;
+        }
+        m_fetch_scheduler.Forget(key);
+        return true;
+    });
+}
+
 void ItemsManagerWorker::OnStashReceived(const Result<poe::StashPayload> &result,
-                                         const ItemLocation &location)
+                                         const ItemLocation &location,
+                                         std::optional<Items> delta)
 {
     spdlog::trace("ItemsManagerWorker::OnStashReceived() entered");
 
@@ -971,36 +1237,63 @@ void ItemsManagerWorker::OnStashReceived(const Result<poe::StashPayload> &result
     }
 
     const auto &stash = result->stash;
+    const FetchSourceKey key = FetchSourceKey::ForLocation(location);
+
+    bool changed = m_fetch_scheduler.Observe(key, result->digest, QDateTime::currentDateTime());
+    if (changed && result->unchanged) {
+        // The reply matched the digest its fetch was launched with, so its
+        // items were never parsed, but this source's history has moved on
+        // since. There is nothing to replace the held items with: keep
+        // them, and forget the history so the next fetch builds in full.
+        spdlog::debug("ItemsManagerWorker: stash history changed during its fetch: {}",
+                      location.GetHeader());
+        m_fetch_scheduler.Forget(key);
+        changed = false;
+    }
 
-    // The bytes ride along untouched (F62): the facade parsed this stash
-    // from exactly this substring of the reply, and the datastore stores it.
-    emit stashReceived(stash, result->bytes, m_realm, m_league);
-
-    // Atomically replace whatever this request fetched last time: for a
-    // normal tab that is the tab's items, for a child of a special tab it
-    // is just that child's share of the parent location's items. One bucket
-    // swap in the source-keyed store — O(replaced + delta), never a pass
-    // over the collection (D3, post-M2-M2).
-    Items delta;
-    if (stash.items) {
-        const auto &items = *stash.items;
-        if (items.size() > 0) {
-            ParseItems(items, location, delta);
-        } else {
-            spdlog::debug("Stash 'items' does not contain any items: {}", location.GetHeader());
-        }
+    if (!changed) {
+        // Byte-identical to the reply this source's held items were built
+        // from: the atomic replace would swap in equal items, the datastore
+        // would rewrite the same row, and the delta would re-price and
+        // re-filter a tab that did not change. Only the fetch is recorded;
+        // the counters and children below are handled as for any reply.
+        spdlog::debug("ItemsManagerWorker: stash unchanged since its last fetch: {}",
+                      location.GetHeader());
+        emit stashUnchanged(stash.id, m_realm, m_league);
     } else {
-        spdlog::debug("Stash does not have an 'items' array: {}", location.GetHeader());
+        // The bytes ride along untouched (F62): the facade parsed this stash
+        // from exactly this substring of the reply, and the datastore stores it.
+        emit stashReceived(stash, result->bytes, result->digest, m_realm, m_league);
+
+        // Atomically replace whatever this request fetched last time: for a
+        // normal tab that is the tab's items, for a child of a special tab it
+        // is just that child's share of the parent location's items. One
+        // bucket swap in the source-keyed store — O(replaced + delta), never
+        // a pass over the collection (D3, post-M2-M2).
+        if (!delta) {
+            delta.emplace();
+            if (stash.items) {
+                const auto &items = *stash.items;
+                if (items.size() > 0) {
+                    ParseItems(items, location, *delta);
+                } else {
+                    spdlog::debug("Stash 'items' does not contain any items: {}",
+                                  location.GetHeader());
+                }
+            } else {
+                spdlog::debug("Stash does not have an 'items' array: {}", location.GetHeader());
+            }
+        }
+        const size_t replaced = m_items.ReplaceSource(key, *delta);
+        spdlog::debug("ItemsManagerWorker: replacing {} items fetched by '{}'",
+                      replaced,
+                      location.fetch_id());
+
+        // Presentation delta (M2 D3): the exact replacement just applied for
+        // this fetch source, sharing its shared_ptrs, emitted after the atomic
+        // replace and before the counter increment.
+        emit TabRefreshed(location, *delta);
     }
-    const size_t replaced = m_items.ReplaceSource(FetchSourceKey::ForLocation(location), delta);
-    spdlog::debug("ItemsManagerWorker: replacing {} items fetched by '{}'",
-                  replaced,
-                  location.fetch_id());
-
-    // Presentation delta (M2 D3): the exact replacement just applied for this
-    // fetch source, sharing its shared_ptrs, emitted after the atomic replace
-    // and before the counter increment.
-    emit TabRefreshed(location, delta);
 
     ++m_stashes_received;
     SendStatusUpdate();
@@ -1072,7 +1365,7 @@ void ItemsManagerWorker::OnStashReceived(const Result<poe::StashPayload> &result
             emit stashChildrenReplaced(location.id(), child_ids, m_realm, m_league);
         }
         const std::set<FetchSourceKey> expected_keys(expected.begin(), expected.end());
-        const size_t dropped = m_items.EraseSourcesIf(
+        const size_t dropped = EraseSourcesIf(
             [&](const FetchSourceKey &key, const ItemLocation &item_location) {
                 return (key.type == ItemLocationType::STASH)
                        && (item_location.id() == location.id())
@@ -1100,7 +1393,8 @@ void ItemsManagerWorker::OnStashReceived(const Result<poe::StashPayload> &result
 }
 
 void ItemsManagerWorker::OnCharacterReceived(const Result<poe::CharacterPayload> &result,
-                                             const ItemLocation &location)
+                                             const ItemLocation &location,
+                                             std::optional<Items> delta)
 {
     spdlog::trace("ItemsManagerWorker::OnCharacterReceived() entered");
 
@@ -1134,22 +1428,18 @@ void ItemsManagerWorker::OnCharacterReceived(const Result<poe::CharacterPayload>
 
     const auto &character = result->character;
 
-    emit characterReceived(character, result->bytes, m_realm);
+    emit characterReceived(character, result->bytes, result->digest, m_realm);
+    m_fetch_scheduler.Observe(FetchSourceKey::ForLocation(location),
+                              result->digest,
+                              QDateTime::currentDateTime());
 
     // Atomically replace this character's items: one bucket swap, as in
     // OnStashReceived.
-    Items delta;
-    const auto collections = {character.equipment,
-                              character.inventory,
-                              character.rucksack,
-                              character.jewels};
-
-    for (const auto &items : collections) {
-        if (items) {
-            ParseItems(*items, location, delta);
-        }
+    if (!delta) {
+        delta.emplace();
+        ParseCharacterItems(character, location, *delta);
     }
-    const size_t replaced = m_items.ReplaceSource(FetchSourceKey::ForLocation(location), delta);
+    const size_t replaced = m_items.ReplaceSource(FetchSourceKey::ForLocation(location), *delta);
     spdlog::debug("ItemsManagerWorker: replacing {} items fetched by '{}'",
                   replaced,
                   location.fetch_id());
@@ -1157,7 +1447,7 @@ void ItemsManagerWorker::OnCharacterReceived(const Result<poe::CharacterPayload>
     // Presentation delta (M2 D3), as in OnStashReceived: after the atomic
     // replace, before the counter increment. A character reply discovers no
     // children, so there is no ChildrenReconciled here.
-    emit TabRefreshed(location, delta);
+    emit TabRefreshed(location, *delta);
 
     ++m_characters_received;
     SendStatusUpdate();
@@ -1167,7 +1457,7 @@ void ItemsManagerWorker::OnCharacterReceived(const Result<poe::CharacterPayload>
     CheckUpdateFinished();
 }
 
-void ItemsManagerWorker::LaunchContent(std::vector<ItemsRequest> batch)
+void ItemsManagerWorker::LaunchContent(std::vector<ItemsRequest> batch, size_t limit)
 {
     // The whole batch goes out at once (D6, F56): no worker-side pacing, no
     // one-at-a-time submission. The caller owns the batch as a local vector, so a
@@ -1179,6 +1469,27 @@ void ItemsManagerWorker::LaunchContent(std::vector<ItemsRequest> batch)
         return;
     }
 
+    // Likeliest-changed first. The sort is stable, so sources that score
+    // alike — every source of a first refresh — keep their traversal order.
+    const QDateTime now = QDateTime::currentDateTime();
+    std::vector<std::pair<double, ItemsRequest>> ranked;
+    ranked.reserve(batch.size());
+    for (auto &request : batch) {
+        const double score = m_fetch_scheduler.Score(request.location, now);
+        ranked.emplace_back(score, std::move(request));
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) {
+        return a.first > b.first;
+    });
+    if ((limit > 0) && (ranked.size() > limit)) {
+        spdlog::debug("Quick refresh: fetching {} of {} sources.", limit, ranked.size());
+        ranked.erase(ranked.begin() + limit, ranked.end());
+    }
+    batch.clear();
+    for (auto &[score, request] : ranked) {
+        batch.push_back(std::move(request));
+    }
+
     // Initialize the entire batch's needed counters BEFORE the first launch
     // (IR2/S1-6): a ready or fail-fast future runs its completion inline in the
     // launch loop below, and it must never observe a needed count still being
@@ -1201,8 +1512,8 @@ void ItemsManagerWorker::LaunchContent(std::vector<ItemsRequest> batch)
     const std::stop_token token = m_stop_source.get_token();
 
     // Each entry names the resource, not how to fetch it; launch an owned
-    // per-fetch task per entry, in the batch's source traversal order (D6's
-    // per-lane FIFO). Every handle lives in m_fetch_tasks — no fire-and-forget.
+    // per-fetch task per entry, in the batch's ranked order (D6's per-lane
+    // FIFO). Every handle lives in m_fetch_tasks — no fire-and-forget.
     for (const auto &request : batch) {
         const ItemLocation location = request.location;
         std::visit(
@@ -1283,9 +1594,111 @@ void ItemsManagerWorker::SendStatusUpdate()
     emit StatusUpdate(ProgramState::Busy, message);
 }
 
+QFuture<Items> ItemsManagerWorker::BuildOnParsePool(std::function<Items()> build)
+{
+    auto promise = std::make_shared<QPromise<Items>>();
+    QFuture<Items> future = promise->future();
+    promise->start();
+    m_parse_pool.start([promise, build = std::move(build)]() {
+        // A throw crosses back as an exceptional future, so the awaiting
+        // fetch's catch-all aborts the update as for any handler throw.
+        try {
+            promise->addResult(build());
+        } catch (...) {
+            promise->setException(std::current_exception());
+        }
+        promise->finish();
+    });
+    return future;
+}
+
+void ItemsManagerWorker::ReleaseParseMemory()
+{
+    m_parse_pool.start([]() {
+        if (heap::releaseFreedMemory()) {
+            spdlog::debug("ItemsManagerWorker: returned freed parse memory to the system");
+        }
+    });
+}
+
+std::uint64_t ItemsManagerWorker::EnqueueReply(const std::stop_token &token)
+{
+    const std::uint64_t ticket = m_next_reply_ticket++;
+    m_pending_replies.push_back(PendingReply{ticket, token, {}});
+    return ticket;
+}
+
+void ItemsManagerWorker::CompleteReply(std::uint64_t ticket, std::function<void()> handler)
+{
+    const auto it = std::find_if(m_pending_replies.begin(),
+                                 m_pending_replies.end(),
+                                 [ticket](const PendingReply &reply) {
+                                     return reply.ticket == ticket;
+                                 });
+    if (it == m_pending_replies.end()) {
+        // Dropped by DrainReplies after its update stopped.
+        return;
+    }
+    it->handler = std::move(handler);
+    DrainReplies();
+}
+
+void ItemsManagerWorker::OnStoreBacklog(bool backlogged)
+{
+    m_store_backlogged = backlogged;
+    if (!backlogged) {
+        DrainReplies();
+    }
+}
+
+void ItemsManagerWorker::DrainReplies()
+{
+    // Each handler is popped before it runs: it may launch fetches whose
+    // ready futures complete inline and re-enter here, and a throw from it
+    // must leave the queue consistent for the catch-all's abort.
+    while (!m_pending_replies.empty() && !m_store_backlogged) {
+        PendingReply &front = m_pending_replies.front();
+        if (front.handler) {
+            auto handler = std::move(front.handler);
+            m_pending_replies.pop_front();
+            handler();
+        } else if (front.token.stop_requested()) {
+            // Still parsing for a stopped update; its handler would be
+            // gated out anyway.
+            m_pending_replies.pop_front();
+        } else {
+            break;
+        }
+    }
+}
+
+size_t ItemsManagerWorker::CountCharacterItems(const poe::Character &character)
+{
+    size_t count = 0;
+    for (const auto *items :
+         {&character.equipment, &character.inventory, &character.rucksack, &character.jewels}) {
+        if (*items) {
+            count += (*items)->size();
+        }
+    }
+    return count;
+}
+
+void ItemsManagerWorker::ParseCharacterItems(const poe::Character &character,
+                                             const ItemLocation &location,
+                                             Items &out)
+{
+    for (const auto *items :
+         {&character.equipment, &character.inventory, &character.rucksack, &character.jewels}) {
+        if (*items) {
+            ParseItems(**items, location, out);
+        }
+    }
+}
+
 void ItemsManagerWorker::ParseItems(const std::vector<poe::Item> &items,
                                     const ItemLocation &base_location,
-                                    Items &out) const
+                                    Items &out)
 {
     for (auto &item : items) {
         const ItemLocation location = base_location.getItemLocation(item);
@@ -1379,6 +1792,7 @@ void ItemsManagerWorker::FinishUpdate()
 
     m_state = WorkerState::Idle;
     spdlog::debug("Update finished.");
+    ReleaseParseMemory();
 
     // The typed terminal event (D4), pinned ordering: final ItemsRefreshed,
     // then Idle, then RefreshFinished — the fan-out observes an idle worker
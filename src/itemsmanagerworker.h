@@ -5,21 +5,27 @@
 
 #include <QCoroTask>
 
+#include <QFuture>
 #include <QNetworkCookie>
 #include <QObject>
 #include <QPointer>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
 
 #include <atomic>
+#include <cstdint>
+#include <deque>
 #include <expected>
 #include <functional>
 #include <map>
+#include <optional>
 #include <set>
 #include <stop_token>
 #include <variant>
 #include <vector>
 
+#include "fetchscheduler.h"
 #include "fetchsourcekey.h"
 #include "item.h"
 #include "refreshoutcome.h"
@@ -72,6 +78,7 @@ struct ParseResult
     std::vector<ItemLocation> tabs;
     Items items;
     std::set<QString> tab_id_index;
+    std::map<FetchSourceKey, FetchScheduler::History> fetch_history;
 };
 
 // Read-only observation of the deferred task sweep (network-redesign phase 5,
@@ -109,6 +116,9 @@ public:
     // Runs on the parser thread and must not touch m_settings (QSettings is
     // not thread-safe for one shared instance the UI writes concurrently); it
     // reads only the datastore and the realm/league captured at construction.
+    // The parser thread is the reader stage of a pipeline: it streams the
+    // cached blobs to a pool of parse workers, joined before it returns, and
+    // merges their Items back in source order.
     ParseResult ParseCachedItems(const QString &dataDir) const;
 
 signals:
@@ -160,14 +170,20 @@ signals:
     // ever persisted.
     void characterReceived(const poe::Character &character,
                            const QByteArray &bytes,
+                           const QByteArray &digest,
                            const QString &realm);
     void stashListReceived(const std::vector<poe::StashTab> &stashes,
                            const QString &realm,
                            const QString &league);
     void stashReceived(const poe::StashTab &stash,
                        const QByteArray &bytes,
+                       const QByteArray &digest,
                        const QString &realm,
                        const QString &league);
+    // Emitted instead of stashReceived when a reply's bytes match the last
+    // ones its items were built from: the datastore already holds them, so
+    // it only records the fetch.
+    void stashUnchanged(const QString &stash_id, const QString &realm, const QString &league);
 
     // Authoritative-list signals (F53): emitted only for a fresh top-level
     // list (never for ProcessTab's folder-children re-emits of
@@ -190,6 +206,11 @@ public slots:
     void OnRePoEReady();
     void Update(Util::TabSelection type, const std::vector<ItemLocation> &tab_names = {});
 
+    // Back-pressure from the write-behind store (its backlogChanged): while
+    // it is backlogged, finished content replies wait in m_pending_replies
+    // instead of being handled, since handling one queues its write.
+    void OnStoreBacklog(bool backlogged);
+
 private:
     // Every handler takes one already-classified result (phase 4b): the
     // transport check, the status check, and the parse the handlers used to
@@ -199,10 +220,37 @@ private:
     using Result = std::expected<T, RateLimit::FetchError>;
 
     void OnStashListReceived(const Result<poe::StashListWrapper> &result);
-    void OnStashReceived(const Result<poe::StashPayload> &result, const ItemLocation &location);
+    // `delta` is the reply's Items when the parse pool already built them;
+    // otherwise the handler builds them inline. A reply whose digest matches
+    // the source's last one is unchanged: the facade never parsed its items,
+    // and nothing is replaced, emitted, or rewritten for it.
+    void OnStashReceived(const Result<poe::StashPayload> &result,
+                         const ItemLocation &location,
+                         std::optional<Items> delta = std::nullopt);
     void OnCharacterListReceived(const Result<poe::CharacterListWrapper> &result);
     void OnCharacterReceived(const Result<poe::CharacterPayload> &result,
-                             const ItemLocation &location);
+                             const ItemLocation &location,
+                             std::optional<Items> delta = std::nullopt);
+
+    // The content-reply parse stage. A reply with at least
+    // m_pool_parse_min_items items has its Items built on m_parse_pool, so a
+    // quad or map tab's Item construction (mod tables, hashes) never runs on
+    // the UI thread; smaller replies build inline, where the hop would cost
+    // more than it saves. Either way the handler — the atomic
+    // ReplaceSource, the TabRefreshed emit, the datastore courier — runs
+    // here, on the worker's thread, in reply order: each reply takes a
+    // ticket when its fetch resumes, and a ticket's handler waits for every
+    // earlier ticket's. The stop-token gate runs when the handler does, so a
+    // reply whose update stopped while it parsed is discarded like any
+    // straggler, and a stopped ticket never holds up a live one.
+    QFuture<Items> BuildOnParsePool(std::function<Items()> build);
+    std::uint64_t EnqueueReply(const std::stop_token &token);
+    void CompleteReply(std::uint64_t ticket, std::function<void()> handler);
+    void DrainReplies();
+
+    // Hands the heap the replies' transient poe:: graphs left behind (see
+    // util/heap.h), off this thread: a trim walks every arena.
+    void ReleaseParseMemory();
 
     enum class WorkerState { Initializing, Idle, Updating };
 
@@ -210,20 +258,20 @@ private:
     bool isUpdating() const { return m_state == WorkerState::Updating; }
     void StartParseThread();
     void OnParseCompleted(ParseResult result);
-    void LoadItems(const poe::Character &character,
-                   ItemLocation location,
-                   ParseResult &result) const;
-    void LoadItems(const poe::StashTab &stash, ItemLocation location, ParseResult &result) const;
+    void LoadItems(const poe::Character &character, ItemLocation location, Items &out) const;
+    void LoadItems(const poe::StashTab &stash, ItemLocation location, Items &out) const;
     void RebaseItemLocations(ItemLocationType type);
     void SubmitStashListRequest();
     void SubmitCharacterListRequest();
     // Launch a whole content batch at once (D6, F56): no worker-side pacing, no
     // one-at-a-time submission. The batch is a local vector the caller built —
     // one policy lane's worth of fetches (a list's content, or a parent reply's
-    // discovered children) in source traversal order. The whole batch's needed
+    // discovered children) in source traversal order, which LaunchContent
+    // reorders likeliest-changed first (m_fetch_scheduler) and, when `limit`
+    // is non-zero, cuts to its first `limit` entries. The whole batch's needed
     // counters are initialized before its first launch, because a ready/fail-fast
     // future runs its completion synchronously inside the launch loop (IR2/S1-6).
-    void LaunchContent(std::vector<ItemsRequest> batch);
+    void LaunchContent(std::vector<ItemsRequest> batch, size_t limit = 0);
 
     // The root orchestration (D6, rev. 10): it launches the update's required
     // list(s) without awaiting one another and returns. It is an ordinary
@@ -302,14 +350,25 @@ private:
     void SweepTasks();
 
     void SendStatusUpdate();
-    void ParseItems(const std::vector<poe::Item> &items,
-                    const ItemLocation &base_location,
-                    Items &out) const;
+    // These touch no worker state, so the parse pool runs them too.
+    static void ParseItems(const std::vector<poe::Item> &items,
+                           const ItemLocation &base_location,
+                           Items &out);
+    static void ParseCharacterItems(const poe::Character &character,
+                                    const ItemLocation &location,
+                                    Items &out);
+    static size_t CountCharacterItems(const poe::Character &character);
     void CheckUpdateFinished();
     void FinishUpdate();
 
     void ProcessTab(const poe::StashTab &tab, std::vector<ItemsRequest> &batch);
 
+    // Every erase from m_items goes through here: it also forgets each erased
+    // source's change history, because an unchanged reply is only safe to
+    // skip while the items it would have rebuilt are still held.
+    size_t EraseSourcesIf(
+        const std::function<bool(const FetchSourceKey &, const ItemLocation &)> &pred);
+
     QSettings &m_settings;
     BuyoutManager &m_buyout_manager;
     PoeApiClient &m_api;
@@ -362,13 +421,25 @@ private:
     bool m_delivering_terminal{false};
 
     // The current update's content selection: refresh everything
-    // (All/TabsOnly), or only the tabs/characters whose ids are listed. A
+    // (All/TabsOnly/Quick), or only the tabs/characters whose ids are listed. A
     // partial refresh fetches strictly its selection; a newly discovered
     // tab is listed but not fetched until a full refresh or a selection
     // reaches it (F55, revised).
     bool m_update_all;
     std::set<QString> m_tabs_to_update;
 
+    // A quick refresh (TabSelection::Quick) lists everything like a full
+    // one but fetches only the first m_quick_refresh_limit sources of each
+    // list's ranked batch; zero for every other selection. Children a
+    // fetched parent discovers are never cut.
+    size_t m_quick_refresh_limit{0};
+
+    // Each source's change history, which LaunchContent ranks batches by and
+    // OnStashReceived compares digests against. Seeded from the datastore at
+    // startup (only for sources whose cache loaded), updated by every
+    // accepted reply.
+    FetchScheduler m_fetch_scheduler;
+
     bool m_need_stash_list;
     bool m_need_character_list;
 
@@ -395,6 +466,24 @@ private:
     // turn coalesce into a single SweepTasks() run.
     bool m_sweep_scheduled{false};
 
+    // Content replies awaiting their turn, in ticket (reply) order. An entry
+    // without a handler is still parsing.
+    struct PendingReply
+    {
+        std::uint64_t ticket{0};
+        std::stop_token token;
+        std::function<void()> handler;
+    };
+    std::deque<PendingReply> m_pending_replies;
+    std::uint64_t m_next_reply_ticket{0};
+    bool m_store_backlogged{false};
+    size_t m_pool_parse_min_items{256};
+
+    // Destroyed after m_fetch_tasks and before everything else: its
+    // destructor waits out any running build, which owns its inputs and
+    // touches no worker state.
+    QThreadPool m_parse_pool;
+
     // Owned per-fetch coroutine handles (D6/R4-3). Declared LAST so they
     // destruct FIRST: at worker destruction a suspended frame is detached
     // (S1-1), and it must be released before any member its frame could still
@@ -49,6 +49,10 @@ public:
         : m_repo(repo)
     {}
 
+    // The plan matches legacy buyouts against the stash and character rows
+    // these repos read. Replies are persisted write-behind on another
+    // connection, so the caller flushes WriteBehindStore first or the plan
+    // can miss the latest refresh.
     LegacyBuyoutImporter(BuyoutRepo &repo,
                          StashRepo &stashes,
                          CharacterRepo &characters,
@@ -92,11 +92,16 @@ int main(int argc, char *argv[])
     option_log_level.setDescription("How much to log.");
     option_log_level.setValueName("log-level");
 
+    QCommandLineOption option_sync_log("sync-log");
+    option_sync_log.setDescription(
+        "Write log messages on the thread that logs them instead of a background thread.");
+
     QCommandLineParser parser;
     parser.addHelpOption();
     parser.addVersionOption();
     parser.addOption(option_data_dir);
     parser.addOption(option_log_level);
+    parser.addOption(option_sync_log);
     parser.process(a);
 
     // Setup the data dir, which is where the log will be written.
@@ -131,7 +136,8 @@ int main(int argc, char *argv[])
 
     // Setup logging.
     const QString logPath(appDataDir.filePath("log.txt"));
-    logging::init(logPath);
+    logging::init(logPath,
+                  parser.isSet(option_sync_log) ? logging::Mode::Sync : logging::Mode::Async);
 
     // Determine the logging level. The command-line argument takes first priority.
     // If no command line argument is present, Acquistion will check for a logging
@@ -186,7 +192,10 @@ int main(int argc, char *argv[])
     // (An aboutToQuit hook is too early: it fires before Application is
     // destroyed, and a still-running parser thread would then log through a
     // destroyed default logger and crash.)
-    auto loggingShutdown = qScopeGuard([] { spdlog::shutdown(); });
+    auto loggingShutdown = qScopeGuard([] {
+        logging::flush();
+        spdlog::shutdown();
+    });
 
     // Construct an instance of Application.
     Application app(appDataDir);
@@ -67,6 +67,15 @@ struct ModelProbes
     // fired it. The delta-debounce pin asserts a burst yields one.
     std::int64_t column_resizes = 0;
 
+    // Filter edits Search::FilterItems applied as row operations rather
+    // than a reset (the narrowing/widening path). Those runs count neither
+    // as refilters nor as index rebuilds.
+    std::int64_t incremental_refilters = 0;
+
+    // Detail-pane renders on the UI thread: TooltipCache::Get misses.
+    // Background prewarm renders are not counted (and run off-thread).
+    std::int64_t tooltip_renders = 0;
+
     // Gauge, not a counter; sites live since S3 (D1 residency): estimated
     // bytes of resident sort keys, adjusted at hydration, entry rebuild,
     // and eviction (ResidentKeyStore). Unlike the counters, the gauge is
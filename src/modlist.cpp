@@ -3,15 +3,18 @@
 
 #include "modlist.h"
 
-#include <QRegularExpression>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlQuery>
 #include <QtSql/QSqlRecord>
 
-#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "item.h"
@@ -19,17 +22,289 @@
 #include "repoe/stattranslation.h"
 #include "util/glaze_qt.h"
 #include "util/spdlog_qt.h"
-#include "util/util.h"
 
 namespace {
 
     QStringListModel m_mod_list_model;
     std::set<QString> mods;
-    std::unordered_map<QString, SumModGenerator *> mods_map;
-    std::vector<SumModGen> mod_generators;
+
+    // The global modifier dictionary (see InitModList). Ids below
+    // natural_count are the stat-translation templates (and pseudo mod names,
+    // which InitStatTranslations seeds into the same set); the ones above
+    // are pseudo mods the mods set did not already contain, which only the
+    // pseudo sums write.
+    std::unordered_map<QString, ModifierId> modifier_ids;
+    std::vector<QString> modifier_names;
+    ModifierId natural_count = 0;
 
     const PseudoModManager pseudo_mgr;
 
+    ModifierId InternName(const QString &name)
+    {
+        const auto [it, inserted] = modifier_ids.try_emplace(name,
+                                                             static_cast<ModifierId>(
+                                                                 modifier_names.size()));
+        if (inserted) {
+            modifier_names.push_back(name);
+        }
+        return it->second;
+    }
+
+    bool IsAsciiDigit(QChar c)
+    {
+        return (c >= u'0') && (c <= u'9');
+    }
+
+    // Reads the leading number of a [0-9.]+ run the way strtod would (so
+    // "1.2.3" is 1.2 and a lone "." is 0), in hundredths with the third
+    // decimal rounding half-up.
+    std::int32_t ParseHundredths(QStringView run)
+    {
+        const qsizetype n = run.size();
+        qsizetype i = 0;
+        std::int64_t int_part = 0;
+        while ((i < n) && IsAsciiDigit(run[i])) {
+            int_part = std::min<std::int64_t>((int_part * 10) + (run[i].unicode() - u'0'),
+                                              std::numeric_limits<std::int32_t>::max());
+            ++i;
+        }
+
+        std::int64_t frac = 0;
+        bool round_up = false;
+        if ((i + 1 < n) && (run[i] == u'.') && IsAsciiDigit(run[i + 1])) {
+            ++i;
+            for (int position = 0; (i < n) && IsAsciiDigit(run[i]); ++position, ++i) {
+                const int d = run[i].unicode() - u'0';
+                if (position < 2) {
+                    frac += d * ((position == 0) ? 10 : 1);
+                } else if (position == 2) {
+                    round_up = (d >= 5);
+                }
+            }
+        }
+
+        const std::int64_t value = (int_part * 100) + frac + (round_up ? 1 : 0);
+        return static_cast<std::int32_t>(
+            std::min<std::int64_t>(value, std::numeric_limits<std::int32_t>::max()));
+    }
+
+    // The end of the [0-9.]+ run starting at `begin`.
+    qsizetype NumberRunEnd(QStringView s, qsizetype begin)
+    {
+        qsizetype end = begin + 1;
+        while ((end < s.size()) && (IsAsciiDigit(s[end]) || (s[end] == u'.'))) {
+            ++end;
+        }
+        return end;
+    }
+
+    // The mod templates AddModToTable resolves, compiled by InitModList into
+    // a trie over UTF-16 code units in which '#' stands for a whole number.
+    // The walk takes each maximal [0-9.]+ run of a raw line as one '#' step
+    // and parses the number on the way, so normalizing, looking up, and
+    // valuing a line is one pass with no allocation, and a line no template
+    // starts with is rejected at its first unknown code unit. A leaf holds
+    // everything its template feeds: its own id as a natural mod and the
+    // summing pseudo mods it adds to.
+    //
+    // A literal '#' in a line steps along '#' without a number, exactly as
+    // it survived the old substitution; templates that contain digits or
+    // '.' could never match a normalized line and are left out.
+    class ModMatcher
+    {
+    public:
+        void Clear()
+        {
+            m_pending.clear();
+            m_nodes.clear();
+            m_edges.clear();
+            m_leaves.clear();
+            m_pseudo.clear();
+        }
+
+        void AddNatural(const QString &pattern, ModifierId id)
+        {
+            if (Matchable(pattern)) {
+                m_pending[pattern].natural = id;
+            }
+        }
+
+        void AddPseudo(const QString &pattern, ModifierId id)
+        {
+            if (Matchable(pattern)) {
+                m_pending[pattern].pseudo.push_back(id);
+            }
+        }
+
+        // Lays the pending templates out breadth-first, each node's edges
+        // contiguous and sorted by code unit. The templates are sorted, so
+        // every node's subtree is a contiguous run of them.
+        void Compile()
+        {
+            std::vector<std::pair<const QString *, const Targets *>> patterns;
+            patterns.reserve(m_pending.size());
+            for (const auto &[pattern, targets] : m_pending) {
+                patterns.emplace_back(&pattern, &targets);
+            }
+
+            struct Range
+            {
+                std::uint32_t node;
+                size_t lo;
+                size_t hi;
+                qsizetype depth;
+            };
+            m_nodes.assign(1, Node{});
+            std::vector<Range> queue;
+            if (!patterns.empty()) {
+                queue.push_back({0, 0, patterns.size(), 0});
+            }
+            for (size_t next = 0; next < queue.size(); ++next) {
+                const Range range = queue[next];
+                size_t lo = range.lo;
+                if (patterns[lo].first->size() == range.depth) {
+                    m_nodes[range.node].leaf = AddLeaf(*patterns[lo].second);
+                    ++lo;
+                }
+                const auto first_edge = static_cast<std::uint32_t>(m_edges.size());
+                while (lo < range.hi) {
+                    const char16_t unit = patterns[lo].first->at(range.depth).unicode();
+                    size_t hi = lo + 1;
+                    while ((hi < range.hi)
+                           && (patterns[hi].first->at(range.depth).unicode() == unit)) {
+                        ++hi;
+                    }
+                    const auto child = static_cast<std::uint32_t>(m_nodes.size());
+                    m_nodes.push_back(Node{});
+                    m_edges.push_back({unit, child});
+                    queue.push_back({child, lo, hi, range.depth + 1});
+                    lo = hi;
+                }
+                // Already ascending unless a surrogate pair sorted as a
+                // code point; Child's binary search needs code units.
+                std::sort(m_edges.begin() + first_edge,
+                          m_edges.end(),
+                          [](const Edge &a, const Edge &b) { return a.unit < b.unit; });
+                m_nodes[range.node].first_edge = first_edge;
+                m_nodes[range.node].edge_count = static_cast<std::uint32_t>(m_edges.size())
+                                                 - first_edge;
+            }
+            m_pending.clear();
+            m_nodes.shrink_to_fit();
+            m_edges.shrink_to_fit();
+        }
+
+        size_t node_count() const { return m_nodes.size(); }
+
+        // A mod's value is the average of its numbers (Util::MatchMod's
+        // rule); a line without numbers has none.
+        void Apply(QStringView line, ModTable &output) const
+        {
+            if (m_nodes.empty()) {
+                return;
+            }
+            std::uint32_t node = 0;
+            std::int64_t sum = 0;
+            std::int64_t count = 0;
+            for (qsizetype i = 0; i < line.size();) {
+                char16_t unit = line[i].unicode();
+                if (IsAsciiDigit(line[i]) || (unit == u'.')) {
+                    const qsizetype end = NumberRunEnd(line, i);
+                    sum += ParseHundredths(line.sliced(i, end - i));
+                    ++count;
+                    unit = u'#';
+                    i = end;
+                } else {
+                    ++i;
+                }
+                node = Child(node, unit);
+                if (node == kNone) {
+                    return;
+                }
+            }
+            const std::uint32_t leaf_index = m_nodes[node].leaf;
+            if (leaf_index == kNone) {
+                return;
+            }
+
+            const Leaf &leaf = m_leaves[leaf_index];
+            const std::int32_t value = (count == 0) ? ModTable::kNoValue
+                                                    : ModTable::FromDouble(
+                                                          static_cast<double>(sum)
+                                                          / static_cast<double>(count) / 100.0);
+            if (leaf.natural != kNoModifier) {
+                output.Set(leaf.natural, value);
+            }
+            for (std::uint32_t k = 0; k < leaf.pseudo_count; ++k) {
+                output.Add(m_pseudo[leaf.first_pseudo + k], value);
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+        struct Targets
+        {
+            ModifierId natural = kNoModifier;
+            std::vector<ModifierId> pseudo;
+        };
+        struct Node
+        {
+            std::uint32_t first_edge = 0;
+            std::uint32_t edge_count = 0;
+            std::uint32_t leaf = kNone;
+        };
+        struct Edge
+        {
+            char16_t unit;
+            std::uint32_t child;
+        };
+        struct Leaf
+        {
+            ModifierId natural;
+            std::uint32_t first_pseudo;
+            std::uint32_t pseudo_count;
+        };
+
+        static bool Matchable(const QString &pattern)
+        {
+            return !pattern.isEmpty()
+                   && std::none_of(pattern.cbegin(), pattern.cend(), [](QChar c) {
+                          return IsAsciiDigit(c) || (c == u'.');
+                      });
+        }
+
+        std::uint32_t AddLeaf(const Targets &targets)
+        {
+            const auto index = static_cast<std::uint32_t>(m_leaves.size());
+            m_leaves.push_back({targets.natural,
+                                static_cast<std::uint32_t>(m_pseudo.size()),
+                                static_cast<std::uint32_t>(targets.pseudo.size())});
+            m_pseudo.insert(m_pseudo.end(), targets.pseudo.begin(), targets.pseudo.end());
+            return index;
+        }
+
+        std::uint32_t Child(std::uint32_t node, char16_t unit) const
+        {
+            const Node &n = m_nodes[node];
+            const auto first = m_edges.begin() + n.first_edge;
+            const auto last = first + n.edge_count;
+            const auto it = std::lower_bound(first, last, unit, [](const Edge &e, char16_t u) {
+                return e.unit < u;
+            });
+            return ((it != last) && (it->unit == unit)) ? it->child : kNone;
+        }
+
+        std::map<QString, Targets> m_pending;
+        std::vector<Node> m_nodes;
+        std::vector<Edge> m_edges;
+        std::vector<Leaf> m_leaves;
+        std::vector<ModifierId> m_pseudo;
+    };
+
+    // Immutable between InitModList calls, like the dictionary.
+    ModMatcher mod_matcher;
+
 } // namespace
 
 /*
@@ -298,103 +573,56 @@ void InitModList()
 {
     spdlog::trace("InitModList() entered");
 
-    std::set<QString> mod_strings;
-    mod_generators.clear();
-    mods_map.clear();
-    for (auto &mod : mods) {
-        if (mod_strings.count(mod) > 0) {
-            spdlog::warn("InitModList(): duplicate mod: {}", mod);
-        } else {
-            mod_strings.insert(mod);
-            std::vector<QString> list = {mod};
-            SumModGen gen = std::make_shared<SumModGenerator>(mod, list);
-            mods_map[mod] = gen.get();
-            mod_generators.push_back(gen);
+    // Ids follow the mods set's order, so a given set of stat translations
+    // always produces the same dictionary.
+    modifier_ids.clear();
+    modifier_names.clear();
+    mod_matcher.Clear();
+    modifier_ids.reserve(mods.size());
+    modifier_names.reserve(mods.size());
+    for (const auto &mod : mods) {
+        mod_matcher.AddNatural(mod, InternName(mod));
+    }
+    natural_count = static_cast<ModifierId>(modifier_names.size());
+
+    // Pseudo mods get ids even when InitStatTranslations did not seed them,
+    // so the sums never depend on initialization order.
+    for (const auto &[pseudo_mod, real_mods] : pseudo_mgr.SUMMING_MODS) {
+        InternName(pseudo_mod);
+    }
+    for (const auto &[real_mod, pseudo_mods] : pseudo_mgr.SUMMING_MODS_LOOKUP) {
+        for (const auto &pseudo_mod : pseudo_mods) {
+            mod_matcher.AddPseudo(real_mod, modifier_ids.at(pseudo_mod));
         }
     }
+    mod_matcher.Compile();
+    spdlog::debug("InitModList(): {} modifiers in the dictionary, {} matcher nodes",
+                  modifier_names.size(),
+                  mod_matcher.node_count());
+
     QStringList mod_list;
-    mod_list.reserve(mod_strings.size());
-    for (auto &mod : mod_strings) {
+    mod_list.reserve(mods.size());
+    for (auto &mod : mods) {
         mod_list.append(mod);
     }
     mod_list.sort(Qt::CaseInsensitive);
     m_mod_list_model.setStringList(mod_list);
 }
 
-SumModGenerator::SumModGenerator(const QString &name, const std::vector<QString> &matches)
-    : m_name(name)
-    , m_matches(matches)
-{}
-
-bool SumModGenerator::Match(const char *mod, double &output)
-{
-    bool found = false;
-    output = 0.0;
-    for (auto &match : m_matches) {
-        double result = 0.0;
-        if (Util::MatchMod(match.toStdString().c_str(), mod, &result)) {
-            output += result;
-            found = true;
-        }
-    }
-    return found;
-}
-
-void SumModGenerator::Generate(const QString &mod, ModTable &output)
-{
-    double result;
-    if (Match(mod.toStdString().c_str(), result)) {
-        output[m_name] = result;
-    }
-}
-
 void AddModToTable(const QString &raw_mod, ModTable &output)
 {
-    QString generic_mod = raw_mod;
-
-    if (generic_mod.startsWith("1 Added Passive Skill")) {
+    if (raw_mod.startsWith("1 Added Passive Skill")) {
         // Skip modifiers that appear to be cluster jewel notables.
         // This is such a terrible hack. The entire mods stuff needs to be completely redone.
-    } else {
-        static const QRegularExpression rep("([0-9\\.]+)");
-        generic_mod.replace(rep, "#");
-    }
-
-    const std::string raw_str = raw_mod.toStdString();
-
-    // First, process natural modifiers.
-    {
-        auto it = mods_map.find(generic_mod);
-        if (it != mods_map.end()) {
-            SumModGenerator *gen = it->second;
-            gen->Generate(raw_mod, output);
-        }
-    }
-
-    // Next, process summing pseudo-mods.
-    {
-        auto it = pseudo_mgr.SUMMING_MODS_LOOKUP.find(generic_mod);
-        if (it != pseudo_mgr.SUMMING_MODS_LOOKUP.end()) {
-            const std::string generic_str = generic_mod.toStdString();
-
-            // Get the list of summing pseudo-mods this modifier impacts.
-            const std::vector<QString> &pseudo_mods = it->second;
-
-            // Process each summing pseudo-mod.
-            for (const QString &pseudo_mod : pseudo_mods) {
-                double value;
-                Util::MatchMod(generic_str.c_str(), raw_str.c_str(), &value);
-                if (output.contains(pseudo_mod)) {
-                    output[pseudo_mod] += value;
-                } else {
-                    output[pseudo_mod] = value;
-                }
-            }
+        const auto it = modifier_ids.find(raw_mod);
+        if ((it != modifier_ids.end()) && (it->second < natural_count)) {
+            output.Set(it->second, ModTable::kNoValue);
         }
+        return;
     }
+    mod_matcher.Apply(raw_mod, output);
 }
 
-/*
 NormalizedModifier normalize_modifier(QStringView s)
 {
     NormalizedModifier r;
@@ -402,87 +630,43 @@ NormalizedModifier normalize_modifier(QStringView s)
 
     const qsizetype n = s.size();
     qsizetype i = 0;
-
     while (i < n) {
-        const QChar u0 = s[i];
-
-        const bool startsInt = u0.isDigit();
-        const bool startsDotFrac = (u0 == '.') && ((i + 1) < n) && s[i + 1].isDigit();
-
-        if (startsInt || startsDotFrac) {
-            r.normalized.append("#"); // one token per number
-
-            // Integer part (optional if starts with ".")
-            int64_t intPart = 0;
-            while ((i < n) && s[i].isDigit()) {
-                intPart = (intPart * 10) + s[i].unicode() - QChar('0').unicode();
-                ++i;
-            }
-
-            // Fractional part: '.' + digits (optional)
-            int64_t frac = 0;     // store up to 2 digits
-            int fracCount = 0;    // digits stored (0..2)
-            bool roundUp = false; // 3rd fractional digit rounds half-up
-
-            if ((i < n) && (s[i] == '.') && ((i + 1) < n) && s[i + 1].isDigit()) {
-                ++i; // consume '.'
-
-                int fracPos = 0;
-                while ((i < n) && s[i].isDigit()) {
-                    const int d = s[i].unicode() - QChar('0').unicode();
-
-                    if (fracPos < 2) {
-                        frac = (frac * 10) + d;
-                        ++fracCount;
-                    } else if (fracPos == 2) {
-                        roundUp = (d >= 5);
-                    }
-                    ++fracPos;
-                    ++i;
-                }
-            }
-
-            if (fracCount == 1) {
-                frac *= 10; // ".5" => 50
-            }
-            // fracCount == 0 => 0; fracCount == 2 => already correct
-
-            int64_t v = (intPart * 100) + frac;
-            if (roundUp) {
-                ++v;
-            }
-
-            // If you want safety, clamp here. Assuming values fit:
-            r.values_x100.push_back(static_cast<int32_t>(v));
+        const QChar c = s[i];
+        if (!IsAsciiDigit(c) && (c != u'.')) {
+            r.normalized.append(c);
+            ++i;
             continue;
         }
 
-        // Non-number: lowercase (your original behavior)
-        r.normalized.append(u0.toLower());
-        ++i;
+        // One token per number: the whole [0-9.]+ run, as the regex
+        // substitution this replaces matched it.
+        const qsizetype end = NumberRunEnd(s, i);
+        r.normalized.append(u'#');
+        r.values_x100.push_back(ParseHundredths(s.sliced(i, end - i)));
+        i = end;
     }
-
     return r;
 }
 
-uint32_t intern_modifier(const QString &modifier)
+InternedModifier intern_modifier(QStringView modifier)
 {
-    const uint32_t id = static_cast<uint32_t>(modifier_strings.size());
-
-    if (id == modifier_strings.capacity()) {
-        modifier_strings.reserve(id + 500);
-    }
+    NormalizedModifier normalized = normalize_modifier(modifier);
+    return {modifier_id(normalized.normalized), std::move(normalized.values_x100)};
+}
 
-    QString mod = normalize_modifier(QStringView(modifier));
+ModifierId modifier_id(const QString &name)
+{
+    const auto it = modifier_ids.find(name);
+    return (it != modifier_ids.end()) ? it->second : kNoModifier;
+}
 
-    auto [it, inserted] = modifier_ids.try_emplace(std::move(mod), id);
-    if (inserted) {
-        // Store a view into the QString owned by the unordered_map key.
-        modifier_strings.push_back(QStringView(it->first));
-        return id;
-    }
+const QString &modifier_name(ModifierId id)
+{
+    static const QString unknown;
+    return (id < modifier_names.size()) ? modifier_names[id] : unknown;
+}
 
-    // Already existed; return existing id (and do NOT push to modifier_strings).
-    return it->second;
+size_t modifier_count()
+{
+    return modifier_names.size();
 }
-*/
@@ -9,66 +9,52 @@
 #include <QStringListModel>
 #include <QStringView>
 
-#include <memory>
-#include <unordered_map>
+#include <cstdint>
 #include <vector>
 
-class Item;
-typedef std::unordered_map<QString, double> ModTable;
+#include "modtable.h"
 
-// This generates regular expressions for mods and does other setup, should be called when the app starts, perhaps in main()
-// Maybe this is not needed and constexpr could do the trick, but VS doesn't support it right now.
+// Builds the mod list model and the global modifier dictionary from the
+// loaded stat translations: every mod template plus every summing pseudo
+// mod gets a ModifierId. The dictionary is immutable between InitModList
+// calls, which run before the worker parses anything (RePoE gates it), so
+// parser threads read it without locking.
 void InitModList();
 
 QStringListModel &mod_list_model();
 
-class ModGenerator
-{
-public:
-    virtual ~ModGenerator() {};
-    virtual void Generate(const QString &json, ModTable &output) = 0;
-};
-
-class SumModGenerator : public ModGenerator
-{
-public:
-    SumModGenerator(const QString &name, const std::vector<QString> &sum);
-    virtual ~SumModGenerator() {};
-    virtual void Generate(const QString &json, ModTable &output);
-
-private:
-    bool Match(const char *mod, double &output);
-
-    QString m_name;
-    std::vector<QString> m_matches;
-};
-
-typedef std::shared_ptr<SumModGenerator> SumModGen;
-
 void InitStatTranslations();
 void AddStatTranslations(const QByteArray &statTranslations);
-void AddModToTable(const QString &mod, ModTable &output);
 
-//------------------------------
-/*
+// Adds one raw mod line to an item's table: its own value when it is a
+// known template, and its contribution to every summing pseudo mod it
+// feeds. Runs the matcher InitModList compiles, in one allocation-free pass.
+void AddModToTable(const QString &mod, ModTable &output);
 
+// A mod line with every number replaced by '#' — the template form the
+// stat translations use — plus the numbers themselves in hundredths,
+// rounded half-up on the third decimal. A number is a maximal run of ASCII
+// digits and '.', read the way strtod reads it, so templates are exactly
+// the ones the old regex substitution produced.
 struct NormalizedModifier
 {
     QString normalized;
-    std::vector<int32_t> values_x100;
+    std::vector<std::int32_t> values_x100;
 };
 
+// A normalized mod line resolved against the dictionary; kNoModifier when
+// the template is unknown.
 struct InternedModifier
 {
-    uint32_t id;
-    std::vector<int32_t> values_x100;
+    ModifierId id;
+    std::vector<std::int32_t> values_x100;
 };
 
-static std::unordered_map<QString, uint32_t> modifier_ids;
-static std::vector<QStringView> modifier_strings;
-
 NormalizedModifier normalize_modifier(QStringView s);
+InternedModifier intern_modifier(QStringView modifier);
 
-InternedModifier intern_modifier(QStringView &modifier);
-
-*/
+// Dictionary lookups by template (the strings mod_list_model() offers).
+// modifier_id returns kNoModifier for unknown templates.
+ModifierId modifier_id(const QString &name);
+const QString &modifier_name(ModifierId id);
+size_t modifier_count();
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+// A modifier's id in the global dictionary InitModList builds from the
+// RePoE stat translations and the pseudo mods (see modlist.h).
+using ModifierId = std::uint32_t;
+
+// Never issued by the dictionary: the id of a name it does not know, so a
+// lookup for it fails like the old string lookup did.
+inline constexpr ModifierId kNoModifier = std::numeric_limits<ModifierId>::max();
+
+// An item's modifier values: a flat vector of (id, value x 100) sorted by
+// id, replacing the old QString-keyed hash map. A typical item holds a
+// dozen entries, so one 8-byte entry each beats a hash node holding a
+// QString, and a mods-filter row is a binary search on an integer.
+//
+// Values are fixed-point hundredths (the modlist normalizer's precision).
+// A modifier without numbers keeps the old map's NaN (the matcher's
+// average over zero numbers) through the kNoValue sentinel.
+class ModTable
+{
+public:
+    struct Entry
+    {
+        ModifierId id;
+        std::int32_t value_x100;
+    };
+
+    static constexpr std::int32_t kNoValue = std::numeric_limits<std::int32_t>::min();
+
+    static double ToDouble(std::int32_t value_x100)
+    {
+        return (value_x100 == kNoValue) ? std::numeric_limits<double>::quiet_NaN()
+                                        : value_x100 / 100.0;
+    }
+
+    static std::int32_t FromDouble(double value)
+    {
+        if (std::isnan(value)) {
+            return kNoValue;
+        }
+        const double x100 = std::round(value * 100.0);
+        constexpr double lo = std::numeric_limits<std::int32_t>::min() + 1.0;
+        constexpr double hi = std::numeric_limits<std::int32_t>::max();
+        return static_cast<std::int32_t>(std::clamp(x100, lo, hi));
+    }
+
+    // Overwrites the entry (a natural mod's own value).
+    void Set(ModifierId id, std::int32_t value_x100)
+    {
+        const auto it = LowerBound(id);
+        if ((it != m_entries.end()) && (it->id == id)) {
+            it->value_x100 = value_x100;
+        } else {
+            m_entries.insert(it, Entry{id, value_x100});
+        }
+    }
+
+    // Accumulates into the entry (a summing pseudo mod). Saturates rather
+    // than wrapping; a kNoValue addend poisons the sum like NaN did.
+    void Add(ModifierId id, std::int32_t value_x100)
+    {
+        const auto it = LowerBound(id);
+        if ((it == m_entries.end()) || (it->id != id)) {
+            m_entries.insert(it, Entry{id, value_x100});
+            return;
+        }
+        if ((it->value_x100 == kNoValue) || (value_x100 == kNoValue)) {
+            it->value_x100 = kNoValue;
+            return;
+        }
+        const std::int64_t sum = std::int64_t{it->value_x100} + value_x100;
+        it->value_x100 = static_cast<std::int32_t>(
+            std::clamp<std::int64_t>(sum,
+                                     std::numeric_limits<std::int32_t>::min() + 1,
+                                     std::numeric_limits<std::int32_t>::max()));
+    }
+
+    std::optional<double> value(ModifierId id) const
+    {
+        const auto it = std::lower_bound(m_entries.begin(),
+                                         m_entries.end(),
+                                         id,
+                                         [](const Entry &e, ModifierId v) { return e.id < v; });
+        if ((it == m_entries.end()) || (it->id != id)) {
+            return std::nullopt;
+        }
+        return ToDouble(it->value_x100);
+    }
+
+    bool contains(ModifierId id) const { return value(id).has_value(); }
+    bool empty() const { return m_entries.empty(); }
+    size_t size() const { return m_entries.size(); }
+    auto begin() const { return m_entries.cbegin(); }
+    auto end() const { return m_entries.cend(); }
+    void shrink_to_fit() { m_entries.shrink_to_fit(); }
+
+private:
+    std::vector<Entry>::iterator LowerBound(ModifierId id)
+    {
+        return std::lower_bound(m_entries.begin(),
+                                m_entries.end(),
+                                id,
+                                [](const Entry &e, ModifierId v) { return e.id < v; });
+    }
+
+    std::vector<Entry> m_entries;
+};
@@ -90,13 +90,16 @@ PoeApiClient::Result<poe::StashPayload> PoeApiClient::getStash(const QString &re
                                                                const QString &league,
                                                                const QString &stash_id,
                                                                const QString &substash_id,
+                                                               const QByteArray &known_digest,
                                                                std::stop_token token)
 {
     const auto [endpoint, request] = poe::MakeStashRequest(realm, league, stash_id, substash_id);
     return ParseInto<poe::StashPayload>(m_rate_limiter.SubmitFuture(endpoint,
                                                                     request,
                                                                     std::move(token)),
-                                        &json::readStashPayload,
+                                        [known_digest](const QByteArray &json) {
+                                            return json::readStashPayload(json, known_digest);
+                                        },
                                         endpoint,
                                         request.url());
 }
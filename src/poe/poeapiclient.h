@@ -6,6 +6,7 @@
 #include <expected>
 #include <stop_token>
 
+#include <QByteArray>
 #include <QFuture>
 #include <QString>
 
@@ -63,10 +64,14 @@ public:
                                                       const QString &league,
                                                       std::stop_token token = {});
 
+    // `known_digest` is the digest of the last reply this tab's held items
+    // were built from, if any: a reply whose bytes still match it comes back
+    // `unchanged`, parsed without its items (poe::StashPayload).
     virtual Result<poe::StashPayload> getStash(const QString &realm,
                                                const QString &league,
                                                const QString &stash_id,
                                                const QString &substash_id = {},
+                                               const QByteArray &known_digest = {},
                                                std::stop_token token = {});
 
     virtual Result<poe::CharacterListWrapper> listCharacters(const QString &realm,
@@ -84,11 +84,13 @@ namespace poe {
     // parsed payload plus the exact wire bytes of the reply's "character"
     // sub-object it was parsed from. Members unconditional for the same
     // reason as poe::StashPayload — a missing sub-object is a facade Parse
-    // error, never a success.
+    // error, never a success. `digest` is Util::ContentDigest of `bytes`,
+    // taken by the reader.
     struct CharacterPayload
     {
         poe::Character character;
         QByteArray bytes;
+        QByteArray digest;
     };
 
 } // namespace poe
@@ -106,4 +106,28 @@ namespace glz {
         }
     };
 
+    // The binary item records (util/binary_items.h) carry Flags as the plain
+    // object; only the JSON reader needs the empty-array quirk above.
+    template<>
+    struct from<BEVE, poe::ItemMod::Flags>
+    {
+        template<auto Opts>
+        static void op(poe::ItemMod::Flags &value, auto &&...args)
+        {
+            parse<BEVE>::op<Opts>(static_cast<poe::ItemMod::FlagFields &>(value),
+                                  std::forward<decltype(args)>(args)...);
+        }
+    };
+
+    template<>
+    struct to<BEVE, poe::ItemMod::Flags>
+    {
+        template<auto Opts>
+        static void op(const poe::ItemMod::Flags &value, auto &&...args)
+        {
+            serialize<BEVE>::op<Opts>(static_cast<const poe::ItemMod::FlagFields &>(value),
+                                      std::forward<decltype(args)>(args)...);
+        }
+    };
+
 } // namespace glz
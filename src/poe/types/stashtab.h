@@ -63,10 +63,18 @@ namespace poe {
     // payload that exists always holds a stash and the bytes it was parsed
     // from. Not a wire type and never serialized; the wire shape lives with
     // the reader (json_readers.cpp).
+    //
+    // `digest` is Util::ContentDigest of `bytes`, taken by the reader before
+    // the typed parse. When it equals the digest the caller passed in, the
+    // reply is `unchanged`: the reader parsed only the tab's header — id,
+    // names, metadata and children — and left `stash.items` empty, because
+    // the caller already holds the items those bytes build.
     struct StashPayload
     {
         poe::StashTab stash;
         QByteArray bytes;
+        QByteArray digest;
+        bool unchanged{false};
     };
 
 }; // namespace poe
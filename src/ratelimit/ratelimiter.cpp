@@ -10,17 +10,36 @@
 #include <QThread>
 
 #include <algorithm>
+#include <map>
+#include <vector>
 
+#include "datastore/datastore.h"
 #include "ratelimit/fetcherror.h"
 #include "ratelimit/networkcapture.h"
 #include "ratelimit/ratelimit.h"
 #include "ratelimit/ratelimitmanager.h"
 #include "ratelimit/ratelimitpolicy.h"
+#include "util/glaze_qt.h" // IWYU pragma: keep
 #include "util/networkmanager.h"
 #include "util/spdlog_qt.h" // IWYU pragma: keep
 
 constexpr int UPDATE_INTERVAL_MSEC = 1000;
 
+// Persisted rate-limit state lives under this data store key. The version
+// is bumped whenever the layout below changes; a mismatched state is
+// dropped rather than migrated, since the next probe relearns it.
+constexpr const char *PERSISTED_STATE_KEY = "rate_limit_state";
+constexpr int PERSISTED_STATE_VERSION = 1;
+
+// A persisted state older than this is dropped whole: GGG can retune
+// policies and reshuffle endpoints, and a day-old topology is not worth
+// risking a misrouted pump for when one HEAD per endpoint relearns it.
+constexpr int PERSISTED_STATE_MAX_AGE_SECS = 24 * 60 * 60;
+
+// How long after a policy update the state is written, so a busy refresh
+// costs one write every few seconds rather than one per reply.
+constexpr int PERSIST_DELAY_MSEC = 5000;
+
 // The setup-failure cooldown (D4, named, provisional): a caller
 // resubmitting from its completion handler cannot loop HEAD probes against
 // N16's narrow one-HEAD-at-boot sanction.
@@ -32,6 +51,45 @@ constexpr int SETUP_RETRY_COOLDOWN_SECS = 60;
 constexpr int RETRY_BUCKET_PAD_SECS = 60;
 constexpr int RETRY_BUFFER_SECS = 1;
 
+struct SerializedRateLimitEvent
+{
+    quint64 request_id;
+    QString request_url;
+    qint64 request_time;
+    qint64 received_time;
+    qint64 reply_time;
+    int reply_status;
+};
+
+struct SerializedRateLimitPolicy
+{
+    std::map<QString, QString> headers;
+    std::vector<SerializedRateLimitEvent> history;
+};
+
+struct SerializedRateLimitState
+{
+    int version;
+    qint64 saved_at;
+    std::map<QString, QString> endpoints;
+    std::vector<SerializedRateLimitPolicy> policies;
+};
+
+namespace {
+
+    // Invalid times are stored as zero.
+    qint64 toMSecs(const QDateTime &t)
+    {
+        return t.isValid() ? t.toMSecsSinceEpoch() : 0;
+    }
+
+    QDateTime fromMSecs(qint64 msecs)
+    {
+        return (msecs != 0) ? QDateTime::fromMSecsSinceEpoch(msecs).toLocalTime() : QDateTime();
+    }
+
+} // namespace
+
 RateLimiter::RateLimiter(NetworkManager &network_manager, RateLimit::Scheduler *scheduler)
     : m_network_manager(network_manager)
     , m_scheduler(scheduler ? *scheduler : m_own_scheduler)
@@ -42,7 +100,12 @@ RateLimiter::RateLimiter(NetworkManager &network_manager, RateLimit::Scheduler *
     connect(&m_update_timer, &QTimer::timeout, this, &RateLimiter::SendStatusUpdate);
 }
 
-RateLimiter::~RateLimiter() {}
+RateLimiter::~RateLimiter()
+{
+    if (m_data) {
+        SaveNow();
+    }
+}
 
 void RateLimiter::EnableCapture(const QString &file_path)
 {
@@ -50,6 +113,166 @@ void RateLimiter::EnableCapture(const QString &file_path)
     m_capture = std::make_unique<NetworkCapture>(file_path);
 }
 
+void RateLimiter::EnablePersistence(DataStore &data)
+{
+    m_data = &data;
+    RestoreState(m_data->Get(PERSISTED_STATE_KEY), QDateTime::currentDateTime());
+}
+
+QString RateLimiter::SaveState(const QDateTime &now) const
+{
+    SerializedRateLimitState state{PERSISTED_STATE_VERSION, now.toMSecsSinceEpoch(), {}, {}};
+    for (const auto &[endpoint, manager] : m_manager_by_endpoint) {
+        if (manager->hasPolicy()) {
+            state.endpoints[endpoint] = manager->policy().name();
+        }
+    }
+    for (const auto &[policy_name, manager] : m_manager_by_policy) {
+        if (!manager->hasPolicy()) {
+            continue;
+        }
+        SerializedRateLimitPolicy &policy = state.policies.emplace_back();
+        for (const auto &[name, value] : manager->policy().Headers()) {
+            policy.headers[QString::fromUtf8(name)] = QString::fromUtf8(value);
+        }
+        for (const auto &event : manager->history()) {
+            policy.history.push_back({event.request_id,
+                                      event.request_url,
+                                      toMSecs(event.request_time),
+                                      toMSecs(event.received_time),
+                                      toMSecs(event.reply_time),
+                                      event.reply_status});
+        }
+    }
+
+    const auto result = glz::write_json(state);
+    if (!result) {
+        spdlog::error("Rate limiter: error serializing the rate limit state: {}",
+                      glz::format_error(result.error()));
+        return QString();
+    }
+    return QString::fromStdString(*result);
+}
+
+void RateLimiter::RestoreState(const QString &state, const QDateTime &now)
+{
+    // Nothing saved yet (first use) is not an error.
+    if (state.isEmpty()) {
+        return;
+    }
+
+    const QByteArray bytes{state.toUtf8()};
+    const std::string_view sv{bytes.constData(), size_t(bytes.size())};
+    const auto result = glz::read_json<SerializedRateLimitState>(sv);
+    if (!result) {
+        spdlog::warn("Rate limiter: ignoring an unreadable saved rate limit state: {}",
+                     glz::format_error(result.error()));
+        return;
+    }
+    const SerializedRateLimitState &saved = *result;
+    if (saved.version != PERSISTED_STATE_VERSION) {
+        spdlog::info("Rate limiter: ignoring a saved rate limit state of version {}",
+                     saved.version);
+        return;
+    }
+    const qint64 age_secs = QDateTime::fromMSecsSinceEpoch(saved.saved_at).secsTo(now);
+    if ((age_secs < 0) || (age_secs > PERSISTED_STATE_MAX_AGE_SECS)) {
+        spdlog::info("Rate limiter: the saved rate limit state is {}s old; relearning it",
+                     age_secs);
+        return;
+    }
+
+    for (const auto &policy : saved.policies) {
+        RateLimitPolicy::HeaderList headers;
+        for (const auto &[name, value] : policy.headers) {
+            headers.append({name.toUtf8(), value.toUtf8()});
+        }
+        const auto parsed = RateLimitPolicy::Parse(headers);
+        if (!parsed) {
+            spdlog::warn("Rate limiter: ignoring a saved rate limit policy: {}", parsed.error());
+            continue;
+        }
+        auto existing = m_manager_by_policy.find(parsed->name());
+        if ((existing != m_manager_by_policy.end()) && existing->second->hasPolicy()) {
+            // Learned this session already; what the server said wins.
+            continue;
+        }
+
+        // The state counters were last reported no later than the save, so
+        // aging them from it can only keep them too long, never too short.
+        const RateLimitPolicy aged = parsed->Aged(std::chrono::seconds(age_secs));
+
+        // History older than the longest period cannot hold back a send.
+        int longest_period = 0;
+        for (const auto &rule : aged.rules()) {
+            for (const auto &item : rule.items()) {
+                longest_period = std::max(longest_period, item.limit().period());
+            }
+        }
+        const QDateTime cutoff = now.addSecs(-longest_period);
+        std::deque<RateLimit::Event> history;
+        for (const auto &e : policy.history) {
+            RateLimit::Event event{static_cast<unsigned long>(e.request_id),
+                                   e.request_url,
+                                   fromMSecs(e.request_time),
+                                   fromMSecs(e.received_time),
+                                   fromMSecs(e.reply_time),
+                                   e.reply_status};
+            const QDateTime latest = std::max({event.request_time,
+                                               event.received_time,
+                                               event.reply_time});
+            if (latest < cutoff) {
+                break;
+            }
+            history.push_back(std::move(event));
+        }
+
+        RateLimitManager &manager = GetPolicyManager(aged.name());
+        manager.Restore(aged, std::move(history));
+        if (const int restriction = aged.restriction_secs(); restriction > 0) {
+            spdlog::warn("Rate limiter: policy '{}' is still restricted for {}s",
+                         aged.name(),
+                         restriction);
+            manager.HoldUntil(m_scheduler.Now()
+                              + std::chrono::seconds(restriction + RETRY_BUFFER_SECS));
+        }
+    }
+
+    int endpoints = 0;
+    for (const auto &[endpoint, policy_name] : saved.endpoints) {
+        auto it = m_manager_by_policy.find(policy_name);
+        if ((it == m_manager_by_policy.end()) || m_manager_by_endpoint.contains(endpoint)) {
+            continue;
+        }
+        m_manager_by_endpoint[endpoint] = it->second;
+        ++endpoints;
+    }
+    spdlog::info("Rate limiter: restored {} endpoints and {} policies saved {}s ago",
+                 endpoints,
+                 m_manager_by_policy.size(),
+                 age_secs);
+}
+
+void RateLimiter::SaveNow()
+{
+    m_save_scheduled = false;
+    const QString state = SaveState(QDateTime::currentDateTime());
+    if (!state.isEmpty()) {
+        m_data->Set(PERSISTED_STATE_KEY, state);
+    }
+}
+
+void RateLimiter::ScheduleSave()
+{
+    if (!m_data || m_save_scheduled) {
+        return;
+    }
+    m_save_scheduled = true;
+    m_scheduler.CallAt(m_scheduler.Now() + std::chrono::milliseconds(PERSIST_DELAY_MSEC),
+                       this,
+                       [this]() { SaveNow(); });
+}
+
 QFuture<RateLimit::FetchOutcome> RateLimiter::SubmitFuture(const QString &endpoint,
                                                            QNetworkRequest network_request,
                                                            std::stop_token token)
@@ -440,30 +663,31 @@ RateLimitManager &RateLimiter::GetManager(const QString &endpoint, const QString
     spdlog::trace("RateLimiter::GetManager() endpoint = {}", endpoint);
     spdlog::trace("RateLimiter::GetManager() policy_name = {}", policy_name);
 
-    auto it = m_manager_by_policy.find(policy_name);
-    if (it == m_manager_by_policy.end()) {
-        // Create a new policy manager.
-        spdlog::debug("Creating rate limit policy {} for {}", policy_name, endpoint);
-        auto sender = std::bind_front(&RateLimiter::SendRequest, this);
-        auto mgr = std::make_unique<RateLimitManager>(sender, m_scheduler, m_gate, m_capture.get());
-        auto &manager = m_managers.emplace_back(std::move(mgr));
-        connect(manager.get(),
-                &RateLimitManager::PolicyUpdated,
-                this,
-                &RateLimiter::OnPolicyUpdated);
-        connect(manager.get(), &RateLimitManager::QueueUpdated, this, &RateLimiter::OnQueueUpdated);
-        connect(manager.get(), &RateLimitManager::Paused, this, &RateLimiter::OnManagerPaused);
-        connect(manager.get(), &RateLimitManager::Violation, this, &RateLimiter::OnViolation);
-        m_manager_by_policy[policy_name] = manager.get();
-        m_manager_by_endpoint[endpoint] = manager.get();
-        return *manager;
-    } else {
-        // Use an existing policy manager.
+    if (m_manager_by_policy.contains(policy_name)) {
         spdlog::debug("Using an existing rate limit policy {} for {}", policy_name, endpoint);
-        RateLimitManager *manager = it->second;
-        m_manager_by_endpoint[endpoint] = manager;
-        return *manager;
+    } else {
+        spdlog::debug("Creating rate limit policy {} for {}", policy_name, endpoint);
+    }
+    RateLimitManager &manager = GetPolicyManager(policy_name);
+    m_manager_by_endpoint[endpoint] = &manager;
+    return manager;
+}
+
+RateLimitManager &RateLimiter::GetPolicyManager(const QString &policy_name)
+{
+    auto it = m_manager_by_policy.find(policy_name);
+    if (it != m_manager_by_policy.end()) {
+        return *it->second;
     }
+    auto sender = std::bind_front(&RateLimiter::SendRequest, this);
+    auto mgr = std::make_unique<RateLimitManager>(sender, m_scheduler, m_gate, m_capture.get());
+    auto &manager = m_managers.emplace_back(std::move(mgr));
+    connect(manager.get(), &RateLimitManager::PolicyUpdated, this, &RateLimiter::OnPolicyUpdated);
+    connect(manager.get(), &RateLimitManager::QueueUpdated, this, &RateLimiter::OnQueueUpdated);
+    connect(manager.get(), &RateLimitManager::Paused, this, &RateLimiter::OnManagerPaused);
+    connect(manager.get(), &RateLimitManager::Violation, this, &RateLimiter::OnViolation);
+    m_manager_by_policy[policy_name] = manager.get();
+    return *manager;
 }
 
 QNetworkReply *RateLimiter::SendRequest(const QNetworkRequest &request)
@@ -482,6 +706,7 @@ void RateLimiter::OnUpdateRequested()
 void RateLimiter::OnPolicyUpdated(const RateLimitPolicy &policy)
 {
     spdlog::trace("RateLimiter::OnPolicyUpdated() entered");
+    ScheduleSave();
     emit PolicyUpdate(policy);
 }
 
@@ -26,6 +26,7 @@
 #include "ratelimit/ratelimitedrequest.h"
 #include "ratelimit/scheduler.h"
 
+class DataStore;
 class NetworkCapture;
 class NetworkManager;
 class RateLimitManager;
@@ -69,6 +70,23 @@ public:
     // submission so no manager is created without the capture hook.
     void EnableCapture(const QString &file_path);
 
+    // Persist what this session learns — the endpoint-to-policy topology,
+    // each policy as last received, and each policy's recent send history —
+    // to the user's data store, and restore what an earlier session saved
+    // there. A restored endpoint is Established from the start: its first
+    // submission goes straight to its pump, paced on the carried-over
+    // history, with no HEAD probe. Saves are debounced on the scheduler and
+    // made once more at destruction. Call before the first submission.
+    void EnablePersistence(DataStore &data);
+
+    // The persisted form, stamped `now`, and its restore as of `now`. A
+    // state older than a day is dropped whole; otherwise each policy is
+    // aged by the time since the save, history older than its longest
+    // period is dropped, and a restriction still running holds the pump's
+    // first send. Public so tests can age a state by restoring it later.
+    QString SaveState(const QDateTime &now) const;
+    void RestoreState(const QString &state, const QDateTime &now);
+
 public slots:
     // Used by the GUI to request a manual refresh.
     void OnUpdateRequested();
@@ -174,6 +192,14 @@ private:
     // Get or create the rate limit policy manager for the given endpoint.
     RateLimitManager &GetManager(const QString &endpoint, const QString &policy_name);
 
+    // Get or create the rate limit policy manager for the given policy.
+    RateLimitManager &GetPolicyManager(const QString &policy_name);
+
+    // Write the persisted state to the data store (EnablePersistence), and
+    // schedule that write a little after the policies change.
+    void SaveNow();
+    void ScheduleSave();
+
     // This function is passed to individual managers via a bound
     // function so they can send network requests without having
     // to know anything about OAuth.
@@ -218,4 +244,8 @@ private:
     std::map<const QString, RateLimitManager *> m_manager_by_endpoint;
 
     unsigned int m_violation_count{0};
+
+    // Where learned state is persisted; null unless persistence is enabled.
+    DataStore *m_data{nullptr};
+    bool m_save_scheduled{false};
 };
@@ -94,6 +94,26 @@ const RateLimitPolicy &RateLimitManager::policy()
     return *m_policy;
 }
 
+void RateLimitManager::Restore(const RateLimitPolicy &policy, std::deque<RateLimit::Event> history)
+{
+    m_policy = std::make_unique<RateLimitPolicy>(policy);
+    m_history_size = std::max(m_history_size,
+                              static_cast<size_t>(m_policy->maximum_hits() + HISTORY_BUFFER));
+    m_history = std::move(history);
+    while (m_history.size() > m_history_size) {
+        m_history.pop_back();
+    }
+    spdlog::debug("{}: restored the policy with {} history events",
+                  m_policy->name(),
+                  m_history.size());
+    emit PolicyUpdated(*m_policy);
+
+    if (!m_draining && !m_failed && !m_queue.empty()) {
+        m_draining = true;
+        m_drain_task = Drain();
+    }
+}
+
 int RateLimitManager::msecToNextSend() const
 {
     if (!m_next_send_deadline) {
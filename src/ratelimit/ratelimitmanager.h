@@ -91,6 +91,18 @@ public:
 
     const RateLimitPolicy &policy();
 
+    // Whether a policy has been installed yet, by Update() or Restore().
+    bool hasPolicy() const { return m_policy != nullptr; }
+
+    // Install a policy and send history carried over from an earlier
+    // session — the hub's restore path, taken before anything is queued.
+    // The history is most recent first, as history() returns it; pacing
+    // resumes from it exactly as if the sends had been made here.
+    void Restore(const RateLimitPolicy &policy, std::deque<RateLimit::Event> history);
+
+    // The recorded send history, most recent first.
+    const std::deque<RateLimit::Event> &history() const { return m_history; }
+
     // Hold the next send until no earlier than the given deadline on the
     // scheduler's clock — the D4 HEAD-429 case: the hub establishes (or
     // joins) the pump but the next send waits out Retry-After + pad +
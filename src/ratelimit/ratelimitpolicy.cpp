@@ -166,18 +166,42 @@ namespace {
 
 std::expected<RateLimitPolicy, QString> RateLimitPolicy::Parse(QNetworkReply *const reply)
 {
-    if (!reply->hasRawHeader("X-Rate-Limit-Policy")) {
+    return ParseFrom([reply](const QByteArray &name) -> std::optional<QByteArray> {
+        if (!reply->hasRawHeader(name)) {
+            return std::nullopt;
+        }
+        return reply->rawHeader(name);
+    });
+}
+
+std::expected<RateLimitPolicy, QString> RateLimitPolicy::Parse(const HeaderList &headers)
+{
+    return ParseFrom([&headers](const QByteArray &name) -> std::optional<QByteArray> {
+        for (const auto &[key, value] : headers) {
+            if (key.compare(name, Qt::CaseInsensitive) == 0) {
+                return value;
+            }
+        }
+        return std::nullopt;
+    });
+}
+
+std::expected<RateLimitPolicy, QString> RateLimitPolicy::ParseFrom(const HeaderLookup &header)
+{
+    const auto policy_header = header("X-Rate-Limit-Policy");
+    if (!policy_header) {
         return std::unexpected(QString("missing X-Rate-Limit-Policy header"));
     }
-    const QString policy_name = QString::fromUtf8(reply->rawHeader("X-Rate-Limit-Policy"));
+    const QString policy_name = QString::fromUtf8(*policy_header);
     if (policy_name.isEmpty()) {
         return std::unexpected(QString("empty policy name"));
     }
 
-    if (!reply->hasRawHeader("X-Rate-Limit-Rules")) {
+    const auto rules_header = header("X-Rate-Limit-Rules");
+    if (!rules_header) {
         return std::unexpected(QString("missing X-Rate-Limit-Rules header"));
     }
-    const QByteArrayList rule_names = reply->rawHeader("X-Rate-Limit-Rules").split(',');
+    const QByteArrayList rule_names = rules_header->split(',');
     // Qt's split turns an empty value into a one-element [""] list — the
     // shape behind the out-of-bounds read this parse replaces — so the
     // empty-name check below also rejects an empty rules list.
@@ -192,14 +216,16 @@ std::expected<RateLimitPolicy, QString> RateLimitPolicy::Parse(QNetworkReply *co
     for (const auto &rule_name : rule_names) {
         const QByteArray limit_header = "X-Rate-Limit-" + rule_name;
         const QByteArray state_header = limit_header + "-State";
-        if (!reply->hasRawHeader(limit_header)) {
+        const auto limit_value = header(limit_header);
+        if (!limit_value) {
             return std::unexpected(QString("missing %1 header").arg(QString(limit_header)));
         }
-        if (!reply->hasRawHeader(state_header)) {
+        const auto state_value = header(state_header);
+        if (!state_value) {
             return std::unexpected(QString("missing %1 header").arg(QString(state_header)));
         }
-        const QByteArrayList limit_fragments = reply->rawHeader(limit_header).split(',');
-        const QByteArrayList state_fragments = reply->rawHeader(state_header).split(',');
+        const QByteArrayList limit_fragments = limit_value->split(',');
+        const QByteArrayList state_fragments = state_value->split(',');
         if (limit_fragments.size() != state_fragments.size()) {
             return std::unexpected(QString("rule '%1' has %2 limits but %3 states")
                                        .arg(QString(rule_name))
@@ -265,6 +291,64 @@ RateLimitPolicy::RateLimitPolicy(const QString &name, std::vector<RateLimitRule>
     }
 }
 
+RateLimitPolicy::HeaderList RateLimitPolicy::Headers() const
+{
+    const auto triplet = [](const RateLimitData &data) {
+        return QByteArray::number(data.hits()) + ':' + QByteArray::number(data.period()) + ':'
+               + QByteArray::number(data.restriction());
+    };
+    QByteArrayList rule_names;
+    HeaderList headers;
+    headers.append({"X-Rate-Limit-Policy", m_name.toUtf8()});
+    for (const auto &rule : m_rules) {
+        rule_names.append(rule.name().toUtf8());
+    }
+    headers.append({"X-Rate-Limit-Rules", rule_names.join(',')});
+    for (const auto &rule : m_rules) {
+        QByteArrayList limits;
+        QByteArrayList states;
+        for (const auto &item : rule.items()) {
+            limits.append(triplet(item.limit()));
+            states.append(triplet(item.state()));
+        }
+        const QByteArray limit_header = "X-Rate-Limit-" + rule.name().toUtf8();
+        headers.append({limit_header, limits.join(',')});
+        headers.append({limit_header + "-State", states.join(',')});
+    }
+    return headers;
+}
+
+RateLimitPolicy RateLimitPolicy::Aged(std::chrono::seconds elapsed) const
+{
+    const auto secs = static_cast<qint64>(std::max<std::chrono::seconds::rep>(elapsed.count(), 0));
+    std::vector<RateLimitRule> rules;
+    rules.reserve(m_rules.size());
+    for (const auto &rule : m_rules) {
+        std::vector<RateLimitItem> items;
+        items.reserve(rule.items().size());
+        for (const auto &item : rule.items()) {
+            const auto &state = item.state();
+            const int hits = (secs >= state.period()) ? 0 : state.hits();
+            const int restriction = static_cast<int>(
+                std::max<qint64>(state.restriction() - secs, 0));
+            items.emplace_back(item.limit(), RateLimitData(hits, state.period(), restriction));
+        }
+        rules.emplace_back(rule.name(), std::move(items));
+    }
+    return RateLimitPolicy(m_name, std::move(rules));
+}
+
+int RateLimitPolicy::restriction_secs() const
+{
+    int restriction = 0;
+    for (const auto &rule : m_rules) {
+        for (const auto &item : rule.items()) {
+            restriction = std::max(restriction, item.state().restriction());
+        }
+    }
+    return restriction;
+}
+
 bool RateLimitPolicy::HasSameShape(const RateLimitPolicy &other) const
 {
     if (m_name != other.m_name || m_rules.size() != other.rules().size()) {
@@ -3,16 +3,21 @@
 
 #pragma once
 
+#include <chrono>
 #include <deque>
 #include <expected>
+#include <functional>
+#include <optional>
+#include <utility>
 #include <vector>
 
+#include <QByteArray>
+#include <QList>
 #include <QMetaObject>
 #include <QString>
 
 #include "ratelimit/ratelimit.h"
 
-class QByteArray;
 class QDateTime;
 class QNetworkReply;
 
@@ -95,6 +100,9 @@ class RateLimitPolicy
 {
     Q_GADGET
 public:
+    // Header name/value pairs, the same shape as QNetworkReply::RawHeaderPair.
+    using HeaderList = QList<std::pair<QByteArray, QByteArray>>;
+
     // The total parse (D8): Full means this succeeds, which requires a
     // nonempty policy name; a nonempty rules list; every rule name nonempty,
     // with at least one item and limit/state lists of equal length; every
@@ -105,6 +113,25 @@ public:
     // capture.
     static std::expected<RateLimitPolicy, QString> Parse(QNetworkReply *const reply);
 
+    // The same total parse over a list of headers; names match
+    // case-insensitively, as they do on a reply.
+    static std::expected<RateLimitPolicy, QString> Parse(const HeaderList &headers);
+
+    // The X-Rate-Limit-* headers a reply carrying this policy would have.
+    // Parse(Headers()) yields the same policy; the rate limiter persists
+    // policies in this form, so a restored one passes the same grammar.
+    HeaderList Headers() const;
+
+    // This policy as it stands `elapsed` after its headers were received:
+    // a state counter whose whole period has passed since is reset, and
+    // restrictions count down. Counters still inside their period are kept
+    // as they were, which can only overestimate them.
+    RateLimitPolicy Aged(std::chrono::seconds elapsed) const;
+
+    // The longest remaining restriction across every item, in seconds;
+    // zero when nothing is restricted.
+    int restriction_secs() const;
+
     // Whether two definitions describe the same set of counters. A shape
     // change makes locally-recorded request history inapplicable to the new
     // definition, even when the policy name stays the same.
@@ -124,6 +151,9 @@ public:
 private:
     RateLimitPolicy(const QString &name, std::vector<RateLimitRule> rules);
 
+    using HeaderLookup = std::function<std::optional<QByteArray>(const QByteArray &)>;
+    static std::expected<RateLimitPolicy, QString> ParseFrom(const HeaderLookup &header);
+
     QString m_name;
     std::vector<RateLimitRule> m_rules;
     RateLimit::Status m_status;
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -12,10 +13,12 @@
 #include "bucket.h"
 #include "buyoutmanager.h"
 #include "column.h"
+#include "filters/filterindex.h"
 #include "filters/filtermatchers.h"
 #include "filters/filterspec.h"
 #include "items_model.h"
 #include "modelprobes.h"
+#include "modlist.h"
 #include "util/fatalerror.h"
 #include "util/spdlog_qt.h" // IWYU pragma: keep
 
@@ -44,9 +47,11 @@ namespace {
 Search::Search(BuyoutManager &bo_manager,
                const QString &caption,
                const FilterCatalog &catalog,
-               const LocationInventory *location_inventory)
+               const LocationInventory *location_inventory,
+               const FilterIndex *filter_index)
     : m_bo_manager(bo_manager)
     , m_location_inventory(location_inventory)
+    , m_filter_index(filter_index)
     , m_filter_catalog(catalog)
     , m_model(bo_manager, *this)
     , m_caption(caption)
@@ -127,6 +132,14 @@ void Search::setFilterState(qsizetype index, FilterState state)
     if (current == state) {
         return;
     }
+    // Mod rows resolve to dictionary ids once per edit, not per item. An
+    // edit stored before RePoE built the dictionary stays unresolved, and
+    // the matcher looks it up per call instead of pinning "unknown".
+    if (auto *mods = std::get_if<ModsState>(&state); mods && (modifier_count() > 0)) {
+        for (auto &row : mods->rows) {
+            row.id = modifier_id(row.mod);
+        }
+    }
     current = std::move(state);
     m_states_dirty = true;
 }
@@ -253,6 +266,26 @@ void Search::SortBucket(int row, int column, Qt::SortOrder order)
     bucket_list[static_cast<size_t>(row)].Sort(*m_columns[column], order);
 }
 
+std::optional<Bucket::SortPlan> Search::MakeFlatSortPlan(int column, Qt::SortOrder order) const
+{
+    if ((m_current_mode != ViewMode::ByItem) || m_bucket_by_item.empty() || (column < 0)
+        || (column >= static_cast<int>(m_columns.size()))) {
+        return std::nullopt;
+    }
+    return m_bucket_by_item.front().MakeSortPlan(*m_columns[column], order);
+}
+
+bool Search::CanAdoptFlatSortPlan(const Bucket::SortPlan &plan) const
+{
+    return (m_current_mode == ViewMode::ByItem) && !m_bucket_by_item.empty()
+           && m_bucket_by_item.front().CanAdoptSortPlan(plan);
+}
+
+void Search::AdoptFlatSortPlan(Bucket::SortPlan &&plan)
+{
+    m_bucket_by_item.front().AdoptSortPlan(std::move(plan));
+}
+
 void Search::MarkBucketExpanded(int row)
 {
     auto &bucket_list = active_buckets();
@@ -382,6 +415,13 @@ void Search::FilterItems(const Items &items)
         return;
     }
 
+    // A form edit that provably only narrows or only widens the result
+    // lands as row removals or insertions on the live model: no reset, so
+    // expansion, scroll, and the sorted orders survive untouched.
+    if ((m_refresh_reason == RefreshReason::SearchFormChanged) && RefilterIncrementally(items)) {
+        return;
+    }
+
     if (auto &probes = ModelProbes::instance(); probes.enabled) {
         ++probes.refilters;
     }
@@ -414,8 +454,9 @@ void Search::FilterItems(const Items &items)
     // this flag (hidden empty buckets, default expansion) must be stable
     // across deltas, and the snapshot could be flipped by one delta — a
     // whole-view change no bucket-scoped operation can express. This
-    // definition flips only at filter edits, which are full refilters by
-    // construction (D6).
+    // definition flips only at filter edits, and only through this full
+    // refilter (D6) — the incremental path declines any edit that would
+    // flip it.
     m_filtered = !active_filters.empty();
     m_filtered_item_count = 0;
     m_visible_by_id.clear();
@@ -435,14 +476,37 @@ void Search::FilterItems(const Items &items)
     // bucket renders the freshest metadata seen for its key.
     std::map<LocationInventory::Key, Bucket> bucketed_tabs;
 
+    // Indexable filters are answered for the whole collection up front by
+    // the columnar index, leaving only the rest for the per-item loop. A
+    // collection the index does not hold (tests, a diverged copy) gets no
+    // mask and every active filter stays per-item.
+    std::optional<FilterIndex::RowMask> indexed;
+    std::vector<qsizetype> residual_filters;
+    if (m_filter_index && !active_filters.empty()) {
+        indexed = m_filter_index->Scan(items, m_filter_states, active_filters);
+    }
+    if (indexed) {
+        for (const qsizetype index : active_filters) {
+            if (!m_filter_index->Indexes(index)) {
+                residual_filters.push_back(index);
+            }
+        }
+    }
+    const auto &per_item_filters = indexed ? residual_filters : active_filters;
+
     // Try to minimize the number of times we have to loop over each item,
     // because some players have hundreds of thousands or millions of items.
-    for (const auto &item : items) {
+    for (size_t row = 0; row < items.size(); ++row) {
+        const auto &item = items[row];
+        if (indexed && !FilterIndex::Test(*indexed, row)) {
+            continue;
+        }
+
         // Start by assuming there is a match and run through evey
         // filter until we find that one that will filter out the
         // current item.
         bool matches = true;
-        for (const qsizetype index : active_filters) {
+        for (const qsizetype index : per_item_filters) {
             const auto &state = m_filter_states.at(static_cast<size_t>(index));
             if (!MatchesFilter(*item, m_filter_catalog[index], state)) {
                 // Now that we know this item will be filtered out,
@@ -533,10 +597,206 @@ void Search::FilterItems(const Items &items)
     m_model.SetSorted(false);
     m_model.endUpdate();
 
+    m_applied_states = m_filter_states;
     m_states_dirty = false;
     m_items_dirty = false; // a successful refilter clears its own flag (D9 rule 3)
 }
 
+bool Search::RefilterIncrementally(const Items &items)
+{
+    // The visible result must be exactly the old states applied to this
+    // collection: a clean search whose deltas all landed (R1-7).
+    if (!m_states_dirty || m_items_dirty || !m_filtered
+        || (m_applied_states.size() != m_filter_states.size())) {
+        return false;
+    }
+
+    std::vector<qsizetype> changed;
+    bool narrowing = false;
+    bool widening = false;
+    bool filtered = false;
+    for (qsizetype index = 0; index < static_cast<qsizetype>(m_filter_states.size()); ++index) {
+        const auto &before = m_applied_states.at(static_cast<size_t>(index));
+        const auto &after = m_filter_states.at(static_cast<size_t>(index));
+        filtered = filtered || IsActive(after);
+        // A buyout-backed filter can have drifted since it was applied;
+        // only a full pass re-reads it.
+        const auto *flag = std::get_if<BoolPayload>(&m_filter_catalog[index].payload);
+        if (flag && !flag->indexable && (IsActive(before) || IsActive(after))) {
+            return false;
+        }
+        if (before == after) {
+            continue;
+        }
+        switch (ClassifyFilterEdit(before, after)) {
+        case FilterEdit::Narrowing:
+            narrowing = true;
+            break;
+        case FilterEdit::Widening:
+            widening = true;
+            break;
+        case FilterEdit::Unknown:
+            return false;
+        }
+        changed.push_back(index);
+    }
+    // m_filtered decides hidden empty buckets and default expansion for
+    // the whole view; a flip is the full refilter's to make.
+    if (changed.empty() || (narrowing && widening) || !filtered) {
+        return false;
+    }
+    if ((m_current_mode == ViewMode::ByItem) && m_bucket_by_item.empty()) {
+        return false;
+    }
+
+    const int column = m_model.GetSortColumn();
+    const bool sortable = (column >= 0) && (column < static_cast<int>(m_columns.size()));
+    bool content_changed = false;
+
+    if (narrowing) {
+        // Visible rows passed every old state, and the unchanged filters
+        // still say so: only the changed ones can reject them now.
+        const auto rejected = [this, &changed](const Item &item) {
+            for (const qsizetype index : changed) {
+                const auto &state = m_filter_states.at(static_cast<size_t>(index));
+                if (!MatchesFilter(item, m_filter_catalog[index], state)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        if (m_current_mode == ViewMode::ByItem) {
+            Bucket &flat = m_bucket_by_item.front();
+            const Column *merge_column = (sortable && flat.sorted()) ? m_columns[column].get()
+                                                                     : nullptr;
+            const Items removed = flat.ReplaceSourceRows(
+                rejected,
+                {},
+                merge_column,
+                m_model.GetSortOrder(),
+                [this](int first, int last) { m_model.BeginRemoveItemRows(0, first, last); },
+                [this] { m_model.EndRemoveItemRows(); },
+                [this](int first, int last) { m_model.BeginInsertItemRows(0, first, last); },
+                [this] { m_model.EndInsertItemRows(); });
+            for (const auto &item : removed) {
+                IndexRemoveVisible(item);
+            }
+            content_changed = !removed.empty();
+            // Defensive, like the delta path (D4 rule 1): the flat bucket
+            // never keeps stale order past a content change.
+            if (content_changed && !flat.sorted()) {
+                m_model.ResortBucket(0);
+            }
+        } else {
+            // Back-to-front, so a bucket the edit empties (hidden: the
+            // search stays filtered) leaves without shifting the rows
+            // still to visit.
+            for (int row = static_cast<int>(m_bucket_by_tab.size()) - 1; row >= 0; --row) {
+                if (!RemoveBucketRows(row, rejected)) {
+                    continue;
+                }
+                content_changed = true;
+                if (m_bucket_by_tab[static_cast<size_t>(row)].items().empty()) {
+                    RemoveBucketRow(row);
+                }
+            }
+        }
+    } else {
+        // Arrivals are exactly the rows some changed filter rejected
+        // under its old state that now pass every filter. Rows the old
+        // states accepted on the changed filters are either visible or
+        // still rejected by an unchanged one, so they are never tested.
+        // A changed filter that was inactive rejected nothing; the
+        // columnar index answers the indexable half of the rest.
+        std::vector<qsizetype> rejecting;
+        for (const qsizetype index : changed) {
+            if (IsActive(m_applied_states.at(static_cast<size_t>(index)))) {
+                rejecting.push_back(index);
+            }
+        }
+        std::optional<FilterIndex::RowMask> accepted_before;
+        if (m_filter_index) {
+            accepted_before = m_filter_index->Scan(items, m_applied_states, rejecting);
+        }
+        Items arrivals;
+        for (size_t row = 0; row < items.size(); ++row) {
+            const Item &item = *items[row];
+            bool was_rejected = accepted_before && !FilterIndex::Test(*accepted_before, row);
+            for (const qsizetype index : rejecting) {
+                if (was_rejected) {
+                    break;
+                }
+                if (accepted_before && m_filter_index->Indexes(index)) {
+                    continue;
+                }
+                const auto &state = m_applied_states.at(static_cast<size_t>(index));
+                was_rejected = !MatchesFilter(item, m_filter_catalog[index], state);
+            }
+            if (was_rejected && MatchesActiveFilters(item)) {
+                arrivals.push_back(items[row]);
+            }
+        }
+
+        if (m_current_mode == ViewMode::ByItem) {
+            Bucket &flat = m_bucket_by_item.front();
+            const Column *merge_column = (sortable && flat.sorted()) ? m_columns[column].get()
+                                                                     : nullptr;
+            flat.ReplaceSourceRows(
+                [](const Item &) { return false; },
+                arrivals,
+                merge_column,
+                m_model.GetSortOrder(),
+                [this](int first, int last) { m_model.BeginRemoveItemRows(0, first, last); },
+                [this] { m_model.EndRemoveItemRows(); },
+                [this](int first, int last) { m_model.BeginInsertItemRows(0, first, last); },
+                [this] { m_model.EndInsertItemRows(); });
+            for (const auto &item : arrivals) {
+                IndexInsertVisible(item);
+            }
+            if (!arrivals.empty() && !flat.sorted()) {
+                m_model.ResortBucket(0);
+            }
+        } else {
+            // Per display bucket, in collection order like the full
+            // pass; a bucket appears when its first arrivals do.
+            std::map<LocationInventory::Key, Items> by_bucket;
+            for (const auto &item : arrivals) {
+                by_bucket[LocationInventory::KeyFor(item->location())].push_back(item);
+            }
+            for (const auto &[key, accepted] : by_bucket) {
+                int bucket_row = FindBucketRow(key);
+                if (bucket_row < 0) {
+                    InsertBucketRow(canonicalLocation(accepted.front()->location()), accepted);
+                    continue;
+                }
+                InsertArrivals(bucket_row, accepted);
+                const Bucket &bucket = m_bucket_by_tab[static_cast<size_t>(bucket_row)];
+                if (bucket.expanded() && !bucket.sorted()) {
+                    m_model.ResortBucket(bucket_row);
+                }
+            }
+        }
+        content_changed = !arrivals.empty();
+    }
+
+    if (content_changed) {
+        // The active mode's buckets were maintained; the other side
+        // rebuilds at the next mode switch, as after a delta (S5).
+        m_items_stale = true;
+        if (m_current_mode == ViewMode::ByItem) {
+            m_tab_buckets_stale = true;
+        } else {
+            m_flat_bucket_stale = true;
+        }
+    }
+    if (auto &probes = ModelProbes::instance(); probes.enabled) {
+        ++probes.incremental_refilters;
+    }
+    m_applied_states = m_filter_states;
+    m_states_dirty = false;
+    return true;
+}
+
 const Items &Search::items() const
 {
     if (m_items_stale) {
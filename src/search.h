@@ -25,6 +25,7 @@
 
 class BuyoutManager;
 class FilterCatalog;
+class FilterIndex;
 class ItemsModel;
 class QModelIndex;
 struct BuyoutChangeSet;
@@ -39,10 +40,14 @@ public:
     // The inventory resolves bucket metadata to the freshest location seen
     // per stable display key (M2 D6); null (tests without a pipeline) keeps
     // each item's embedded location and the published tab list alone.
+    // The filter index, when given, answers the refilter's indexable
+    // filters columnar-wise for the collection it holds; any other
+    // collection takes the per-item path.
     Search(BuyoutManager &bo,
            const QString &caption,
            const FilterCatalog &catalog,
-           const LocationInventory *location_inventory = nullptr);
+           const LocationInventory *location_inventory = nullptr,
+           const FilterIndex *filter_index = nullptr);
     ~Search();
     void FilterItems(const Items &items);
     const QString &caption() const { return m_caption; }
@@ -121,6 +126,14 @@ public:
     // model's layout-change protocol by ItemsModel.
     void SortBucket(int row, int column, Qt::SortOrder order);
 
+    // The By-Item background sort's two UI-thread ends (ItemsModel::sort):
+    // a plan snapshotting the flat bucket — nullopt outside By-Item or
+    // without one — and its adoption, which the model wraps in the
+    // layout-change protocol only after CanAdoptFlatSortPlan said yes.
+    std::optional<Bucket::SortPlan> MakeFlatSortPlan(int column, Qt::SortOrder order) const;
+    bool CanAdoptFlatSortPlan(const Bucket::SortPlan &plan) const;
+    void AdoptFlatSortPlan(Bucket::SortPlan &&plan);
+
     // The view's materialization marks (D1/D2), driven by the tree's
     // expand/collapse signals through ItemsModel. Collapse evicts the
     // bucket's keys; its order and flag persist (D2 rule 3).
@@ -309,9 +322,20 @@ private:
     // collection when leaving By-Item mode (S5): By-Item deltas mark the
     // By-Tab side stale instead of maintaining two structures per delta.
     void RebuildTabBucketsFromFlat();
+    // A form edit applied as row operations instead of a reset: when
+    // every changed filter narrows, only the visible rows are re-tested
+    // against the changed filters and the failures leave; when every one
+    // widens, only the rows the old states rejected are tested and the
+    // passes arrive through the delta path's merge. Returns false, having
+    // touched nothing, when the edit is mixed or unclassifiable, flips
+    // m_filtered, involves a filter reading buyouts, or the visible
+    // result is not known to be current (items-dirty) — FilterItems then
+    // runs its full refilter.
+    bool RefilterIncrementally(const Items &items);
 
     BuyoutManager &m_bo_manager;
     const LocationInventory *m_location_inventory{nullptr};
+    const FilterIndex *m_filter_index{nullptr};
 
     // Catalog and filter states are index-aligned. MainWindow owns the catalog
     // and outlives every Search.
@@ -323,6 +347,11 @@ private:
     // change after a state change does.
     bool m_states_dirty{false};
 
+    // The states the visible result was last filtered against, by either
+    // refilter path; empty before the first. The incremental path diffs
+    // m_filter_states against these.
+    std::vector<FilterState> m_applied_states;
+
     // True when a streamed delta changed the underlying items since this
     // search last filtered (D9 rule 1).
     bool m_items_dirty{false};
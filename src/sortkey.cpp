@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "sortkey.h"
+
+#include <bit>
+
+namespace {
+
+    // Writes the key's serialization big-endian into the prefix's bytes,
+    // dropping whatever does not fit. Every field encodes prefix-free (fixed
+    // width, or terminated), so the serializations of two keys first differ
+    // inside the field where their tuples first differ, in the same
+    // direction — and a truncation of that order can only tie, never flip.
+    class PrefixWriter
+    {
+    public:
+        void U8(std::uint8_t value)
+        {
+            if (m_size < m_bytes.size()) {
+                m_bytes[m_size++] = value;
+            }
+        }
+
+        void U16(std::uint16_t value)
+        {
+            U8(static_cast<std::uint8_t>(value >> 8));
+            U8(static_cast<std::uint8_t>(value));
+        }
+
+        void U32(std::uint32_t value)
+        {
+            U16(static_cast<std::uint16_t>(value >> 16));
+            U16(static_cast<std::uint16_t>(value));
+        }
+
+        void U64(std::uint64_t value)
+        {
+            U32(static_cast<std::uint32_t>(value >> 32));
+            U32(static_cast<std::uint32_t>(value));
+        }
+
+        void Int(int value) { U32(static_cast<std::uint32_t>(value) ^ 0x80000000u); }
+
+        // Negatives flip every bit, non-negatives only the sign. -0.0 is
+        // written as 0.0: the tuple calls them equal and moves on to the
+        // next field, so the prefix must too.
+        void Double(double value)
+        {
+            if (value == 0.0) {
+                value = 0.0;
+            }
+            const auto bits = std::bit_cast<std::uint64_t>(value);
+            U64(((bits >> 63) != 0) ? ~bits : (bits | (std::uint64_t{1} << 63)));
+        }
+
+        // QString orders by UTF-16 code unit, shorter first on a common
+        // prefix. A unit is one 16-bit symbol, except U+0000, which is
+        // (0, 0xFFFF) so that the terminator (0, 0) stays below every unit.
+        void String(const QString &value)
+        {
+            for (const QChar c : value) {
+                const char16_t unit = c.unicode();
+                if (unit == 0) {
+                    U16(0);
+                    U16(0xFFFF);
+                } else {
+                    U16(unit);
+                }
+                if (full()) {
+                    return;
+                }
+            }
+            U16(0);
+            U16(0);
+        }
+
+        // Invalid datetimes order first (QDateTime's own rule), valid ones
+        // by instant.
+        void DateTime(const QDateTime &value)
+        {
+            if (!value.isValid()) {
+                U8(0);
+                U64(0);
+                return;
+            }
+            U8(1);
+            U64(static_cast<std::uint64_t>(value.toMSecsSinceEpoch()) ^ (std::uint64_t{1} << 63));
+        }
+
+        bool full() const { return m_size == m_bytes.size(); }
+
+        ItemSortKey::Prefix prefix() const
+        {
+            ItemSortKey::Prefix words{};
+            for (size_t n = 0; n < m_bytes.size(); ++n) {
+                words[n / 8] = (words[n / 8] << 8) | m_bytes[n];
+            }
+            return words;
+        }
+
+    private:
+        std::array<std::uint8_t, sizeof(ItemSortKey::Prefix)> m_bytes{};
+        size_t m_size{0};
+    };
+
+} // namespace
+
+ItemSortKey::Prefix ItemSortKey::Normalize(const Head &head, const Suffix &suffix)
+{
+    PrefixWriter writer;
+    if (const auto *base = std::get_if<BaseHead>(&head)) {
+        writer.Double(std::get<0>(*base));
+        writer.String(std::get<1>(*base));
+        writer.Double(std::get<2>(*base));
+        writer.String(std::get<3>(*base));
+    } else if (const auto *price = std::get_if<PriceHead>(&head)) {
+        writer.Int(std::get<0>(*price));
+        writer.Double(std::get<1>(*price));
+    } else if (const auto *date = std::get_if<DateHead>(&head)) {
+        writer.DateTime(std::get<0>(*date));
+    }
+    if (!writer.full()) {
+        writer.String(std::get<0>(suffix));
+        writer.String(std::get<1>(suffix));
+        writer.String(std::get<2>(suffix));
+    }
+    return writer.prefix();
+}
@@ -6,7 +6,10 @@
 #include <QDateTime>
 #include <QString>
 
+#include <array>
+#include <cstdint>
 #include <tuple>
+#include <utility>
 #include <variant>
 
 // The M3 sort key (items-pipeline-m3.md D1): the comparator's own tuple,
@@ -16,6 +19,13 @@
 // so a keyed sort reproduces the comparator's order without paying the
 // regex/QVariant work per comparison (keyedOrderMatchesComparatorOrder is
 // the equivalence pin).
+//
+// The tuple is fronted by a normalized prefix: the first 24 bytes of an
+// order-preserving serialization of (head, suffix) — doubles sign-flipped,
+// strings as their UTF-16 units with an escaped terminator — packed into
+// three big-endian words. Unequal prefixes order exactly as the tuples do;
+// only equal ones fall back to the QString compares. Sorts gather the
+// prefixes into a dense array, so most comparisons never leave it.
 struct ItemSortKey
 {
     // One alternative per comparator family. Every key in a single sort is
@@ -24,13 +34,30 @@ struct ItemSortKey
     using BaseHead = std::tuple<double, QString, double, QString>; // Column::multivalue
     using PriceHead = std::tuple<int, double>;                     // (currency rank, value)
     using DateHead = std::tuple<QDateTime>;                        // (last_update)
-    using Suffix = std::tuple<QString, QString, QString>;          // (PrettyName, uid, hash)
+    using Head = std::variant<BaseHead, PriceHead, DateHead>;
+    using Suffix = std::tuple<QString, QString, QString>; // (PrettyName, uid, hash)
+    using Prefix = std::array<std::uint64_t, 3>;
 
-    std::variant<BaseHead, PriceHead, DateHead> head;
+    ItemSortKey() = default;
+    ItemSortKey(Head key_head, Suffix key_suffix)
+        : head(std::move(key_head))
+        , suffix(std::move(key_suffix))
+        , prefix(Normalize(head, suffix))
+    {}
+
+    Head head;
     Suffix suffix;
+    Prefix prefix{};
 
     bool operator<(const ItemSortKey &rhs) const
     {
+        if (prefix != rhs.prefix) {
+            return prefix < rhs.prefix;
+        }
         return std::tie(head, suffix) < std::tie(rhs.head, rhs.suffix);
     }
+
+    // The prefix of (head, suffix). Two keys whose tuples compare a < b
+    // never get prefixes compared the other way round.
+    static Prefix Normalize(const Head &head, const Suffix &suffix);
 };
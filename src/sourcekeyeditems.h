@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <map>
+#include <set>
+#include <unordered_map>
 
 #include "fetchsourcekey.h"
 #include "item.h"
@@ -26,6 +28,10 @@
 // identical to the flat representation this replaces. Predicates that used
 // to test every item's location therefore test one representative per
 // bucket.
+//
+// A second index groups the buckets by that stable id, so everything shown
+// under one tab (its own items and its children's) is reachable without a
+// whole-collection walk — the pricing passes' per-tab scope.
 class SourceKeyedItems
 {
 public:
@@ -35,9 +41,13 @@ public:
     void ResetTo(Items items)
     {
         m_buckets.clear();
+        m_by_location.clear();
         for (const auto &item : items) {
             m_buckets[FetchSourceKey::ForLocation(item->location())].push_back(item);
         }
+        for (const auto &[key, bucket] : m_buckets) {
+            m_by_location[bucket.front()->location().id()].insert(key);
+        }
         m_flat = std::move(items);
         m_flat_dirty = false;
         m_size = m_flat.size();
@@ -54,6 +64,7 @@ public:
             removed = it->second.size();
             m_size -= removed;
             if (items.empty()) {
+                Unindex(key, it->second);
                 m_buckets.erase(it);
             } else {
                 m_size += items.size();
@@ -62,6 +73,7 @@ public:
             m_flat_dirty = true;
         } else if (!items.empty()) {
             m_size += items.size();
+            m_by_location[items.front()->location().id()].insert(key);
             m_buckets.emplace(key, std::move(items));
             m_flat_dirty = true;
         }
@@ -79,6 +91,7 @@ public:
         for (auto it = m_buckets.begin(); it != m_buckets.end();) {
             if (pred(it->first, it->second.front()->location())) {
                 erased += it->second.size();
+                Unindex(it->first, it->second);
                 it = m_buckets.erase(it);
             } else {
                 ++it;
@@ -123,10 +136,38 @@ public:
     // mutable through the const view; the bucket structure does not.
     const std::map<FetchSourceKey, Items> &buckets() const { return m_buckets; }
 
+    // Every item whose location has this stable id, bucket by bucket.
+    // O(those items); an unknown id visits nothing.
+    template<typename Fn>
+    void ForEachItemAt(const QString &location_id, Fn fn) const
+    {
+        const auto it = m_by_location.find(location_id);
+        if (it == m_by_location.end()) {
+            return;
+        }
+        for (const auto &key : it->second) {
+            for (const auto &item : m_buckets.at(key)) {
+                fn(item);
+            }
+        }
+    }
+
     size_t size() const { return m_size; }
 
 private:
+    void Unindex(const FetchSourceKey &key, const Items &bucket)
+    {
+        const auto it = m_by_location.find(bucket.front()->location().id());
+        if (it != m_by_location.end()) {
+            it->second.erase(key);
+            if (it->second.empty()) {
+                m_by_location.erase(it);
+            }
+        }
+    }
+
     std::map<FetchSourceKey, Items> m_buckets;
+    std::unordered_map<QString, std::set<FetchSourceKey>> m_by_location;
     // The lazily rebuilt whole-collection view (D3): mutable so Flat() can
     // service const readers like ItemsManager::items().
     mutable Items m_flat;
@@ -128,6 +128,16 @@ static std::array FrameToKey = {"White", "Magic", "Rare", "Unique", "Gem", "Curr
 
 static std::array FrameToColor = {"#c8c8c8", "#88f", "#ff7", "#af6025", "#1ba29b", "#aa9e82"};
 
+static size_t FrameOf(const Item &item)
+{
+    const size_t frame = item.frameType();
+    return (frame < FrameToKey.size()) ? frame : 0;
+}
+
+static QImage GenerateItemSockets(const int width,
+                                  const int height,
+                                  const std::vector<ItemSocket> &sockets);
+
 static void UpdateMinimap(const Item &item, Ui::MainWindow *ui)
 {
     QPixmap pixmap(MINIMAP_SIZE, MINIMAP_SIZE);
@@ -175,16 +185,25 @@ void GenerateItemHeaderSide(QLabel *itemHeader,
     itemHeader->setPixmap(header_pixmap);
 }
 
-void UpdateItemTooltip(const Item &item, Ui::MainWindow *ui)
+ItemTooltipArtifacts RenderItemTooltip(const Item &item)
 {
-    size_t frame = item.frameType();
-    if (frame >= FrameToKey.size()) {
-        frame = 0;
+    const QString key = FrameToKey[FrameOf(item)];
+    ItemTooltipArtifacts artifacts;
+    artifacts.properties_html = GenerateItemInfo(item, key, true);
+    artifacts.text_html = GenerateItemInfo(item, key, false);
+    if (item.text_sockets().size() > 0) {
+        artifacts.sockets = GenerateItemSockets(item.w(), item.h(), item.text_sockets());
     }
-    QString key = FrameToKey[frame];
+    return artifacts;
+}
+
+void UpdateItemTooltip(const Item &item, const ItemTooltipArtifacts &artifacts, Ui::MainWindow *ui)
+{
+    const size_t frame = FrameOf(item);
+    const QString key = FrameToKey[frame];
 
-    ui->propertiesLabel->setText(GenerateItemInfo(item, key, true));
-    ui->itemTextTooltip->setText(GenerateItemInfo(item, key, false));
+    ui->propertiesLabel->setText(artifacts.properties_html);
+    ui->itemTextTooltip->setText(artifacts.text_html);
     UpdateMinimap(item, ui);
 
     bool singleline = item.name().isEmpty();
@@ -230,15 +249,18 @@ void UpdateItemTooltip(const Item &item, Ui::MainWindow *ui)
     ui->itemNameSecondLine->setStyleSheet(css);
 }
 
-QPixmap GenerateItemSockets(const int width,
-                            const int height,
-                            const std::vector<ItemSocket> &sockets)
+// Painted on a QImage, not a QPixmap, so RenderItemTooltip can run off
+// the UI thread.
+static QImage GenerateItemSockets(const int width,
+                                  const int height,
+                                  const std::vector<ItemSocket> &sockets)
 {
     static const auto &images = IMAGES::instance();
 
-    QPixmap pixmap(width * PIXELS_PER_SLOT,
-                   height
-                       * PIXELS_PER_SLOT); // This will ensure we have enough room to draw the slots
+    // This will ensure we have enough room to draw the slots
+    QImage pixmap(width * PIXELS_PER_SLOT,
+                  height * PIXELS_PER_SLOT,
+                  QImage::Format_ARGB32_Premultiplied);
     pixmap.fill(Qt::transparent);
     QPainter painter(&pixmap);
 
@@ -309,10 +331,11 @@ QPixmap GenerateItemSockets(const int width,
         }
     }
 
+    painter.end();
     return pixmap.copy(0, 0, PIXELS_PER_SLOT * socket_columns, PIXELS_PER_SLOT * socket_rows);
 }
 
-QPixmap GenerateItemIcon(const Item &item, const QImage &image)
+QPixmap GenerateItemIcon(const Item &item, const QImage &image, const QImage &sockets)
 {
     static const auto &images = IMAGES::instance();
     const int height = item.h();
@@ -369,12 +392,10 @@ QPixmap GenerateItemIcon(const Item &item, const QImage &image)
 
     layered_painter.drawImage(0, 0, image);
 
-    if (item.text_sockets().size() > 0) {
-        QPixmap sockets = GenerateItemSockets(width, height, item.text_sockets());
-
-        layered_painter.drawPixmap((int) (0.5 * (image.width() - sockets.width())),
-                                   (int) (0.5 * (image.height() - sockets.height())),
-                                   sockets); // Center sockets on overall image
+    if (!sockets.isNull()) {
+        layered_painter.drawImage((int) (0.5 * (image.width() - sockets.width())),
+                                  (int) (0.5 * (image.height() - sockets.height())),
+                                  sockets); // Center sockets on overall image
     }
 
     return layered;
@@ -5,6 +5,7 @@
 
 #include <QImage>
 #include <QPixmap>
+#include <QString>
 
 namespace Ui {
     class MainWindow;
@@ -12,5 +13,16 @@ namespace Ui {
 
 class Item;
 
-void UpdateItemTooltip(const Item &item, Ui::MainWindow *ui);
-QPixmap GenerateItemIcon(const Item &item, const QImage &image);
+// The parts of the detail pane rendered from the item alone: both HTML
+// renderings and the socket overlay. No QPixmap, so any thread can render
+// them (see TooltipCache).
+struct ItemTooltipArtifacts
+{
+    QString properties_html;
+    QString text_html;
+    QImage sockets; // null when the item has no sockets
+};
+
+ItemTooltipArtifacts RenderItemTooltip(const Item &item);
+void UpdateItemTooltip(const Item &item, const ItemTooltipArtifacts &artifacts, Ui::MainWindow *ui);
+QPixmap GenerateItemIcon(const Item &item, const QImage &image, const QImage &sockets);
@@ -31,6 +31,7 @@
 #include <QTabBar>
 #include <QVersionNumber>
 
+#include <algorithm>
 #include <set>
 #include <utility>
 #include <vector>
@@ -71,6 +72,9 @@ constexpr const char *POE_WEBCDN
     = "http://webcdn.pathofexile.com"; // Should be updated to https://web.poecdn.com ?
 
 constexpr int CURRENT_ITEM_UPDATE_DELAY_MS = 100;
+// Rows on each side of the current item whose icons are decoded, and
+// tooltips rendered, ahead of arrow-key browsing.
+constexpr int PREFETCH_ROWS = 8;
 constexpr int SEARCH_UPDATE_DELAY_MS = 350;
 // The delta-path column-resize debounce (S7 review round 1): each
 // ResizeTreeColumns pass costs ~10 ms regardless of scale, so a
@@ -139,6 +143,15 @@ namespace {
         return dialog.clickedButton() == accept;
     }
 
+    QString iconUrl(const Item &item)
+    {
+        QString icon = item.icon();
+        if ((icon.size() >= 1) && (icon[0] == '/')) {
+            icon = POE_WEBCDN + icon;
+        }
+        return icon;
+    }
+
 } // namespace
 
 struct ImgurStatus
@@ -179,6 +192,7 @@ MainWindow::MainWindow(QSettings &settings,
     , m_image_cache(image_cache)
     , m_app_data_dir(app_data_dir)
     , m_filter_catalog(BuildFilterCatalog(buyout_manager))
+    , m_filter_index(m_filter_catalog)
     , ui(new Ui::MainWindow)
     , m_currency_dialog(nullptr)
     , m_current_search(nullptr)
@@ -451,6 +465,10 @@ void MainWindow::InitializeUi()
             &QAction::triggered,
             this,
             &MainWindow::OnRefreshCheckedTabs);
+    connect(ui->actionQuickRefreshTabs,
+            &QAction::triggered,
+            this,
+            &MainWindow::OnQuickRefreshTabs);
     connect(ui->actionRefreshAllTabs, &QAction::triggered, this, &MainWindow::OnRefreshAllTabs);
     connect(ui->actionSetAutomaticTabRefresh,
             &QAction::triggered,
@@ -882,6 +900,10 @@ void MainWindow::OnImportLegacyBuyouts()
         return;
     }
 
+    // The plan reads stash and character rows on this connection, and the
+    // worker's latest replies may still be queued on the writer's.
+    emit FlushStoreWrites();
+
     const QString plan_path = legacyBuyoutAuditPath(m_app_data_dir);
     LegacyBuyoutImporter importer(m_buyout_repo,
                                   m_stash_repo,
@@ -1095,6 +1117,11 @@ void MainWindow::OnDeleteTabClicked(int index)
 
 void MainWindow::OnTabRefreshed(const ItemLocation &location, const Items &items)
 {
+    // The same source replacement ItemsManager just applied to the
+    // published copy, so the next refilter still finds the index current.
+    m_filter_index.ReplaceSource(FetchSourceKey::ForLocation(location), items);
+    m_tooltip_cache.Invalidate(items);
+
     // Background searches keep M2 D9 rule 1 verbatim (R1-7): every delta
     // marks them items-dirty, and their next activation refilters.
     for (const auto &search : m_searches) {
@@ -1119,6 +1146,15 @@ void MainWindow::OnTabRefreshed(const ItemLocation &location, const Items &items
 void MainWindow::OnChildrenReconciled(const ItemLocation &parent,
                                       const std::vector<FetchSourceKey> &expected)
 {
+    // ItemsManager's reconcile predicate, applied to the filter index. A
+    // divergence here would only cost the refilter its index (the scan
+    // refuses a collection it does not hold exactly), never correctness.
+    const std::set<FetchSourceKey> expected_keys(expected.begin(), expected.end());
+    m_filter_index.EraseSourcesIf([&](const FetchSourceKey &key, const ItemLocation &loc) {
+        return (key.type == ItemLocationType::STASH) && (loc.id() == parent.id())
+               && (expected_keys.count(key) == 0);
+    });
+
     // Aggregate reconciliations are first-class delta inputs (R5-2/R6-2);
     // background searches keep rule 1, and the active By-Tab search
     // applies the erase as row removals scoped to the parent's bucket (D3).
@@ -1482,6 +1518,7 @@ void MainWindow::OnCurrentItemChanged(const QModelIndex &current, const QModelIn
                 // the selected item's stable id.
                 m_selection_intent_id = m_current_item->id();
                 m_delayed_update_current_item.start();
+                PrefetchNeighbours(bucket, item_row);
             } else {
                 spdlog::warn("OnCurrentItemChanged(): parent bucket {} does not have {} rows",
                              bucket_row,
@@ -1672,7 +1709,8 @@ void MainWindow::NewSearch()
     auto search = std::make_unique<Search>(m_buyout_manager,
                                            caption,
                                            m_filter_catalog,
-                                           &m_items_manager.locationInventory());
+                                           &m_items_manager.locationInventory(),
+                                           &m_filter_index);
     m_current_search = search.get();
     m_current_item = m_current_search->currentItem();
     m_current_bucket_location = m_current_search->currentBucket();
@@ -1742,7 +1780,7 @@ void MainWindow::UpdateCurrentItem()
 
     // Everything except item image now lives in itemtooltip.cpp
     // in future should move everything tooltip-related there
-    UpdateItemTooltip(*m_current_item, ui);
+    UpdateItemTooltip(*m_current_item, m_tooltip_cache.Get(m_current_item), ui);
 
     // The location line renders through the canonical inventory (S4
     // review round 1): a metadata delta renames a tab without replacing
@@ -1751,22 +1789,36 @@ void MainWindow::UpdateCurrentItem()
         m_items_manager.locationInventory().Canonical(m_current_item->location()).GetHeader());
     ui->pobTooltipButton->setEnabled(m_current_item->Wearable());
 
-    QString icon = m_current_item->icon();
-    if ((icon.size() >= 1) && (icon[0] == '/')) {
-        icon = POE_WEBCDN + icon;
+    emit GetImage(iconUrl(*m_current_item));
+}
+
+void MainWindow::PrefetchNeighbours(const Bucket &bucket, int row)
+{
+    // Decoding and rendering start while the delayed update waits, so the
+    // rows the arrow keys reach next already have their icons in memory
+    // and their tooltips rendered.
+    QStringList urls;
+    Items items;
+    const int first = std::max(0, row - PREFETCH_ROWS);
+    const int last = std::min(bucket.size() - 1, row + PREFETCH_ROWS);
+    for (int n = first; n <= last; ++n) {
+        if (n != row) {
+            urls.push_back(iconUrl(*bucket.item(n)));
+            items.push_back(bucket.item(n));
+        }
     }
-    emit GetImage(icon);
+    emit PrefetchImages(urls);
+    m_tooltip_cache.Prewarm(items);
 }
 
 void MainWindow::OnImageFetched(const QString &url)
 {
     if (m_current_item) {
-        const QString icon = m_current_item->icon();
+        const QString icon = iconUrl(*m_current_item);
         if (url == icon) {
             const QImage image = m_image_cache.load(url);
             if (!image.isNull()) {
-                const QPixmap pixmap = GenerateItemIcon(*m_current_item, image);
-                ui->imageLabel->setPixmap(pixmap);
+                ui->imageLabel->setPixmap(m_tooltip_cache.Icon(m_current_item, image));
             }
         }
     }
@@ -1814,6 +1866,11 @@ void MainWindow::ResetBuyoutWidgets()
 void MainWindow::OnItemsRefreshed(bool initial_refresh)
 {
     spdlog::trace("MainWindow::OnItemsRefreshed() entered");
+    // Snapshot boundary: the filter index is rebuilt from the published
+    // collection once, in its published order, so the next refilter binds
+    // to it without a lookup per item.
+    m_filter_index.ResetTo(m_items_manager.items());
+
     // Background searches keep rule 1 at the snapshot boundary too
     // (R1-7): the snapshot mutates published state no delta expressed
     // (deleted tabs, new listings, the location rebase), so every
@@ -1971,6 +2028,11 @@ void MainWindow::OnRefreshCheckedTabs()
     m_items_manager.Update(TabSelection::Checked);
 }
 
+void MainWindow::OnQuickRefreshTabs()
+{
+    m_items_manager.Update(TabSelection::Quick);
+}
+
 void MainWindow::OnSetAutomaticTabRefresh()
 {
     m_items_manager.SetAutoUpdate(ui->actionSetAutomaticTabRefresh->isChecked());
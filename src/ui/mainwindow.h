@@ -18,16 +18,19 @@
 #include <spdlog/spdlog.h>
 
 #include "fetchsourcekey.h"
+#include "filters/filterindex.h"
 #include "filters/filterspec.h"
 #include "item.h"
 #include "itemlocation.h"
 #include "refreshoutcome.h"
+#include "ui/tooltipcache.h"
 #include "util/programstate.h"
 
 class QNetworkReply;
 class QSettings;
 class QVBoxLayout;
 
+class Bucket;
 class BuyoutManager;
 class BuyoutRepo;
 class CharacterRepo;
@@ -80,6 +83,10 @@ signals:
     void SetSessionId(const QString &poesessid);
     void SetTheme(const QString &theme);
     void GetImage(const QString &url);
+    void PrefetchImages(const QStringList &urls);
+    // Commits the write-behind store's queue before the stash and character
+    // repos are read on this connection; returns once it has.
+    void FlushStoreWrites();
 public slots:
     // Streamed-delta consumers (items-pipeline M3, D3/D4): the active
     // search applies each delta immediately and stays clean (R1-7) —
@@ -137,6 +144,7 @@ private slots:
     // Tabs menu actions
     void OnFetchTabsList();
     void OnRefreshCheckedTabs();
+    void OnQuickRefreshTabs();
     void OnRefreshAllTabs();
     void OnSetAutomaticTabRefresh();
     void OnSetTabRefreshInterval();
@@ -197,6 +205,7 @@ private:
     void ClearCurrentItem();
     void UpdateCurrentBucket();
     void UpdateCurrentItem();
+    void PrefetchNeighbours(const Bucket &bucket, int row);
     void UpdateCurrentBuyout();
     void ResetBuyoutWidgets();
     void NewSearch();
@@ -229,11 +238,17 @@ private:
     // declared after m_filter_catalog so reverse destruction destroys searches
     // before the catalog they reference.
     FilterCatalog m_filter_catalog;
+    // The refilter's columnar side index over the published collection:
+    // rebuilt at every ItemsRefreshed and patched by every delta, before
+    // the active search sees either. Declared after the catalog its
+    // columns point into and before the searches that read it.
+    FilterIndex m_filter_index;
 
     Ui::MainWindow *ui;
     CurrencyDialog *m_currency_dialog;
 
     std::shared_ptr<Item> m_current_item;
+    TooltipCache m_tooltip_cache;
     std::optional<ItemLocation> m_current_bucket_location;
     // The selection intent (M3 R1-3): the selected item's stable id, held
     // independently of row existence. During an active refresh (first
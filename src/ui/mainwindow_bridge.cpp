@@ -4,6 +4,7 @@
 #include "ui/mainwindow_bridge.h"
 
 #include "application.h"
+#include "datastore/writebehindstore.h"
 #include "imagecache.h"
 #include "itemsmanager.h"
 #include "itemsmanagerworker.h"
@@ -51,7 +52,8 @@ void ConnectMainWindow(Application &application,
                        ItemsManagerWorker &items_worker,
                        Shop &shop,
                        UpdateChecker &update_checker,
-                       ImageCache &image_cache)
+                       ImageCache &image_cache,
+                       WriteBehindStore &store_writer)
 {
     QObject::connect(&main_window,
                      &MainWindow::SetSessionId,
@@ -94,11 +96,21 @@ void ConnectMainWindow(Application &application,
                      &MainWindow::OnNotifyUser);
 
     QObject::connect(&main_window, &MainWindow::GetImage, &image_cache, &ImageCache::fetch);
+    QObject::connect(&main_window,
+                     &MainWindow::PrefetchImages,
+                     &image_cache,
+                     &ImageCache::prefetch);
     QObject::connect(&image_cache,
                      &ImageCache::imageReady,
                      &main_window,
                      &MainWindow::OnImageFetched);
 
+    // Direct: the emit returns once every queued write is committed.
+    QObject::connect(&main_window,
+                     &MainWindow::FlushStoreWrites,
+                     &store_writer,
+                     &WriteBehindStore::flush);
+
     QObject::connect(&shop, &Shop::StatusUpdate, &main_window, &MainWindow::OnStatusUpdate);
     QObject::connect(&shop,
                      &Shop::UserWarning,
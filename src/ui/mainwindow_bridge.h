@@ -22,6 +22,7 @@ class RateLimiter;
 class Shop;
 class StashRepo;
 class UpdateChecker;
+class WriteBehindStore;
 
 MainWindow *CreateMainWindow(QSettings &settings,
                              NetworkManager &network_manager,
@@ -43,5 +44,6 @@ void ConnectMainWindow(Application &application,
                        ItemsManagerWorker &items_worker,
                        Shop &shop,
                        UpdateChecker &update_checker,
-                       ImageCache &image_cache);
+                       ImageCache &image_cache,
+                       WriteBehindStore &store_writer);
 void ShowMainWindow(MainWindow &window);
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "ui/tooltipcache.h"
+
+#include "modelprobes.h"
+
+TooltipCache::TooltipCache(QObject *parent)
+    : QObject(parent)
+    , m_entries(MAX_ENTRIES)
+{
+    // One thread: prewarming is a nicety, and must not compete with the
+    // parse pool during a refresh.
+    m_render_pool.setMaxThreadCount(1);
+}
+
+TooltipCache::~TooltipCache()
+{
+    m_render_pool.clear();
+}
+
+QString TooltipCache::KeyOf(const Item &item)
+{
+    return item.id().isEmpty() ? item.hash_v4() : item.id();
+}
+
+TooltipCache::Entry *TooltipCache::Find(const std::shared_ptr<Item> &item)
+{
+    Entry *entry = m_entries.object(KeyOf(*item));
+    return (entry && (entry->item.lock() == item)) ? entry : nullptr;
+}
+
+TooltipCache::Entry *TooltipCache::Insert(const std::shared_ptr<Item> &item,
+                                          ItemTooltipArtifacts artifacts)
+{
+    const QString key = KeyOf(*item);
+    m_entries.insert(key, new Entry{item, std::move(artifacts), {}, 0});
+    return m_entries.object(key);
+}
+
+bool TooltipCache::Contains(const std::shared_ptr<Item> &item)
+{
+    return Find(item) != nullptr;
+}
+
+ItemTooltipArtifacts TooltipCache::Get(const std::shared_ptr<Item> &item)
+{
+    if (const Entry *entry = Find(item)) {
+        return entry->artifacts;
+    }
+    auto &probes = ModelProbes::instance();
+    if (probes.enabled) {
+        ++probes.tooltip_renders;
+    }
+    return Insert(item, RenderItemTooltip(*item))->artifacts;
+}
+
+QPixmap TooltipCache::Icon(const std::shared_ptr<Item> &item, const QImage &image)
+{
+    Entry *entry = Find(item);
+    if (!entry) {
+        Get(item);
+        entry = Find(item);
+    }
+    if (entry->icon.isNull() || (entry->icon_source != image.cacheKey())) {
+        entry->icon = GenerateItemIcon(*item, image, entry->artifacts.sockets);
+        entry->icon_source = image.cacheKey();
+    }
+    return entry->icon;
+}
+
+void TooltipCache::Prewarm(const Items &items)
+{
+    // Renders still queued are for rows the user has moved past. One that
+    // is already running may be queued again below, and OnRendered keeps
+    // whichever lands first.
+    m_render_pool.clear();
+    m_pending.clear();
+
+    for (const auto &item : items) {
+        const QString key = KeyOf(*item);
+        if (m_pending.contains(key) || Find(item)) {
+            continue;
+        }
+        m_pending.insert(key);
+        m_render_pool.start([this, item]() {
+            const ItemTooltipArtifacts artifacts = RenderItemTooltip(*item);
+            QMetaObject::invokeMethod(
+                this,
+                [this, item, artifacts]() { OnRendered(item, artifacts); },
+                Qt::QueuedConnection);
+        });
+    }
+}
+
+void TooltipCache::OnRendered(const std::shared_ptr<Item> &item,
+                              const ItemTooltipArtifacts &artifacts)
+{
+    m_pending.remove(KeyOf(*item));
+    if (!Find(item)) {
+        Insert(item, artifacts);
+    }
+}
+
+void TooltipCache::Invalidate(const Items &items)
+{
+    for (const auto &item : items) {
+        m_entries.remove(KeyOf(*item));
+    }
+}
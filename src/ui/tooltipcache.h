@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+#include <memory>
+
+#include "item.h"
+#include "ui/itemtooltip.h"
+
+// The detail pane's rendered artifacts per item, so arrow-key browsing back
+// and forth over a result list repaints without re-rendering: the HTML and
+// socket overlay (RenderItemTooltip) and the composed icon
+// (GenerateItemIcon).
+//
+// Entries are keyed by the item's uid (its hash when it has none), and the
+// content version is the Item object itself: a refresh always builds new
+// ones, so an entry holds the Item it was rendered from weakly and serves
+// that object only. A replaced item therefore misses even before
+// Invalidate drops the delta's uids, which only releases the memory early.
+//
+// Prewarm renders the neighbours of the current row on a background
+// thread; the composed icon needs the decoded image, and a QPixmap, so it
+// is only ever built on the UI thread.
+class TooltipCache : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int MAX_ENTRIES = 512;
+
+    explicit TooltipCache(QObject *parent = nullptr);
+    ~TooltipCache();
+
+    bool Contains(const std::shared_ptr<Item> &item);
+
+    // Renders on the calling thread on a miss.
+    ItemTooltipArtifacts Get(const std::shared_ptr<Item> &item);
+    QPixmap Icon(const std::shared_ptr<Item> &item, const QImage &image);
+
+    // Queues background renders of the items not yet cached, replacing
+    // whatever an earlier call queued and has not started.
+    void Prewarm(const Items &items);
+
+    // Drops the entries for these items' uids (a delta's replacements).
+    void Invalidate(const Items &items);
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<Item> item;
+        ItemTooltipArtifacts artifacts;
+        QPixmap icon;
+        qint64 icon_source{0}; // QImage::cacheKey of the image it was composed from
+    };
+
+    static QString KeyOf(const Item &item);
+    Entry *Find(const std::shared_ptr<Item> &item);
+    Entry *Insert(const std::shared_ptr<Item> &item, ItemTooltipArtifacts artifacts);
+    void OnRendered(const std::shared_ptr<Item> &item, const ItemTooltipArtifacts &artifacts);
+
+    QCache<QString, Entry> m_entries;
+    QSet<QString> m_pending; // keys with a background render queued or running
+
+    // Destroyed first: its destructor waits out any running render, whose
+    // completion is queued to this object and dropped with it.
+    QThreadPool m_render_pool;
+};
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "util/binary_items.h"
+
+#include "poe/types/item.h"
+#include "util/glaze_qt.h" // IWYU pragma: keep
+#include "util/spdlog_qt.h" // IWYU pragma: keep
+
+namespace {
+
+    constexpr glz::opts BEVE_OPTS{.format = glz::BEVE};
+
+} // namespace
+
+QByteArray binary::writeItems(const std::vector<poe::Item> &items)
+{
+    std::string buffer;
+    const auto err = glz::write<BEVE_OPTS>(items, buffer);
+    if (err) {
+        spdlog::error("Error encoding {} items: {}", items.size(), glz::format_error(err));
+        return {};
+    }
+    return qCompress(reinterpret_cast<const uchar *>(buffer.data()), qsizetype(buffer.size()));
+}
+
+std::optional<std::vector<poe::Item>> binary::readItems(const QByteArray &data)
+{
+    const QByteArray raw = qUncompress(data);
+    if (raw.isEmpty()) {
+        spdlog::error("Error decompressing {} bytes of binary items", data.size());
+        return std::nullopt;
+    }
+    std::vector<poe::Item> items;
+    const std::string_view str{raw.constData(), size_t(raw.size())};
+    const auto err = glz::read<BEVE_OPTS>(items, str);
+    if (err) {
+        spdlog::error("Error decoding binary items: {}", glz::format_error(err));
+        return std::nullopt;
+    }
+    return items;
+}
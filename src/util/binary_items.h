@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <QByteArray>
+
+#include <optional>
+#include <vector>
+
+namespace poe {
+    struct Item;
+} // namespace poe
+
+// A compact binary encoding of a stash's parsed items, stored next to the
+// raw wire bytes (stashes.items_data) so a cold start can skip the JSON
+// parse. The wire bytes stay the source of truth (F62): this is a derived
+// cache of what json::readStash would produce from them, and any row whose
+// encoding is missing or unreadable falls back to parsing json_data.
+//
+// The encoding is glaze's BEVE of std::vector<poe::Item>, zlib-compressed
+// through qCompress.
+
+namespace binary {
+
+    // Format of stashes.items_data.
+    //
+    //   1  BEVE of std::vector<poe::Item>, qCompress'ed
+    //
+    // BEVE objects are keyed, so an added member is harmless, but a renamed
+    // or retyped one is not: bump this whenever a poe:: item type changes
+    // shape, and whenever json::PAYLOAD_VERSION moves.
+    // Readers compare for EQUALITY, like the JSON payload version: a stale
+    // or newer encoding costs one JSON parse, never a misread.
+    constexpr int ITEMS_VERSION = 1;
+
+    QByteArray writeItems(const std::vector<poe::Item> &items);
+
+    // nullopt when the bytes do not decompress or decode.
+    std::optional<std::vector<poe::Item>> readItems(const QByteArray &data);
+
+} // namespace binary
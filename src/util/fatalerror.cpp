@@ -14,6 +14,7 @@
 #include <QUrl>
 #include <QUrlQuery>
 
+#include "util/logging.h"
 #include "util/spdlog_qt.h" // IWYU pragma: keep
 #include "version_defines.h"
 
@@ -22,6 +23,9 @@ constexpr const char *GITHUB_ISSUES_URL = (APP_URL "/issues");
 [[noreturn]] void FatalError(const QString &message)
 {
     spdlog::critical(message);
+    // The log goes through a background thread: get the message to disk
+    // before the dialog, which may never return.
+    logging::flush();
 
     QTextEdit *details = new QTextEdit;
     details->setReadOnly(true);
@@ -71,5 +75,6 @@ constexpr const char *GITHUB_ISSUES_URL = (APP_URL "/issues");
 
     // Finally cause a crash, which should trigger a crash report
     spdlog::critical("Aborting acquisition after a fatal error.");
+    logging::flush();
     abort();
 }
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// A sorted vector of (key, value) pairs with the read interface of the
+// std::map it replaces. Item's property and requirement maps hold a handful
+// of entries each; one contiguous allocation per map beats a tree node per
+// entry on memory, and a binary search over a few keys beats the pointer
+// chase. Inserting is O(n), which only construction does.
+template<typename Key, typename Value>
+class FlatMap
+{
+public:
+    using value_type = std::pair<Key, Value>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    const_iterator begin() const { return m_entries.cbegin(); }
+    const_iterator end() const { return m_entries.cend(); }
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    const_iterator find(const Key &key) const
+    {
+        const auto it = LowerBound(key);
+        return ((it != m_entries.cend()) && !(key < it->first)) ? it : m_entries.cend();
+    }
+
+    size_t count(const Key &key) const { return (find(key) != end()) ? 1 : 0; }
+    bool contains(const Key &key) const { return find(key) != end(); }
+
+    const Value &at(const Key &key) const
+    {
+        const auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("FlatMap::at");
+        }
+        return it->second;
+    }
+
+    Value &operator[](const Key &key)
+    {
+        auto it = std::lower_bound(m_entries.begin(),
+                                   m_entries.end(),
+                                   key,
+                                   [](const value_type &e, const Key &k) { return e.first < k; });
+        if ((it == m_entries.end()) || (key < it->first)) {
+            it = m_entries.insert(it, value_type{key, Value{}});
+        }
+        return it->second;
+    }
+
+    void shrink_to_fit() { m_entries.shrink_to_fit(); }
+
+private:
+    const_iterator LowerBound(const Key &key) const
+    {
+        return std::lower_bound(m_entries.cbegin(),
+                                m_entries.cend(),
+                                key,
+                                [](const value_type &e, const Key &k) { return e.first < k; });
+    }
+
+    std::vector<value_type> m_entries;
+};
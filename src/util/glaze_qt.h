@@ -7,6 +7,7 @@
 #include <QDateTime>
 #include <QHashFunctions> // Needed to avoid obscure errors in std::unordered_map with QString keys.
 #include <QString>
+#include <QStringDecoder>
 
 #include <map>
 #include <string>
@@ -28,6 +29,14 @@
 //  - std::map<QByteArray, ...>
 //  - std::unordered_map<QString, ...>
 //  - std::unordered_map<QByteArray, ...>
+//
+// and, for the binary item records (util/binary_items.h), BEVE support for
+// QString and std::unordered_map<QString, ...> — the Qt types poe::Item
+// carries.
+//
+// The JSON QString reader decodes straight from the buffer into UTF-16: a
+// string without escapes is one fromUtf8, and one with escapes is written
+// in place into a single QString, with no intermediate std::string.
 
 namespace {
 
@@ -36,6 +45,140 @@ namespace {
 
 } // namespace
 
+namespace glaze_qt {
+
+    // An optional parse-time interning hook. While one is installed on the
+    // thread, the JSON QString reader offers it the raw bytes of every
+    // string without escapes before decoding them, and uses a non-null
+    // answer as is — a repeated value then costs a lookup instead of an
+    // allocation. json_readers installs StringPool::FindUtf8 for its reads.
+    using InternHook = QString (*)(std::string_view utf8);
+
+    inline thread_local InternHook intern_hook = nullptr;
+
+    // Installs a hook for the scope's lifetime, restoring the previous one.
+    class ScopedInternHook
+    {
+    public:
+        explicit ScopedInternHook(InternHook hook)
+            : m_previous(intern_hook)
+        {
+            intern_hook = hook;
+        }
+        ~ScopedInternHook() { intern_hook = m_previous; }
+
+        ScopedInternHook(const ScopedInternHook &) = delete;
+        ScopedInternHook &operator=(const ScopedInternHook &) = delete;
+
+    private:
+        InternHook m_previous;
+    };
+
+    inline QString decodePlain(std::string_view utf8)
+    {
+        if (intern_hook) {
+            QString pooled = intern_hook(utf8);
+            if (!pooled.isNull()) {
+                return pooled;
+            }
+        }
+        return QString::fromUtf8(utf8.data(), qsizetype(utf8.size()));
+    }
+
+    inline int hexDigit(char c)
+    {
+        if ((c >= '0') && (c <= '9')) {
+            return c - '0';
+        }
+        if ((c >= 'a') && (c <= 'f')) {
+            return c - 'a' + 10;
+        }
+        if ((c >= 'A') && (c <= 'F')) {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    // Decodes a JSON string body (the bytes between the quotes) that holds
+    // escapes. No escape decodes to more UTF-16 units than its bytes, and no
+    // UTF-8 sequence does either, so the body's length bounds the result:
+    // one allocation, trimmed at the end. \uXXXX is written as the UTF-16
+    // unit it names, which is what a surrogate pair needs. Returns false on
+    // a malformed escape.
+    inline bool decodeEscaped(std::string_view body, QString &value)
+    {
+        QString result(qsizetype(body.size()), Qt::Uninitialized);
+        QChar *out = result.data();
+        QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::ConvertInitialBom);
+        const char *p = body.data();
+        const char *const end = p + body.size();
+        while (p != end) {
+            const char *const run = p;
+            while ((p != end) && (*p != '\\')) {
+                ++p;
+            }
+            if (p != run) {
+                // A run ends at a backslash, which is ASCII, so it never
+                // splits a multi-byte sequence.
+                out = decoder.appendToBuffer(out, QByteArrayView(run, p - run));
+            }
+            if (p == end) {
+                break;
+            }
+            if (++p == end) {
+                return false;
+            }
+            switch (*p++) {
+            case '"':
+                *out++ = u'"';
+                break;
+            case '\\':
+                *out++ = u'\\';
+                break;
+            case '/':
+                *out++ = u'/';
+                break;
+            case 'b':
+                *out++ = u'\b';
+                break;
+            case 'f':
+                *out++ = u'\f';
+                break;
+            case 'n':
+                *out++ = u'\n';
+                break;
+            case 'r':
+                *out++ = u'\r';
+                break;
+            case 't':
+                *out++ = u'\t';
+                break;
+            case 'u': {
+                if ((end - p) < 4) {
+                    return false;
+                }
+                char16_t unit = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const int digit = hexDigit(*p++);
+                    if (digit < 0) {
+                        return false;
+                    }
+                    unit = char16_t((unit << 4) | digit);
+                }
+                *out++ = QChar(unit);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        result.truncate(out - result.constData());
+        value = std::move(result);
+        return true;
+    }
+
+} // namespace glaze_qt
+
 namespace glz {
 
     // ----- QString -----
@@ -56,11 +199,43 @@ namespace glz {
     struct from<JSON, QString>
     {
         template<auto Opts>
-        static inline void op(QString &value, auto &&...args) noexcept
+        static inline void op(QString &value, is_context auto &&ctx, auto &&it, auto &&end) noexcept
         {
-            std::string str;
-            glz::parse<JSON>::op<Opts>(str, std::forward<decltype(args)>(args)...);
-            value = QString::fromUtf8(str.data(), qsizetype(str.size()));
+            if (skip_ws<Opts>(ctx, it, end)) {
+                return;
+            }
+            if ((it == end) || (*it != '"')) {
+                ctx.error = error_code::expected_quote;
+                return;
+            }
+            ++it;
+            const auto first = it;
+            bool escaped = false;
+            while ((it != end) && (*it != '"')) {
+                // JSON forbids raw control characters in a string.
+                if (static_cast<unsigned char>(*it) < 0x20) {
+                    ctx.error = error_code::syntax_error;
+                    return;
+                }
+                if (*it == '\\') {
+                    escaped = true;
+                    if (++it == end) {
+                        break;
+                    }
+                }
+                ++it;
+            }
+            if (it == end) {
+                ctx.error = error_code::unexpected_end;
+                return;
+            }
+            const std::string_view body(&*first, size_t(it - first));
+            ++it;
+            if (!escaped) {
+                value = glaze_qt::decodePlain(body);
+            } else if (!glaze_qt::decodeEscaped(body, value)) {
+                ctx.error = error_code::syntax_error;
+            }
         }
     };
 
@@ -116,6 +291,32 @@ namespace glz {
         }
     };
 
+    // ----- QString (BEVE) -----
+
+    template<>
+    struct to<BEVE, QString>
+    {
+        template<auto Opts>
+        static inline void op(const QString &value, auto &&...args) noexcept
+        {
+            const QByteArray utf8 = value.toUtf8();
+            const std::string_view sv{utf8.constData(), size_t(utf8.size())};
+            glz::serialize<BEVE>::op<Opts>(sv, std::forward<decltype(args)>(args)...);
+        }
+    };
+
+    template<>
+    struct from<BEVE, QString>
+    {
+        template<auto Opts>
+        static inline void op(QString &value, auto &&...args) noexcept
+        {
+            std::string str;
+            glz::parse<BEVE>::op<Opts>(str, std::forward<decltype(args)>(args)...);
+            value = QString::fromUtf8(str.data(), qsizetype(str.size()));
+        }
+    };
+
     // -------------------- std::unordered_map --------------------
 
     // ---- QString keys ----
@@ -155,6 +356,41 @@ namespace glz {
         }
     };
 
+    template<typename T, typename Hash, typename KeyEq, typename Alloc>
+    struct from<BEVE, std::unordered_map<QString, T, Hash, KeyEq, Alloc>>
+    {
+        template<auto Opts>
+        static void op(std::unordered_map<QString, T, Hash, KeyEq, Alloc> &out,
+                       auto &&...args) noexcept
+        {
+            std::unordered_map<std::string, T> tmp;
+            glz::parse<BEVE>::op<Opts>(tmp, std::forward<decltype(args)>(args)...);
+
+            out.clear();
+            out.reserve(tmp.size());
+            for (auto &[k, v] : tmp) {
+                out.emplace(QString::fromUtf8(k.data(), int(k.size())), std::move(v));
+            }
+        }
+    };
+
+    template<typename T, typename Hash, typename KeyEq, typename Alloc>
+    struct to<BEVE, std::unordered_map<QString, T, Hash, KeyEq, Alloc>>
+    {
+        template<auto Opts>
+        static void op(const std::unordered_map<QString, T, Hash, KeyEq, Alloc> &in,
+                       auto &&...args) noexcept
+        {
+            std::unordered_map<std::string, T> tmp;
+            tmp.reserve(in.size());
+            for (const auto &[k, v] : in) {
+                const QByteArray utf8 = k.toUtf8();
+                tmp.emplace(std::string(utf8.constData(), size_t(utf8.size())), v);
+            }
+            glz::serialize<BEVE>::op<Opts>(tmp, std::forward<decltype(args)>(args)...);
+        }
+    };
+
     // ---- QByteArray keys ----
 
     template<typename T, typename Hash, typename KeyEq, typename Alloc>
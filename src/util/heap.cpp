@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "util/heap.h"
+
+#include <cstdlib> // Defines __GLIBC__ on glibc.
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+bool heap::releaseFreedMemory()
+{
+#if defined(__GLIBC__)
+    return malloc_trim(0) != 0;
+#else
+    return false;
+#endif
+}
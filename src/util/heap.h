@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+// Returning freed heap memory to the operating system.
+//
+// A stash reply's transient poe:: graph is parsed, turned into Items, and
+// dropped, interleaved on the parse pool's threads with the Items that
+// outlive it. glibc keeps the freed pages in its per-thread arenas, so
+// after a few hourly refreshes the resident size keeps the high-water mark
+// of every parse even though the collection itself has not grown. The
+// workers call releaseFreedMemory() once a bulk parse is over.
+namespace heap {
+
+    // Trims every allocator arena back to what is in use. Returns true when
+    // anything was released. A no-op returning false where the allocator
+    // already returns memory itself (macOS, Windows) or has no trim entry.
+    bool releaseFreedMemory();
+
+} // namespace heap
@@ -10,22 +10,41 @@
 #include "util/glaze_qt.h" // IWYU pragma: keep
 #include "util/oauthtoken.h"
 #include "util/spdlog_qt.h" // IWYU pragma: keep
+#include "util/stringpool.h"
+#include "util/util.h"
 
 // The wire shape of a single stash/character reply, with the payload
-// captured as the raw substring (F62): glz::raw_json keeps the exact bytes
-// GGG sent, including every field the poe:: types do not model. In a named
-// namespace (not the anonymous one) because glaze reflection requires the
-// type to have linkage.
+// captured as the raw substring (F62): glz::raw_json_view keeps the exact
+// bytes GGG sent, including every field the poe:: types do not model, as a
+// view into the reply rather than a copy of it. In a named namespace (not
+// the anonymous one) because glaze reflection requires the type to have
+// linkage.
 namespace json::raw {
 
     struct StashWrapper
     {
-        std::optional<glz::raw_json> stash;
+        std::optional<glz::raw_json_view> stash;
     };
 
     struct CharacterWrapper
     {
-        std::optional<glz::raw_json> character;
+        std::optional<glz::raw_json_view> character;
+    };
+
+    // poe::StashTab without its items: what an unchanged reply still has to
+    // yield, since the worker reads the tab's identity and launches its
+    // children from it. Glaze skips the "items" array of such a reply as an
+    // unknown key, without building a single poe::Item.
+    struct StashHeader
+    {
+        QString id;
+        std::optional<QString> parent;
+        std::optional<QString> folder;
+        QString name;
+        QString type;
+        std::optional<unsigned> index;
+        poe::StashTab::Metadata metadata;
+        std::optional<std::vector<StashHeader>> children;
     };
 
 } // namespace json::raw
@@ -44,6 +63,10 @@ namespace {
         // Tolerate unknown keys so new fields in GGG's API responses do
         // not break parsing.
         static constexpr glz::opts opts{.error_on_unknown_keys = false};
+        // Strings the item vocabulary already pooled come back shared
+        // instead of freshly decoded. Credentials stay out of the lookup.
+        const glaze_qt::ScopedInternHook intern(
+            (sensitivity == BufferSensitivity::ordinary) ? &StringPool::FindUtf8 : nullptr);
         T result;
         const std::string_view str{json.constData(), size_t(json.size())};
         const auto err = glz::read<opts>(result, str);
@@ -77,18 +100,15 @@ namespace {
         return read_json_impl<T>(json, BufferSensitivity::credentials);
     }
 
-    // Capture the reply's sub-object losslessly, then parse the typed
-    // payload from that same substring, so the stored bytes and the parsed
-    // object cannot diverge. The whole read fails — which the facade
-    // classifies as FetchError{Parse} — when the sub-object is missing or
-    // null (M2 D5/R2-4: a 200 without its payload is deterministic, and it
-    // must arrive as a typed error, not as a success the worker has to
-    // second-guess) or when the sub-object fails the typed parse.
-    template<typename Payload, typename Value, typename Raw>
-    std::optional<Payload> read_payload(const QByteArray &json,
-                                        const char *what,
-                                        std::optional<glz::raw_json> Raw::*member,
-                                        Value Payload::*value)
+    // Capture the reply's sub-object losslessly, as a view into `json`. The
+    // read fails — which the facade classifies as FetchError{Parse} — when
+    // the sub-object is missing or null (M2 D5/R2-4: a 200 without its
+    // payload is deterministic, and it must arrive as a typed error, not as a
+    // success the worker has to second-guess).
+    template<typename Raw>
+    std::optional<QByteArray> read_sub_object(const QByteArray &json,
+                                              const char *what,
+                                              std::optional<glz::raw_json_view> Raw::*member)
     {
         const auto raw = read_json<Raw>(json);
         if (!raw) {
@@ -98,18 +118,56 @@ namespace {
             spdlog::error("The reply has no '{}' payload", what);
             return std::nullopt;
         }
-        const std::string &str = (*raw.*member)->str;
-        const auto view = QByteArray::fromRawData(str.data(), qsizetype(str.size()));
-        auto parsed = read_json<Value>(view);
+        const std::string_view str = (*raw.*member)->str;
+        return QByteArray::fromRawData(str.data(), qsizetype(str.size()));
+    }
+
+    // Parse the typed payload from the captured sub-object, so the stored
+    // bytes and the parsed object cannot diverge. The whole read fails when
+    // the sub-object is missing or fails the typed parse.
+    template<typename Payload, typename Value, typename Raw>
+    std::optional<Payload> read_payload(const QByteArray &json,
+                                        const char *what,
+                                        std::optional<glz::raw_json_view> Raw::*member,
+                                        Value Payload::*value)
+    {
+        // A view into `json`, which outlives the parse: the stored bytes
+        // below are the reply's only copy of the payload.
+        const auto view = read_sub_object(json, what, member);
+        if (!view) {
+            return std::nullopt;
+        }
+        auto parsed = read_json<Value>(*view);
         if (!parsed) {
             return std::nullopt;
         }
         Payload payload;
         payload.*value = std::move(*parsed);
-        payload.bytes = QByteArray(str.data(), qsizetype(str.size()));
+        payload.bytes = QByteArray(view->constData(), view->size());
+        payload.digest = Util::ContentDigest(*view);
         return payload;
     }
 
+    poe::StashTab to_stash_tab(json::raw::StashHeader &&header)
+    {
+        poe::StashTab tab;
+        tab.id = std::move(header.id);
+        tab.parent = std::move(header.parent);
+        tab.folder = std::move(header.folder);
+        tab.name = std::move(header.name);
+        tab.type = std::move(header.type);
+        tab.index = header.index;
+        tab.metadata = std::move(header.metadata);
+        if (header.children) {
+            auto &children = tab.children.emplace();
+            children.reserve(header.children->size());
+            for (auto &child : *header.children) {
+                children.push_back(to_stash_tab(std::move(child)));
+            }
+        }
+        return tab;
+    }
+
 } // namespace
 
 std::optional<OAuthToken> json::readOAuthToken(const QByteArray &json)
@@ -155,9 +213,40 @@ std::optional<poe::StashListWrapper> json::readStashListWrapper(const QByteArray
     return read_json<poe::StashListWrapper>(json);
 }
 
-std::optional<poe::StashPayload> json::readStashPayload(const QByteArray &json)
+std::optional<poe::StashPayload> json::readStashPayload(const QByteArray &json,
+                                                        const QByteArray &known_digest)
 {
-    return read_payload(json, "stash", &json::raw::StashWrapper::stash, &poe::StashPayload::stash);
+    if (known_digest.isEmpty()) {
+        return read_payload(json,
+                            "stash",
+                            &json::raw::StashWrapper::stash,
+                            &poe::StashPayload::stash);
+    }
+    const auto view = read_sub_object(json, "stash", &json::raw::StashWrapper::stash);
+    if (!view) {
+        return std::nullopt;
+    }
+    // The digest is taken before any typed parse, so a reply that matches
+    // the caller's never builds its items at all.
+    QByteArray digest = Util::ContentDigest(*view);
+    poe::StashPayload payload;
+    if (digest == known_digest) {
+        auto header = read_json<json::raw::StashHeader>(*view);
+        if (!header) {
+            return std::nullopt;
+        }
+        payload.stash = to_stash_tab(std::move(*header));
+        payload.unchanged = true;
+    } else {
+        auto parsed = read_json<poe::StashTab>(*view);
+        if (!parsed) {
+            return std::nullopt;
+        }
+        payload.stash = std::move(*parsed);
+    }
+    payload.bytes = QByteArray(view->constData(), view->size());
+    payload.digest = std::move(digest);
+    return payload;
 }
 
 std::optional<std::vector<poe::StashTab>> json::readStashList(const QByteArray &json)
@@ -31,10 +31,13 @@ namespace json {
 
     // The payload readers capture the reply's stash/character sub-object
     // losslessly and parse the typed payload from that same substring, so
-    // the bytes and the parse cannot diverge (F62).
+    // the bytes and the parse cannot diverge (F62). A stash whose bytes
+    // match `known_digest` is parsed without its items (see
+    // poe::StashPayload).
     std::optional<poe::CharacterPayload> readCharacterPayload(const QByteArray &json);
     std::optional<poe::CharacterListWrapper> readCharacterListWrapper(const QByteArray &json);
-    std::optional<poe::StashPayload> readStashPayload(const QByteArray &json);
+    std::optional<poe::StashPayload> readStashPayload(const QByteArray &json,
+                                                      const QByteArray &known_digest = {});
     std::optional<poe::StashListWrapper> readStashListWrapper(const QByteArray &json);
 
     std::optional<poe::WebStashListWrapper> readWebStashListWrapper(const QByteArray &json);
@@ -3,7 +3,10 @@
 
 #include "util/logging.h"
 
+#include <future>
+
 #include <sentry.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/callback_sink.h>
 #include <spdlog/sinks/dist_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
@@ -20,6 +23,11 @@ constexpr int MAX_FILES = 20;
 
 constexpr int MAX_LOG_SIZE = 10 * 1024 * 1024; // 10MB
 
+// Messages the async logger may hold before a caller waits for room. A
+// full queue blocks rather than drops: at the default level it never fills,
+// and a trace burst that outruns the disk is better slowed than lost.
+constexpr size_t ASYNC_QUEUE_SIZE = 32768;
+
 #ifdef Q_OS_WIN
 // Visual Studio debug output on Windows
 using DEBUG_SINK = spdlog::sinks::msvc_sink_mt;
@@ -28,7 +36,7 @@ using DEBUG_SINK = spdlog::sinks::msvc_sink_mt;
 using DEBUG_SINK = spdlog::sinks::stdout_color_sink_mt;
 #endif
 
-void logging::init(const QString &filename)
+void logging::init(const QString &filename, Mode mode)
 {
     // Create a debug sink for the c
     auto debug_sink = std::make_shared<DEBUG_SINK>();
@@ -72,9 +80,47 @@ void logging::init(const QString &filename)
         // sentry_sink,
     };
 
-    // Create logger with both sinks
-    auto logger = std::make_shared<spdlog::logger>("main", sinks.begin(), sinks.end());
+    // Create the logger. The async one has a single worker thread, so the
+    // sinks still see messages in the order they were logged.
+    std::shared_ptr<spdlog::logger> logger;
+    if (mode == Mode::Async) {
+        spdlog::init_thread_pool(ASYNC_QUEUE_SIZE, 1);
+        logger = std::make_shared<spdlog::async_logger>("main",
+                                                        sinks.begin(),
+                                                        sinks.end(),
+                                                        spdlog::thread_pool(),
+                                                        spdlog::async_overflow_policy::block);
+    } else {
+        logger = std::make_shared<spdlog::logger>("main", sinks.begin(), sinks.end());
+    }
 
     spdlog::set_default_logger(logger);
     spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
 }
+
+void logging::flush()
+{
+    const auto logger = spdlog::default_logger();
+    if (!logger) {
+        return;
+    }
+    logger->flush();
+
+    // An async logger only queues that flush. The pool's one worker handles
+    // the queue in order, so once a marker posted behind the flush has been
+    // delivered, everything before it is on disk.
+    const auto pool = spdlog::thread_pool();
+    if (!pool || !std::dynamic_pointer_cast<spdlog::async_logger>(logger)) {
+        return;
+    }
+    auto delivered = std::make_shared<std::promise<void>>();
+    auto done = delivered->get_future();
+    auto marker_sink = std::make_shared<spdlog::sinks::callback_sink_mt>(
+        [delivered](const spdlog::details::log_msg &) { delivered->set_value(); });
+    auto marker = std::make_shared<spdlog::async_logger>("flush-marker",
+                                                         marker_sink,
+                                                         pool,
+                                                         spdlog::async_overflow_policy::block);
+    marker->critical("");
+    done.wait();
+}
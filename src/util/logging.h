@@ -9,6 +9,17 @@
 
 namespace logging {
 
-    void init(const QString &filename);
+    // How the main logger reaches its sinks. Async hands each message that
+    // passes the level check to one background thread through a bounded
+    // queue, so a logging call costs the format and an enqueue, never the
+    // file write. Sync writes on the calling thread.
+    enum class Mode { Sync, Async };
+
+    void init(const QString &filename, Mode mode = Mode::Async);
+
+    // Blocks until everything logged before the call has been written and
+    // the sinks flushed. For paths that may end the process without
+    // unwinding (FatalError) and for shutdown.
+    void flush();
 
 }
@@ -153,6 +153,9 @@ void NetworkManager::logReply(const QNetworkReply *reply)
 
 void NetworkManager::logAttributes(const QString &name, AttributeGetter getAttribute)
 {
+    if (!spdlog::should_log(spdlog::level::debug)) {
+        return;
+    }
     QStringList lines;
     for (const auto &[code, attribute] : KNOWN_ATTRIBUTES) {
         const QVariant value = getAttribute(code);
@@ -169,6 +172,9 @@ void NetworkManager::logAttributes(const QString &name, AttributeGetter getAttri
 
 void NetworkManager::logHeaders(const QString &name, const QHttpHeaders &headers)
 {
+    if (!spdlog::should_log(spdlog::level::debug)) {
+        return;
+    }
     QStringList lines;
     const auto headerPairs = headers.toListOfPairs();
     for (const auto &[header, value] : headerPairs) {
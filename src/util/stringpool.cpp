@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include "util/stringpool.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QHashFunctions>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+
+namespace {
+
+    // Sharded so the parse pool's threads rarely wait on each other.
+    constexpr size_t kShardCount = 16;
+
+    struct Shard
+    {
+        QMutex mutex;
+        QSet<QString> strings;
+    };
+
+    // The same entries keyed by their UTF-8 bytes, for FindUtf8, which the
+    // JSON readers call for every string they decode. Open addressing over
+    // a fixed array of slots filled at most half way: entries are only ever
+    // added, under the mutex, and published with a release store, so a
+    // lookup takes no lock. Bounded, since each entry is a second copy of
+    // its string: once full, later pool entries are not indexed, and the
+    // vocabulary the first parses pooled is what the hook keeps finding.
+    constexpr size_t kUtf8Slots = StringPool::kUtf8IndexCapacity * 2;
+    static_assert((kUtf8Slots & (kUtf8Slots - 1)) == 0);
+
+    struct Utf8Entry
+    {
+        QByteArray utf8;
+        QString value;
+    };
+
+    struct Utf8Index
+    {
+        std::array<std::atomic<const Utf8Entry *>, kUtf8Slots> slots{};
+        QMutex mutex;
+        std::deque<Utf8Entry> entries; // owns what the slots point to
+    };
+
+    size_t utf8SlotFor(QByteArrayView utf8)
+    {
+        return qHash(utf8) & (kUtf8Slots - 1);
+    }
+
+    void indexUtf8(Utf8Index &index, const QString &pooled)
+    {
+        QMutexLocker locker(&index.mutex);
+        if (index.entries.size() >= StringPool::kUtf8IndexCapacity) {
+            return;
+        }
+        QByteArray utf8 = pooled.toUtf8();
+        size_t slot = utf8SlotFor(utf8);
+        while (const Utf8Entry *entry = index.slots[slot].load(std::memory_order_relaxed)) {
+            if (entry->utf8 == utf8) {
+                return;
+            }
+            slot = (slot + 1) & (kUtf8Slots - 1);
+        }
+        const Utf8Entry &entry = index.entries.emplace_back(Utf8Entry{std::move(utf8), pooled});
+        index.slots[slot].store(&entry, std::memory_order_release);
+    }
+
+    StringPool::Pool &processPool()
+    {
+        static StringPool::Pool instance;
+        return instance;
+    }
+
+} // namespace
+
+struct StringPool::Pool::State
+{
+    std::array<Shard, kShardCount> shards;
+    Utf8Index utf8;
+};
+
+StringPool::Pool::Pool()
+    : m_state(std::make_unique<State>())
+{}
+
+StringPool::Pool::~Pool() = default;
+
+QString StringPool::Pool::Intern(const QString &value)
+{
+    if (value.isEmpty()) {
+        return QString();
+    }
+    QString pooled;
+    {
+        Shard &shard = m_state->shards[qHash(value) % kShardCount];
+        QMutexLocker locker(&shard.mutex);
+        const auto found = shard.strings.constFind(value);
+        if (found != shard.strings.cend()) {
+            return *found;
+        }
+        pooled = *shard.strings.insert(value);
+    }
+    // A new entry: index it by its bytes too. Only misses pay the encode.
+    indexUtf8(m_state->utf8, pooled);
+    return pooled;
+}
+
+QString StringPool::Pool::FindUtf8(std::string_view utf8) const
+{
+    if (utf8.empty()) {
+        return QString();
+    }
+    const QByteArrayView key(utf8.data(), qsizetype(utf8.size()));
+    const Utf8Index &index = m_state->utf8;
+    size_t slot = utf8SlotFor(key);
+    while (const Utf8Entry *entry = index.slots[slot].load(std::memory_order_acquire)) {
+        if (QByteArrayView(entry->utf8) == key) {
+            return entry->value;
+        }
+        slot = (slot + 1) & (kUtf8Slots - 1);
+    }
+    return QString();
+}
+
+size_t StringPool::Pool::size() const
+{
+    size_t total = 0;
+    for (Shard &shard : m_state->shards) {
+        QMutexLocker locker(&shard.mutex);
+        total += static_cast<size_t>(shard.strings.size());
+    }
+    return total;
+}
+
+QString StringPool::Intern(const QString &value)
+{
+    return processPool().Intern(value);
+}
+
+QString StringPool::FindUtf8(std::string_view utf8)
+{
+    return processPool().FindUtf8(utf8);
+}
+
+size_t StringPool::size()
+{
+    return processPool().size();
+}
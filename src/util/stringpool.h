@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#pragma once
+
+#include <QString>
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+// A process-wide pool of immutable strings. Intern() returns the pooled copy
+// of a value, so a string repeated across a million items (a base type, an
+// icon URL, a property name) is one implicitly shared buffer rather than one
+// allocation per item. Items are built on the parse pool's threads, so the
+// pool is sharded behind mutexes.
+//
+// Entries live for the process: intern only the item vocabulary, which is
+// bounded, never per-item values like ids, notes, or property values.
+namespace StringPool {
+
+    // How many pooled strings FindUtf8 can find: its index keeps a UTF-8
+    // copy of each, so it stops taking entries once it holds this many.
+    inline constexpr size_t kUtf8IndexCapacity = 16384;
+
+    // One pool. The free functions below use the process-wide instance;
+    // a pool of its own lets a test fill one without touching the other.
+    class Pool
+    {
+    public:
+        Pool();
+        ~Pool();
+        Pool(const Pool &) = delete;
+        Pool &operator=(const Pool &) = delete;
+
+        QString Intern(const QString &value);
+        QString FindUtf8(std::string_view utf8) const;
+        size_t size() const;
+
+    private:
+        struct State;
+        std::unique_ptr<State> m_state;
+    };
+
+    QString Intern(const QString &value);
+
+    // The pooled copy of a value given as UTF-8, or a null QString when it
+    // is not pooled (or was pooled after the index filled). Lookup only —
+    // never inserts — so the JSON readers can offer every string they decode
+    // (glaze_qt's intern hook) without letting ids or notes into the pool.
+    // Takes no lock, and a hit allocates nothing.
+    QString FindUtf8(std::string_view utf8);
+
+    // The number of distinct strings pooled (for the memory reports).
+    size_t size();
+
+} // namespace StringPool
@@ -21,6 +21,8 @@
 
 #include <cmath>
 
+#include <xxhash.h>
+
 #include "currency.h"
 #include "poe/types/stashtab.h"
 
@@ -36,6 +38,12 @@ QString Util::Md5(const QString &value)
     return hash.toUtf8().constData();
 }
 
+QByteArray Util::ContentDigest(const QByteArray &bytes)
+{
+    const XXH64_hash_t hash = XXH3_64bits(bytes.constData(), size_t(bytes.size()));
+    return QByteArray::number(quint64(hash), 16).rightJustified(16, '0');
+}
+
 double Util::AverageDamage(const QString &s)
 {
     const QStringList parts = s.split("-");
@@ -36,11 +36,16 @@ namespace Util {
     enum class RefreshReason { Unknown, ItemsChanged, SearchFormChanged, TabCreated, TabChanged };
     Q_ENUM_NS(RefreshReason)
 
-    enum class TabSelection { All, Checked, Selected, TabsOnly };
+    enum class TabSelection { All, Checked, Selected, TabsOnly, Quick };
     Q_ENUM_NS(TabSelection)
 
     QByteArray toPathBytes(const QString &path);
     QString Md5(const QString &value);
+    // Hex XXH3-64 of a reply's wire bytes: what StashRepo stores beside
+    // the bytes and the fetch scheduler compares replies by. Not a
+    // cryptographic hash — it only has to tell a reply from the previous
+    // one for the same source, and it is taken for every fetched tab.
+    QByteArray ContentDigest(const QByteArray &bytes);
     double AverageDamage(const QString &s);
     void PopulateBuyoutTypeComboBox(QComboBox *combobox);
     void PopulateBuyoutCurrencyComboBox(QComboBox *combobox);
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+// Buyout-pricing benchmark: what a snapshot pricing pass costs the user
+// store. Not a test: run by hand in a Release build:
+//
+//   ./buyoutpricing_benchmark
+//   ./buyoutpricing_benchmark --items 200000 --reps 3
+//
+// The items are the first --items (default 50k) of the 100k SpikeDataset
+// preset, every one of them inheriting its tab's price, against a user
+// store on disk (WAL, synchronous=NORMAL, as in production). Each rep
+// gives every tab a new price and runs PropagateTabBuyouts's per-item
+// rule, so every item's row is rewritten. Rows, all informational:
+//
+// - the pass inside one BuyoutBatch: one transaction, multi-row upserts;
+// - the pass with no batch open: one autocommit per item, the way every
+//   pass wrote before BuyoutBatch reached the repo.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "buyoutmanager.h"
+#include "currency.h"
+#include "datastore/buyoutrepo.h"
+#include "datastore/sqlitedatastore.h"
+#include "datastore/userstore.h"
+#include "item.h"
+#include "itemcategories.h"
+#include "itemlocation.h"
+#include "poe/types/item.h"
+#include "poe/types/stashtab.h"
+#include "spikedataset.h"
+
+namespace {
+
+    qint64 median(std::vector<qint64> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    void parseItems(const std::vector<poe::Item> &items,
+                    const ItemLocation &base,
+                    Items &out,
+                    size_t limit)
+    {
+        for (const auto &item : items) {
+            if (out.size() >= limit) {
+                return;
+            }
+            const ItemLocation location = base.getItemLocation(item);
+            out.push_back(std::make_shared<Item>(item, location));
+            if (item.socketedItems) {
+                parseItems(*item.socketedItems, location, out, limit);
+            }
+        }
+    }
+
+    // ItemsManager::PropagateTabBuyouts, less the refresh locks.
+    void propagate(BuyoutManager &manager, const Items &items)
+    {
+        for (const auto &item : items) {
+            if (manager.Get(*item).IsInherited()) {
+                Buyout tab_bo = manager.GetTab(item->location());
+                if (tab_bo.IsActive()) {
+                    tab_bo.inherited = true;
+                    tab_bo.last_update = QDateTime::currentDateTime();
+                    manager.Set(*item, tab_bo);
+                } else {
+                    manager.Set(*item, Buyout());
+                }
+            }
+        }
+    }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    const QCommandLineOption items_option("items", "Items to price.", "items", "50000");
+    const QCommandLineOption reps_option("reps", "Timed repetitions per row.", "reps", "5");
+    parser.addOption(items_option);
+    parser.addOption(reps_option);
+    parser.process(app);
+
+    const size_t item_count = std::max(1, parser.value(items_option).toInt());
+    const int reps = std::max(1, parser.value(reps_option).toInt());
+
+    auto main_logger = std::make_shared<spdlog::logger>("main");
+    main_logger->sinks().push_back(std::make_shared<spdlog::sinks::dist_sink_mt>());
+    spdlog::register_logger(main_logger);
+    spdlog::set_level(spdlog::level::warn);
+
+    InitItemClasses(R"json({"TestClass":{"name":"Weapons"}})json");
+    InitItemBaseTypes(
+        R"json({"Metadata/Items/TestSword":{"item_class":"TestClass","name":"Test Sword","release_state":"released"}})json");
+
+    std::printf("buyout-pricing benchmark: building %zu items...\n", item_count);
+    Items items;
+    std::vector<ItemLocation> tabs;
+    {
+        const SpikeDataset dataset(*SpikeDataset::Config::Preset("100k"));
+        for (int t = 0; (t < dataset.tabCount()) && (items.size() < item_count); ++t) {
+            const poe::StashTab stash = dataset.MakeStashReply(t);
+            if (stash.items) {
+                parseItems(*stash.items, dataset.location(t), items, item_count);
+            }
+            tabs.push_back(dataset.location(t));
+        }
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        std::fprintf(stderr, "could not create a temporary directory\n");
+        return 1;
+    }
+    SqliteDataStore data(dir.filePath("acquisition.sqlite"));
+    UserStore store(QDir(dir.path()), "benchmark");
+    BuyoutRepo &repo = store.buyouts();
+    BuyoutManager manager(data, repo);
+    QObject::connect(&manager,
+                     &BuyoutManager::SetItemBuyout,
+                     &repo,
+                     qOverload<const Buyout &, const Item &>(&BuyoutRepo::saveItemBuyout));
+    QObject::connect(&manager,
+                     &BuyoutManager::SetLocationBuyout,
+                     &repo,
+                     qOverload<const Buyout &, const ItemLocation &>(
+                         &BuyoutRepo::saveLocationBuyout));
+
+    // A new tab price every pass, so every item's row changes.
+    double price = 0.0;
+    const auto run_pass = [&](bool batched) {
+        price += 1.0;
+        const Buyout tab_bo(price,
+                            Buyout::BUYOUT_TYPE_BUYOUT,
+                            Currency::CURRENCY_CHAOS_ORB,
+                            QDateTime::currentDateTime());
+        {
+            const BuyoutBatch batch(manager);
+            for (const auto &tab : tabs) {
+                manager.SetTab(tab, tab_bo);
+            }
+        }
+        QElapsedTimer timer;
+        timer.start();
+        if (batched) {
+            const BuyoutBatch batch(manager);
+            propagate(manager, items);
+        } else {
+            propagate(manager, items);
+        }
+        return timer.nsecsElapsed();
+    };
+
+    // The first pass inserts every row; the timed ones update them.
+    run_pass(true);
+    std::vector<qint64> batched_samples;
+    std::vector<qint64> unbatched_samples;
+    for (int rep = 0; rep < reps; ++rep) {
+        batched_samples.push_back(run_pass(true));
+    }
+    for (int rep = 0; rep < reps; ++rep) {
+        unbatched_samples.push_back(run_pass(false));
+    }
+
+    const qint64 batched_ns = median(batched_samples);
+    const qint64 unbatched_ns = median(unbatched_samples);
+    std::printf("  %zu items in %zu tabs, %d reps\n\n", items.size(), tabs.size(), reps);
+    std::printf("%-44s %12s %12s\n", "row (median of reps)", "ms", "items/s");
+    const auto row = [&](const char *name, qint64 ns) {
+        std::printf("%-44s %12.3f %12.0f\n",
+                    name,
+                    ns / 1e6,
+                    (ns > 0) ? static_cast<double>(items.size()) / (ns / 1e9) : 0.0);
+    };
+    row("snapshot pricing: one BuyoutBatch", batched_ns);
+    row("snapshot pricing: no batch (per-item commit)", unbatched_ns);
+    return 0;
+}
@@ -10,6 +10,7 @@
 #include <variant>
 #include <vector>
 
+#include <QByteArray>
 #include <QFuture>
 #include <QPromise>
 #include <QString>
@@ -18,6 +19,7 @@
 #include "poe/poeapiclient.h"
 #include "ratelimit/fetcherror.h"
 #include "util/json_writers.h"
+#include "util/util.h"
 // Only for the unused base-constructor argument the fake is handed; nothing
 // here calls into the limiter.
 #include "ratelimit/ratelimiter.h"
@@ -74,6 +76,8 @@ public:
         QString league;
         QString stash_id;
         QString substash_id;
+        // The digest a stash fetch was launched with (PoeApiClient::getStash).
+        QByteArray known_digest;
         QString name;
         // The stop_token the worker passed with this call. From phase 5 the
         // worker threads one per-update token through every call in the update;
@@ -97,6 +101,7 @@ public:
                                                      const QString &league,
                                                      const QString &stash_id,
                                                      const QString &substash_id = {},
+                                                     const QByteArray &known_digest = {},
                                                      std::stop_token token = {}) override
     {
         Call call{.kind = Call::Kind::GetStash,
@@ -104,6 +109,7 @@ public:
                   .league = league,
                   .stash_id = stash_id,
                   .substash_id = substash_id,
+                  .known_digest = known_digest,
                   .token = token};
         return record<poe::StashPayload>(std::move(call));
     }
@@ -354,10 +360,11 @@ public:
     // facade returns the reply's wire bytes alongside the parse (F62); the
     // fake serializes the typed fixture instead — re-serialization is
     // harmless in tests, it is the production cache that must be faithful.
+    // A stash whose bytes match the digest its call was launched with comes
+    // back unchanged and without items, as the real reader returns it.
     void resolveStash(size_t i, poe::StashTab stash)
     {
-        QByteArray bytes = json::writeStash(stash);
-        resolve(i, poe::StashPayload{.stash = std::move(stash), .bytes = std::move(bytes)});
+        resolve(i, stashPayload(std::move(stash), m_pending.at(i).call.known_digest));
     }
 
     void resolveStashList(size_t i, std::vector<poe::StashTab> stashes)
@@ -368,8 +375,11 @@ public:
     void resolveCharacter(size_t i, poe::Character character)
     {
         QByteArray bytes = json::writeCharacter(character);
+        QByteArray digest = Util::ContentDigest(bytes);
         resolve(i,
-                poe::CharacterPayload{.character = std::move(character), .bytes = std::move(bytes)});
+                poe::CharacterPayload{.character = std::move(character),
+                                      .bytes = std::move(bytes),
+                                      .digest = std::move(digest)});
     }
 
     void resolveCharacterList(size_t i, std::vector<poe::Character> characters)
@@ -455,13 +465,12 @@ public:
     // These drive the content/child variants of the initialize-before-launch
     // invariant (W-INIT): a ready fetch runs its handler inline in the batch
     // launch loop, and must not finalize early or corrupt the counters and
-    // parent bookkeeping that were set before the launch.
+    // parent bookkeeping that were set before the launch. The call's known
+    // digest is not known yet when it is armed, so the payload is always
+    // parsed in full.
     void preresolveStash(poe::StashTab stash)
     {
-        QByteArray bytes = json::writeStash(stash);
-        armReady<poe::StashPayload>(Call::Kind::GetStash,
-                                    poe::StashPayload{.stash = std::move(stash),
-                                                      .bytes = std::move(bytes)});
+        armReady<poe::StashPayload>(Call::Kind::GetStash, stashPayload(std::move(stash), {}));
     }
 
     void prerejectStash(RateLimit::FetchError::Kind kind)
@@ -489,6 +498,20 @@ public:
     }
 
 private:
+    // The payload the real reader would return for `stash`'s bytes.
+    static poe::StashPayload stashPayload(poe::StashTab stash, const QByteArray &known_digest)
+    {
+        poe::StashPayload payload;
+        payload.bytes = json::writeStash(stash);
+        payload.digest = Util::ContentDigest(payload.bytes);
+        payload.unchanged = !known_digest.isEmpty() && (payload.digest == known_digest);
+        if (payload.unchanged) {
+            stash.items.reset();
+        }
+        payload.stash = std::move(stash);
+        return payload;
+    }
+
     // Type-erased settle hooks, so calls of different payload types can live
     // in one indexed list.
     struct Slot
@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+// JSON-parse throughput benchmark: glaze_qt's QString reader over recorded
+// stash payloads. Not a test: run by hand in a Release build:
+//
+//   ./jsonparse_benchmark --preset 100k
+//   ./jsonparse_benchmark --preset 1m --reps 3
+//
+// The payloads are the SpikeDataset preset's content replies (mod rolls
+// on), written the way a fetch stores them. Rows, all informational, in
+// MB/s of the bytes each row reads:
+//
+// - every string value in the payloads, decoded the previous way (into a
+//   std::string, then QString::fromUtf8) and by the direct reader, without
+//   and with the intern hook over a warm pool;
+// - whole payloads through json::readStash, first with an empty pool (the
+//   hook misses on every string), then after the item vocabulary has been
+//   interned the way Item's constructor interns it.
+//
+// Before timing, every string's direct decode is checked against the
+// previous decode; a mismatch exits non-zero.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "poe/types/item.h"
+#include "poe/types/stashtab.h"
+#include "spikedataset.h"
+#include "util/glaze_qt.h" // IWYU pragma: keep
+#include "util/json_readers.h"
+#include "util/json_writers.h"
+#include "util/stringpool.h"
+
+namespace {
+
+    constexpr glz::opts kOpts{.null_terminated = false};
+
+    qint64 median(std::vector<qint64> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    double megabytesPerSecond(size_t bytes, qint64 ns)
+    {
+        return (ns > 0) ? (static_cast<double>(bytes) / 1e6) / (static_cast<double>(ns) / 1e9)
+                        : 0.0;
+    }
+
+    // Every string value in a payload, quotes included; object keys are
+    // skipped, since glaze reads those itself.
+    void collectStrings(const QByteArray &payload, std::vector<std::string_view> &out)
+    {
+        const char *p = payload.constData();
+        const char *const end = p + payload.size();
+        while (p != end) {
+            if (*p != '"') {
+                ++p;
+                continue;
+            }
+            const char *const first = p++;
+            while ((p != end) && (*p != '"')) {
+                p += ((*p == '\\') && (p + 1 != end)) ? 2 : 1;
+            }
+            if (p == end) {
+                return;
+            }
+            const std::string_view literal(first, size_t(++p - first));
+            const char *next = p;
+            while ((next != end) && ((*next == ' ') || (*next == '\n') || (*next == '\t'))) {
+                ++next;
+            }
+            if ((next == end) || (*next != ':')) {
+                out.push_back(literal);
+            }
+        }
+    }
+
+    QString decodePrevious(std::string_view literal)
+    {
+        std::string str;
+        if (glz::read<kOpts>(str, literal)) {
+            return QString();
+        }
+        return QString::fromUtf8(str.data(), qsizetype(str.size()));
+    }
+
+    QString decodeDirect(std::string_view literal)
+    {
+        QString value;
+        if (glz::read<kOpts>(value, literal)) {
+            return QString();
+        }
+        return value;
+    }
+
+    // What Item's constructor pools from a parsed item.
+    void internVocabulary(const poe::Item &item)
+    {
+        StringPool::Intern(item.typeLine);
+        StringPool::Intern(item.baseType);
+        StringPool::Intern(item.icon);
+        for (const auto *list : {&item.properties, &item.requirements}) {
+            if (!*list) {
+                continue;
+            }
+            for (const auto &property : **list) {
+                StringPool::Intern(property.name);
+            }
+        }
+    }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    const QCommandLineOption preset_option("preset",
+                                           "Dataset preset: smoke, 100k, or 1m.",
+                                           "preset",
+                                           "100k");
+    const QCommandLineOption reps_option("reps", "Timed repetitions per row.", "reps", "5");
+    parser.addOption(preset_option);
+    parser.addOption(reps_option);
+    parser.process(app);
+
+    const QString preset_name = parser.value(preset_option);
+    auto preset = SpikeDataset::Config::Preset(preset_name);
+    if (!preset) {
+        std::fprintf(stderr, "unknown preset: %s\n", qPrintable(preset_name));
+        return 1;
+    }
+    preset->with_mods = true;
+    const int reps = std::max(1, parser.value(reps_option).toInt());
+
+    auto main_logger = std::make_shared<spdlog::logger>("main");
+    main_logger->sinks().push_back(std::make_shared<spdlog::sinks::dist_sink_mt>());
+    spdlog::register_logger(main_logger);
+    spdlog::set_level(spdlog::level::warn);
+
+    std::printf("json-parse benchmark: building dataset preset %s...\n", qPrintable(preset_name));
+    const SpikeDataset dataset(*preset);
+    std::vector<QByteArray> payloads;
+    payloads.reserve(static_cast<size_t>(dataset.tabCount()));
+    size_t payload_bytes = 0;
+    for (int t = 0; t < dataset.tabCount(); ++t) {
+        payloads.push_back(json::writeStash(dataset.MakeStashReply(t)));
+        payload_bytes += static_cast<size_t>(payloads.back().size());
+    }
+
+    std::vector<std::string_view> strings;
+    for (const auto &payload : payloads) {
+        collectStrings(payload, strings);
+    }
+    size_t string_bytes = 0;
+    for (const auto &literal : strings) {
+        string_bytes += literal.size();
+        if (decodeDirect(literal) != decodePrevious(literal)) {
+            std::fprintf(stderr,
+                         "decode mismatch: %.*s\n",
+                         int(literal.size()),
+                         literal.data());
+            return 1;
+        }
+    }
+    std::printf("  %zu payloads, %.2f MB; %zu strings, %.2f MB\n\n",
+                payloads.size(),
+                payload_bytes / 1e6,
+                strings.size(),
+                string_bytes / 1e6);
+
+    const auto time_row = [&](const auto &body) {
+        std::vector<qint64> samples;
+        for (int rep = 0; rep < reps; ++rep) {
+            QElapsedTimer timer;
+            timer.start();
+            body();
+            samples.push_back(timer.nsecsElapsed());
+        }
+        return median(samples);
+    };
+    // Summed over every row and printed, so no decode can be elided.
+    qsizetype decoded_units = 0;
+    const auto time_strings = [&](QString (*decode)(std::string_view)) {
+        return time_row([&] {
+            for (const auto &literal : strings) {
+                decoded_units += decode(literal).size();
+            }
+        });
+    };
+    const auto time_payloads = [&] {
+        return time_row([&] {
+            for (const auto &payload : payloads) {
+                if (!json::readStash(payload)) {
+                    std::fprintf(stderr, "a payload failed to parse\n");
+                }
+            }
+        });
+    };
+
+    const qint64 previous_ns = time_strings(&decodePrevious);
+    const qint64 direct_ns = time_strings(&decodeDirect);
+    const qint64 cold_ns = time_payloads();
+
+    for (const auto &payload : payloads) {
+        const auto stash = json::readStash(payload);
+        if (stash && stash->items) {
+            for (const auto &item : *stash->items) {
+                internVocabulary(item);
+            }
+        }
+    }
+    qint64 hooked_ns = 0;
+    {
+        const glaze_qt::ScopedInternHook intern(&StringPool::FindUtf8);
+        hooked_ns = time_strings(&decodeDirect);
+    }
+    const qint64 warm_ns = time_payloads();
+
+    std::printf("%-44s %12s %12s\n", "row (median of reps)", "ms", "MB/s");
+    const auto row = [](const char *name, size_t bytes, qint64 ns) {
+        std::printf("%-44s %12.3f %12.1f\n", name, ns / 1e6, megabytesPerSecond(bytes, ns));
+    };
+    row("strings: std::string + fromUtf8 (previous)", string_bytes, previous_ns);
+    row("strings: direct decode", string_bytes, direct_ns);
+    row("strings: direct decode + intern hook", string_bytes, hooked_ns);
+    row("readStash: empty pool", payload_bytes, cold_ns);
+    row("readStash: vocabulary pooled", payload_bytes, warm_ns);
+    std::printf("\n  %zu strings pooled, %lld UTF-16 units decoded\n",
+                StringPool::size(),
+                static_cast<long long>(decoded_units));
+    std::printf("[attribution] direct decode vs previous: %.1f%% of the time\n",
+                (previous_ns > 0)
+                    ? 100.0 * static_cast<double>(direct_ns) / static_cast<double>(previous_ns)
+                    : 0.0);
+    return 0;
+}
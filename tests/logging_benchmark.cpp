@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+// Logging benchmark: what the log costs a full refresh. Not a test: run by
+// hand in a Release build:
+//
+//   ./logging_benchmark
+//   ./logging_benchmark --preset 1m --reps 1
+//
+// Each rep is a fresh worker, manager, and user store that loads an empty
+// cache and then runs one full refresh of the SpikeDataset preset through
+// the real reply path (worker -> persistence -> manager), every tab a
+// changed reply. The logger is built the way logging::init builds it —
+// rotating file sink at trace, the UI sink hub at warn, sync or async —
+// less the console sink, which would only measure the terminal. Rows, the
+// median of the reps:
+//
+// - the refresh, until the final snapshot is published: what the UI
+//   thread pays;
+// - the same plus logging::flush(): when the last line is on disk.
+//
+// for {sync, async} x {info, trace}, info being the release default.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "datastore/stashrepo.h"
+#include "datastore/userstore.h"
+#include "fakeapiclient.h"
+#include "itemcategories.h"
+#include "itemsmanager.h"
+#include "itemsmanagerworker.h"
+#include "ratelimit/ratelimiter.h"
+#include "spikedataset.h"
+#include "testfixtures.h"
+#include "util/json_writers.h"
+#include "util/logging.h"
+#include "util/networkmanager.h"
+#include "util/util.h"
+
+namespace {
+
+    constexpr const char *kRealm = "pc";
+    constexpr const char *kLeague = "Logging League";
+    constexpr const char *kAccount = "logging";
+
+    struct Sample
+    {
+        qint64 refresh_ns = 0;
+        qint64 drained_ns = 0;
+    };
+
+    qint64 median(std::vector<qint64> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    void installLogger(const QString &path, logging::Mode mode, spdlog::level::level_enum level)
+    {
+        auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(path.toStdString(),
+                                                                                10 * 1024 * 1024,
+                                                                                20);
+        file_sink->set_level(spdlog::level::trace);
+        auto ui_sink_hub = std::make_shared<spdlog::sinks::dist_sink_mt>();
+        ui_sink_hub->set_level(spdlog::level::warn);
+        std::vector<spdlog::sink_ptr> sinks{file_sink, ui_sink_hub};
+
+        std::shared_ptr<spdlog::logger> logger;
+        if (mode == logging::Mode::Async) {
+            spdlog::init_thread_pool(32768, 1);
+            logger = std::make_shared<spdlog::async_logger>("main",
+                                                            sinks.begin(),
+                                                            sinks.end(),
+                                                            spdlog::thread_pool(),
+                                                            spdlog::async_overflow_policy::block);
+        } else {
+            logger = std::make_shared<spdlog::logger>("main", sinks.begin(), sinks.end());
+        }
+        spdlog::set_default_logger(logger);
+        spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
+        spdlog::set_level(level);
+    }
+
+    // Runs the event loop until `done`, or gives up after ten minutes.
+    template<typename Pred>
+    bool spinUntil(Pred done)
+    {
+        QElapsedTimer deadline;
+        deadline.start();
+        while (!done()) {
+            if (deadline.elapsed() > 10 * 60 * 1000) {
+                return false;
+            }
+            QCoreApplication::processEvents(QEventLoop::AllEvents);
+        }
+        return true;
+    }
+
+    std::optional<Sample> runRefresh(const std::vector<poe::StashTab> &stash_list,
+                                     const std::vector<poe::StashPayload> &replies,
+                                     const QString &log_path,
+                                     logging::Mode mode,
+                                     spdlog::level::level_enum level)
+    {
+        BuyoutManagerFixture bm;
+        installLogger(log_path, mode, level);
+
+        QSettings settings(bm.tempDir.filePath("settings.ini"), QSettings::IniFormat);
+        settings.setValue("account", kAccount);
+        settings.setValue("realm", kRealm);
+        settings.setValue("league", kLeague);
+        settings.sync();
+
+        NetworkManager network;
+        RateLimiter limiter(network);
+        FakePoeApiClient api(limiter);
+        ItemsManager manager(settings, *bm.manager, *bm.data);
+        UserStore store(QDir(bm.tempDir.filePath("data")), kAccount);
+        ItemsManagerWorker worker(settings, *bm.manager, api);
+
+        int refresh_count = 0;
+        QObject::connect(&manager, &ItemsManager::ItemsRefreshed, &manager, [&] {
+            ++refresh_count;
+        });
+        QObject::connect(&worker,
+                         &ItemsManagerWorker::stashListReceived,
+                         &store.stashes(),
+                         &StashRepo::saveStashList);
+        QObject::connect(&worker,
+                         &ItemsManagerWorker::stashReceived,
+                         &store.stashes(),
+                         &StashRepo::saveStash);
+        QObject::connect(&worker,
+                         &ItemsManagerWorker::TabRefreshed,
+                         &manager,
+                         &ItemsManager::OnTabRefreshed);
+        QObject::connect(&worker,
+                         &ItemsManagerWorker::ChildrenReconciled,
+                         &manager,
+                         &ItemsManager::OnChildrenReconciled);
+        QObject::connect(&worker,
+                         &ItemsManagerWorker::ItemsRefreshed,
+                         &manager,
+                         &ItemsManager::OnItemsRefreshed);
+
+        worker.OnRePoEReady();
+        if (!spinUntil([&] { return refresh_count == 1; })) {
+            std::fprintf(stderr, "the initial load never completed\n");
+            return std::nullopt;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        worker.Update(TabSelection::All);
+        api.resolveCharacterList(api.pendingCharacterList(kRealm), {});
+        api.resolveStashList(api.pendingStashList(kRealm, kLeague), stash_list);
+        QCoreApplication::processEvents(QEventLoop::AllEvents);
+        for (const auto &reply : replies) {
+            api.resolve(api.pendingStash(reply.stash.id), reply);
+        }
+        if (!spinUntil([&] { return refresh_count == 2; })) {
+            std::fprintf(stderr, "the refresh never completed\n");
+            return std::nullopt;
+        }
+        Sample sample;
+        sample.refresh_ns = timer.nsecsElapsed();
+        logging::flush();
+        sample.drained_ns = timer.nsecsElapsed();
+        return sample;
+    }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    const QCommandLineOption preset_option("preset",
+                                           "Dataset preset: smoke, 100k, or 1m.",
+                                           "preset",
+                                           "100k");
+    const QCommandLineOption reps_option("reps", "Refreshes per row.", "reps", "3");
+    parser.addOption(preset_option);
+    parser.addOption(reps_option);
+    parser.process(app);
+
+    const QString preset_name = parser.value(preset_option);
+    const auto preset = SpikeDataset::Config::Preset(preset_name);
+    if (!preset) {
+        std::fprintf(stderr, "unknown preset: %s\n", qPrintable(preset_name));
+        return 1;
+    }
+    const int reps = std::max(1, parser.value(reps_option).toInt());
+
+    // The logs outlive each rep's fixture: the logger keeps its file open
+    // until the next rep replaces it.
+    QTemporaryDir log_dir;
+    if (!log_dir.isValid()) {
+        std::fprintf(stderr, "could not create a temporary directory\n");
+        return 1;
+    }
+    int log_index = 0;
+
+    InitItemClasses(R"json({"TestClass":{"name":"Weapons"}})json");
+    InitItemBaseTypes(
+        R"json({"Metadata/Items/TestSword":{"item_class":"TestClass","name":"Test Sword","release_state":"released"}})json");
+
+    std::printf("logging benchmark: building dataset preset %s...\n", qPrintable(preset_name));
+    std::vector<poe::StashTab> stash_list;
+    std::vector<poe::StashPayload> replies;
+    qsizetype item_count = 0;
+    {
+        const SpikeDataset dataset(*preset);
+        for (int t = 0; t < dataset.tabCount(); ++t) {
+            stash_list.push_back(dataset.stashSpec(t));
+            poe::StashTab reply = dataset.MakeStashReply(t);
+            QByteArray bytes = json::writeStash(reply);
+            QByteArray digest = Util::ContentDigest(bytes);
+            replies.push_back(poe::StashPayload{.stash = std::move(reply),
+                                                .bytes = std::move(bytes),
+                                                .digest = std::move(digest)});
+        }
+        item_count = dataset.totalItems();
+    }
+
+    struct Row
+    {
+        const char *name;
+        logging::Mode mode;
+        spdlog::level::level_enum level;
+    };
+    const Row rows[] = {
+        {"sync, info", logging::Mode::Sync, spdlog::level::info},
+        {"sync, trace", logging::Mode::Sync, spdlog::level::trace},
+        {"async, info", logging::Mode::Async, spdlog::level::info},
+        {"async, trace", logging::Mode::Async, spdlog::level::trace},
+    };
+
+    std::printf("  %zu tabs, %lld items, %d reps\n\n",
+                stash_list.size(),
+                static_cast<long long>(item_count),
+                reps);
+    std::printf("%-24s %16s %16s\n", "row (median of reps)", "refresh ms", "+ flush ms");
+    for (const Row &row : rows) {
+        std::vector<qint64> refresh_samples;
+        std::vector<qint64> drained_samples;
+        for (int rep = 0; rep < reps; ++rep) {
+            const QString log_path = log_dir.filePath(QString("log-%1.txt").arg(log_index++));
+            const auto sample = runRefresh(stash_list, replies, log_path, row.mode, row.level);
+            if (!sample) {
+                return 1;
+            }
+            refresh_samples.push_back(sample->refresh_ns);
+            drained_samples.push_back(sample->drained_ns);
+        }
+        std::printf("%-24s %16.1f %16.1f\n",
+                    row.name,
+                    median(refresh_samples) / 1e6,
+                    median(drained_samples) / 1e6);
+    }
+    spdlog::shutdown();
+    return 0;
+}
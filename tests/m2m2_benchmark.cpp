@@ -53,6 +53,7 @@
 #include "ui/mainwindow.h"
 #include "util/json_writers.h"
 #include "util/networkmanager.h"
+#include "util/util.h"
 #include "workertestaccess.h"
 
 namespace {
@@ -387,8 +388,11 @@ int main(int argc, char *argv[])
     for (int t = 0; t < dataset.tabCount(); ++t) {
         poe::StashTab reply = dataset.MakeStashReply(t);
         QByteArray bytes = json::writeStash(reply);
+        QByteArray digest = Util::ContentDigest(bytes);
         api.resolve(api.pendingStash(reply.id),
-                    poe::StashPayload{.stash = std::move(reply), .bytes = std::move(bytes)});
+                    poe::StashPayload{.stash = std::move(reply),
+                                      .bytes = std::move(bytes),
+                                      .digest = std::move(digest)});
         if ((t % 64) == 0 && !drainUntilIdle()) {
             std::fprintf(stderr, "event loop never settled during populate\n");
             return 1;
@@ -451,6 +455,7 @@ int main(int argc, char *argv[])
             reply = dataset.MakeStashReply(t);
         }
         QByteArray bytes = json::writeStash(reply);
+        QByteArray digest = Util::ContentDigest(bytes);
         const FetchSourceKey key{ItemLocationType::STASH, reply.id};
 
         Sample sample;
@@ -485,7 +490,9 @@ int main(int argc, char *argv[])
         probes = Probes{};
         probes.window_start = g_clock.nsecsElapsed();
         api.resolve(api.pendingStash(reply.id),
-                    poe::StashPayload{.stash = reply, .bytes = std::move(bytes)});
+                    poe::StashPayload{.stash = reply,
+                                      .bytes = std::move(bytes),
+                                      .digest = std::move(digest)});
         if (!drainUntilIdle()) {
             std::fprintf(stderr, "event loop never settled during a measured reply\n");
             return 1;
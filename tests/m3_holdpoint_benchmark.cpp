@@ -28,7 +28,19 @@
 // S6 rows (informational, added in S6 review round 1): the clean final
 // snapshot's row reconciliation, By-Tab and By-Item — elapsed plus
 // lifetime-peak delta, no budget (the spec accepts O(collection) once
-// per refresh; these keep the every-refresh path measured).
+// per refresh; these keep the every-refresh path measured). Cold-start
+// rows (informational): the cached-load parse, serial against the
+// reader + parse-pool pipeline, over a user store seeded from the preset.
+// Columnar-index rows (informational): the broad filter's bare
+// FilterItems on the per-item path against the FilterIndex path, and the
+// Quality and ilvl columns' key extraction against the regular
+// expressions SortValue replaced; likewise a name search, per-item against
+// the trigram-indexed text column.
+// Collection-memory row (informational): the process footprint delta
+// across materializing the preset's Items, per item, and the resident set
+// size before and after it on any platform. Column-switch rows
+// (informational): a By-Item header click with the flat sort on the UI
+// thread, against the background sort's UI block and landing latency.
 //
 // S7 runs this same accumulated set as the formal complete-table M1-M3
 // gate (the spec's acceptance-criteria budget table, authoritative on
@@ -48,11 +60,15 @@
 #include <QComboBox>
 #include <QCommandLineParser>
 #include <QElapsedTimer>
+#include <QFile>
 #include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
+#include <QRegularExpression>
 #include <QScrollBar>
+#include <QSettings>
 #include <QTabBar>
+#include <QThread>
 #include <QTreeView>
 
 #include <algorithm>
@@ -65,18 +81,27 @@
 #include <mach/mach.h>
 #endif
 #include <sys/resource.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 #include <spdlog/sinks/dist_sink.h>
 #include <spdlog/spdlog.h>
 
 #include "bucket.h"
 #include "column.h"
+#include "datastore/stashrepo.h"
+#include "datastore/userstore.h"
+#include "filters/filterindex.h"
 #include "filters/filterspec.h"
 #include "filters/filterstate.h"
+#include "items_model.h"
+#include "itemsmanagerworker.h"
 #include "mainwindowfixture.h"
 #include "modelprobes.h"
 #include "search.h"
 #include "spikedataset.h"
+#include "util/stringpool.h"
 
 namespace {
 
@@ -129,6 +154,16 @@ namespace {
         }
     }
 
+    // A By-Item header click over a large flat bucket sorts off the UI
+    // thread; rows that need the new order wait for it to land.
+    void waitForBackgroundSort(QTreeView &tree)
+    {
+        const auto *model = qobject_cast<ItemsModel *>(tree.model());
+        while (model && model->backgroundSortPending()) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents | QEventLoop::WaitForMoreEvents);
+        }
+    }
+
     // Process-level memory footprint (phys_footprint on macOS — the
     // number Activity Monitor calls "memory"). The S5/S7 resident-key
     // budget is stated at process level; the gauge is an estimate.
@@ -145,6 +180,32 @@ namespace {
         return -1;
     }
 
+    // Resident set size, for the collection-memory row on every platform:
+    // the footprint API above is macOS only.
+    std::int64_t processResidentBytes()
+    {
+#ifdef __APPLE__
+        mach_task_basic_info_data_t info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(),
+                      MACH_TASK_BASIC_INFO,
+                      reinterpret_cast<task_info_t>(&info),
+                      &count)
+            == KERN_SUCCESS) {
+            return static_cast<std::int64_t>(info.resident_size);
+        }
+#elif defined(__linux__)
+        QFile statm("/proc/self/statm");
+        if (statm.open(QIODevice::ReadOnly)) {
+            const QList<QByteArray> fields = statm.readAll().split(' ');
+            if (fields.size() > 1) {
+                return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+            }
+        }
+#endif
+        return -1;
+    }
+
     struct BudgetRow
     {
         const char *name;
@@ -218,13 +279,43 @@ int main(int argc, char *argv[])
 
     std::printf("M3 hold-point harness: building dataset preset %s...\n", qPrintable(preset_name));
     SpikeDataset dataset(*preset);
+    const std::int64_t collection_footprint_before = processFootprintBytes();
+    const std::int64_t collection_rss_before = processResidentBytes();
     Items all_items = dataset.allItems();
+    const std::int64_t collection_footprint_after = processFootprintBytes();
+    const std::int64_t collection_rss_after = processResidentBytes();
     std::vector<ItemLocation> locations;
     locations.reserve(static_cast<size_t>(dataset.tabCount()));
     for (int t = 0; t < dataset.tabCount(); ++t) {
         locations.push_back(dataset.location(t));
     }
     std::printf("  %d tabs, %zu items\n", dataset.tabCount(), all_items.size());
+    // Informational: what the materialized collection itself costs, the
+    // figure Item's pooled strings and flat maps are judged by. The two
+    // collection rows need only this file's footprint and resident-size
+    // helpers, so they carry over as-is to a tree without the pooling,
+    // whose run is the baseline they compare against. The pool's own size
+    // is a separate row.
+    if ((collection_footprint_before >= 0) && (collection_footprint_after >= 0)) {
+        const double delta = static_cast<double>(collection_footprint_after
+                                                 - collection_footprint_before);
+        std::printf("  [memory] materialized collection: process footprint delta %.1f MB "
+                    "(%.0f bytes/item)\n",
+                    delta / (1024.0 * 1024.0),
+                    all_items.empty() ? 0.0 : delta / static_cast<double>(all_items.size()));
+    } else {
+        std::printf("  [memory] materialized collection: no process footprint API on this "
+                    "platform\n");
+    }
+    if ((collection_rss_before >= 0) && (collection_rss_after >= 0)) {
+        std::printf("  [memory] materialized collection: RSS before %.1f MB, after %.1f MB "
+                    "(delta %.1f MB)\n",
+                    static_cast<double>(collection_rss_before) / (1024.0 * 1024.0),
+                    static_cast<double>(collection_rss_after) / (1024.0 * 1024.0),
+                    static_cast<double>(collection_rss_after - collection_rss_before)
+                        / (1024.0 * 1024.0));
+    }
+    std::printf("  [shape] pooled strings: %zu\n", StringPool::size());
 
     MainWindowFixture fixture;
     auto *tree = fixture.window->findChild<QTreeView *>("treeView");
@@ -416,6 +507,133 @@ int main(int argc, char *argv[])
                     toMs(micro_filter),
                     toMs(micro_sort));
 
+        // Base-family key extraction over the whole collection, for two
+        // columns every sort of them pays: the typed SortValue path
+        // against the two regular expressions it replaced, run here on
+        // the same value() strings.
+        static const QRegularExpression sort_double_match("^\\+?([\\d.]+)%?$");
+        static const QRegularExpression sort_two_values("^(\\d+)([-/])(\\d+)$");
+        const PropertyColumn quality_column("Q", "Quality");
+        const ItemlevelColumn ilvl_column;
+        for (const Column *column : {static_cast<const Column *>(&quality_column),
+                                     static_cast<const Column *>(&ilvl_column)}) {
+            std::vector<qint64> typed_samples;
+            std::vector<qint64> regex_samples;
+            qsizetype sink = 0;
+            for (int rep = 0; rep < 3; ++rep) {
+                t0 = clock.nsecsElapsed();
+                for (const auto &item : all_items) {
+                    sink += static_cast<qsizetype>(column->key(*item).prefix[0] & 1);
+                }
+                typed_samples.push_back(clock.nsecsElapsed() - t0);
+                t0 = clock.nsecsElapsed();
+                for (const auto &item : all_items) {
+                    const QString str = column->value(*item).toString();
+                    QRegularExpressionMatch match;
+                    if (str.contains(sort_double_match, &match)
+                        || str.contains(sort_two_values, &match)) {
+                        sink += match.capturedLength(1);
+                    }
+                }
+                regex_samples.push_back(clock.nsecsElapsed() - t0);
+            }
+            std::printf("  [micro] %s key extraction: SortValue keys %.3f ms; the old "
+                        "regex match alone %.3f ms (median of 3, sink %lld)\n",
+                        qPrintable(column->name()),
+                        toMs(median(typed_samples)),
+                        toMs(median(regex_samples)),
+                        static_cast<long long>(sink));
+        }
+
+        // The same broad filter through the columnar index: the snapshot
+        // build (slots only), the first scan (materializes the ilvl
+        // column), then the steady state every later refilter sees. The
+        // per-item row repeats the micro above so the two are comparable.
+        FilterIndex filter_index(catalog);
+        t0 = clock.nsecsElapsed();
+        filter_index.ResetTo(all_items);
+        const qint64 index_build = clock.nsecsElapsed() - t0;
+        Search indexed(*fixture.buyoutFixture.manager,
+                       "micro-indexed",
+                       catalog,
+                       nullptr,
+                       &filter_index);
+        for (qsizetype n = 0; n < catalog.size(); ++n) {
+            indexed.setFilterState(n, bare.filterStateAt(n));
+        }
+        t0 = clock.nsecsElapsed();
+        indexed.FilterItems(all_items);
+        const qint64 index_first = clock.nsecsElapsed() - t0;
+        std::vector<qint64> per_item_samples;
+        std::vector<qint64> indexed_samples;
+        for (int rep = 0; rep < 3; ++rep) {
+            t0 = clock.nsecsElapsed();
+            bare.FilterItems(all_items);
+            per_item_samples.push_back(clock.nsecsElapsed() - t0);
+            t0 = clock.nsecsElapsed();
+            indexed.FilterItems(all_items);
+            indexed_samples.push_back(clock.nsecsElapsed() - t0);
+        }
+        if (indexed.items().size() != bare.items().size()) {
+            std::printf("  [micro] columnar index result MISMATCH: %zu vs %zu visible items\n",
+                        indexed.items().size(),
+                        bare.items().size());
+        }
+        std::printf("  [micro] columnar index: snapshot build %.3f ms; first scan "
+                    "(materializes ilvl) %.3f ms\n",
+                    toMs(index_build),
+                    toMs(index_first));
+        rows.push_back({"broad-filter FilterItems, per-item path (median)",
+                        toMs(median(per_item_samples)),
+                        -1});
+        rows.push_back({"broad-filter FilterItems, columnar index (median)",
+                        toMs(median(indexed_samples)),
+                        -1});
+
+        // A name search on both paths: the ilvl filter off, a query taken
+        // from the collection so it matches. The first indexed scan
+        // materializes the name column and its trigram postings.
+        const QString name_query = all_items.empty()
+                                       ? QString("ring")
+                                       : all_items.front()->PrettyName().left(4);
+        for (qsizetype n = 0; n < catalog.size(); ++n) {
+            if (catalog[n].caption == "ilvl") {
+                bare.setFilterState(n, MakeDefaultState(catalog[n]));
+                indexed.setFilterState(n, MakeDefaultState(catalog[n]));
+            } else if (catalog[n].caption == "Name") {
+                bare.setFilterState(n, TextState{name_query});
+                indexed.setFilterState(n, TextState{name_query});
+            }
+        }
+        t0 = clock.nsecsElapsed();
+        indexed.FilterItems(all_items);
+        const qint64 name_first = clock.nsecsElapsed() - t0;
+        per_item_samples.clear();
+        indexed_samples.clear();
+        for (int rep = 0; rep < 3; ++rep) {
+            t0 = clock.nsecsElapsed();
+            bare.FilterItems(all_items);
+            per_item_samples.push_back(clock.nsecsElapsed() - t0);
+            t0 = clock.nsecsElapsed();
+            indexed.FilterItems(all_items);
+            indexed_samples.push_back(clock.nsecsElapsed() - t0);
+        }
+        if (indexed.items().size() != bare.items().size()) {
+            std::printf("  [micro] name index result MISMATCH: %zu vs %zu visible items\n",
+                        indexed.items().size(),
+                        bare.items().size());
+        }
+        std::printf("  [micro] name index: first scan (materializes name, %zu visible) "
+                    "%.3f ms\n",
+                    bare.items().size(),
+                    toMs(name_first));
+        rows.push_back({"name-search FilterItems, per-item path (median)",
+                        toMs(median(per_item_samples)),
+                        -1});
+        rows.push_back({"name-search FilterItems, trigram index (median)",
+                        toMs(median(indexed_samples)),
+                        -1});
+
         ilvl_min->clear();
         fixture.window->OnSearchFormChange();
         drainEvents();
@@ -788,6 +1006,7 @@ int main(int argc, char *argv[])
             // flat bucket (R3-2), then the merge applies.
             {
                 tree->header()->setSortIndicator(1, Qt::AscendingOrder); // Price; re-keys + sorts
+                waitForBackgroundSort(*tree);
                 drainEvents();
                 std::vector<Items> reps;
                 for (int rep = 0; rep < 5; ++rep) {
@@ -817,10 +1036,48 @@ int main(int argc, char *argv[])
                             static_cast<long long>(probes.model_resets));
                 drainEvents();
                 tree->header()->setSortIndicator(0, Qt::DescendingOrder); // restore Name
+                waitForBackgroundSort(*tree);
                 drainEvents();
             }
         }
 
+        // Rows: a By-Item column switch, the header click that re-keys and
+        // re-sorts the whole flat bucket. Informational: the UI thread's
+        // block with the sort on it, against the background sort's block
+        // (snapshot and hand-off) and its click-to-landed latency.
+        {
+            auto *items_model = qobject_cast<ItemsModel *>(tree->model());
+            const int ilvl_column = items_model->columnCount() - 1;
+            std::vector<qint64> landed;
+            const auto columnSwitch = [&](int background_rows) {
+                items_model->SetBackgroundSortRows(background_rows);
+                std::vector<qint64> blocked;
+                landed.clear();
+                for (int rep = 0; rep < 3; ++rep) {
+                    t0 = clock.nsecsElapsed();
+                    tree->header()->setSortIndicator(ilvl_column, Qt::AscendingOrder);
+                    blocked.push_back(clock.nsecsElapsed() - t0);
+                    waitForBackgroundSort(*tree);
+                    landed.push_back(clock.nsecsElapsed() - t0);
+                    drainEvents();
+                    tree->header()->setSortIndicator(0, Qt::DescendingOrder); // restore Name
+                    waitForBackgroundSort(*tree);
+                    drainEvents();
+                }
+                return median(blocked);
+            };
+            rows.push_back({"By-Item column switch, UI-thread sort (median of 3)",
+                            toMs(columnSwitch(0)),
+                            -1.0});
+            rows.push_back({"By-Item column switch, background sort: UI block",
+                            toMs(columnSwitch(1)),
+                            -1.0});
+            rows.push_back({"  background sort: click to landed", toMs(median(landed)), -1.0});
+            std::printf("  [shape] background sort: %d threads (idealThreadCount)\n",
+                        std::max(1, QThread::idealThreadCount()));
+            items_model->SetBackgroundSortRows(ItemsModel::kBackgroundSortRows);
+        }
+
         // A′ gates (S5 remedy): the shown, laid-out spot check — the
         // unshown rows above never materialize the view's flat row list,
         // so they cannot adjudicate per-batch view overhead — and the
@@ -916,6 +1173,57 @@ int main(int argc, char *argv[])
         cleanSnapshotRow("S6 clean final snapshot, By-Item (median of 5)");
     }
 
+    // --- Cold-start rows (informational): ParseCachedItems over a user
+    // store seeded from this same dataset — the serial load (a one-thread
+    // parse pool, the pre-pipeline shape) against the reader + parse pool
+    // at its default size. Seeding is untimed; each run builds the whole
+    // ParseResult, so the items are dropped before the next run.
+    {
+        const QString account = "m3-coldstart";
+        const QString realm = "pc";
+        const QString league = "M3 Cold Start";
+        const QString data_dir = fixture.tempDir.filePath("coldstart-data");
+        {
+            UserStore store(QDir(data_dir), account);
+            std::vector<poe::StashTab> list;
+            list.reserve(static_cast<size_t>(dataset.tabCount()));
+            for (int t = 0; t < dataset.tabCount(); ++t) {
+                list.push_back(dataset.stashSpec(t));
+            }
+            store.stashes().saveStashList(list, realm, league);
+            for (int t = 0; t < dataset.tabCount(); ++t) {
+                saveStashFixture(store.stashes(), dataset.MakeStashReply(t), realm, league);
+            }
+        }
+        QSettings settings(fixture.tempDir.filePath("coldstart.ini"), QSettings::IniFormat);
+        settings.setValue("account", account);
+        settings.setValue("realm", realm);
+        settings.setValue("league", league);
+        settings.sync();
+        ItemsManagerWorker worker(settings, *fixture.buyoutFixture.manager, *fixture.api);
+
+        const auto coldStart = [&](int threads) {
+            if (threads > 0) {
+                qputenv("ACQ_PARSE_THREADS", QByteArray::number(threads));
+            } else {
+                qunsetenv("ACQ_PARSE_THREADS");
+            }
+            t0 = clock.nsecsElapsed();
+            const ParseResult result = worker.ParseCachedItems(data_dir);
+            const qint64 elapsed = clock.nsecsElapsed() - t0;
+            std::printf("  [shape] cold start (%s): %zu items from %zu tabs\n",
+                        threads > 0 ? "serial" : "pool",
+                        result.items.size(),
+                        result.tabs.size());
+            return elapsed;
+        };
+        rows.push_back({"cold-start parse, serial (1 parse thread)", toMs(coldStart(1)), -1.0});
+        rows.push_back({"cold-start parse, reader + parse pool", toMs(coldStart(0)), -1.0});
+        std::printf("  [shape] cold-start parse pool: %d threads (idealThreadCount - 1)\n",
+                    std::max(1, QThread::idealThreadCount() - 1));
+        qunsetenv("ACQ_PARSE_THREADS");
+    }
+
     std::printf("\n=== M3 hold-point result (S3-S7 rows): preset %s, %d tabs, %zu items, Qt %s ===\n",
                 qPrintable(preset_name),
                 dataset.tabCount(),
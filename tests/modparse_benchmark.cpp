@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+// Mod-parse micro-benchmark: mods parsed per second through AddModToTable,
+// the per-line cost every Item construction pays on cold start and on
+// every tab reply. Not a test: run by hand in a Release build:
+//
+//   ./modparse_benchmark --preset 100k
+//   ./modparse_benchmark --preset 1m --reps 3
+//
+// The corpus is the SpikeDataset preset with its mod rolls switched on,
+// against the dataset's own stat translations (one template left
+// undefined, so the corpus has misses). Three rows, all informational:
+//
+// - the precompiled matcher, AddModToTable itself, one table per item;
+// - the two-step reference it replaced on identical lines: normalize the
+//   line into a QString plus a value vector, then a dictionary lookup and a
+//   pseudo-target lookup by that string;
+// - whole-Item construction over the same items, for the mod share of it.
+//
+// Before timing, every item's table from the matcher is checked entry for
+// entry against the reference; a mismatch exits non-zero.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "item.h"
+#include "itemcategories.h"
+#include "modlist.h"
+#include "pseudomods.h"
+#include "spikedataset.h"
+
+namespace {
+
+    qint64 median(std::vector<qint64> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    // The pre-matcher path: allocate the normalized line, then resolve it
+    // twice by string.
+    class ReferenceParser
+    {
+    public:
+        ReferenceParser()
+        {
+            // Pseudo mods the translations do not name are written only by
+            // sums; the model lists exactly the named ones.
+            m_natural.resize(modifier_count());
+            for (const QString &name : mod_list_model().stringList()) {
+                m_natural[modifier_id(name)] = 1;
+            }
+            for (const auto &[real_mod, pseudo_mods] : PseudoModManager::SUMMING_MODS_LOOKUP) {
+                auto &targets = m_pseudo_targets[real_mod];
+                for (const auto &pseudo_mod : pseudo_mods) {
+                    targets.push_back(modifier_id(pseudo_mod));
+                }
+            }
+        }
+
+        void Add(const QString &line, ModTable &output) const
+        {
+            const NormalizedModifier mod = normalize_modifier(line);
+            std::int32_t value = ModTable::kNoValue;
+            if (!mod.values_x100.empty()) {
+                double sum = 0.0;
+                for (const std::int32_t v : mod.values_x100) {
+                    sum += v;
+                }
+                value = ModTable::FromDouble(sum / static_cast<double>(mod.values_x100.size())
+                                             / 100.0);
+            }
+            const ModifierId id = modifier_id(mod.normalized);
+            if ((id != kNoModifier) && m_natural[id]) {
+                output.Set(id, value);
+            }
+            const auto it = m_pseudo_targets.find(mod.normalized);
+            if (it != m_pseudo_targets.end()) {
+                for (const ModifierId pseudo_mod : it->second) {
+                    output.Add(pseudo_mod, value);
+                }
+            }
+        }
+
+    private:
+        std::vector<char> m_natural;
+        std::unordered_map<QString, std::vector<ModifierId>> m_pseudo_targets;
+    };
+
+    bool sameTable(const ModTable &a, const ModTable &b)
+    {
+        return std::equal(a.begin(),
+                          a.end(),
+                          b.begin(),
+                          b.end(),
+                          [](const ModTable::Entry &x, const ModTable::Entry &y) {
+                              return (x.id == y.id) && (x.value_x100 == y.value_x100);
+                          });
+    }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    const QCommandLineOption preset_option("preset",
+                                           "Dataset preset: smoke, 100k, or 1m.",
+                                           "preset",
+                                           "100k");
+    const QCommandLineOption reps_option("reps", "Timed repetitions per row.", "reps", "5");
+    parser.addOption(preset_option);
+    parser.addOption(reps_option);
+    parser.process(app);
+
+    const QString preset_name = parser.value(preset_option);
+    auto preset = SpikeDataset::Config::Preset(preset_name);
+    if (!preset) {
+        std::fprintf(stderr, "unknown preset: %s\n", qPrintable(preset_name));
+        return 1;
+    }
+    preset->with_mods = true;
+    const int reps = std::max(1, parser.value(reps_option).toInt());
+
+    auto main_logger = std::make_shared<spdlog::logger>("main");
+    main_logger->sinks().push_back(std::make_shared<spdlog::sinks::dist_sink_mt>());
+    spdlog::register_logger(main_logger);
+    spdlog::set_level(spdlog::level::warn);
+
+    InitItemClasses(R"json({"TestClass":{"name":"Weapons"}})json");
+    InitItemBaseTypes(
+        R"json({"Metadata/Items/TestSword":{"item_class":"TestClass","name":"Test Sword","release_state":"released"}})json");
+    InitStatTranslations();
+    AddStatTranslations(SpikeDataset::StatTranslationsJson());
+    InitModList();
+
+    std::printf("mod-parse benchmark: building dataset preset %s...\n", qPrintable(preset_name));
+    const SpikeDataset dataset(*preset);
+    std::vector<poe::Item> items;
+    std::vector<ItemLocation> item_locations;
+    std::vector<std::vector<QString>> lines;
+    items.reserve(static_cast<size_t>(dataset.totalItems()));
+    lines.reserve(static_cast<size_t>(dataset.totalItems()));
+    size_t line_count = 0;
+    for (int t = 0; t < dataset.tabCount(); ++t) {
+        const ItemLocation location = dataset.location(t);
+        poe::StashTab reply = dataset.MakeStashReply(t);
+        for (auto &item : *reply.items) {
+            std::vector<QString> item_lines;
+            for (const auto *mods : {&item.implicitMods, &item.explicitMods}) {
+                if (*mods) {
+                    for (const auto &mod : **mods) {
+                        item_lines.push_back(mod.description);
+                    }
+                }
+            }
+            line_count += item_lines.size();
+            lines.push_back(std::move(item_lines));
+            items.push_back(std::move(item));
+            item_locations.push_back(location);
+        }
+    }
+    std::printf("  %zu items, %zu mod lines, %zu modifiers in the dictionary\n\n",
+                items.size(),
+                line_count,
+                modifier_count());
+
+    const ReferenceParser reference;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        ModTable matched;
+        ModTable expected;
+        for (const QString &line : lines[i]) {
+            AddModToTable(line, matched);
+            reference.Add(line, expected);
+        }
+        if (!sameTable(matched, expected)) {
+            std::fprintf(stderr, "item %zu: matcher and reference tables differ\n", i);
+            return 1;
+        }
+    }
+
+    const auto time_lines = [&](auto &&parse) {
+        std::vector<qint64> samples;
+        for (int rep = 0; rep < reps; ++rep) {
+            QElapsedTimer timer;
+            timer.start();
+            for (const auto &item_lines : lines) {
+                ModTable table;
+                for (const QString &line : item_lines) {
+                    parse(line, table);
+                }
+            }
+            samples.push_back(timer.nsecsElapsed());
+        }
+        return median(samples);
+    };
+    const qint64 matcher_ns = time_lines(
+        [](const QString &line, ModTable &table) { AddModToTable(line, table); });
+    const qint64 reference_ns = time_lines(
+        [&reference](const QString &line, ModTable &table) { reference.Add(line, table); });
+
+    std::vector<qint64> construct_samples;
+    for (int rep = 0; rep < reps; ++rep) {
+        QElapsedTimer timer;
+        timer.start();
+        for (size_t i = 0; i < items.size(); ++i) {
+            const auto item = std::make_shared<Item>(items[i], item_locations[i]);
+            Q_UNUSED(item);
+        }
+        construct_samples.push_back(timer.nsecsElapsed());
+    }
+    const qint64 construct_ns = median(construct_samples);
+
+    const auto rate = [line_count](qint64 ns) {
+        return (ns > 0) ? static_cast<double>(line_count) * 1e9 / static_cast<double>(ns) : 0.0;
+    };
+    std::printf("%-38s %12s %14s\n", "row (median of reps)", "ms", "mods/sec");
+    std::printf("%-38s %12.3f %14.0f\n",
+                "AddModToTable (matcher)",
+                matcher_ns / 1e6,
+                rate(matcher_ns));
+    std::printf("%-38s %12.3f %14.0f\n",
+                "normalize + lookup (reference)",
+                reference_ns / 1e6,
+                rate(reference_ns));
+    std::printf("%-38s %12.3f %14.0f\n",
+                "Item construction (whole item)",
+                construct_ns / 1e6,
+                rate(construct_ns));
+    std::printf("\n[attribution] matcher share of Item construction: %.1f%%\n",
+                (construct_ns > 0) ? 100.0 * static_cast<double>(matcher_ns)
+                                         / static_cast<double>(construct_ns)
+                                   : 0.0);
+    return 0;
+}
@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+// Parse-memory benchmark: what repeated refreshes cost the heap. Not a
+// test: run by hand in a Release build:
+//
+//   ./parsememory_benchmark --preset 100k
+//   ./parsememory_benchmark --preset 1m --cycles 8
+//   ./parsememory_benchmark --preset 1m --cycles 8 --no-release
+//
+// The payloads are the SpikeDataset preset's content replies (mod rolls
+// on). Each cycle stands in for one auto-refresh, threaded as the worker
+// threads it: every payload is parsed into its transient poe:: graph on
+// the main thread, turned into Items on a pool the size of the worker's
+// parse pool, and the graph dropped; the new collection then replaces the
+// previous one, and heap::releaseFreedMemory() runs as the worker runs it
+// once an update is over. --no-release skips that call, which is the
+// baseline the release is measured against. Rows, all informational:
+//
+// - the parse time per cycle (median over the cycles);
+// - the lifetime peak RSS (ru_maxrss);
+// - the resident size after each cycle (the highest, and the last);
+// - the resident size after a final heap::releaseFreedMemory() — in a
+//   --no-release run, the gap to the last cycle is the freed transient
+//   memory the allocator was still holding. Linux only; elsewhere the RSS
+//   rows read n/a.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThread>
+#include <QThreadPool>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "item.h"
+#include "itemcategories.h"
+#include "itemlocation.h"
+#include "modlist.h"
+#include "poe/types/item.h"
+#include "poe/types/stashtab.h"
+#include "spikedataset.h"
+#include "util/heap.h"
+#include "util/json_readers.h"
+#include "util/json_writers.h"
+
+namespace {
+
+    qint64 median(std::vector<qint64> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    // Resident bytes now, or -1 where /proc is not available.
+    double residentMiB()
+    {
+        QFile statm("/proc/self/statm");
+        if (!statm.open(QIODevice::ReadOnly)) {
+            return -1.0;
+        }
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() < 2) {
+            return -1.0;
+        }
+        return fields[1].toDouble() * static_cast<double>(sysconf(_SC_PAGESIZE)) / 1048576.0;
+    }
+
+    double peakMiB()
+    {
+        struct rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+        return static_cast<double>(usage.ru_maxrss) / 1048576.0;
+#else
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+    }
+
+    // ItemsManagerWorker::ParseItems, socketed items included.
+    void parseItems(const std::vector<poe::Item> &items, const ItemLocation &base, Items &out)
+    {
+        for (const auto &item : items) {
+            const ItemLocation location = base.getItemLocation(item);
+            out.push_back(std::make_shared<Item>(item, location));
+            if (item.socketedItems) {
+                parseItems(*item.socketedItems, location, out);
+            }
+        }
+    }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    const QCommandLineOption preset_option("preset",
+                                           "Dataset preset: smoke, 100k, or 1m.",
+                                           "preset",
+                                           "100k");
+    const QCommandLineOption cycles_option("cycles", "Refresh cycles to run.", "cycles", "5");
+    const QCommandLineOption no_release_option(
+        "no-release", "Do not release freed memory after each cycle (the baseline).");
+    parser.addOption(preset_option);
+    parser.addOption(cycles_option);
+    parser.addOption(no_release_option);
+    parser.process(app);
+
+    const QString preset_name = parser.value(preset_option);
+    auto preset = SpikeDataset::Config::Preset(preset_name);
+    if (!preset) {
+        std::fprintf(stderr, "unknown preset: %s\n", qPrintable(preset_name));
+        return 1;
+    }
+    preset->with_mods = true;
+    const int cycles = std::max(1, parser.value(cycles_option).toInt());
+    const bool release = !parser.isSet(no_release_option);
+
+    auto main_logger = std::make_shared<spdlog::logger>("main");
+    main_logger->sinks().push_back(std::make_shared<spdlog::sinks::dist_sink_mt>());
+    spdlog::register_logger(main_logger);
+    spdlog::set_level(spdlog::level::warn);
+
+    InitItemClasses(R"json({"TestClass":{"name":"Weapons"}})json");
+    InitItemBaseTypes(
+        R"json({"Metadata/Items/TestSword":{"item_class":"TestClass","name":"Test Sword","release_state":"released"}})json");
+    InitStatTranslations();
+    AddStatTranslations(SpikeDataset::StatTranslationsJson());
+    InitModList();
+
+    std::printf("parse-memory benchmark: building dataset preset %s...\n",
+                qPrintable(preset_name));
+    std::vector<QByteArray> payloads;
+    std::vector<ItemLocation> locations;
+    {
+        const SpikeDataset dataset(*preset);
+        payloads.reserve(static_cast<size_t>(dataset.tabCount()));
+        for (int t = 0; t < dataset.tabCount(); ++t) {
+            payloads.push_back(json::writeStash(dataset.MakeStashReply(t)));
+            locations.push_back(dataset.location(t));
+        }
+    }
+    heap::releaseFreedMemory();
+    const double baseline_mib = residentMiB();
+
+    // Sized like ItemsManagerWorker's parse pool.
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+
+    Items collection;
+    std::vector<qint64> samples;
+    double cycle_high_mib = -1.0;
+    double held_mib = -1.0;
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        QElapsedTimer timer;
+        timer.start();
+        std::vector<Items> built(payloads.size());
+        for (size_t t = 0; t < payloads.size(); ++t) {
+            auto parsed = json::readStash(payloads[t]);
+            if (!parsed || !parsed->items) {
+                std::fprintf(stderr, "payload %zu failed to parse\n", t);
+                return 1;
+            }
+            auto stash = std::make_shared<poe::StashTab>(std::move(*parsed));
+            pool.start([stash, &location = locations[t], &out = built[t]]() {
+                parseItems(*stash->items, location, out);
+            });
+        }
+        pool.waitForDone();
+        samples.push_back(timer.nsecsElapsed());
+
+        Items next;
+        next.reserve(collection.size());
+        for (auto &items : built) {
+            next.insert(next.end(),
+                        std::make_move_iterator(items.begin()),
+                        std::make_move_iterator(items.end()));
+        }
+        built = {};
+        collection = std::move(next);
+        if (release) {
+            heap::releaseFreedMemory();
+        }
+        held_mib = residentMiB();
+        cycle_high_mib = std::max(cycle_high_mib, held_mib);
+    }
+    heap::releaseFreedMemory();
+    const double released_mib = residentMiB();
+
+    const auto mib = [](double value) {
+        static char buffer[32];
+        if (value < 0.0) {
+            std::snprintf(buffer, sizeof(buffer), "%12s", "n/a");
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%12.1f", value);
+        }
+        return buffer;
+    };
+    std::printf("  %zu payloads, %zu items, %d cycles, %d parse threads, release %s\n\n",
+                payloads.size(),
+                collection.size(),
+                cycles,
+                pool.maxThreadCount(),
+                release ? "after each cycle" : "off");
+    std::printf("%-44s %12s\n", "row", "value");
+    std::printf("%-44s %12.3f\n", "parse per cycle, ms (median)", median(samples) / 1e6);
+    std::printf("%-44s %12.1f\n", "peak RSS, MiB", peakMiB());
+    std::printf("%-44s %s\n", "RSS before the first cycle, MiB", mib(baseline_mib));
+    std::printf("%-44s %s\n", "RSS after a cycle, MiB (highest)", mib(cycle_high_mib));
+    std::printf("%-44s %s\n", "RSS after the last cycle, MiB", mib(held_mib));
+    std::printf("%-44s %s\n", "RSS after a final releaseFreedMemory, MiB", mib(released_mib));
+    return 0;
+}
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QString>
 
 #include <algorithm>
@@ -24,6 +25,7 @@
 #include "item.h"
 #include "itemlocation.h"
 #include "poe/types/item.h"
+#include "poe/types/itemmod.h"
 #include "poe/types/stashtab.h"
 
 class SpikeDataset
@@ -37,6 +39,10 @@ public:
         // realistically quad-heavy; the default matches a typical mix.
         double quad_share = 0.1;
         uint32_t seed = 20260729;
+        // Rolls implicit and explicit mod lines from kModTemplates onto the
+        // items (the mod-parse benchmark's corpus). Off in the presets: the
+        // recorded shapes predate it and carry no mods.
+        bool with_mods = false;
 
         // The recorded shapes by name (M3 S0), so the M1-M3 scenarios and
         // the tests share one definition. "100k" is this struct's defaults
@@ -228,6 +234,26 @@ public:
         return reply;
     }
 
+    // The stat translations (RePoE's shape) defining every kModTemplates
+    // entry but the last, which stays unknown so the corpus has misses.
+    static QByteArray StatTranslationsJson()
+    {
+        QByteArray json = "[";
+        for (size_t t = 0; t + 1 < kModTemplates.size(); ++t) {
+            QString string = kModTemplates[t];
+            QByteArray format;
+            for (int arg = 0; string.contains(QChar('#')); ++arg) {
+                string.replace(string.indexOf(QChar('#')), 1, QString("{%1}").arg(arg));
+                format += (arg == 0) ? "\"#\"" : ",\"#\"";
+            }
+            json += (t == 0) ? "" : ",";
+            json += "{\"English\":[{\"format\":[" + format + "],\"string\":\"" + string.toUtf8()
+                    + "\"}]}";
+        }
+        json += "]";
+        return json;
+    }
+
 private:
     ItemSpec MakeSpec(bool quad)
     {
@@ -281,9 +307,57 @@ private:
             quality.values.emplace_back(QString("+%1%").arg(spec.quality), 1);
             item.properties = std::vector<poe::ItemProperty>{quality};
         }
+        if (m_config.with_mods) {
+            RollMods(spec, item);
+        }
         return item;
     }
 
+    // Mods are a pure function of the serial (Materialize is const and a
+    // modified item must keep its mods): one implicit at most, and as many
+    // explicits as the rarity allows.
+    static void RollMods(const ItemSpec &spec, poe::Item &item)
+    {
+        uint64_t state = spec.serial * 0x9e3779b97f4a7c15ULL;
+        const auto next = [&state]() {
+            state += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        };
+        const auto roll = [&next]() {
+            QString line = kModTemplates[next() % kModTemplates.size()];
+            while (line.contains(QChar('#'))) {
+                const uint64_t r = next();
+                const QString number = (r % 4 == 0)
+                                           ? QString::number(static_cast<double>(r % 200) / 10.0,
+                                                             'f',
+                                                             1)
+                                           : QString::number(1 + (r % 120));
+                line.replace(line.indexOf(QChar('#')), 1, number);
+            }
+            poe::ItemMod mod;
+            mod.description = line;
+            return mod;
+        };
+
+        static constexpr std::array<int, 4> kExplicits = {0, 2, 6, 8};
+        if (next() % 3 == 0) {
+            item.implicitMods = std::vector<poe::ItemMod>{roll()};
+        }
+        const int explicits = static_cast<int>(
+            next() % static_cast<uint64_t>(kExplicits[static_cast<size_t>(spec.frame_type)] + 1));
+        if (explicits > 0) {
+            std::vector<poe::ItemMod> mods;
+            mods.reserve(static_cast<size_t>(explicits));
+            for (int n = 0; n < explicits; ++n) {
+                mods.push_back(roll());
+            }
+            item.explicitMods = std::move(mods);
+        }
+    }
+
     static constexpr std::array<const char *, 16> kPrefixes = {"Blazing",
                                                                "Frozen",
                                                                "Storm",
@@ -341,6 +415,33 @@ private:
                                                                "Dump",
                                                                "Trade"};
 
+    // Common affixes, several of them summing pseudo-mod sources.
+    static constexpr std::array<const char *, 24> kModTemplates
+        = {"+# to maximum Life",
+           "#% increased maximum Life",
+           "+# to maximum Energy Shield",
+           "+# to maximum Mana",
+           "+#% to Fire Resistance",
+           "+#% to Cold Resistance",
+           "+#% to Lightning Resistance",
+           "+#% to Chaos Resistance",
+           "+#% to Fire and Cold Resistances",
+           "+#% to Cold and Lightning Resistances",
+           "+#% to all Elemental Resistances",
+           "+# to Strength",
+           "+# to Dexterity",
+           "+# to Intelligence",
+           "+# to all Attributes",
+           "#% increased Attack Speed",
+           "#% increased Movement Speed",
+           "#% increased Rarity of Items found",
+           "Adds # to # Physical Damage to Attacks",
+           "Adds # to # Fire Damage to Attacks",
+           "#% of Physical Attack Damage Leeched as Life",
+           "+# to Accuracy Rating",
+           "#% increased Global Critical Strike Chance",
+           "#% chance to do something no translation names"};
+
     Config m_config;
     std::mt19937 m_rng;
     uint64_t m_next_serial = 1;
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+// Stash-cache benchmark: the binary item records (stashes.items_data)
+// against the JSON-only cache they sit beside. Not a test: run by hand in
+// a Release build:
+//
+//   ./stashcache_benchmark --preset 100k
+//   ./stashcache_benchmark --preset 1m --reps 3
+//
+// One UserStore is written from the SpikeDataset preset (mod rolls on),
+// each tab saved the way a fetch saves it. A copy with items_data and
+// items_version NULLed stands in for the pre-binary cache; both files are
+// VACUUMed before they are measured. Two rows per file, all informational:
+//
+// - the file size on disk;
+// - the cold-start load: the reader stage's per-tab query plus the decode
+//   of every tab into poe::Item vectors, single-threaded so the rows
+//   compare decode cost rather than pool scheduling. Item construction is
+//   identical either way and left out.
+//
+// Before timing, every tab's binary decode is checked against its JSON
+// parse item for item; a mismatch exits non-zero.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QUuid>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "datastore/stashrepo.h"
+#include "datastore/userstore.h"
+#include "poe/types/item.h"
+#include "poe/types/stashtab.h"
+#include "spikedataset.h"
+#include "util/binary_items.h"
+#include "util/json_readers.h"
+#include "util/json_writers.h"
+#include "util/util.h"
+
+namespace {
+
+    constexpr const char *kRealm = "pc";
+    constexpr const char *kLeague = "Standard";
+    constexpr const char *kAccount = "benchmark";
+
+    qint64 median(std::vector<qint64> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    QString dbPath(const QDir &dir)
+    {
+        return dir.absoluteFilePath(QString("userstore-%1.db").arg(kAccount));
+    }
+
+    bool exec(const QString &path, const QStringList &statements)
+    {
+        bool ok = true;
+        const QString connection = "bench-" + QUuid::createUuid().toString(QUuid::WithoutBraces);
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connection);
+            db.setDatabaseName(path);
+            ok = db.open();
+            QSqlQuery q(db);
+            for (const auto &sql : statements) {
+                if (ok && !q.exec(sql)) {
+                    std::fprintf(stderr, "%s failed\n", qPrintable(sql));
+                    ok = false;
+                }
+            }
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(connection);
+        return ok;
+    }
+
+    qint64 fileSize(const QString &path)
+    {
+        return QFileInfo(path).size() + QFileInfo(path + "-wal").size();
+    }
+
+    // The reader stage and the decode, as ParseCachedItems runs them.
+    size_t loadAll(const QDir &dir, const std::vector<poe::StashTab> &tabs)
+    {
+        UserStore store(dir, kAccount);
+        size_t items = 0;
+        for (const auto &tab : tabs) {
+            const auto cached = store.stashes().getCachedStash(tab.id, kRealm, kLeague);
+            if (!cached) {
+                continue;
+            }
+            if (cached->binary) {
+                const auto decoded = binary::readItems(cached->data);
+                items += decoded ? decoded->size() : 0;
+            } else {
+                const auto stash = json::readStash(cached->data);
+                items += (stash && stash->items) ? stash->items->size() : 0;
+            }
+        }
+        return items;
+    }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    const QCommandLineOption preset_option("preset",
+                                           "Dataset preset: smoke, 100k, or 1m.",
+                                           "preset",
+                                           "100k");
+    const QCommandLineOption reps_option("reps", "Timed repetitions per row.", "reps", "5");
+    parser.addOption(preset_option);
+    parser.addOption(reps_option);
+    parser.process(app);
+
+    const QString preset_name = parser.value(preset_option);
+    auto preset = SpikeDataset::Config::Preset(preset_name);
+    if (!preset) {
+        std::fprintf(stderr, "unknown preset: %s\n", qPrintable(preset_name));
+        return 1;
+    }
+    preset->with_mods = true;
+    const int reps = std::max(1, parser.value(reps_option).toInt());
+
+    auto main_logger = std::make_shared<spdlog::logger>("main");
+    main_logger->sinks().push_back(std::make_shared<spdlog::sinks::dist_sink_mt>());
+    spdlog::register_logger(main_logger);
+    spdlog::set_level(spdlog::level::warn);
+
+    QTemporaryDir temp;
+    if (!temp.isValid()) {
+        std::fprintf(stderr, "could not create a temporary directory\n");
+        return 1;
+    }
+    const QDir binary_dir(temp.filePath("binary"));
+    const QDir json_dir(temp.filePath("json"));
+
+    std::printf("stash-cache benchmark: building dataset preset %s...\n", qPrintable(preset_name));
+    const SpikeDataset dataset(*preset);
+    std::vector<poe::StashTab> tabs;
+    tabs.reserve(static_cast<size_t>(dataset.tabCount()));
+    for (int t = 0; t < dataset.tabCount(); ++t) {
+        tabs.push_back(dataset.stashSpec(t));
+    }
+
+    size_t total_items = 0;
+    {
+        UserStore store(binary_dir, kAccount);
+        if (!store.stashes().saveStashList(tabs, kRealm, kLeague)) {
+            std::fprintf(stderr, "could not save the stash list\n");
+            return 1;
+        }
+        for (int t = 0; t < dataset.tabCount(); ++t) {
+            const poe::StashTab reply = dataset.MakeStashReply(t);
+            total_items += reply.items ? reply.items->size() : 0;
+            const QByteArray bytes = json::writeStash(reply);
+            if (!store.stashes().saveStash(reply,
+                                           bytes,
+                                           Util::ContentDigest(bytes),
+                                           kRealm,
+                                           kLeague)) {
+                std::fprintf(stderr, "could not save tab %d\n", t);
+                return 1;
+            }
+        }
+    }
+
+    QDir().mkpath(json_dir.absolutePath());
+    if (!QFile::copy(dbPath(binary_dir), dbPath(json_dir))
+        || !exec(dbPath(json_dir),
+                 {"UPDATE stashes SET items_data = NULL, items_version = NULL", "VACUUM"})
+        || !exec(dbPath(binary_dir), {"VACUUM"})) {
+        std::fprintf(stderr, "could not prepare the database files\n");
+        return 1;
+    }
+
+    {
+        UserStore store(binary_dir, kAccount);
+        for (const auto &tab : tabs) {
+            const auto json = store.stashes().getStashJson(tab.id, kRealm, kLeague);
+            const auto cached = store.stashes().getCachedStash(tab.id, kRealm, kLeague);
+            if (!json || !cached || !cached->binary) {
+                std::fprintf(stderr, "tab %s: missing cached rows\n", qPrintable(tab.id));
+                return 1;
+            }
+            const auto parsed = json::readStash(*json);
+            const auto decoded = binary::readItems(cached->data);
+            if (!parsed || !parsed->items || !decoded || (parsed->items->size() != decoded->size())) {
+                std::fprintf(stderr, "tab %s: decode and parse differ\n", qPrintable(tab.id));
+                return 1;
+            }
+            for (size_t i = 0; i < decoded->size(); ++i) {
+                const poe::Item &a = (*parsed->items)[i];
+                const poe::Item &b = (*decoded)[i];
+                if ((a.id != b.id) || (a.typeLine != b.typeLine) || (a.name != b.name)
+                    || (a.explicitMods.has_value() != b.explicitMods.has_value())
+                    || (a.explicitMods && (a.explicitMods->size() != b.explicitMods->size()))) {
+                    std::fprintf(stderr, "tab %s item %zu: decode and parse differ\n",
+                                 qPrintable(tab.id),
+                                 i);
+                    return 1;
+                }
+            }
+        }
+    }
+    std::printf("  %zu tabs, %zu items\n\n", tabs.size(), total_items);
+
+    const auto time_load = [&](const QDir &dir) {
+        std::vector<qint64> samples;
+        for (int rep = 0; rep < reps; ++rep) {
+            QElapsedTimer timer;
+            timer.start();
+            const size_t loaded = loadAll(dir, tabs);
+            samples.push_back(timer.nsecsElapsed());
+            if (loaded != total_items) {
+                std::fprintf(stderr, "loaded %zu of %zu items\n", loaded, total_items);
+            }
+        }
+        return median(samples);
+    };
+    const qint64 json_ns = time_load(json_dir);
+    const qint64 binary_ns = time_load(binary_dir);
+    const qint64 json_bytes = fileSize(dbPath(json_dir));
+    const qint64 binary_bytes = fileSize(dbPath(binary_dir));
+
+    std::printf("%-38s %12s %14s\n", "row (median of reps)", "MiB", "load ms");
+    std::printf("%-38s %12.2f %14.3f\n",
+                "json_data only (previous format)",
+                json_bytes / 1048576.0,
+                json_ns / 1e6);
+    std::printf("%-38s %12.2f %14.3f\n",
+                "json_data + items_data",
+                binary_bytes / 1048576.0,
+                binary_ns / 1e6);
+    std::printf("\n[attribution] load time vs json: %.1f%%, file size vs json: %.1f%%\n",
+                (json_ns > 0) ? 100.0 * static_cast<double>(binary_ns) / static_cast<double>(json_ns)
+                              : 0.0,
+                (json_bytes > 0)
+                    ? 100.0 * static_cast<double>(binary_bytes) / static_cast<double>(json_bytes)
+                    : 0.0);
+    return 0;
+}
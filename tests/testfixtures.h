@@ -22,6 +22,7 @@
 #include "poe/types/stashtab.h"
 #include "util/glaze_qt.h" // IWYU pragma: keep
 #include "util/json_writers.h"
+#include "util/util.h"
 
 class BuyoutManagerFixture
 {
@@ -81,12 +82,14 @@ inline bool saveStashFixture(StashRepo &repo,
                              const QString &realm,
                              const QString &league)
 {
-    return repo.saveStash(stash, json::writeStash(stash), realm, league);
+    const QByteArray bytes = json::writeStash(stash);
+    return repo.saveStash(stash, bytes, Util::ContentDigest(bytes), realm, league);
 }
 
 inline bool saveCharacterFixture(CharacterRepo &repo, const poe::Character &character)
 {
-    return repo.saveCharacter(character, json::writeCharacter(character));
+    const QByteArray bytes = json::writeCharacter(character);
+    return repo.saveCharacter(character, bytes, Util::ContentDigest(bytes));
 }
 
 inline ItemLocation makeTestStashLocation(const QString &id = "stash00001",
@@ -26,6 +26,11 @@ private slots:
     void unbatchedMigrationEmitsOneBatch();
     void unbatchedTabCompressionEmitsOnceAfterErase();
     void unbatchedItemCompressionEmitsOnceAfterErase();
+
+    // BuyoutBatch carried down to the repo: one transaction per outermost
+    // batch, item writes queued and upserted many rows per statement.
+    void batchWritesCommitAtTheOuterBoundary();
+    void batchKeepsLastWriteAndHonorsRemovals();
 };
 
 void BuyoutManagerTest::stringToBuyout()
@@ -314,6 +319,69 @@ void BuyoutManagerTest::unbatchedItemCompressionEmitsOnceAfterErase()
     QVERIFY(observedPostEraseState);
 }
 
+static int itemBuyoutRows(QSqlDatabase &db)
+{
+    QSqlQuery q(db);
+    if (!q.exec("SELECT COUNT(*) FROM item_buyouts") || !q.next()) {
+        return -1;
+    }
+    return q.value(0).toInt();
+}
+
+// Until the outermost batch closes, its transaction stays open (a second
+// BEGIN fails) and only full multi-row statements have run; at the close
+// the queued remainder goes out and everything commits.
+void BuyoutManagerTest::batchWritesCommitAtTheOuterBoundary()
+{
+    BuyoutManagerFixture fixture;
+    std::vector<Item> items;
+    for (int n = 0; n < 250; ++n) {
+        const QByteArray id = QString("batched-item-%1").arg(n).toUtf8();
+        items.push_back(makeTestItem(id.constData()));
+    }
+
+    {
+        const BuyoutBatch outer(*fixture.manager);
+        {
+            const BuyoutBatch inner(*fixture.manager);
+            for (const auto &item : items) {
+                fixture.manager->Set(item, makeChaosBuyout(3.0));
+            }
+        }
+        QVERIFY(!fixture.db->transaction());
+        QCOMPARE(itemBuyoutRows(*fixture.db), 200);
+    }
+
+    QCOMPARE(itemBuyoutRows(*fixture.db), 250);
+    QVERIFY(fixture.db->transaction());
+    QVERIFY(fixture.db->rollback());
+    const auto saved = fixture.repo->getItemBuyouts();
+    QCOMPARE(saved.at("batched-item-249").value, 3.0);
+}
+
+// A queued write is replaced by a later one for the same item and dropped
+// by a removal; reads inside the batch see the queue.
+void BuyoutManagerTest::batchKeepsLastWriteAndHonorsRemovals()
+{
+    BuyoutManagerFixture fixture;
+    const Item kept = makeTestItem("batched-kept");
+    const Item removed = makeTestItem("batched-removed");
+
+    {
+        const BuyoutBatch batch(*fixture.manager);
+        fixture.manager->Set(kept, makeChaosBuyout(1.0));
+        fixture.manager->Set(kept, makeChaosBuyout(2.0));
+        fixture.manager->Set(removed, makeChaosBuyout(4.0));
+        fixture.manager->Set(removed, Buyout());
+        QVERIFY(fixture.repo->getItemBuyouts().contains(kept.id()));
+    }
+
+    const auto saved = fixture.repo->getItemBuyouts();
+    QCOMPARE(saved.size(), size_t(1));
+    QCOMPARE(saved.at(kept.id()).value, 2.0);
+    QVERIFY(fixture.manager->Get(removed).IsNull());
+}
+
 QTEST_GUILESS_MAIN(BuyoutManagerTest)
 
 #include "tst_buyoutmanager.moc"
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include <QTimeZone>
+#include <QtTest/QtTest>
+
+#include "fetchscheduler.h"
+#include "itemlocation.h"
+#include "poe/types/stashtab.h"
+
+// Pins for the fetch scheduler's ranking: what it knows nothing about goes
+// first, then sources by how often and how lately their replies changed,
+// with currency-like tabs ahead of plain tabs of the same history.
+
+namespace {
+
+    const QDateTime kNow = QDateTime(QDate(2026, 1, 1), QTime(12, 0), QTimeZone::utc());
+
+    ItemLocation makeLocation(const QString &id, const QString &type = "PremiumStash")
+    {
+        poe::StashTab tab;
+        tab.id = id;
+        tab.name = "Tab " + id;
+        tab.type = type;
+        return ItemLocation(tab);
+    }
+
+    FetchSourceKey keyOf(const ItemLocation &location)
+    {
+        return FetchSourceKey::ForLocation(location);
+    }
+
+} // namespace
+
+class FetchSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void unknownSourcesRankFirst();
+    void observeReportsChangedBytesOnly();
+    void frequentChangesOutrankRareOnes();
+    void recentChangesOutrankOldOnes();
+    void currencyTabsOutrankPlainTabsOfEqualHistory();
+};
+
+void FetchSchedulerTest::unknownSourcesRankFirst()
+{
+    FetchScheduler scheduler;
+    const ItemLocation known = makeLocation("known", "CurrencyStash");
+    scheduler.Observe(keyOf(known), "aaaa", kNow);
+
+    const ItemLocation unknown = makeLocation("unknown");
+    QVERIFY(scheduler.Find(keyOf(unknown)) == nullptr);
+    QVERIFY(scheduler.Score(unknown, kNow) > scheduler.Score(known, kNow));
+}
+
+void FetchSchedulerTest::observeReportsChangedBytesOnly()
+{
+    FetchScheduler scheduler;
+    const FetchSourceKey key = keyOf(makeLocation("tab"));
+
+    QVERIFY(scheduler.Observe(key, "aaaa", kNow));
+    QVERIFY(!scheduler.Observe(key, "aaaa", kNow.addSecs(60)));
+    QVERIFY(scheduler.Observe(key, "bbbb", kNow.addSecs(120)));
+
+    const auto *history = scheduler.Find(key);
+    QVERIFY(history);
+    QCOMPARE(history->fetches, 3u);
+    QCOMPARE(history->changes, 2u);
+    QCOMPARE(history->digest, QByteArray("bbbb"));
+    QCOMPARE(history->changed_at, kNow.addSecs(120));
+    QCOMPARE(history->fetched_at, kNow.addSecs(120));
+}
+
+void FetchSchedulerTest::frequentChangesOutrankRareOnes()
+{
+    // Both last changed at the same moment; one changes on every fetch.
+    const QDateTime changed = kNow.addDays(-10);
+    const ItemLocation busy = makeLocation("busy");
+    const ItemLocation idle = makeLocation("idle");
+
+    std::map<FetchSourceKey, FetchScheduler::History> history;
+    history[keyOf(busy)] = {"aaaa", changed, changed, 8, 8};
+    history[keyOf(idle)] = {"bbbb", changed, changed, 8, 1};
+    FetchScheduler scheduler;
+    scheduler.Reset(std::move(history));
+
+    QVERIFY(scheduler.Score(busy, kNow) > scheduler.Score(idle, kNow));
+}
+
+void FetchSchedulerTest::recentChangesOutrankOldOnes()
+{
+    const ItemLocation dump = makeLocation("dump");
+    const ItemLocation archive = makeLocation("archive");
+
+    std::map<FetchSourceKey, FetchScheduler::History> history;
+    history[keyOf(dump)] = {"aaaa", kNow.addSecs(-3600), kNow.addSecs(-3600), 1, 1};
+    history[keyOf(archive)] = {"bbbb", kNow.addDays(-30), kNow.addSecs(-3600), 1, 1};
+    FetchScheduler scheduler;
+    scheduler.Reset(std::move(history));
+
+    QVERIFY(scheduler.Score(dump, kNow) > scheduler.Score(archive, kNow));
+}
+
+void FetchSchedulerTest::currencyTabsOutrankPlainTabsOfEqualHistory()
+{
+    const QDateTime changed = kNow.addDays(-2);
+    const ItemLocation currency = makeLocation("currency", "CurrencyStash");
+    const ItemLocation plain = makeLocation("plain");
+
+    std::map<FetchSourceKey, FetchScheduler::History> history;
+    history[keyOf(currency)] = {"aaaa", changed, changed, 1, 0};
+    history[keyOf(plain)] = {"bbbb", changed, changed, 1, 0};
+    FetchScheduler scheduler;
+    scheduler.Reset(std::move(history));
+
+    QVERIFY(scheduler.Score(currency, kNow) > scheduler.Score(plain, kNow));
+}
+
+QTEST_GUILESS_MAIN(FetchSchedulerTest)
+
+#include "tst_fetchscheduler.moc"
@@ -1,12 +1,17 @@
 #include <QtTest/QtTest>
 
+#include <algorithm>
+#include <cmath>
 #include <optional>
 
+#include "filters/filterindex.h"
 #include "filters/filtermatchers.h"
 #include "filters/filterspec.h"
 #include "itemcategories.h"
 #include "modlist.h"
 #include "testfixtures.h"
+#include "util/stringpool.h"
+#include "util/util.h"
 
 class FiltersTest : public QObject
 {
@@ -18,11 +23,16 @@ private slots:
     void categoryFilter();
     void minMaxFilter();
     void defaultAndRequiredFilters();
+    void numericFieldsMatchStringParsing();
     void socketColorFilters();
     void booleanFilter();
     void booleanPredicates();
     void rarityFilter();
     void modsFilter();
+    void modifierDictionary();
+    void columnarIndexMatchesPerItemPath();
+    void columnarIndexFollowsSourceReplacement();
+    void textIndexMatchesSubstrings();
 };
 
 static std::shared_ptr<Item> makeFilterItem(
@@ -32,7 +42,8 @@ static std::shared_ptr<Item> makeFilterItem(
     const QString &frameTypeId = "Rare",
     const QString &icon = "https://web.poecdn.com/image/test.png",
     const QString &baseType = "Test Item",
-    bool identified = true)
+    bool identified = true,
+    const QString &name = "Alpha Bite")
 {
     const QByteArray json = QString(R"json({
         "baseType": "%6",
@@ -43,7 +54,7 @@ static std::shared_ptr<Item> makeFilterItem(
         "id": "%1",
         "identified": %7,
         "ilvl": 1,
-        "name": "Alpha Bite",
+        "name": "%8",
         "typeLine": "Test Item",
         "verified": false,
         "w": 1,
@@ -56,7 +67,8 @@ static std::shared_ptr<Item> makeFilterItem(
                                      frameTypeId,
                                      icon,
                                      baseType,
-                                     identified ? "true" : "false")
+                                     identified ? "true" : "false",
+                                     name)
                                 .toUtf8();
     return std::make_shared<Item>(makeTestItem(json.constData(), makeTestStashLocation()));
 }
@@ -113,6 +125,32 @@ static const FilterSpec *findColorsFilterSpec(const FilterCatalog &catalog,
     return nullptr;
 }
 
+static qsizetype findSpecIndex(const FilterCatalog &catalog, const QString &caption)
+{
+    for (qsizetype index = 0; index < catalog.size(); ++index) {
+        if (catalog[index].caption == caption) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+// The per-item answer FilterIndex::Scan must reproduce for its filters.
+static bool matchesIndexedFilters(const Item &item,
+                                  const FilterCatalog &catalog,
+                                  const FilterIndex &index,
+                                  const std::vector<FilterState> &states,
+                                  const std::vector<qsizetype> &active)
+{
+    for (const qsizetype filter : active) {
+        if (index.Indexes(filter)
+            && !MatchesFilter(item, catalog[filter], states[static_cast<size_t>(filter)])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static void verifyBooleanPredicate(const FilterSpec &spec,
                                    const std::shared_ptr<Item> &matching,
                                    const std::shared_ptr<Item> &notMatching)
@@ -267,6 +305,123 @@ void FiltersTest::defaultAndRequiredFilters()
     QVERIFY(MatchesFilter(*withoutRequirement, *required, requiredState));
 }
 
+void FiltersTest::numericFieldsMatchStringParsing()
+{
+    BuyoutManagerFixture buyoutFixture;
+    const FilterCatalog catalog = BuildFilterCatalog(*buyoutFixture.manager);
+    const auto weapon = makeFilterItem("weapon",
+                                       R"json(,
+        "properties": [
+            {"displayMode": 0, "name": "Physical Damage", "values": [["10-20", 1]]},
+            {"displayMode": 0, "name": "Elemental Damage", "values": [["5-10", 4], ["1-3", 6]]},
+            {"displayMode": 0, "name": "Chaos Damage", "values": [["2-4", 7]]},
+            {"displayMode": 0, "name": "Critical Strike Chance", "values": [["7.50%", 1]]},
+            {"displayMode": 0, "name": "Attacks per Second", "values": [["1.45", 1]]},
+            {"displayMode": 0, "name": "Armour", "values": [["312", 1]]},
+            {"displayMode": 0, "name": "Quality", "values": [["+20%", 1]]},
+            {"displayMode": 0, "name": "Level", "values": [["20 (Max)", 0]]}
+        ],
+        "requirements": [
+            {"displayMode": 0, "name": "Level", "values": [["62", 0]]},
+            {"displayMode": 0, "name": "Str", "values": [["113", 0]]}
+        ])json");
+    const auto rateless = makeFilterItem("rateless",
+                                         R"json(,
+        "properties": [
+            {"displayMode": 0, "name": "Physical Damage", "values": [["10-20", 1]]}
+        ])json");
+    const auto bare = makeFilterItem("bare", "");
+
+    // What the accessors computed from the strings on every call.
+    const auto property = [](const Item &item, const QString &name) -> std::optional<double> {
+        const auto found = item.properties().find(name);
+        return (found == item.properties().end()) ? std::nullopt
+                                                  : std::optional(found->second.toDouble());
+    };
+    const auto damage = [](const Item &item, const QString &name) {
+        const auto found = item.properties().find(name);
+        return (found == item.properties().end()) ? 0.0 : Util::AverageDamage(found->second);
+    };
+
+    for (const auto &item : {weapon, rateless, bare}) {
+        const double aps = property(*item, "Attacks per Second").value_or(0.0);
+        const bool attacks = property(*item, "Attacks per Second").has_value();
+        double elemental = 0.0;
+        for (const auto &[hit, type] : item->elemental_damage()) {
+            elemental += Util::AverageDamage(hit);
+        }
+        const double pdps = attacks ? aps * damage(*item, "Physical Damage") : 0.0;
+        const double edps = attacks ? aps * elemental : 0.0;
+        const double cdps = attacks ? aps * damage(*item, "Chaos Damage") : 0.0;
+        QCOMPARE(item->pDPS(), pdps);
+        QCOMPARE(item->eDPS(), edps);
+        QCOMPARE(item->cDPS(), cdps);
+        QCOMPARE(item->DPS(), pdps + edps + cdps);
+
+        for (const auto &[caption, name] :
+             std::initializer_list<std::pair<const char *, const char *>>{
+                 {"Crit.", "Critical Strike Chance"},
+                 {"APS", "Attacks per Second"},
+                 {"Armour", "Armour"},
+                 {"Evasion", "Evasion Rating"},
+                 {"Shield", "Energy Shield"},
+                 {"Block", "Chance to Block"},
+                 {"Level", "Level"},
+                 {"Map Tier", "Map Tier"}}) {
+            const auto *spec = findMinMaxFilterSpec(catalog, caption);
+            QVERIFY(spec);
+            const auto &payload = std::get<MinMaxPayload>(spec->payload);
+            const auto expected = property(*item, name);
+            QCOMPARE(payload.present(*item), expected.has_value());
+            if (expected) {
+                QCOMPARE(payload.value(*item), *expected);
+            }
+        }
+        const auto *quality = findMinMaxFilterSpec(catalog, "Quality");
+        QVERIFY(quality);
+        QCOMPARE(std::get<MinMaxPayload>(quality->payload).value(*item),
+                 property(*item, "Quality").value_or(0.0));
+
+        for (const auto &[caption, name] :
+             std::initializer_list<std::pair<const char *, const char *>>{
+                 {"R. Level", "Level"}, {"R. Str", "Str"}, {"R. Dex", "Dex"}, {"R. Int", "Int"}}) {
+            const auto *spec = findMinMaxFilterSpec(catalog, caption);
+            QVERIFY(spec);
+            const auto found = item->requirements().find(name);
+            const double expected = (found == item->requirements().end()) ? 0.0 : found->second;
+            QCOMPARE(std::get<MinMaxPayload>(spec->payload).value(*item), expected);
+        }
+    }
+
+    // Pinned values, so the comparison above is not vacuous.
+    QCOMPARE(weapon->pDPS(), 1.45 * 15.0);
+    QCOMPARE(weapon->eDPS(), 1.45 * (7.5 + 2.0));
+    QCOMPARE(weapon->numbers().value(ItemNumbers::Level), 20.0);
+    QCOMPARE(weapon->numbers().value(ItemNumbers::Quality), 20.0);
+    QCOMPARE(weapon->numbers().requirement(ItemNumbers::RequiredStr), 113);
+    // toDouble() rejects the percent sign; the summary keeps that.
+    QVERIFY(weapon->numbers().has(ItemNumbers::CriticalStrikeChance));
+    QCOMPARE(weapon->numbers().value(ItemNumbers::CriticalStrikeChance), 0.0);
+    QCOMPARE(rateless->DPS(), 0.0);
+    QVERIFY(!bare->numbers().has(ItemNumbers::Armour));
+
+    // The property vocabulary is pooled: equal names share one buffer.
+    QCOMPARE(weapon->text_properties().front().name, "Physical Damage");
+    QCOMPARE(rateless->text_properties().front().name.constData(),
+             weapon->text_properties().front().name.constData());
+    // Values are per item and stay out of the process-lifetime pool.
+    const size_t pooled = StringPool::size();
+    makeFilterItem("unpooled-value",
+                   R"json(,
+        "properties": [
+            {"displayMode": 0, "name": "Physical Damage", "values": [["11-23", 1]]}
+        ],
+        "requirements": [
+            {"displayMode": 0, "name": "Level", "values": [["67", 0]]}
+        ])json");
+    QCOMPARE(StringPool::size(), pooled);
+}
+
 void FiltersTest::socketColorFilters()
 {
     BuyoutManagerFixture buyoutFixture;
@@ -504,6 +659,243 @@ void FiltersTest::modsFilter()
     QVERIFY(!MatchesFilter(*item, *mods, state));
 }
 
+void FiltersTest::modifierDictionary()
+{
+    // Numbers are whole [0-9.]+ runs read like strtod, in hundredths.
+    const auto adds = normalize_modifier(u"Adds 1.5 to 2.255 Fire Damage");
+    QCOMPARE(adds.normalized, "Adds # to # Fire Damage");
+    QCOMPARE(adds.values_x100, (std::vector<std::int32_t>{150, 226}));
+    const auto odd = normalize_modifier(u"1.2.3 and .5");
+    QCOMPARE(odd.normalized, "# and #");
+    QCOMPARE(odd.values_x100, (std::vector<std::int32_t>{120, 50}));
+
+    InitStatTranslations();
+    AddStatTranslations(R"json([
+        {"English":[{"format":["+#"],"string":"{0}% to Fire Resistance"}]},
+        {"English":[{"format":["+#"],"string":"{0}% to Fire and Cold Resistances"}]}
+    ])json");
+    InitModList();
+
+    const ModifierId fire = modifier_id("+#% to Fire Resistance");
+    const ModifierId totalFire = modifier_id("+#% total to Fire Resistance");
+    const ModifierId totalCold = modifier_id("+#% total to Cold Resistance");
+    QVERIFY(fire != kNoModifier);
+    QVERIFY(totalFire != kNoModifier);
+    QCOMPARE(modifier_name(fire), "+#% to Fire Resistance");
+    QCOMPARE(modifier_id("+#% to unknown"), kNoModifier);
+    QCOMPARE(intern_modifier(u"+12% to Fire Resistance").id, fire);
+
+    // Natural mods keep their own value; pseudo mods sum their sources.
+    ModTable table;
+    AddModToTable("+12% to Fire Resistance", table);
+    AddModToTable("+10% to Fire and Cold Resistances", table);
+    QCOMPARE(table.value(fire), std::optional<double>(12.0));
+    QCOMPARE(table.value(totalFire), std::optional<double>(22.0));
+    QCOMPARE(table.value(totalCold), std::optional<double>(10.0));
+    QVERIFY(!table.contains(kNoModifier));
+    QVERIFY(std::is_sorted(table.begin(), table.end(), [](const auto &a, const auto &b) {
+        return a.id < b.id;
+    }));
+
+    // The matcher reads lines exactly as normalize-then-lookup would: a
+    // line that only starts or ends like a template misses, and a literal
+    // '#' matches the template's number without giving it a value.
+    ModTable misses;
+    AddModToTable("+12% to Fire Resistance and more", misses);
+    AddModToTable("+12% to Fire", misses);
+    AddModToTable("to Fire Resistance", misses);
+    QVERIFY(misses.empty());
+    ModTable literal;
+    AddModToTable("+#% to Fire Resistance", literal);
+    QVERIFY(literal.contains(fire));
+    QVERIFY(std::isnan(*literal.value(fire)));
+
+    // A resolved row is the same state as an unresolved one.
+    ModRow resolved{"+#% to Fire Resistance", 1.0, std::nullopt};
+    resolved.id = fire;
+    QCOMPARE(resolved, (ModRow{"+#% to Fire Resistance", 1.0, std::nullopt}));
+}
+
+void FiltersTest::columnarIndexMatchesPerItemPath()
+{
+    BuyoutManagerFixture buyoutFixture;
+    const FilterCatalog catalog = BuildFilterCatalog(*buyoutFixture.manager);
+    const auto critProperty = [](const char *value) {
+        return QString(R"json(,
+        "properties": [
+            {"displayMode": 0, "name": "Critical Strike Chance", "type": 6,
+             "values": [["%1", 1]]}
+        ])json")
+            .arg(value);
+    };
+    // 7.3 is not a float: a threshold of exactly 7.3 must tie after rounding
+    // and still be decided exactly.
+    const QString corruptedJson = R"json(, "corrupted": true)json";
+    const Items items{makeFilterItem("crit-low", critProperty("5")),
+                      makeFilterItem("crit-exact", critProperty("7.3"), 3, "Unique"),
+                      makeFilterItem("crit-high", critProperty("20") + corruptedJson),
+                      makeFilterItem("no-crit", corruptedJson, 0, "Normal")};
+
+    FilterIndex index(catalog);
+    index.ResetTo(items);
+    QCOMPARE(index.size(), items.size());
+
+    const qsizetype crit = findSpecIndex(catalog, "Crit.");
+    const qsizetype corrupted = findSpecIndex(catalog, "Corrupted");
+    const qsizetype rarity = findSpecIndex(catalog, "Rarity");
+    const qsizetype priced = findSpecIndex(catalog, "Priced");
+    const qsizetype name = findSpecIndex(catalog, "Name");
+    const qsizetype tab = findSpecIndex(catalog, "Tab");
+    QVERIFY(index.Indexes(crit));
+    QVERIFY(index.Indexes(corrupted));
+    QVERIFY(index.Indexes(rarity));
+    QVERIFY(index.Indexes(name));
+    QVERIFY(!index.Indexes(priced)); // buyout state is not the item's
+    QVERIFY(!index.Indexes(tab));    // tabs are renamed in place
+
+    std::vector<FilterState> states;
+    for (const auto &spec : catalog) {
+        states.push_back(MakeDefaultState(spec));
+    }
+    const auto verify = [&](const std::vector<qsizetype> &active) {
+        const auto mask = index.Scan(items, states, active);
+        QVERIFY(mask.has_value());
+        for (size_t row = 0; row < items.size(); ++row) {
+            QCOMPARE(FilterIndex::Test(*mask, row),
+                     matchesIndexedFilters(*items[row], catalog, index, states, active));
+        }
+    };
+
+    states[static_cast<size_t>(crit)] = MinMaxState{7.3, std::nullopt};
+    verify({crit});
+    states[static_cast<size_t>(crit)] = MinMaxState{7.3000001, std::nullopt};
+    verify({crit});
+    states[static_cast<size_t>(crit)] = MinMaxState{std::nullopt, 7.3};
+    verify({crit});
+    states[static_cast<size_t>(crit)] = MinMaxState{5.0, 20.0};
+    verify({crit});
+
+    states[static_cast<size_t>(corrupted)] = BoolState{true};
+    verify({crit, corrupted});
+    verify({corrupted});
+
+    states[static_cast<size_t>(rarity)] = ComboState{"Any Non-Unique"};
+    verify({rarity});
+    verify({crit, corrupted, rarity});
+    states[static_cast<size_t>(rarity)] = ComboState{"Unique"};
+    verify({crit, rarity});
+
+    states[static_cast<size_t>(name)] = TextState{"BITE"};
+    verify({name});
+    verify({crit, name});
+    states[static_cast<size_t>(name)] = TextState{"missing"};
+    verify({name});
+
+    // A collection the index does not hold exactly is refused.
+    const Items other{items[0], items[1]};
+    QVERIFY(!index.Scan(other, states, {crit}).has_value());
+}
+
+void FiltersTest::columnarIndexFollowsSourceReplacement()
+{
+    BuyoutManagerFixture buyoutFixture;
+    const FilterCatalog catalog = BuildFilterCatalog(*buyoutFixture.manager);
+    const qsizetype corrupted = findSpecIndex(catalog, "Corrupted");
+    std::vector<FilterState> states;
+    for (const auto &spec : catalog) {
+        states.push_back(MakeDefaultState(spec));
+    }
+    states[static_cast<size_t>(corrupted)] = BoolState{true};
+
+    const auto plain = makeFilterItem("plain", "");
+    const auto broken = makeFilterItem("broken", R"json(, "corrupted": true)json");
+    FilterIndex index(catalog);
+    index.ResetTo({plain});
+    auto mask = index.Scan({plain}, states, {corrupted});
+    QVERIFY(mask.has_value());
+    QVERIFY(!FilterIndex::Test(*mask, 0));
+
+    // The delta replaces the whole source; the materialized column is
+    // patched for the arrivals and the recycled slot answers for them.
+    const auto key = FetchSourceKey::ForLocation(plain->location());
+    index.ReplaceSource(key, {broken, plain});
+    QVERIFY(!index.Scan({plain}, states, {corrupted}).has_value());
+    mask = index.Scan({plain, broken}, states, {corrupted});
+    QVERIFY(mask.has_value());
+    QVERIFY(!FilterIndex::Test(*mask, 0));
+    QVERIFY(FilterIndex::Test(*mask, 1));
+
+    index.EraseSourcesIf([&key](const FetchSourceKey &source, const ItemLocation &) {
+        return source == key;
+    });
+    QCOMPARE(index.size(), size_t{0});
+    QVERIFY(index.Scan({}, states, {corrupted}).has_value());
+}
+
+void FiltersTest::textIndexMatchesSubstrings()
+{
+    BuyoutManagerFixture buyoutFixture;
+    const FilterCatalog catalog = BuildFilterCatalog(*buyoutFixture.manager);
+    const qsizetype name = findSpecIndex(catalog, "Name");
+    std::vector<FilterState> states;
+    for (const auto &spec : catalog) {
+        states.push_back(MakeDefaultState(spec));
+    }
+    const auto named = [](const QString &id, const QString &itemName) {
+        return makeFilterItem(id,
+                              "",
+                              2,
+                              "Rare",
+                              "https://web.poecdn.com/image/test.png",
+                              "Test Item",
+                              true,
+                              itemName);
+    };
+
+    // "Abc Cab" holds every trigram of "abcab" without holding "abcab":
+    // the posting lists only narrow, the substring test decides.
+    Items items{named("split", "Abc Cab"),
+                named("whole", "Xabcabx"),
+                named("twin", "Abc Cab"),
+                named("accented", "Éclat Ward"),
+                named("short", "")};
+    FilterIndex index(catalog);
+    index.ResetTo(items);
+
+    const auto verify = [&](const Items &current, const QString &query) {
+        const TextState state{query};
+        states[static_cast<size_t>(name)] = state;
+        const auto mask = index.Scan(current, states, {name});
+        QVERIFY(mask.has_value());
+        for (size_t row = 0; row < current.size(); ++row) {
+            QCOMPARE(FilterIndex::Test(*mask, row),
+                     MatchesFilter(*current[row], catalog[name], state));
+        }
+    };
+    const QStringList queries{"a",
+                              "AB",
+                              "abc",
+                              "abcab",
+                              "c c",
+                              "ÉCLAT",
+                              "test item",
+                              "item test",
+                              "zzz",
+                              "abcabx"};
+    for (const QString &query : queries) {
+        verify(items, query);
+    }
+
+    // A delta brings a name no string so far held, and drops one; the
+    // posting lists are patched for the arrival.
+    const auto key = FetchSourceKey::ForLocation(items[0]->location());
+    items = {named("whole", "Xabcabx"), named("renamed", "Cabbage Patch")};
+    index.ReplaceSource(key, items);
+    for (const QString &query : queries + QStringList{"cabbage", "bbag"}) {
+        verify(items, query);
+    }
+}
+
 QTEST_GUILESS_MAIN(FiltersTest)
 
 #include "tst_filters.moc"
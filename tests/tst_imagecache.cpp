@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "fakenetworkmanager.h"
+#include "imagecache.h"
+#include "util/util.h"
+
+// Pins for the icon cache: the directory is indexed once, on-disk images
+// decode off the calling thread and land in a bounded in-memory LRU, and
+// downloads are coalesced per URL, bounded, and ordered with the image on
+// screen first.
+
+namespace {
+
+    constexpr const char *kUrl = "https://web.poecdn.com/image/a.png";
+    constexpr const char *kOtherUrl = "https://web.poecdn.com/image/b.png";
+    constexpr const char *kThirdUrl = "https://web.poecdn.com/image/c.png";
+
+    // 32x32 ARGB32: 4 KiB decoded.
+    QImage makeIcon(QRgb color)
+    {
+        QImage image(32, 32, QImage::Format_ARGB32);
+        image.fill(color);
+        return image;
+    }
+
+    QString pathFor(const QTemporaryDir &dir, const QString &url)
+    {
+        return dir.filePath(Util::Md5(url) + ".png");
+    }
+
+    void writeIcon(const QTemporaryDir &dir, const QString &url, QRgb color)
+    {
+        QVERIFY(makeIcon(color).save(pathFor(dir, url)));
+    }
+
+    QByteArray pngBytes(QRgb color)
+    {
+        QByteArray bytes;
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::WriteOnly);
+        makeIcon(color).save(&buffer, "PNG");
+        return bytes;
+    }
+
+    QString iconUrl(int n)
+    {
+        return QString("https://web.poecdn.com/image/%1.png").arg(n);
+    }
+
+} // namespace
+
+class ImageCacheTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void directoryIsIndexedOnce();
+    void onDiskFetchDecodesInTheBackground();
+    void prefetchDecodesOnDiskImagesAndQueuesTheRest();
+    void memoryIsBoundedLeastRecentlyUsedFirst();
+    void concurrentFetchesShareOneDownload();
+    void downloadsAreBoundedWithTheFetchedImageFirst();
+    void newPrefetchReplacesQueuedPrefetches();
+    void failedDownloadCanBeRetried();
+};
+
+void ImageCacheTest::directoryIsIndexedOnce()
+{
+    QTemporaryDir dir;
+    writeIcon(dir, kUrl, qRgb(255, 0, 0));
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path());
+
+    QVERIFY(cache.contains(kUrl));
+    QVERIFY(!cache.contains(kOtherUrl));
+
+    // Lookups answer from the index, not the disk.
+    writeIcon(dir, kOtherUrl, qRgb(0, 255, 0));
+    QVERIFY(!cache.contains(kOtherUrl));
+}
+
+void ImageCacheTest::onDiskFetchDecodesInTheBackground()
+{
+    QTemporaryDir dir;
+    writeIcon(dir, kUrl, qRgb(255, 0, 0));
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path());
+    QSignalSpy ready(&cache, &ImageCache::imageReady);
+
+    cache.fetch(kUrl);
+    QCOMPARE(ready.count(), 0);
+    QVERIFY(ready.wait());
+    QCOMPARE(ready.takeFirst().at(0).toString(), QString(kUrl));
+    QCOMPARE(network.count(), 0);
+
+    // Once in memory, the file is no longer needed and a fetch answers at
+    // once.
+    QVERIFY(QFile::remove(pathFor(dir, kUrl)));
+    cache.fetch(kUrl);
+    QCOMPARE(ready.count(), 1);
+    QCOMPARE(cache.load(kUrl).pixel(0, 0), qRgb(255, 0, 0));
+}
+
+void ImageCacheTest::prefetchDecodesOnDiskImagesAndQueuesTheRest()
+{
+    QTemporaryDir dir;
+    writeIcon(dir, kUrl, qRgb(255, 0, 0));
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path());
+    QSignalSpy ready(&cache, &ImageCache::imageReady);
+
+    cache.prefetch({kUrl, kOtherUrl});
+    QCOMPARE(network.count(), 1);
+    QCOMPARE(network.sent(0).request.url().toString(), QString(kOtherUrl));
+
+    // A fetch of an image already being decoded waits for that decode.
+    cache.fetch(kUrl);
+    QVERIFY(ready.wait());
+    QTest::qWait(50);
+    QCOMPARE(ready.count(), 1);
+    QCOMPARE(ready.at(0).at(0).toString(), QString(kUrl));
+    QVERIFY(!cache.load(kUrl).isNull());
+}
+
+void ImageCacheTest::memoryIsBoundedLeastRecentlyUsedFirst()
+{
+    QTemporaryDir dir;
+    writeIcon(dir, kUrl, qRgb(255, 0, 0));
+    writeIcon(dir, kOtherUrl, qRgb(0, 255, 0));
+    writeIcon(dir, kThirdUrl, qRgb(0, 0, 255));
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path(), 10 * 1024); // room for two icons
+    QSignalSpy ready(&cache, &ImageCache::imageReady);
+
+    for (const char *url : {kUrl, kOtherUrl, kThirdUrl}) {
+        cache.fetch(url);
+        QVERIFY(ready.wait());
+    }
+    for (const char *url : {kUrl, kOtherUrl, kThirdUrl}) {
+        QVERIFY(QFile::remove(pathFor(dir, url)));
+    }
+
+    // The first one in was evicted; the other two are still in memory.
+    QVERIFY(cache.load(kUrl).isNull());
+    QCOMPARE(cache.load(kOtherUrl).pixel(0, 0), qRgb(0, 255, 0));
+    QCOMPARE(cache.load(kThirdUrl).pixel(0, 0), qRgb(0, 0, 255));
+}
+
+void ImageCacheTest::concurrentFetchesShareOneDownload()
+{
+    QTemporaryDir dir;
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path());
+    QSignalSpy ready(&cache, &ImageCache::imageReady);
+
+    cache.fetch(kUrl);
+    cache.fetch(kUrl);
+    cache.prefetch({kUrl});
+    cache.fetch(kUrl);
+    QCOMPARE(network.count(), 1);
+
+    network.sent(0).reply->finish({}, 200, QNetworkReply::NoError, pngBytes(qRgb(0, 0, 255)));
+    QVERIFY(ready.wait());
+    QTest::qWait(50);
+    QCOMPARE(ready.count(), 1);
+    QVERIFY(cache.contains(kUrl));
+    QCOMPARE(cache.load(kUrl).pixel(0, 0), qRgb(0, 0, 255));
+
+    // Written by rename: the image is in place and no temporary is left.
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files),
+             QStringList{Util::Md5(kUrl) + ".png"});
+    QCOMPARE(QImage(pathFor(dir, kUrl)).pixel(0, 0), qRgb(0, 0, 255));
+}
+
+void ImageCacheTest::downloadsAreBoundedWithTheFetchedImageFirst()
+{
+    QTemporaryDir dir;
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path());
+
+    QStringList neighbours;
+    for (int n = 0; n < ImageCache::MAX_DOWNLOADS + 2; ++n) {
+        neighbours.push_back(iconUrl(n));
+    }
+    cache.prefetch(neighbours);
+    QCOMPARE(network.count(), ImageCache::MAX_DOWNLOADS);
+
+    // Two fetches while the slots are full: the newer one is the image on
+    // screen and goes first, ahead of both the older one and the queued
+    // prefetches. A queued prefetch that is then fetched moves up too.
+    cache.fetch(iconUrl(100));
+    cache.fetch(iconUrl(101));
+    cache.fetch(iconUrl(ImageCache::MAX_DOWNLOADS + 1));
+    QCOMPARE(network.count(), ImageCache::MAX_DOWNLOADS);
+
+    const QStringList expected{iconUrl(ImageCache::MAX_DOWNLOADS + 1),
+                               iconUrl(101),
+                               iconUrl(100),
+                               iconUrl(ImageCache::MAX_DOWNLOADS)};
+    for (int n = 0; n < expected.size(); ++n) {
+        network.sent(n).reply->finish({}, 200, QNetworkReply::NoError, pngBytes(qRgb(0, 0, 0)));
+        QCOMPARE(network.count(), ImageCache::MAX_DOWNLOADS + n + 1);
+        QCOMPARE(network.sent(ImageCache::MAX_DOWNLOADS + n).request.url().toString(),
+                 expected[n]);
+    }
+}
+
+void ImageCacheTest::newPrefetchReplacesQueuedPrefetches()
+{
+    QTemporaryDir dir;
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path());
+
+    QStringList first;
+    for (int n = 0; n < ImageCache::MAX_DOWNLOADS + 2; ++n) {
+        first.push_back(iconUrl(n));
+    }
+    cache.prefetch(first);
+    cache.prefetch({iconUrl(100)});
+    QCOMPARE(network.count(), ImageCache::MAX_DOWNLOADS);
+
+    network.sent(0).reply->finish({}, 200, QNetworkReply::NoError, pngBytes(qRgb(0, 0, 0)));
+    QCOMPARE(network.count(), ImageCache::MAX_DOWNLOADS + 1);
+    QCOMPARE(network.sent(ImageCache::MAX_DOWNLOADS).request.url().toString(), iconUrl(100));
+
+    // The dropped ones are not pending any more: a fetch asks for them.
+    cache.fetch(iconUrl(ImageCache::MAX_DOWNLOADS));
+    network.sent(1).reply->finish({}, 200, QNetworkReply::NoError, pngBytes(qRgb(0, 0, 0)));
+    QCOMPARE(network.count(), ImageCache::MAX_DOWNLOADS + 2);
+    QCOMPARE(network.sent(ImageCache::MAX_DOWNLOADS + 1).request.url().toString(),
+             iconUrl(ImageCache::MAX_DOWNLOADS));
+}
+
+void ImageCacheTest::failedDownloadCanBeRetried()
+{
+    QTemporaryDir dir;
+    FakeNetworkManager network;
+    ImageCache cache(network, dir.path());
+    QSignalSpy ready(&cache, &ImageCache::imageReady);
+
+    cache.fetch(kUrl);
+    network.sent(0).reply->finish({}, 404, QNetworkReply::ContentNotFoundError);
+    QTest::qWait(50);
+    QCOMPARE(ready.count(), 0);
+    QVERIFY(!cache.contains(kUrl));
+
+    cache.fetch(kUrl);
+    QCOMPARE(network.count(), 2);
+}
+
+QTEST_GUILESS_MAIN(ImageCacheTest)
+
+#include "tst_imagecache.moc"
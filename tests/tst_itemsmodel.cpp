@@ -20,6 +20,7 @@ private slots:
     void testerSurvivesRebuildModeSwitchAndSort();
     void selectionSurvivesSort();
     void sortDirectionMatchesOrder();
+    void backgroundSortLandsSupersededOnce();
 };
 
 static std::shared_ptr<Item> makeModelItem(const QString &id,
@@ -222,6 +223,60 @@ void ItemsModelTest::sortDirectionMatchesOrder()
     QCOMPARE(descending, expected);
 }
 
+// A By-Item column click at or above the background threshold returns
+// before the rows move; a second click cancels the first sort, and only
+// the surviving one lands — as one layout change, keys resident.
+void ItemsModelTest::backgroundSortLandsSupersededOnce()
+{
+    BuyoutManagerFixture buyoutFixture;
+    const ItemLocation firstTab = makeTestStashLocation("stash-a", "Alpha Tab", 0);
+    buyoutFixture.manager->SetStashTabLocations({firstTab});
+
+    Items items;
+    items.push_back(makeModelItem("alpha-2", "Zulu Bite", "Vaal Axe", firstTab));
+    items.push_back(makeModelItem("alpha-1", "Alpha Bite", "Copper Sword", firstTab));
+    items.push_back(makeModelItem("alpha-3", "Mid Bite", "Iron Hammer", firstTab));
+    items.push_back(makeModelItem("alpha-4", "Omega Bite", "Steel Dagger", firstTab));
+
+    FilterCatalog catalog({});
+    Search search(*buyoutFixture.manager, "Model", catalog);
+    search.FilterItems(items);
+    search.SetViewMode(Search::ViewMode::ByItem);
+    auto *model = &search.model();
+    model->SetBackgroundSortRows(1);
+    const QModelIndex flat = model->index(0, 0);
+    QCOMPARE(model->rowCount(flat), 4);
+
+    const auto rowNames = [&]() {
+        QStringList names;
+        for (int row = 0; row < model->rowCount(flat); ++row) {
+            names << model->index(row, 0, flat).data().toString();
+        }
+        return names;
+    };
+    const QStringList before = rowNames();
+
+    QSignalSpy layoutChanged(model, &QAbstractItemModel::layoutChanged);
+    model->sort(0, Qt::AscendingOrder);
+    QVERIFY(model->backgroundSortPending());
+    QCOMPARE(rowNames(), before);
+    model->sort(0, Qt::DescendingOrder);
+    QVERIFY(model->backgroundSortPending());
+
+    QTRY_VERIFY(!model->backgroundSortPending());
+    QCOMPARE(layoutChanged.count(), 1);
+    QStringList expected = before;
+    std::sort(expected.begin(), expected.end());
+    std::reverse(expected.begin(), expected.end());
+    QCOMPARE(rowNames(), expected);
+    QVERIFY(search.bucket(0).sorted());
+    QVERIFY(search.bucket(0).hasResidentKeys());
+
+    // Re-clicking the landed sort is the already-sorted skip.
+    model->sort(0, Qt::DescendingOrder);
+    QVERIFY(!model->backgroundSortPending());
+}
+
 QTEST_MAIN(ItemsModelTest)
 
 #include "tst_itemsmodel.moc"
@@ -95,6 +95,9 @@ private slots:
     void multiSelectionBuyoutEditReordersOnce();
     void pricingPassYieldsSingleModelUpdate();
     void snapshotPricingSequenceEmitsOneModelBatch();
+    void tabPriceEditRepricesOnlyThatTab();
+    void notePricingRevisitsOnlyRefetchedItems();
+    void manualPriceOverANoteHoldsUntilRefetch();
     void priceCellsRepaintUnderAnySortColumn();
     void buyoutRepaintCoversEveryVisibleOccurrence();
 
@@ -1382,6 +1385,92 @@ void MainWindowTest::snapshotPricingSequenceEmitsOneModelBatch()
     QVERIFY(tabBuyouts.contains("stash-alpha"));
 }
 
+// Incremental propagation: a tab price edit reprices that tab's items
+// alone. Tab B's refresh lock, set behind the passes' back, is what a
+// whole-collection pass would re-derive (and clear); it is left alone.
+void MainWindowTest::tabPriceEditRepricesOnlyThatTab()
+{
+    MainWindowFixture fixture;
+    BuyoutManager &manager = *fixture.buyoutFixture.manager;
+    const ItemLocation tabA = makeTestStashLocation("stash-alpha", "Alpha Tab", 0);
+    const ItemLocation tabB = makeTestStashLocation("stash-bravo", "Bravo Tab", 1);
+    Items items;
+    items.push_back(makeMainWindowItem("item-a", "Alpha", "Sword", tabA));
+    items.push_back(makeMainWindowItem("item-b", "Bravo", "Sword", tabB));
+    fixture.itemsManager->OnItemsRefreshed(items, {tabA, tabB}, false);
+    QVERIFY(!manager.GetRefreshLocked(tabB));
+
+    manager.SetRefreshLocked(tabB);
+    manager.SetTab(tabA, makeChaosBuyout(4.0));
+    fixture.itemsManager->PropagateTabBuyouts();
+
+    const Buyout propagated = manager.Get(*items[0]);
+    QCOMPARE(propagated.value, 4.0);
+    QVERIFY(propagated.inherited);
+    QVERIFY(manager.GetRefreshLocked(tabA));
+    QVERIFY(manager.GetRefreshLocked(tabB));
+}
+
+// Incremental note pricing: a snapshot that republishes the same items
+// leaves their notes unread; a refetched item (a new Item for the same id)
+// has its note applied again.
+void MainWindowTest::notePricingRevisitsOnlyRefetchedItems()
+{
+    MainWindowFixture fixture;
+    BuyoutManager &manager = *fixture.buyoutFixture.manager;
+    const ItemLocation tabA = makeTestStashLocation("stash-alpha", "Alpha Tab", 0);
+    Items items;
+    items.push_back(makeMainWindowItemWithNote("item-a", "Alpha", "Sword", tabA, "~b/o 5 chaos"));
+    fixture.itemsManager->OnItemsRefreshed(items, {tabA}, false);
+    QCOMPARE(manager.Get(*items[0]).value, 5.0);
+
+    // A price the note rule would overwrite.
+    manager.Set(*items[0], makeChaosBuyout(8.0));
+
+    fixture.itemsManager->OnItemsRefreshed(items, {tabA}, false);
+    QCOMPARE(manager.Get(*items[0]).value, 8.0);
+
+    Items refetched;
+    refetched.push_back(
+        makeMainWindowItemWithNote("item-a", "Alpha", "Sword", tabA, "~b/o 5 chaos"));
+    fixture.itemsManager->OnItemsRefreshed(refetched, {tabA}, false);
+    QCOMPARE(manager.Get(*refetched[0]).value, 5.0);
+}
+
+// A manual price over a note-priced item survives every snapshot and
+// buyout edit that leaves the item itself alone; the note wins again only
+// when the item's tab is refetched, here through a streamed delta.
+void MainWindowTest::manualPriceOverANoteHoldsUntilRefetch()
+{
+    MainWindowFixture fixture;
+    BuyoutManager &manager = *fixture.buyoutFixture.manager;
+    const ItemLocation tabA = makeTestStashLocation("stash-alpha", "Alpha Tab", 0);
+    const ItemLocation tabB = makeTestStashLocation("stash-bravo", "Bravo Tab", 1);
+    Items items;
+    items.push_back(makeMainWindowItemWithNote("item-a", "Alpha", "Sword", tabA, "~b/o 5 chaos"));
+    items.push_back(makeMainWindowItem("item-b", "Bravo", "Sword", tabB));
+    fixture.itemsManager->OnItemsRefreshed(items, {tabA, tabB}, false);
+    QVERIFY(manager.Get(*items[0]).IsGameSet());
+
+    const Buyout manual = makeChaosBuyout(8.0);
+    QCOMPARE(manual.source, Buyout::BUYOUT_SOURCE_MANUAL);
+    manager.Set(*items[0], manual);
+
+    fixture.itemsManager->OnItemsRefreshed(items, {tabA, tabB}, false);
+    manager.SetTab(tabA, makeChaosBuyout(3.0));
+    fixture.itemsManager->PropagateTabBuyouts();
+    fixture.itemsManager->OnItemsRefreshed(items, {tabA, tabB}, false);
+    QCOMPARE(manager.Get(*items[0]).value, 8.0);
+    QVERIFY(!manager.Get(*items[0]).IsGameSet());
+
+    Items refetched;
+    refetched.push_back(
+        makeMainWindowItemWithNote("item-a", "Alpha", "Sword", tabA, "~b/o 5 chaos"));
+    fixture.itemsManager->OnTabRefreshed(tabA, refetched);
+    QCOMPARE(manager.Get(*refetched[0]).value, 5.0);
+    QVERIFY(manager.Get(*refetched[0]).IsGameSet());
+}
+
 // M3 R1-6, rule 5: with Name active, a buyout batch emits dataChanged for
 // the affected visible Price/Date cells and performs no reordering — cell
 // repaint is independent of the active sort column.
@@ -13,6 +13,7 @@
 #include "ratelimit/fetcherror.h"
 #include "replytimeout.h"
 #include "util/networkmanager.h"
+#include "util/util.h"
 
 // The typed facade (network-redesign spec, the facade section): request
 // shapes, the transfer-timeout invariant, and the parse chain. The limiter is
@@ -32,6 +33,7 @@ private slots:
     void legacyStashIndexCarriesQueryAndStableEndpoint();
     void successParsesPayload();
     void stashPayloadCarriesTheWireBytes();
+    void stashMatchingTheKnownDigestSkipsItsItems();
     void characterPayloadCarriesTheWireBytes();
     void missingStashSubObjectIsAParseError();
     void missingCharacterSubObjectIsAParseError();
@@ -200,6 +202,47 @@ void PoeApiClientTest::stashPayloadCarriesTheWireBytes()
     QCOMPARE(consumer.payload->bytes, sub);
 }
 
+void PoeApiClientTest::stashMatchingTheKnownDigestSkipsItsItems()
+{
+    // The digest is taken over the sub-object's bytes before any typed
+    // parse. When it matches the one the caller launched the fetch with, the
+    // items are never built, but the header the worker needs — and the
+    // children it launches from it — still comes back.
+    const QByteArray sub = R"({"id":"0123456789","name":"Maps","type":"MapStash",)"
+                           R"("children":[{"id":"0123456789","name":"Tier 1","type":"MapStash",)"
+                           R"("items":[]}],"items":[{"verified":true,"w":1,"h":1,)"
+                           R"("icon":"https://web.poecdn.com/image/test.png",)"
+                           R"("id":"item000001","name":"","typeLine":"Chaos Orb",)"
+                           R"("baseType":"Chaos Orb","identified":true,"ilvl":1}]})";
+    const QByteArray digest = Util::ContentDigest(sub);
+
+    Rig rig;
+    Consumer<poe::StashPayload> matching;
+    matching.attach(rig.api.getStash("pc", "Standard", "abc", {}, digest));
+    Consumer<poe::StashPayload> stale;
+    stale.attach(rig.api.getStash("pc", "Standard", "abc", {}, "0000000000000000"));
+
+    rig.limiter.resolve(0, "{\"stash\":" + sub + "}");
+    rig.limiter.resolve(1, "{\"stash\":" + sub + "}");
+    drainEvents();
+
+    QVERIFY(matching.payload.has_value());
+    QVERIFY(matching.payload->unchanged);
+    QCOMPARE(matching.payload->digest, digest);
+    QCOMPARE(matching.payload->bytes, sub);
+    QCOMPARE(matching.payload->stash.type, QString("MapStash"));
+    QVERIFY(!matching.payload->stash.items.has_value());
+    QVERIFY(matching.payload->stash.children.has_value());
+    QCOMPARE(matching.payload->stash.children->size(), size_t(1));
+    QCOMPARE(matching.payload->stash.children->front().name, QString("Tier 1"));
+
+    QVERIFY(stale.payload.has_value());
+    QVERIFY(!stale.payload->unchanged);
+    QCOMPARE(stale.payload->digest, digest);
+    QVERIFY(stale.payload->stash.items.has_value());
+    QCOMPARE(stale.payload->stash.items->size(), size_t(1));
+}
+
 void PoeApiClientTest::characterPayloadCarriesTheWireBytes()
 {
     Rig rig;
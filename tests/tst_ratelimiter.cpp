@@ -7,9 +7,11 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QPointer>
+#include <QTemporaryDir>
 
 #include <chrono>
 
+#include "datastore/sqlitedatastore.h"
 #include "fakenetworkmanager.h"
 #include "fakescheduler.h"
 #include "ratelimit/gate.h"
@@ -56,6 +58,12 @@ private slots:
     void cancelingEveryParkedEntryStillEstablishes();
     void resubmitFromCancellationHandlerIsSafe();
     void cancellationWinsOverAConcurrentSetupFailure();
+    void restoredEndpointSendsWithoutAProbe();
+    void restoredHistoryPacesTheFirstSend();
+    void restoredCountersAgeOut();
+    void restoredRestrictionHoldsTheFirstSend();
+    void staleStateIsRelearned();
+    void persistenceSavesAndRestoresThroughTheDataStore();
 };
 
 namespace {
@@ -158,6 +166,24 @@ namespace {
         RateLimiter limiter{network, &scheduler};
     };
 
+    // Establish "ep" with a HEAD reporting `limit` and `head_state`, then
+    // land one GET whose reply reports `state`, leaving that send in the
+    // pump's history.
+    void establishWithOneSend(Rig &rig,
+                              const QByteArray &limit,
+                              const QByteArray &head_state,
+                              const QByteArray &state)
+    {
+        FutureSubmission first;
+        first.attach(rig.limiter.SubmitFuture("ep", request("first"), first.token()));
+        settle(rig.scheduler);
+        rig.network.sent(0).reply->finish(policyHeaders(limit, head_state), 200);
+        drainEvents();
+        advanceAndSettle(rig.scheduler, kGateSpacing);
+        rig.network.sent(1).reply->finish(policyHeaders(limit, state), 200);
+        drainEvents();
+    }
+
 } // namespace
 
 void RateLimiterTest::headEstablishesEndpointAndForwardsParkedFifo()
@@ -844,6 +870,145 @@ void RateLimiterTest::cancellationWinsOverAConcurrentSetupFailure()
     QCOMPARE(victim.completions, 1);
 }
 
+// Persisted state: a restored endpoint is Established from the start, so
+// the first submission of a new session goes to its pump with no HEAD.
+void RateLimiterTest::restoredEndpointSendsWithoutAProbe()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    QString state;
+    {
+        Rig rig;
+        establishWithOneSend(rig, "10:60:60", "0:60:0", "1:60:0");
+        QCOMPARE(rig.network.count(), 2);
+        state = rig.limiter.SaveState(now);
+    }
+
+    Rig rig;
+    rig.limiter.RestoreState(state, now);
+    FutureSubmission s1;
+    s1.attach(rig.limiter.SubmitFuture("ep", request("one"), s1.token()));
+    advanceAndSettle(rig.scheduler, std::chrono::milliseconds(kNormalBufferMsec));
+    QCOMPARE(rig.network.count(), 1);
+    QCOMPARE(rig.network.sent(0).op, QNetworkAccessManager::GetOperation);
+    rig.network.sent(0).reply->finish(policyHeaders("10:60:60", "2:60:0"), 200);
+    drainEvents();
+    QVERIFY(s1.succeeded);
+    QCOMPARE(rig.network.headCount(), 0);
+}
+
+// The carried-over send keeps a BORDERLINE policy paced: the first send of
+// the new session waits out period + bucket + buffer = 10+5+1 = 16s from
+// the old session's last send, not a fresh window.
+void RateLimiterTest::restoredHistoryPacesTheFirstSend()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    QString state;
+    {
+        Rig rig;
+        establishWithOneSend(rig, "1:10:60", "0:10:0", "1:10:0");
+        state = rig.limiter.SaveState(now);
+    }
+
+    Rig rig;
+    rig.limiter.RestoreState(state, now);
+    FutureSubmission s1;
+    s1.attach(rig.limiter.SubmitFuture("ep", request("one"), s1.token()));
+    advanceAndSettle(rig.scheduler, 15s);
+    QCOMPARE(rig.network.count(), 0);
+    advanceAndSettle(rig.scheduler, 2s);
+    QCOMPARE(rig.network.count(), 1);
+    QCOMPARE(rig.network.sent(0).op, QNetworkAccessManager::GetOperation);
+}
+
+// Restored later than the policy's period, the same state has nothing left
+// to pace on: the counter and the history have both aged out.
+void RateLimiterTest::restoredCountersAgeOut()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    QString state;
+    {
+        Rig rig;
+        establishWithOneSend(rig, "1:10:60", "0:10:0", "1:10:0");
+        state = rig.limiter.SaveState(now);
+    }
+
+    Rig rig;
+    rig.limiter.RestoreState(state, now.addSecs(20));
+    FutureSubmission s1;
+    s1.attach(rig.limiter.SubmitFuture("ep", request("one"), s1.token()));
+    advanceAndSettle(rig.scheduler, std::chrono::milliseconds(kNormalBufferMsec));
+    QCOMPARE(rig.network.count(), 1);
+    QCOMPARE(rig.network.headCount(), 0);
+}
+
+// A restriction the old session was put under is still served: 30s plus
+// the one-second buffer, counted from the restore.
+void RateLimiterTest::restoredRestrictionHoldsTheFirstSend()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    QString state;
+    {
+        Rig rig;
+        establishWithOneSend(rig, "1:10:60", "0:10:0", "2:10:30");
+        state = rig.limiter.SaveState(now);
+    }
+
+    Rig rig;
+    rig.limiter.RestoreState(state, now);
+    FutureSubmission s1;
+    s1.attach(rig.limiter.SubmitFuture("ep", request("one"), s1.token()));
+    advanceAndSettle(rig.scheduler, 30s);
+    QCOMPARE(rig.network.count(), 0);
+    advanceAndSettle(rig.scheduler, 2s);
+    QCOMPARE(rig.network.count(), 1);
+    QCOMPARE(rig.network.headCount(), 0);
+}
+
+// Past a day the whole state is dropped and the endpoint is probed again.
+void RateLimiterTest::staleStateIsRelearned()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    QString state;
+    {
+        Rig rig;
+        establishWithOneSend(rig, "10:60:60", "0:60:0", "1:60:0");
+        state = rig.limiter.SaveState(now);
+    }
+
+    Rig rig;
+    rig.limiter.RestoreState(state, now.addSecs(25 * 60 * 60));
+    FutureSubmission s1;
+    s1.attach(rig.limiter.SubmitFuture("ep", request("one"), s1.token()));
+    settle(rig.scheduler);
+    QCOMPARE(rig.network.count(), 1);
+    QCOMPARE(rig.network.sent(0).op, QNetworkAccessManager::HeadOperation);
+}
+
+// The session wiring: a policy update schedules a save a few seconds out
+// on the scheduler, and the next limiter restores from the same store.
+void RateLimiterTest::persistenceSavesAndRestoresThroughTheDataStore()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    SqliteDataStore data(dir.filePath("data.sqlite"));
+    {
+        Rig rig;
+        rig.limiter.EnablePersistence(data);
+        establishWithOneSend(rig, "10:60:60", "0:60:0", "1:60:0");
+        QVERIFY(data.Get("rate_limit_state").isEmpty());
+        advanceAndSettle(rig.scheduler, 5s);
+        QVERIFY(!data.Get("rate_limit_state").isEmpty());
+    }
+
+    Rig rig;
+    rig.limiter.EnablePersistence(data);
+    FutureSubmission s1;
+    s1.attach(rig.limiter.SubmitFuture("ep", request("one"), s1.token()));
+    advanceAndSettle(rig.scheduler, std::chrono::milliseconds(kNormalBufferMsec));
+    QCOMPARE(rig.network.count(), 1);
+    QCOMPARE(rig.network.sent(0).op, QNetworkAccessManager::GetOperation);
+}
+
 QTEST_GUILESS_MAIN(RateLimiterTest)
 
 #include "tst_ratelimiter.moc"
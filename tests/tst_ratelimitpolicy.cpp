@@ -30,6 +30,8 @@ private slots:
     void statusReflectsWorstItem();
     void malformedHeadersFailToParse_data();
     void malformedHeadersFailToParse();
+    void headersRoundTripThroughParse();
+    void agingResetsElapsedCounters();
 };
 
 namespace {
@@ -229,6 +231,62 @@ void RateLimitPolicyTest::malformedHeadersFailToParse()
     QVERIFY(!policy.error().isEmpty());
 }
 
+// The persisted form (RateLimiter::SaveState) is the policy's own headers,
+// so a restored policy passes the same total parse.
+void RateLimitPolicyTest::headersRoundTripThroughParse()
+{
+    auto reply = headerReply({
+        {"X-Rate-Limit-Policy", "backend-item-request-limit"},
+        {"X-Rate-Limit-Rules", "Account,Ip"},
+        {"X-Rate-Limit-Account", "6:4:10"},
+        {"X-Rate-Limit-Account-State", "1:4:0"},
+        {"X-Rate-Limit-Ip", "9:4:10,180:60:300"},
+        {"X-Rate-Limit-Ip-State", "2:4:0,18:60:0"},
+    });
+    const auto policy = RateLimitPolicy::Parse(&reply);
+    QVERIFY(policy.has_value());
+    const auto restored = RateLimitPolicy::Parse(policy->Headers());
+    QVERIFY(restored.has_value());
+    QCOMPARE(restored->GetPolicyReport(), policy->GetPolicyReport());
+    QVERIFY(restored->HasSameShape(*policy));
+
+    // Header names match case-insensitively, as they do on a reply.
+    const auto lowercase = RateLimitPolicy::Parse({
+        {"x-rate-limit-policy", "test-policy"},
+        {"x-rate-limit-rules", "Ip"},
+        {"x-rate-limit-ip", "30:60:120"},
+        {"x-rate-limit-ip-state", "0:60:0"},
+    });
+    QVERIFY(lowercase.has_value());
+}
+
+void RateLimitPolicyTest::agingResetsElapsedCounters()
+{
+    auto reply = headerReply({
+        {"X-Rate-Limit-Policy", "test-policy"},
+        {"X-Rate-Limit-Rules", "Ip"},
+        {"X-Rate-Limit-Ip", "5:10:60,30:300:600"},
+        {"X-Rate-Limit-Ip-State", "6:10:45,30:300:0"},
+    });
+    const auto policy = RateLimitPolicy::Parse(&reply);
+    QVERIFY(policy.has_value());
+    QCOMPARE(policy->status(), RateLimit::Status::VIOLATION);
+    QCOMPARE(policy->restriction_secs(), 45);
+
+    // 20s on: the 10s counter has rolled over, the 300s one has not, and
+    // the restriction has 25s to go.
+    const RateLimitPolicy aged = policy->Aged(std::chrono::seconds(20));
+    const auto &items = aged.rules()[0].items();
+    QCOMPARE(items[0].state().hits(), 0);
+    QCOMPARE(items[1].state().hits(), 30);
+    QCOMPARE(aged.restriction_secs(), 25);
+    QCOMPARE(aged.status(), RateLimit::Status::BORDERLINE);
+
+    const RateLimitPolicy expired = policy->Aged(std::chrono::seconds(300));
+    QCOMPARE(expired.status(), RateLimit::Status::OK);
+    QCOMPARE(expired.restriction_secs(), 0);
+}
+
 QTEST_GUILESS_MAIN(RateLimitPolicyTest)
 
 #include "tst_ratelimitpolicy.moc"
@@ -280,7 +280,7 @@ void ReconcileTest::savedStashBytesAreStoredVerbatim()
     const poe::StashTab tab = makeTab("tab-a");
     const QByteArray bytes
         = R"({"id":"tab-a","name":"Tab tab-a","type":"PremiumStash","unmodeledField":42})";
-    QVERIFY(f.stashes->saveStash(tab, bytes, kRealm, kLeague));
+    QVERIFY(f.stashes->saveStash(tab, bytes, Util::ContentDigest(bytes), kRealm, kLeague));
 
     QSqlQuery q(*f.db);
     QVERIFY(q.exec("SELECT json_data FROM stashes WHERE id = 'tab-a'"));
@@ -296,7 +296,7 @@ void ReconcileTest::savedCharacterBytesAreStoredVerbatim()
 
     const QByteArray bytes
         = R"({"id":"charid0001","name":"CharOne","realm":"pc","unmodeledField":true})";
-    QVERIFY(f.characters->saveCharacter(character, bytes));
+    QVERIFY(f.characters->saveCharacter(character, bytes, Util::ContentDigest(bytes)));
 
     QSqlQuery q(*f.db);
     QVERIFY(q.exec("SELECT json_data FROM characters WHERE id = 'charid0001'"));
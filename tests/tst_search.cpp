@@ -1,3 +1,4 @@
+#include <QRegularExpression>
 #include <QtTest/QtTest>
 
 #include <algorithm>
@@ -6,6 +7,7 @@
 
 #include "bucket.h"
 #include "buyout.h"
+#include "column.h"
 #include "currency.h"
 #include "filters/filterspec.h"
 #include "locationinventory.h"
@@ -27,6 +29,8 @@ private slots:
     void tabChangeRefiltersAfterStateChange();
     void probeCountersTrackRefilterAndSort();
     void keyedOrderMatchesComparatorOrder();
+    void normalizedPrefixNeverContradictsTuple();
+    void sortValueParsesLikeTheRegexes();
     void intendedTieBreakRestored();
     // M3 S6 (R1-2/R1-7): the final reconciliation is authoritative at the
     // row grain, which is what licenses clearing the fail-safe dirty flag
@@ -40,6 +44,9 @@ private slots:
     // elsewhere (insertions target the anchor); the reconciliation must
     // move it home, never retain-and-duplicate.
     void reconciliationRehomesWrongBucketRow();
+    // A one-directional filter edit lands as row operations on the live
+    // model and converges to what a full refilter would show.
+    void filterEditNarrowsAndWidensWithoutReset();
 };
 
 template<typename Payload>
@@ -545,6 +552,88 @@ void SearchTest::keyedOrderMatchesComparatorOrder()
     }
 }
 
+// The normalized prefix may tie where the tuples differ, never disagree
+// with them: checked pairwise over the encoding's edge cases — signed
+// zero, embedded U+0000, strings sharing more units than the prefix holds,
+// surrogates, negative ranks, and invalid against valid datetimes.
+void SearchTest::normalizedPrefixNeverContradictsTuple()
+{
+    const QString long_a = QString(20, QChar('a'));
+    const ItemSortKey::Suffix suffix("Name", "uid", "hash");
+    std::vector<ItemSortKey> keys;
+    for (const double d : {-2.5, -0.0, 0.0, 1.0, 1e300}) {
+        for (const QString &s : {QString(),
+                                 QString("a"),
+                                 QString(QChar(u'\0')),
+                                 QString("a") + QChar(u'\0'),
+                                 QString("b"),
+                                 long_a,
+                                 long_a + "b",
+                                 QString::fromUtf16(u"\U0001F600")}) {
+            keys.emplace_back(ItemSortKey::BaseHead(d, s, 0.0, QString()), suffix);
+            keys.emplace_back(ItemSortKey::BaseHead(0.0, QString(), d, s), suffix);
+            keys.emplace_back(ItemSortKey::BaseHead(0.0, QString(), 0.0, QString()),
+                              ItemSortKey::Suffix(s, QString(), QString()));
+        }
+        keys.emplace_back(ItemSortKey::PriceHead(-1, d), suffix);
+        keys.emplace_back(ItemSortKey::PriceHead(3, d), suffix);
+    }
+    keys.emplace_back(ItemSortKey::DateHead(QDateTime()), suffix);
+    keys.emplace_back(ItemSortKey::DateHead(QDateTime::fromMSecsSinceEpoch(-5)), suffix);
+    keys.emplace_back(ItemSortKey::DateHead(QDateTime::fromSecsSinceEpoch(1700000000)), suffix);
+
+    for (const auto &a : keys) {
+        for (const auto &b : keys) {
+            if (a.head.index() != b.head.index()) {
+                continue; // one sort never mixes head families
+            }
+            const bool tuple_less = std::tie(a.head, a.suffix) < std::tie(b.head, b.suffix);
+            QVERIFY(!(tuple_less && (b.prefix < a.prefix)));
+            QCOMPARE(a < b, tuple_less);
+        }
+    }
+}
+
+// SortValue::Parse replaced the two regular expressions the base-family
+// key used to run per item; it must read every string exactly as they did.
+void SearchTest::sortValueParsesLikeTheRegexes()
+{
+    static const QRegularExpression sort_double_match("^\\+?([\\d.]+)%?$");
+    static const QRegularExpression sort_two_values("^(\\d+)([-/])(\\d+)$");
+
+    const QStringList inputs{
+        // The documented shapes.
+        "12", "12.12", "10%", "10.13%", "+16%", "12-14", "10/20",
+        // Near misses on the number path.
+        "0", ".", "1.2.3", "+", "%", "+%", "12%%", "++12", "-12", " 12", "12 ",
+        // Near misses on the pair path.
+        "12-", "-14", "12--14", "1.5-2", "12/",
+        // $ matched before one final newline, and \d only ASCII digits.
+        "12\n", "12-14\n", "12\n\n", "\u0661\u0662", "12-\u0661",
+        // Text.
+        "Fire", "N/A", ""};
+    for (const QString &input : inputs) {
+        const SortValue parsed = SortValue::Parse(input);
+        QRegularExpressionMatch match;
+        if (input.contains(sort_double_match, &match)) {
+            QCOMPARE(parsed.kind, SortValue::Kind::Number);
+            QCOMPARE(parsed.number, match.captured(1).toDouble());
+        } else if (input.contains(sort_two_values, &match)) {
+            const double first = match.captured(1).toDouble();
+            if (match.captured(2) == "-") {
+                QCOMPARE(parsed.kind, SortValue::Kind::Number);
+                QCOMPARE(parsed.number, 0.5 * (first + match.captured(3).toDouble()));
+            } else {
+                QCOMPARE(parsed.kind, SortValue::Kind::Pair);
+                QCOMPARE(parsed.number, first);
+            }
+        } else {
+            QCOMPARE(parsed.kind, SortValue::Kind::Text);
+            QCOMPARE(parsed.text, input);
+        }
+    }
+}
+
 // S1 pin (items-pipeline-m3.md, sort-correctness): id-less items tying on
 // PrettyName order deterministically by hash across repeated sorts
 // (F67 resolved — the comparator's third tie-break element is now the
@@ -713,6 +802,116 @@ void SearchTest::reconciliationRehomesWrongBucketRow()
     QCOMPARE(search.GetCaption(), "Search [2]");
 }
 
+// Each visible bucket's stable id and its item ids, in display order with
+// each bucket's ids sorted: the membership a fresh refilter would show,
+// independent of row order inside a bucket.
+static QStringList visibleMembership(const Search &search)
+{
+    QStringList membership;
+    for (const auto &bucket : search.buckets()) {
+        QStringList ids;
+        for (const auto &item : bucket.items()) {
+            ids.push_back(item->id());
+        }
+        ids.sort();
+        membership.push_back(bucket.location().id() + ": " + ids.join(','));
+    }
+    return membership;
+}
+
+void SearchTest::filterEditNarrowsAndWidensWithoutReset()
+{
+    BuyoutManagerFixture buyoutFixture;
+    const ItemLocation tabA = makeTestStashLocation("stash-a", "Alpha Tab", 0);
+    const ItemLocation tabB = makeTestStashLocation("stash-b", "Beta Tab", 1);
+    buyoutFixture.manager->SetStashTabLocations({tabA, tabB});
+
+    const auto critItem = [](const QString &id, const QString &crit, const ItemLocation &tab) {
+        const QString properties = QString(R"json(,
+        "properties": [
+            {
+                "displayMode": 0,
+                "name": "Critical Strike Chance",
+                "type": 6,
+                "values": [["%1", 1]]
+            }
+        ])json")
+                                       .arg(crit);
+        return makeSearchItem(id, id, "Vaal Axe", tab, properties);
+    };
+    Items items;
+    items.push_back(critItem("crit-4", "4", tabA));
+    items.push_back(critItem("crit-6", "6", tabA));
+    items.push_back(critItem("crit-8", "8", tabB));
+    items.push_back(makeSearchItem("no-crit", "Plain Guard", "Copper Shield", tabB));
+
+    const FilterCatalog catalog = BuildFilterCatalog(*buyoutFixture.manager);
+    const qsizetype critIndex = findFilterIndex<MinMaxPayload>(catalog, "Crit.");
+    QVERIFY(critIndex >= 0);
+    const auto freshMembership = [&](const MinMaxState &state) {
+        Search fresh(*buyoutFixture.manager, "Fresh", catalog);
+        fresh.setFilterState(critIndex, state);
+        fresh.FilterItems(items);
+        return visibleMembership(fresh);
+    };
+
+    Search search(*buyoutFixture.manager, "Edited", catalog);
+    search.setFilterState(critIndex, MinMaxState{5.0, std::nullopt});
+    search.FilterItems(items);
+    QCOMPARE(visibleMembership(search), QStringList({"stash-a: crit-6", "stash-b: crit-8"}));
+
+    auto &probes = ModelProbes::instance();
+    probes.reset();
+    probes.enabled = true;
+    QSignalSpy resets(&search.model(), &QAbstractItemModel::modelAboutToBeReset);
+    QSignalSpy removed(&search.model(), &QAbstractItemModel::rowsAboutToBeRemoved);
+    QSignalSpy inserted(&search.model(), &QAbstractItemModel::rowsAboutToBeInserted);
+
+    // Narrowing: the emptied Alpha bucket leaves (filtered searches hide
+    // empty buckets), exactly as a fresh refilter would drop it.
+    search.setFilterState(critIndex, MinMaxState{7.0, std::nullopt});
+    search.SetRefreshReason(RefreshReason::SearchFormChanged);
+    search.FilterItems(items);
+    QCOMPARE(resets.count(), 0);
+    QVERIFY(removed.count() > 0);
+    QCOMPARE(probes.incremental_refilters, 1);
+    QCOMPARE(probes.refilters, 0);
+    QCOMPARE(visibleMembership(search), freshMembership(MinMaxState{7.0, std::nullopt}));
+    QCOMPARE(search.GetCaption(), "Edited [1]");
+
+    // Widening: the rejected rows that now pass arrive, recreating the
+    // Alpha bucket; the item without the property stays out.
+    search.setFilterState(critIndex, MinMaxState{3.0, std::nullopt});
+    search.FilterItems(items);
+    QCOMPARE(resets.count(), 0);
+    QVERIFY(inserted.count() > 0);
+    QCOMPARE(probes.incremental_refilters, 2);
+    QCOMPARE(visibleMembership(search), freshMembership(MinMaxState{3.0, std::nullopt}));
+    QCOMPARE(search.GetCaption(), "Edited [3]");
+    QVERIFY(search.visibleItemById("crit-4"));
+
+    // The same in By-Item, where the flat bucket takes the edit.
+    search.SetViewMode(Search::ViewMode::ByItem);
+    resets.clear();
+    search.setFilterState(critIndex, MinMaxState{5.0, 7.0});
+    search.FilterItems(items);
+    QCOMPARE(resets.count(), 0);
+    QCOMPARE(probes.incremental_refilters, 3);
+    QCOMPARE(search.GetCaption(), "Edited [1]");
+    QCOMPARE(search.buckets().front().items().size(), 1);
+    QCOMPARE(search.buckets().front().items().front()->id(), "crit-6");
+
+    // A range that moved rather than grew or shrank is neither: full pass.
+    search.setFilterState(critIndex, MinMaxState{7.0, 9.0});
+    search.FilterItems(items);
+    QCOMPARE(resets.count(), 1);
+    QCOMPARE(probes.incremental_refilters, 3);
+    QCOMPARE(probes.refilters, 1);
+    QCOMPARE(search.buckets().front().items().front()->id(), "crit-8");
+
+    probes.enabled = false;
+}
+
 QTEST_MAIN(SearchTest)
 
 #include "tst_search.moc"
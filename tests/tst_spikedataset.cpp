@@ -3,6 +3,7 @@
 #include <QSet>
 
 #include "itemcategories.h"
+#include "modlist.h"
 #include "spikedataset.h"
 
 // Pins the properties M2 relies on from the dataset generator: the same
@@ -18,6 +19,7 @@ private slots:
     void sameSeedReproducesCollectionAndChurn();
     void churnPreservesStableIdentityNotPointers();
     void namedPresetsMatchRecordedShapes();
+    void modRollsAreStableAndResolve();
 };
 
 static SpikeDataset::Config smallConfig()
@@ -131,6 +133,46 @@ void SpikeDatasetTest::namedPresetsMatchRecordedShapes()
     QVERIFY(!SpikeDataset::Config::Preset("bogus").has_value());
 }
 
+void SpikeDatasetTest::modRollsAreStableAndResolve()
+{
+    // Off by default: the recorded shapes carry no mods.
+    const SpikeDataset plain(smallConfig());
+    for (const auto &item : *plain.MakeStashReply(0).items) {
+        QVERIFY(!item.explicitMods && !item.implicitMods);
+    }
+
+    SpikeDataset::Config config = smallConfig();
+    config.with_mods = true;
+    const SpikeDataset a(config);
+    const SpikeDataset b(config);
+    const auto modLines = [](const SpikeDataset &dataset, int tab) {
+        QStringList result;
+        for (const auto &item : *dataset.MakeStashReply(tab).items) {
+            for (const auto &mod : item.explicitMods.value_or(std::vector<poe::ItemMod>{})) {
+                result.push_back(mod.description);
+            }
+        }
+        return result;
+    };
+    QStringList all;
+    for (int t = 0; t < a.tabCount(); ++t) {
+        QCOMPARE(modLines(b, t), modLines(a, t));
+        all += modLines(a, t);
+    }
+    QVERIFY(!all.isEmpty());
+
+    // The dataset's own translations resolve its rolls.
+    InitStatTranslations();
+    AddStatTranslations(SpikeDataset::StatTranslationsJson());
+    InitModList();
+    QVERIFY(modifier_id("Adds # to # Fire Damage to Attacks") != kNoModifier);
+    qsizetype with_table = 0;
+    for (const auto &item : a.allItems()) {
+        with_table += item->mod_table().empty() ? 0 : 1;
+    }
+    QVERIFY(with_table > 0);
+}
+
 QTEST_GUILESS_MAIN(SpikeDatasetTest)
 
 #include "tst_spikedataset.moc"
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include <QImage>
+#include <QtTest/QtTest>
+
+#include <memory>
+
+#include "modelprobes.h"
+#include "testfixtures.h"
+#include "ui/itemtooltiptext.h"
+#include "ui/tooltipcache.h"
+
+// Pins for the detail-pane render cache: an item renders once on the UI
+// thread however often it is shown, a replacement Item with the same uid
+// misses, a delta's uids are dropped, and prewarmed items are ready before
+// they are shown.
+
+namespace {
+
+    std::shared_ptr<Item> makeShared(const char *id)
+    {
+        return std::make_shared<Item>(makeTestItem(id));
+    }
+
+    QImage makeIcon()
+    {
+        QImage image(47, 47, QImage::Format_ARGB32);
+        image.fill(qRgb(40, 40, 40));
+        return image;
+    }
+
+} // namespace
+
+class TooltipCacheTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void repeatedGetsRenderOnce();
+    void replacementItemMisses();
+    void invalidateDropsTheDeltasUids();
+    void prewarmedItemsNeedNoRender();
+    void iconIsComposedOncePerImage();
+};
+
+void TooltipCacheTest::init()
+{
+    ModelProbes::instance().enabled = true;
+    ModelProbes::instance().reset();
+}
+
+void TooltipCacheTest::cleanup()
+{
+    ModelProbes::instance().enabled = false;
+}
+
+void TooltipCacheTest::repeatedGetsRenderOnce()
+{
+    TooltipCache cache;
+    const auto item = makeShared("item-1");
+
+    const ItemTooltipArtifacts first = cache.Get(item);
+    const ItemTooltipArtifacts second = cache.Get(item);
+    QCOMPARE(ModelProbes::instance().tooltip_renders, 1);
+    QCOMPARE(first.properties_html, GenerateItemInfo(*item, "White", true));
+    QCOMPARE(second.text_html, GenerateItemInfo(*item, "White", false));
+}
+
+void TooltipCacheTest::replacementItemMisses()
+{
+    TooltipCache cache;
+    const auto item = makeShared("item-1");
+    cache.Get(item);
+
+    // A refresh builds a new Item for the same uid: a new content version.
+    const auto replacement = makeShared("item-1");
+    QVERIFY(!cache.Contains(replacement));
+    cache.Get(replacement);
+    QCOMPARE(ModelProbes::instance().tooltip_renders, 2);
+}
+
+void TooltipCacheTest::invalidateDropsTheDeltasUids()
+{
+    TooltipCache cache;
+    const auto kept = makeShared("item-1");
+    const auto replaced = makeShared("item-2");
+    cache.Get(kept);
+    cache.Get(replaced);
+
+    cache.Invalidate({makeShared("item-2")});
+    QVERIFY(cache.Contains(kept));
+    QVERIFY(!cache.Contains(replaced));
+}
+
+void TooltipCacheTest::prewarmedItemsNeedNoRender()
+{
+    TooltipCache cache;
+    const Items neighbours{makeShared("item-1"), makeShared("item-2"), makeShared("item-3")};
+
+    cache.Prewarm(neighbours);
+    for (const auto &item : neighbours) {
+        QTRY_VERIFY(cache.Contains(item));
+    }
+    for (const auto &item : neighbours) {
+        cache.Get(item);
+    }
+    QCOMPARE(ModelProbes::instance().tooltip_renders, 0);
+}
+
+void TooltipCacheTest::iconIsComposedOncePerImage()
+{
+    TooltipCache cache;
+    const auto item = makeShared("item-1");
+    const QImage image = makeIcon();
+
+    const QPixmap first = cache.Icon(item, image);
+    const QPixmap second = cache.Icon(item, image);
+    QVERIFY(!first.isNull());
+    QCOMPARE(second.cacheKey(), first.cacheKey());
+
+    // A fresh decode of the image recomposes.
+    const QPixmap third = cache.Icon(item, makeIcon());
+    QVERIFY(third.cacheKey() != first.cacheKey());
+}
+
+QTEST_MAIN(TooltipCacheTest)
+
+#include "tst_tooltipcache.moc"
@@ -13,8 +13,10 @@
 #include "datastore/stashrepo.h"
 #include "datastore/userstore.h"
 #include "poe/types/character.h"
+#include "poe/types/item.h"
 #include "poe/types/stashtab.h"
 #include "testfixtures.h"
+#include "util/binary_items.h"
 #include "util/json_writers.h"
 
 // Pins for the schema migration ladder: the 1 -> 2 step that introduced
@@ -22,7 +24,11 @@
 // check the column exists to serve), and the 2 -> 3 step that repairs
 // databases created by v0.16.0-alpha.2 through alpha.6, whose composite
 // primary keys break the ON CONFLICT(id) upserts and which predate the
-// buyout tables.
+// buyout tables, the 3 -> 4 step that adds the binary item records
+// (stashes.items_data / items_version) beside json_data, the 4 -> 5 step
+// that adds the reply digest and last-changed time the fetch scheduler
+// ranks tabs by (stashes.json_digest / json_changed_at), and the 5 -> 6 step
+// that adds the same two columns to characters.
 //
 // The two versions are deliberately independent: SCHEMA_VERSION describes the
 // table shape and replays forward ('<'), json::PAYLOAD_VERSION describes the
@@ -210,6 +216,18 @@ namespace {
         return tab;
     }
 
+    poe::StashTab makeTabWithItem(const QString &id)
+    {
+        poe::StashTab tab = makeTab(id);
+        poe::Item item{};
+        item.id = "item-" + id;
+        item.typeLine = "Test Item";
+        item.baseType = "Test Item";
+        item.ilvl = 84;
+        tab.items = std::vector<poe::Item>{item};
+        return tab;
+    }
+
 } // namespace
 
 class UserStoreMigrationTest : public QObject
@@ -224,6 +242,10 @@ private slots:
     void aRowFromANewerPayloadVersionIsNotRead();
     void compositeKeyDatabaseIsRebuilt();
     void buyoutRowsSurviveTheRepairStep();
+    void savedItemsReloadFromTheBinaryRecords();
+    void aStaleItemsVersionFallsBackToJson();
+    void changedAtMovesOnlyWhenTheBytesDo();
+    void charactersKeepTheirOwnFetchHistory();
 };
 
 void UserStoreMigrationTest::migratesVersion1ToCurrent()
@@ -237,9 +259,15 @@ void UserStoreMigrationTest::migratesVersion1ToCurrent()
         UserStore store(QDir(dir.path()), kAccount);
     }
 
-    QCOMPARE(readUserVersion(dir), 3);
+    QCOMPARE(readUserVersion(dir), 6);
     QVERIFY(hasColumn(dir, "stashes", "json_version"));
     QVERIFY(hasColumn(dir, "characters", "json_version"));
+    QVERIFY(hasColumn(dir, "stashes", "items_data"));
+    QVERIFY(hasColumn(dir, "stashes", "items_version"));
+    QVERIFY(hasColumn(dir, "stashes", "json_digest"));
+    QVERIFY(hasColumn(dir, "stashes", "json_changed_at"));
+    QVERIFY(hasColumn(dir, "characters", "json_digest"));
+    QVERIFY(hasColumn(dir, "characters", "json_changed_at"));
 
     // A healthy database must ALTER, not reset: dropping the tables here
     // would take the tab and character metadata with it. The 2 -> 3 repair
@@ -287,9 +315,15 @@ void UserStoreMigrationTest::freshDatabaseGetsTheColumnWithoutAnAlter()
         UserStore store(QDir(dir.path()), kAccount);
     }
 
-    QCOMPARE(readUserVersion(dir), 3);
+    QCOMPARE(readUserVersion(dir), 6);
     QVERIFY(hasColumn(dir, "stashes", "json_version"));
     QVERIFY(hasColumn(dir, "characters", "json_version"));
+    QVERIFY(hasColumn(dir, "stashes", "items_data"));
+    QVERIFY(hasColumn(dir, "stashes", "items_version"));
+    QVERIFY(hasColumn(dir, "stashes", "json_digest"));
+    QVERIFY(hasColumn(dir, "stashes", "json_changed_at"));
+    QVERIFY(hasColumn(dir, "characters", "json_digest"));
+    QVERIFY(hasColumn(dir, "characters", "json_changed_at"));
 }
 
 void UserStoreMigrationTest::savedRowsRoundTripAtTheCurrentPayloadVersion()
@@ -355,7 +389,7 @@ void UserStoreMigrationTest::compositeKeyDatabaseIsRebuilt()
     QCOMPARE(readUserVersion(dir), 1);
 
     UserStore store(QDir(dir.path()), kAccount);
-    QCOMPARE(readUserVersion(dir), 3);
+    QCOMPARE(readUserVersion(dir), 6);
 
     // The rebuilt tables must accept the ON CONFLICT(id) upserts, which the
     // composite-key schema rejected at prepare time. Saving the same id twice
@@ -409,7 +443,7 @@ void UserStoreMigrationTest::buyoutRowsSurviveTheRepairStep()
     QSqlDatabase::removeDatabase(connection);
 
     UserStore store(QDir(dir.path()), kAccount);
-    QCOMPARE(readUserVersion(dir), 3);
+    QCOMPARE(readUserVersion(dir), 6);
 
     const auto buyouts = store.buyouts().getItemBuyouts();
     QCOMPARE(buyouts.size(), size_t(1));
@@ -417,5 +451,154 @@ void UserStoreMigrationTest::buyoutRowsSurviveTheRepairStep()
     QCOMPARE(buyouts.at("item-a").value, 5.0);
 }
 
+void UserStoreMigrationTest::savedItemsReloadFromTheBinaryRecords()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    UserStore store(QDir(dir.path()), kAccount);
+    QVERIFY(saveStashFixture(store.stashes(), makeTabWithItem("tab-d"), kRealm, kLeague));
+
+    const auto cached = store.stashes().getCachedStash("tab-d", kRealm, kLeague);
+    QVERIFY(cached.has_value());
+    QVERIFY(cached->binary);
+
+    const auto items = binary::readItems(cached->data);
+    QVERIFY(items.has_value());
+    QCOMPARE(items->size(), size_t(1));
+    QCOMPARE(items->front().id, std::optional<QString>("item-tab-d"));
+    QCOMPARE(items->front().typeLine, QString("Test Item"));
+    QCOMPARE(items->front().ilvl, 84);
+
+    // The records carry no tab fields; they come back from the same row.
+    QVERIFY(cached->tab.has_value());
+    QCOMPARE(cached->tab->id, QString("tab-d"));
+    QCOMPARE(cached->tab->name, QString("Tab tab-d"));
+    QCOMPARE(cached->tab->type, QString("PremiumStash"));
+
+    // A later stash list rewrites the row's tab fields but not its records,
+    // and the cached stash follows the row.
+    poe::StashTab renamed = makeTab("tab-d");
+    renamed.name = "Renamed";
+    QVERIFY(store.stashes().saveStashList({renamed}, kRealm, kLeague));
+    const auto relisted = store.stashes().getCachedStash("tab-d", kRealm, kLeague);
+    QVERIFY(relisted.has_value());
+    QVERIFY(relisted->binary);
+    QCOMPARE(relisted->data, cached->data);
+    QCOMPARE(relisted->tab->name, QString("Renamed"));
+
+    // The wire bytes are still there for everything that is not the
+    // cold-start load.
+    QVERIFY(store.stashes().getStash("tab-d", kRealm, kLeague).has_value());
+}
+
+void UserStoreMigrationTest::aStaleItemsVersionFallsBackToJson()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    {
+        UserStore store(QDir(dir.path()), kAccount);
+        QVERIFY(saveStashFixture(store.stashes(), makeTabWithItem("tab-e"), kRealm, kLeague));
+    }
+
+    // Records from another encoding version are never decoded; the row
+    // still loads, through its JSON.
+    const QString connection = "items-" + QUuid::createUuid().toString(QUuid::WithoutBraces);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connection);
+        db.setDatabaseName(dbPath(dir));
+        QVERIFY(db.open());
+        QSqlQuery q(db);
+        QVERIFY(q.exec(
+            QString("UPDATE stashes SET items_version = %1").arg(binary::ITEMS_VERSION + 1)));
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connection);
+
+    UserStore store(QDir(dir.path()), kAccount);
+    const auto cached = store.stashes().getCachedStash("tab-e", kRealm, kLeague);
+    QVERIFY(cached.has_value());
+    QVERIFY(!cached->binary);
+    QCOMPARE(cached->data, store.stashes().getStashJson("tab-e", kRealm, kLeague).value());
+}
+
+void UserStoreMigrationTest::changedAtMovesOnlyWhenTheBytesDo()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    UserStore store(QDir(dir.path()), kAccount);
+    const poe::StashTab tab = makeTab("tab-f");
+    QVERIFY(saveStashFixture(store.stashes(), tab, kRealm, kLeague));
+
+    auto history = store.stashes().getFetchHistory(kRealm, kLeague);
+    QCOMPARE(history.size(), size_t(1));
+    const auto first = history.front();
+    QCOMPARE(first.id, QString("tab-f"));
+    QVERIFY(!first.digest.isEmpty());
+    QVERIFY(first.changed_at.isValid());
+    QCOMPARE(first.changed_at, first.fetched_at);
+
+    // The same bytes again: fetched, but not changed.
+    QTest::qWait(20);
+    QVERIFY(saveStashFixture(store.stashes(), tab, kRealm, kLeague));
+    history = store.stashes().getFetchHistory(kRealm, kLeague);
+    QCOMPARE(history.front().digest, first.digest);
+    QCOMPARE(history.front().changed_at, first.changed_at);
+    QVERIFY(history.front().fetched_at > first.fetched_at);
+
+    // New bytes move the digest and the change time with them.
+    QTest::qWait(20);
+    QVERIFY(saveStashFixture(store.stashes(), makeTabWithItem("tab-f"), kRealm, kLeague));
+    history = store.stashes().getFetchHistory(kRealm, kLeague);
+    QVERIFY(history.front().digest != first.digest);
+    QVERIFY(history.front().changed_at > first.changed_at);
+    QCOMPARE(history.front().changed_at, history.front().fetched_at);
+}
+
+void UserStoreMigrationTest::charactersKeepTheirOwnFetchHistory()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    UserStore store(QDir(dir.path()), kAccount);
+    poe::Character character;
+    character.id = "char-g";
+    character.name = "Gina";
+    character.realm = kRealm;
+    character.league = kLeague;
+    character.level = 89;
+    QVERIFY(store.characters().saveCharacterList({character}));
+
+    // Listed but never fetched: nothing to seed from.
+    QVERIFY(store.characters().getFetchHistory(kRealm, kLeague).empty());
+
+    QVERIFY(saveCharacterFixture(store.characters(), character));
+    auto history = store.characters().getFetchHistory(kRealm, kLeague);
+    QCOMPARE(history.size(), size_t(1));
+    const auto first = history.front();
+    QCOMPARE(first.id, QString("char-g"));
+    QVERIFY(!first.digest.isEmpty());
+    QCOMPARE(first.changed_at, first.fetched_at);
+
+    QTest::qWait(20);
+    QVERIFY(saveCharacterFixture(store.characters(), character));
+    history = store.characters().getFetchHistory(kRealm, kLeague);
+    QCOMPARE(history.front().digest, first.digest);
+    QCOMPARE(history.front().changed_at, first.changed_at);
+    QVERIFY(history.front().fetched_at > first.fetched_at);
+
+    QTest::qWait(20);
+    character.level = 90;
+    QVERIFY(saveCharacterFixture(store.characters(), character));
+    history = store.characters().getFetchHistory(kRealm, kLeague);
+    QVERIFY(history.front().digest != first.digest);
+    QCOMPARE(history.front().changed_at, history.front().fetched_at);
+
+    // Characters in another league are not this league's history.
+    QVERIFY(store.characters().getFetchHistory(kRealm, "Hardcore").empty());
+}
+
 QTEST_MAIN(UserStoreMigrationTest)
 #include "tst_userstoremigration.moc"
@@ -13,6 +13,7 @@
 #include "testfixtures.h"
 #include "util/glaze_qt.h" // IWYU pragma: keep
 #include "util/networkmanager.h"
+#include "util/stringpool.h"
 
 class WorkerParseTest : public QObject
 {
@@ -21,6 +22,9 @@ class WorkerParseTest : public QObject
 private slots:
     void parsesCachedStashItems();
     void specialChildItemsKeyedByChildFetchId();
+    void decodesEscapedJsonStrings();
+    void internHookSharesPooledStrings();
+    void utf8IndexIsBounded();
 };
 
 static poe::Item makePoeItem(const char *id)
@@ -154,6 +158,94 @@ void WorkerParseTest::specialChildItemsKeyedByChildFetchId()
     QCOMPARE(result.items[0]->location().fetch_id(), child.id);
 }
 
+// The QString reader decodes escapes in place rather than through a
+// std::string; every JSON escape must come out as it did before, including
+// a surrogate pair spelled as two \u escapes.
+void WorkerParseTest::decodesEscapedJsonStrings()
+{
+    const std::string_view input = R"([
+        "plain",
+        "caf\u00e9 \"quoted\" \\ \/",
+        "tab\there\nnext\r\b\f",
+        "\ud83d\uDE00 ok",
+        "Ær\u00f8 \u00C6",
+        ""
+    ])";
+    std::vector<QString> values;
+    const auto err = glz::read_json(values, input);
+    QVERIFY2(!err, glz::format_error(err, input).c_str());
+    QCOMPARE(values.size(), size_t(6));
+    QCOMPARE(values[0], QString("plain"));
+    QCOMPARE(values[1], QString::fromUtf8("café \"quoted\" \\ /"));
+    QCOMPARE(values[2], QString("tab\there\nnext\r\b\f"));
+    QCOMPARE(values[3], QString::fromUtf8("\xF0\x9F\x98\x80 ok"));
+    QCOMPARE(values[4], QString::fromUtf8("Ærø Æ"));
+    QVERIFY(values[5].isEmpty());
+
+    QString value;
+    QVERIFY(glz::read_json(value, std::string_view(R"("bad \q escape")")));
+    QVERIFY(glz::read_json(value, std::string_view(R"("short \u12")")));
+    QVERIFY(glz::read_json(value, std::string_view(R"("unterminated)")));
+
+    // Raw control characters are malformed JSON, hook or no hook.
+    QVERIFY(glz::read_json(value, std::string_view("\"raw\ttab\"")));
+    QVERIFY(glz::read_json(value, std::string_view("\"raw\nline \\n\"")));
+    const glaze_qt::ScopedInternHook intern(&StringPool::FindUtf8);
+    QVERIFY(glz::read_json(value, std::string_view("\"raw\ttab\"")));
+}
+
+// With the intern hook installed, a string the pool already holds comes back
+// sharing the pooled buffer; anything else is decoded and never pooled.
+void WorkerParseTest::internHookSharesPooledStrings()
+{
+    const QString pooled = StringPool::Intern(QString::fromUtf8("Worker Parse Régalia"));
+    const size_t pool_size = StringPool::size();
+
+    std::vector<QString> values;
+    {
+        const glaze_qt::ScopedInternHook intern(&StringPool::FindUtf8);
+        const std::string_view input = R"(["Worker Parse Régalia", "worker-parse-id"])";
+        QVERIFY(!glz::read_json(values, input));
+    }
+    QCOMPARE(values.size(), size_t(2));
+    QCOMPARE(values[0], pooled);
+    QCOMPARE(values[0].constData(), pooled.constData());
+    QCOMPARE(values[1], QString("worker-parse-id"));
+    QCOMPARE(StringPool::size(), pool_size);
+
+    // Without the hook the same bytes decode into a fresh buffer.
+    QString fresh;
+    QVERIFY(!glz::read_json(fresh, std::string_view(R"("Worker Parse Régalia")")));
+    QCOMPARE(fresh, pooled);
+    QVERIFY(fresh.constData() != pooled.constData());
+}
+
+// The UTF-8 index keeps a second copy of each string it indexes, so it
+// stops growing at its capacity; the pool itself still interns. Filled in
+// a pool of its own, so the process-wide one the other tests use is left
+// as it was.
+void WorkerParseTest::utf8IndexIsBounded()
+{
+    StringPool::Pool pool;
+    QString first;
+    QString last;
+    for (size_t n = 0; n <= StringPool::kUtf8IndexCapacity; ++n) {
+        last = pool.Intern(QString("utf8-bound-%1").arg(n));
+        if (n == 0) {
+            first = last;
+        }
+    }
+    QCOMPARE(pool.size(), StringPool::kUtf8IndexCapacity + 1);
+    const QByteArray first_bytes = first.toUtf8();
+    QCOMPARE(pool.FindUtf8(std::string_view(first_bytes.constData(), first_bytes.size()))
+                 .constData(),
+             first.constData());
+    const QByteArray bytes = last.toUtf8();
+    QVERIFY(pool.FindUtf8(std::string_view(bytes.constData(), bytes.size())).isNull());
+    QCOMPARE(pool.Intern(last).constData(), last.constData());
+    QVERIFY(StringPool::FindUtf8(std::string_view(bytes.constData(), bytes.size())).isNull());
+}
+
 QTEST_GUILESS_MAIN(WorkerParseTest)
 
 #include "tst_workerparse.moc"
@@ -81,6 +81,8 @@ private slots:
     void readyChildErrorStillLaunchesTheRestAndParentStaysRetryable();  // W-INIT (child error)
     void failureKeepsProgressMonotonicWithOneTerminalTransition();      // P-STATUS / P-FAILURE
     void tabsOnlyRequestsBothListsButNoContent();                       // P-SELECTION (TabsOnly)
+    void quickRefreshFetchesTheLikeliestChangedTabs();                  // P-SELECTION (Quick)
+    void quickRefreshRanksCachedCharactersByTheirHistory();             // P-SELECTION (Quick)
 
     // Phase 5D — identity replacement proof (verification §5). The generation
     // guard is gone, so the update token is the sole identity: a successful
@@ -127,6 +129,18 @@ private slots:
     void parseFailureSkipsTabAndUpdateCompletes();
     void missingStashWrapperSkipsTab();
     void missingCharacterWrapperSkipsTab();
+
+    // Content replies above the pool threshold build their Items off the
+    // worker's thread and are still applied in reply order.
+    void poolParsedRepliesApplyInReplyOrder();
+
+    // A stash reply byte-identical to the one its held items were built
+    // from is not rebuilt, re-emitted, or rewritten.
+    void unchangedStashReplySkipsTheRebuild();
+
+    // While the write-behind store is backlogged, finished replies wait
+    // unhandled (and unpersisted) until it drains.
+    void backloggedStoreHoldsRepliesUntilItDrains();
 };
 
 namespace {
@@ -743,6 +757,10 @@ namespace {
                          stashes,
                          &StashRepo::saveStashList);
         QObject::connect(worker, &ItemsManagerWorker::stashReceived, stashes, &StashRepo::saveStash);
+        QObject::connect(worker,
+                         &ItemsManagerWorker::stashUnchanged,
+                         stashes,
+                         &StashRepo::touchStash);
         QObject::connect(worker,
                          &ItemsManagerWorker::characterListReceived,
                          characters,
@@ -1415,9 +1433,9 @@ void WorkerUpdateTest::fakeSettlesStoppedStragglersCanceledExactlyOnce()
     // Two stopped stragglers from an aborted update and one live call from the
     // next. The returned futures are retained so the settlement outcome — not
     // just the counts — is pinned.
-    auto fa = api.getStash(kRealm, kLeague, "A", {}, dead_a.get_token());
+    auto fa = api.getStash(kRealm, kLeague, "A", {}, {}, dead_a.get_token());
     auto fbob = api.getCharacter(kRealm, "Bob", dead_bob.get_token());
-    auto fc = api.getStash(kRealm, kLeague, "C", {}, live.get_token());
+    auto fc = api.getStash(kRealm, kLeague, "C", {}, {}, live.get_token());
 
     QCOMPARE(api.callCount(), size_t(3));
     QCOMPARE(api.pendingCount(), size_t(3));
@@ -1480,8 +1498,8 @@ void WorkerUpdateTest::fakeTreatsCrossUpdateIdentityOverlapAsLive()
 
     // Both fetch stash "X": the first is an aborted update's straggler, the
     // second the new update's live request. Futures retained to pin outcomes.
-    auto f_straggler = api.getStash(kRealm, kLeague, "X", {}, dead.get_token());
-    auto f_live = api.getStash(kRealm, kLeague, "X", {}, live.get_token());
+    auto f_straggler = api.getStash(kRealm, kLeague, "X", {}, {}, dead.get_token());
+    auto f_live = api.getStash(kRealm, kLeague, "X", {}, {}, live.get_token());
     QCOMPARE(api.pendingCount(), size_t(2));
 
     // Exactly one *deliverable* "X" exists, so the finder does not qFatal as an
@@ -1868,7 +1886,8 @@ void WorkerUpdateTest::stagedBatchesRunConcurrentlyPreservingLaneOrder()
 
     // W-F56-ORDER: within the stash lane the launch order is the list's source
     // traversal order (folder children immediately after their folder), NOT the
-    // ids' sorted order — s_zzz1 sorts last but launched first. Addressed by the
+    // ids' sorted order — s_zzz1 sorts last but launched first. Nothing here
+    // has a change history, so the fetch scheduler's stable ranking keeps it. Addressed by the
     // lane's own submission order, never a global call index.
     QCOMPARE(f.api.stashFetchOrder(),
              QStringList({"s_zzz1", "s_aaa1", "fold01", "fchild1", "fchild2", "map01"}));
@@ -2369,6 +2388,108 @@ void WorkerUpdateTest::tabsOnlyRequestsBothListsButNoContent()
     QCOMPARE(sortedItemIds(f.last_items), QStringList({"a1", "c1"}));
 }
 
+// A quick refresh lists everything but fetches only the head of the ranked
+// batch: a tab the cache has never seen, then the currency tab ahead of
+// plain tabs with the same history. A full refresh afterwards still fetches
+// every tab.
+void WorkerUpdateTest::quickRefreshFetchesTheLikeliestChangedTabs()
+{
+    WorkerFixture f("quickrefresh");
+    f.settings.setValue("quick_refresh_tabs", 2);
+
+    const auto plain_1 = json::readStash(stashJson("plain00001", "Plain 1", 0, QStringList{"p1"}));
+    const auto plain_2 = json::readStash(stashJson("plain00002", "Plain 2", 1, QStringList{"p2"}));
+    const auto currency = json::readStash(
+        stashJson("curr000001", "Currency", 2, QStringList{"c1"}, "CurrencyStash"));
+    const auto fresh = json::readStash(stashJson("new0000001", "New Tab", 3));
+    QVERIFY(plain_1 && plain_2 && currency && fresh);
+    {
+        UserStore store(QDir(f.dataDir()), "quickrefresh");
+        QVERIFY(store.stashes().saveStashList({*plain_1, *plain_2, *currency, *fresh},
+                                              kRealm,
+                                              kLeague));
+        QVERIFY(saveStashFixture(store.stashes(), *plain_1, kRealm, kLeague));
+        QVERIFY(saveStashFixture(store.stashes(), *plain_2, kRealm, kLeague));
+        QVERIFY(saveStashFixture(store.stashes(), *currency, kRealm, kLeague));
+        // The new tab: listed, never fetched.
+    }
+
+    f.start();
+    QTRY_COMPARE_WITH_TIMEOUT(f.refresh_count, 1, 10000);
+
+    const std::vector<poe::StashTab> stash_list = stashList(
+        {stashJson("plain00001", "Plain 1", 0),
+         stashJson("plain00002", "Plain 2", 1),
+         stashJson("curr000001", "Currency", 2, {}, "CurrencyStash"),
+         stashJson("new0000001", "New Tab", 3)});
+    const QByteArray currency_reply
+        = stashJson("curr000001", "Currency", 2, QStringList{"c2"}, "CurrencyStash");
+
+    f.worker->Update(TabSelection::Quick);
+    QCOMPARE(f.callCount(), size_t(2));
+    f.deliverStashList(stash_list);
+    QCOMPARE(f.callCount(), size_t(4));
+    QCOMPARE(f.api.stashFetchOrder(), QStringList({"new0000001", "curr000001"}));
+    f.deliverCharacterList({});
+    f.deliverStash("new0000001", stashOf(stashJson("new0000001", "New Tab", 3, QStringList{"n1"})));
+    f.deliverStash("curr000001", stashOf(currency_reply));
+    QCOMPARE(f.refresh_count, 2);
+    // The unfetched tabs keep their cached items.
+    QCOMPARE(sortedItemIds(f.last_items), QStringList({"c2", "n1", "p1", "p2"}));
+
+    // A full refresh covers every tab, ranked or not.
+    f.worker->Update(TabSelection::All);
+    f.deliverStashList(stash_list);
+    QCOMPARE(f.callCount(), size_t(10));
+    QVERIFY(f.hasPendingStash("plain00001"));
+    QVERIFY(f.hasPendingStash("plain00002"));
+    QVERIFY(f.hasPendingStash("curr000001"));
+    QVERIFY(f.hasPendingStash("new0000001"));
+    f.deliverCharacterList({});
+    f.deliverStash("plain00001", stashOf(stashJson("plain00001", "Plain 1", 0, QStringList{"p1"})));
+    f.deliverStash("plain00002", stashOf(stashJson("plain00002", "Plain 2", 1, QStringList{"p2"})));
+    f.deliverStash("curr000001", stashOf(currency_reply));
+    f.deliverStash("new0000001", stashOf(stashJson("new0000001", "New Tab", 3, QStringList{"n1"})));
+    QCOMPARE(f.refresh_count, 3);
+}
+
+// Characters are seeded from their own rows at startup like stashes: a
+// cached character ranks by its history, behind one that was only listed,
+// instead of every character ranking as never fetched after a restart.
+void WorkerUpdateTest::quickRefreshRanksCachedCharactersByTheirHistory()
+{
+    WorkerFixture f("quickcharacters");
+    f.settings.setValue("quick_refresh_tabs", 1);
+
+    const auto char_1 = json::readCharacter(
+        characterJson("charid0001", "CharOne", QStringList{"c1-item"}));
+    const auto char_2 = json::readCharacter(
+        characterJson("charid0002", "CharTwo", QStringList{"c2-item"}));
+    const auto char_new = json::readCharacter(characterJson("charid0003", "CharNew"));
+    QVERIFY(char_1 && char_2 && char_new);
+    {
+        UserStore store(QDir(f.dataDir()), "quickcharacters");
+        QVERIFY(store.characters().saveCharacterList({*char_1, *char_2, *char_new}));
+        QVERIFY(saveCharacterFixture(store.characters(), *char_1));
+        QVERIFY(saveCharacterFixture(store.characters(), *char_2));
+        // CharNew: listed, never fetched.
+    }
+
+    f.start();
+    QTRY_COMPARE_WITH_TIMEOUT(f.refresh_count, 1, 10000);
+
+    f.worker->Update(TabSelection::Quick);
+    QCOMPARE(f.callCount(), size_t(2));
+    f.deliverStashList({});
+    f.deliverCharacterList(characterList({characterJson("charid0001", "CharOne"),
+                                          characterJson("charid0002", "CharTwo"),
+                                          characterJson("charid0003", "CharNew")}));
+    QCOMPARE(f.callCount(), size_t(3));
+    QVERIFY(f.hasPendingCharacter("CharNew"));
+    QVERIFY(!f.hasPendingCharacter("CharOne"));
+    QVERIFY(!f.hasPendingCharacter("CharTwo"));
+}
+
 // W-IDENTITY (verification §5): with the generation guard deleted, the update
 // token is the update's SOLE identity. A failed update stops its token and goes
 // idle immediately, leaving an in-flight sibling as a straggler that still owes
@@ -2784,9 +2905,10 @@ void WorkerUpdateTest::appliedReplySurvivesLaterFailureInMemoryAndDatastore()
     QCOMPARE(sortedItemIds(f.last_items), QStringList({"a-applied", "b-old"}));
 }
 
-// M2 D3 (stage 1, worker half): every accepted content reply emits exactly one
-// primary TabRefreshed whose key is the reply's FetchSourceKey and whose items
-// are exactly the applied replacement, sharing the worker's shared_ptrs —
+// M2 D3 (stage 1, worker half): every accepted content reply that changed its
+// source (see unchangedStashReplySkipsTheRebuild) emits exactly one primary
+// TabRefreshed whose key is the reply's FetchSourceKey and whose items are
+// exactly the applied replacement, sharing the worker's shared_ptrs —
 // after the atomic replace, before the counter increment, and before the
 // terminal emit. A top-level stash reply is followed by exactly one
 // ChildrenReconciled, in that order; character replies emit none. The cached
@@ -3577,6 +3699,149 @@ void WorkerUpdateTest::missingCharacterWrapperSkipsTab()
     QVERIFY(f.status_updates.back().message.contains("1 skipped"));
 }
 
+void WorkerUpdateTest::poolParsedRepliesApplyInReplyOrder()
+{
+    WorkerFixture f("pool-parse");
+    f.start();
+    QTRY_COMPARE_WITH_TIMEOUT(f.refresh_count, 1, 10000);
+    f.access().setPoolParseMinItems(2);
+
+    f.worker->Update(TabSelection::All);
+    f.deliverStashList(stashList({stashJson("stashaaaa1", "Tab A", 0),
+                                  stashJson("stashbbbb1", "Tab B", 1),
+                                  stashJson("stashcccc1", "Tab C", 2)}));
+    f.deliverCharacterList({});
+
+    // A goes to the pool, B builds inline, C goes to the pool. All three
+    // resume before any is drained, so B's handler is ready while A may
+    // still be parsing: it must wait its turn.
+    f.api.resolveStash(f.api.pendingStash("stashaaaa1"),
+                       stashOf(stashJson("stashaaaa1", "Tab A", 0, QStringList{"a1", "a2", "a3"})));
+    f.api.resolveStash(f.api.pendingStash("stashbbbb1"),
+                       stashOf(stashJson("stashbbbb1", "Tab B", 1, QStringList{"b1"})));
+    f.api.resolveStash(f.api.pendingStash("stashcccc1"),
+                       stashOf(stashJson("stashcccc1", "Tab C", 2, QStringList{"c1", "c2"})));
+    QTRY_COMPARE_WITH_TIMEOUT(f.refresh_count, 2, 10000);
+    QVERIFY(WorkerFixture::drainUntilIdle());
+
+    QCOMPARE(f.deltas.size(), size_t(3));
+    QCOMPARE(f.deltas[0].location.id(), QString("stashaaaa1"));
+    QCOMPARE(f.deltas[1].location.id(), QString("stashbbbb1"));
+    QCOMPARE(f.deltas[2].location.id(), QString("stashcccc1"));
+    QCOMPARE(f.deltas[0].items.size(), size_t(3));
+    QCOMPARE(f.deltas[2].items.size(), size_t(2));
+    QCOMPARE(f.deltas[0].items[0]->location().fetch_id(), QString("stashaaaa1"));
+
+    // Each delta still lands between the replace and its counter increment.
+    QCOMPARE(f.deltas[0].counters_at_emit.stashes_received, size_t(0));
+    QCOMPARE(f.deltas[1].counters_at_emit.stashes_received, size_t(1));
+    QCOMPARE(f.deltas[2].counters_at_emit.stashes_received, size_t(2));
+
+    QCOMPARE(f.terminals.size(), size_t(1));
+    QVERIFY(std::holds_alternative<CompletedRefresh>(f.terminals[0].outcome));
+    QCOMPARE(sortedItemIds(f.last_items), QStringList({"a1", "a2", "a3", "b1", "c1", "c2"}));
+}
+
+// A reply whose bytes match the source's cached ones emits no delta and no
+// stashReceived, only stashUnchanged (which touches the row), and is still
+// counted and reconciled. A tab whose items were dropped forgets its digest,
+// so when it comes back its identical reply is rebuilt, not skipped.
+void WorkerUpdateTest::unchangedStashReplySkipsTheRebuild()
+{
+    WorkerFixture f("unchanged-reply");
+
+    const auto tab_a = json::readStash(stashJson("stashaaaa1", "Tab A", 0, QStringList{"a1"}));
+    const auto tab_b = json::readStash(stashJson("stashbbbb1", "Tab B", 1, QStringList{"b1"}));
+    QVERIFY(tab_a && tab_b);
+    {
+        UserStore store(QDir(f.dataDir()), "unchanged-reply");
+        QVERIFY(store.stashes().saveStashList({*tab_a, *tab_b}, kRealm, kLeague));
+        QVERIFY(saveStashFixture(store.stashes(), *tab_a, kRealm, kLeague));
+        QVERIFY(saveStashFixture(store.stashes(), *tab_b, kRealm, kLeague));
+    }
+
+    f.start();
+    f.attachManager();
+    QTRY_COMPARE_WITH_TIMEOUT(f.refresh_count, 1, 10000);
+
+    UserStore store(QDir(f.dataDir()), "unchanged-reply");
+    connectPersistence(f.worker.get(), store);
+    QSignalSpy saved(f.worker.get(), &ItemsManagerWorker::stashReceived);
+    QSignalSpy unchanged(f.worker.get(), &ItemsManagerWorker::stashUnchanged);
+
+    const std::vector<poe::StashTab> both = stashList(
+        {stashJson("stashaaaa1", "Tab A", 0), stashJson("stashbbbb1", "Tab B", 1)});
+    const QByteArray reply_a = stashJson("stashaaaa1", "Tab A", 0, QStringList{"a1"});
+
+    f.worker->Update(TabSelection::All);
+    f.deliverStashList(both);
+    f.deliverCharacterList({});
+    // The fetch is launched with the cached digest, so the facade can skip
+    // the reply's items before parsing them.
+    QCOMPARE(f.api.call(f.api.pendingStash("stashaaaa1")).known_digest,
+             Util::ContentDigest(json::writeStash(*tab_a)));
+    f.deliverStash("stashaaaa1", stashOf(reply_a));
+    QCOMPARE(f.deltas.size(), size_t(0));
+    QCOMPARE(f.reconciles.size(), size_t(1));
+    QCOMPARE(saved.count(), 0);
+    QCOMPARE(unchanged.count(), 1);
+    QCOMPARE(unchanged.at(0).at(0).toString(), QString("stashaaaa1"));
+
+    f.deliverStash("stashbbbb1",
+                   stashOf(stashJson("stashbbbb1", "Tab B", 1, QStringList{"b2"})));
+    QCOMPARE(f.deltas.size(), size_t(1));
+    QCOMPARE(saved.count(), 1);
+    QCOMPARE(f.refresh_count, 2);
+    QCOMPARE(sortedItemIds(f.last_items), QStringList({"a1", "b2"}));
+    QCOMPARE(sortedItemIds(f.manager->items()), QStringList({"a1", "b2"}));
+    // The touched row still reloads as it was.
+    QVERIFY(store.stashes().getCachedStash("stashaaaa1", kRealm, kLeague).has_value());
+
+    // Tab A drops out of the list, taking its items with it...
+    f.worker->Update(TabSelection::All);
+    f.deliverStashList(stashList({stashJson("stashbbbb1", "Tab B", 1)}));
+    f.deliverCharacterList({});
+    f.deliverStash("stashbbbb1",
+                   stashOf(stashJson("stashbbbb1", "Tab B", 1, QStringList{"b2"})));
+    QCOMPARE(f.refresh_count, 3);
+    QCOMPARE(sortedItemIds(f.last_items), QStringList({"b2"}));
+
+    // ...so its identical reply, when it is listed again, is rebuilt.
+    f.worker->Update(TabSelection::All);
+    f.deliverStashList(both);
+    f.deliverCharacterList({});
+    f.deliverStash("stashaaaa1", stashOf(reply_a));
+    QCOMPARE(f.deltas.size(), size_t(2));
+    QCOMPARE(f.deltas.back().location.fetch_id(), QString("stashaaaa1"));
+    f.deliverStash("stashbbbb1",
+                   stashOf(stashJson("stashbbbb1", "Tab B", 1, QStringList{"b2"})));
+    QCOMPARE(f.refresh_count, 4);
+    QCOMPARE(sortedItemIds(f.last_items), QStringList({"a1", "b2"}));
+}
+
+void WorkerUpdateTest::backloggedStoreHoldsRepliesUntilItDrains()
+{
+    WorkerFixture f("backlogged-store");
+    f.start();
+    QTRY_COMPARE_WITH_TIMEOUT(f.refresh_count, 1, 10000);
+    QSignalSpy saved(f.worker.get(), &ItemsManagerWorker::stashReceived);
+
+    f.worker->OnStoreBacklog(true);
+    f.worker->Update(TabSelection::All);
+    f.deliverStashList(stashList({stashJson("stashaaaa1", "Tab A", 0)}));
+    f.deliverCharacterList({});
+    f.deliverStash("stashaaaa1", stashOf(stashJson("stashaaaa1", "Tab A", 0, QStringList{"a1"})));
+    QCOMPARE(saved.count(), 0);
+    QCOMPARE(f.deltas.size(), size_t(0));
+    QCOMPARE(f.refresh_count, 1);
+
+    f.worker->OnStoreBacklog(false);
+    QCOMPARE(saved.count(), 1);
+    QCOMPARE(f.deltas.size(), size_t(1));
+    QCOMPARE(f.refresh_count, 2);
+    QCOMPARE(sortedItemIds(f.last_items), QStringList({"a1"}));
+}
+
 QTEST_GUILESS_MAIN(WorkerUpdateTest)
 
 #include "tst_workerupdate.moc"
@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2026 Tom Holz
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <chrono>
+
+#include "datastore/stashrepo.h"
+#include "datastore/userstore.h"
+#include "datastore/writebehindstore.h"
+#include "poe/types/stashtab.h"
+#include "util/json_writers.h"
+#include "util/util.h"
+
+// Pins for the write-behind persistence queue: writes are grouped into
+// transactions on the writer's own connection, become visible to other
+// connections once committed, keep their emission order (a reconcile never
+// overtakes the saves before it), and are never lost to shutdown, to the
+// back-pressure bound, or to another connection holding the write lock —
+// and that a group the database keeps refusing is dropped rather than
+// wedging the queue.
+
+namespace {
+
+    constexpr const char *kRealm = "pc";
+    constexpr const char *kLeague = "Standard";
+    constexpr const char *kAccount = "TESTER#1234";
+
+    poe::StashTab makeTab(const QString &id, const std::optional<QString> &parent = {})
+    {
+        poe::StashTab tab;
+        tab.id = id;
+        tab.name = "Tab " + id;
+        tab.type = "PremiumStash";
+        tab.parent = parent;
+        return tab;
+    }
+
+    poe::StashTab makeMapStash(const QString &id)
+    {
+        poe::StashTab tab = makeTab(id);
+        tab.type = "MapStash";
+        return tab;
+    }
+
+    // A writer that commits only when asked to, or on a full group.
+    WriteBehindStore::Config holding(size_t max_batch = 64)
+    {
+        WriteBehindStore::Config config;
+        config.max_batch = max_batch;
+        config.max_delay = std::chrono::hours(1);
+        return config;
+    }
+
+    void save(WriteBehindStore &writer, const poe::StashTab &tab)
+    {
+        const QByteArray bytes = json::writeStash(tab);
+        writer.saveStash(tab, bytes, Util::ContentDigest(bytes), kRealm, kLeague);
+    }
+
+    bool isCached(const QTemporaryDir &dir, const QString &id)
+    {
+        UserStore store(QDir(dir.path()), kAccount);
+        return store.stashes().getCachedStash(id, kRealm, kLeague).has_value();
+    }
+
+    bool isListed(const QTemporaryDir &dir, const QString &id)
+    {
+        UserStore store(QDir(dir.path()), kAccount);
+        for (const auto &tab : store.stashes().getStashList(kRealm, kLeague)) {
+            if (tab.id == id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace
+
+class WriteBehindStoreTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void groupsWritesIntoOneTransaction();
+    void commitsOnTheDelayWithoutAFlush();
+    void reconcilesRunAfterTheSavesBeforeThem();
+    void destructionCommitsWhatIsQueued();
+    void backPressureLosesNothing();
+    void busyGroupIsRetriedWhole();
+    void refusedGroupIsDroppedAndReleasesTheProducer();
+    void busyGroupIsDroppedAfterItsAttempts();
+};
+
+void WriteBehindStoreTest::groupsWritesIntoOneTransaction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    WriteBehindStore writer(QDir(dir.path()), kAccount, holding());
+    writer.saveStashList({makeTab("tab-a"), makeTab("tab-b"), makeTab("tab-c")}, kRealm, kLeague);
+    save(writer, makeTab("tab-a"));
+    save(writer, makeTab("tab-b"));
+    save(writer, makeTab("tab-c"));
+
+    // Nothing commits until the delay (an hour here) or a flush.
+    QCOMPARE(writer.committedBatches(), std::uint64_t(0));
+    QVERIFY(!isListed(dir, "tab-a"));
+
+    writer.flush();
+    QCOMPARE(writer.committedBatches(), std::uint64_t(1));
+    QVERIFY(isCached(dir, "tab-a"));
+    QVERIFY(isCached(dir, "tab-b"));
+    QVERIFY(isCached(dir, "tab-c"));
+}
+
+void WriteBehindStoreTest::commitsOnTheDelayWithoutAFlush()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    WriteBehindStore::Config config;
+    config.max_delay = std::chrono::milliseconds(20);
+    WriteBehindStore writer(QDir(dir.path()), kAccount, config);
+    writer.saveStashList({makeTab("tab-a")}, kRealm, kLeague);
+    save(writer, makeTab("tab-a"));
+
+    QTRY_COMPARE(writer.committedBatches(), std::uint64_t(1));
+    QVERIFY(isCached(dir, "tab-a"));
+}
+
+// The worker emits a parent's child saves before the parent's children
+// reconcile, and a list's saves before its list reconcile; grouped or not,
+// the deletes must see those rows.
+void WriteBehindStoreTest::reconcilesRunAfterTheSavesBeforeThem()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    WriteBehindStore writer(QDir(dir.path()), kAccount, holding(2));
+    writer.saveStashList({makeMapStash("parent"), makeTab("gone")}, kRealm, kLeague);
+    save(writer, makeTab("child-keep", QString("parent")));
+    save(writer, makeTab("child-drop", QString("parent")));
+    writer.reconcileStashChildren("parent", {"child-keep"}, kRealm, kLeague);
+    writer.reconcileStashList({makeMapStash("parent")}, kRealm, kLeague);
+    writer.flush();
+
+    // Five writes at two per group.
+    QCOMPARE(writer.committedBatches(), std::uint64_t(3));
+    QVERIFY(isListed(dir, "parent"));
+    QVERIFY(!isListed(dir, "gone"));
+    QVERIFY(isCached(dir, "child-keep"));
+    QVERIFY(!isListed(dir, "child-drop"));
+}
+
+void WriteBehindStoreTest::destructionCommitsWhatIsQueued()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    {
+        WriteBehindStore writer(QDir(dir.path()), kAccount, holding());
+        writer.saveStashList({makeTab("tab-a")}, kRealm, kLeague);
+        save(writer, makeTab("tab-a"));
+    }
+    QVERIFY(isCached(dir, "tab-a"));
+}
+
+// A bound smaller than one reply backlogs the writer on the first save.
+// The saves still return at once, the producer is told to pause and then
+// to resume, and every write lands.
+void WriteBehindStoreTest::backPressureLosesNothing()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    WriteBehindStore::Config config = holding();
+    config.max_queued_bytes = 1;
+    WriteBehindStore writer(QDir(dir.path()), kAccount, config);
+    QSignalSpy backlog(&writer, &WriteBehindStore::backlogChanged);
+    std::vector<poe::StashTab> tabs;
+    for (int n = 0; n < 5; ++n) {
+        tabs.push_back(makeTab(QString("tab-%1").arg(n)));
+    }
+    writer.saveStashList(tabs, kRealm, kLeague);
+    for (const auto &tab : tabs) {
+        save(writer, tab);
+    }
+    writer.flush();
+
+    for (const auto &tab : tabs) {
+        QVERIFY(isCached(dir, tab.id));
+    }
+    QTRY_VERIFY(backlog.count() >= 2);
+    QCOMPARE(backlog.first().at(0).toBool(), true);
+    QTRY_COMPARE(backlog.last().at(0).toBool(), false);
+}
+
+// Another connection's write transaction (a pricing pass's buyout batch)
+// outlasts the writer's busy_timeout: the group is retried until the lock
+// is released, and nothing is dropped.
+void WriteBehindStoreTest::busyGroupIsRetriedWhole()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    UserStore other(QDir(dir.path()), kAccount);
+    WriteBehindStore::Config config = holding();
+    config.busy_timeout = std::chrono::milliseconds(20);
+    config.retry_backoff = std::chrono::milliseconds(20);
+    WriteBehindStore writer(QDir(dir.path()), kAccount, config);
+
+    QVERIFY(other.transaction());
+    writer.saveStashList({makeTab("tab-a")}, kRealm, kLeague);
+    save(writer, makeTab("tab-a"));
+    writer.commitNow();
+    QTest::qWait(200);
+    QCOMPARE(writer.committedBatches(), std::uint64_t(0));
+
+    QVERIFY(other.commit());
+    writer.flush();
+    QCOMPARE(writer.committedBatches(), std::uint64_t(1));
+    QVERIFY(isCached(dir, "tab-a"));
+}
+
+// A directory where the database file belongs: every group fails, and not
+// because another connection holds the lock. Waiting cannot fix that, so
+// the group is dropped at once, flush() returns, and the backlog it raised
+// is cleared so the worker resumes its replies.
+void WriteBehindStoreTest::refusedGroupIsDroppedAndReleasesTheProducer()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(QDir(dir.path()).mkpath(QString("userstore-%1.db").arg(kAccount)));
+
+    WriteBehindStore::Config config = holding();
+    config.max_queued_bytes = 1;
+    config.retry_backoff = std::chrono::hours(1);
+    WriteBehindStore writer(QDir(dir.path()), kAccount, config);
+    QSignalSpy backlog(&writer, &WriteBehindStore::backlogChanged);
+    writer.saveStashList({makeTab("tab-a")}, kRealm, kLeague);
+    save(writer, makeTab("tab-a"));
+    writer.flush();
+
+    QCOMPARE(writer.committedBatches(), std::uint64_t(0));
+    QCOMPARE(writer.droppedBatches(), std::uint64_t(1));
+    QTRY_VERIFY(backlog.count() >= 2);
+    QCOMPARE(backlog.first().at(0).toBool(), true);
+    QCOMPARE(backlog.last().at(0).toBool(), false);
+}
+
+// A lock that outlasts every attempt drops the group rather than holding
+// the queue behind it.
+void WriteBehindStoreTest::busyGroupIsDroppedAfterItsAttempts()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    UserStore other(QDir(dir.path()), kAccount);
+    WriteBehindStore::Config config = holding();
+    config.busy_timeout = std::chrono::milliseconds(10);
+    config.retry_backoff = std::chrono::milliseconds(10);
+    config.max_attempts = 3;
+    WriteBehindStore writer(QDir(dir.path()), kAccount, config);
+
+    QVERIFY(other.transaction());
+    save(writer, makeTab("tab-a"));
+    writer.flush();
+    QCOMPARE(writer.committedBatches(), std::uint64_t(0));
+    QCOMPARE(writer.droppedBatches(), std::uint64_t(1));
+
+    // The queue behind it is not stuck.
+    QVERIFY(other.commit());
+    writer.saveStashList({makeTab("tab-b")}, kRealm, kLeague);
+    save(writer, makeTab("tab-b"));
+    writer.flush();
+    QCOMPARE(writer.committedBatches(), std::uint64_t(1));
+    QVERIFY(isCached(dir, "tab-b"));
+}
+
+QTEST_GUILESS_MAIN(WriteBehindStoreTest)
+
+#include "tst_writebehindstore.moc"
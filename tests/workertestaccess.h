@@ -49,6 +49,11 @@ public:
     // slot-throwing behavior. Null in production.
     void setFaultHook(std::function<void()> hook) { m_worker.m_fault_hook = std::move(hook); }
 
+    // Lower the item count at which a content reply's Items are built on the
+    // parse pool instead of inline, so a small fixture exercises the pool
+    // path and its reply-order hand-back.
+    void setPoolParseMinItems(size_t items) { m_worker.m_pool_parse_min_items = items; }
+
     // How many per-fetch task handles the worker still holds. This reaches zero
     // only after every awaited future — including any stopped old-update
     // straggler — has settled and the deferred sweep has drained, not merely when